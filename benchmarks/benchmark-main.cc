@@ -1,12 +1,32 @@
 #include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
 #include "ubench.h"
 
 #include "value-types.hh"
 #include "prim-types.hh"
 #include "usdGeom.hh"
+#include "stage.hh"
 
 using namespace tinyusdz;
 
+// Count heap allocations to report memory usage of benchmarks.
+static std::atomic<uint64_t> g_allocated_bytes{0};
+
+void *operator new(size_t sz) {
+  g_allocated_bytes += sz;
+  void *p = std::malloc(sz ? sz : 1);
+  if (!p) {
+    std::abort();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
 UBENCH(perf, vector_double_push_back_10M)
 {
   std::vector<double> v;
@@ -61,8 +81,7 @@ UBENCH(perf, timesamples_double_10M)
   tinyusdz::value::TimeSamples ts;
 
   for (size_t i = 0; i < ns; i++) {
-    ts.times.push_back(double(i));
-    ts.values.push_back(double(i));
+    ts.add_sample(double(i), value::Value(double(i)));
   }
 }
 
@@ -104,6 +123,104 @@ UBENCH(perf, string_vector_10M)
 
 }
 
+// Copy an Attribute-like value holding 1M points 100 times.
+// Array in value::Value is shared between copies(copy-on-write), so copies
+// are O(1) and do not allocate the array.
+UBENCH(perf, value_array_copy_1M_x100)
+{
+  constexpr size_t npoints = 1000 * 1000;
+  constexpr size_t ncopies = 100;
+
+  value::Value src(std::vector<value::point3f>(npoints, {1.0f, 2.0f, 3.0f}));
+
+  uint64_t start = g_allocated_bytes.load();
+  std::vector<value::Value> copies(ncopies, src);
+  uint64_t used = g_allocated_bytes.load() - start;
+
+  static bool reported = false;
+  if (!reported) {
+    printf("value_array_copy_1M_x100: allocated %.1f MB for %d copies\n", double(used) / (1024.0 * 1024.0), int(ncopies));
+    reported = true;
+  }
+}
+
+// Same as above, but deep-copy std::vector(= previous behavior of value::Value)
+UBENCH(perf, vector_array_copy_1M_x100)
+{
+  constexpr size_t npoints = 1000 * 1000;
+  constexpr size_t ncopies = 100;
+
+  std::vector<value::point3f> src(npoints, {1.0f, 2.0f, 3.0f});
+
+  uint64_t start = g_allocated_bytes.load();
+  std::vector<std::vector<value::point3f>> copies(ncopies, src);
+  uint64_t used = g_allocated_bytes.load() - start;
+
+  static bool reported = false;
+  if (!reported) {
+    printf("vector_array_copy_1M_x100: allocated %.1f MB for %d copies\n", double(used) / (1024.0 * 1024.0), int(ncopies));
+    reported = true;
+  }
+}
+
+// Stage with 100 root Prims x 100 child Prims.
+static const Stage &GetLookupBenchStage() {
+  static Stage stage;
+  static bool initialized = false;
+  if (!initialized) {
+    for (size_t i = 0; i < 100; i++) {
+      Xform xform;
+      Prim root("root" + std::to_string(i), xform);
+      for (size_t j = 0; j < 100; j++) {
+        Xform child;
+        root.add_child(Prim("child" + std::to_string(j), child));
+      }
+      stage.add_root_prim(std::move(root));
+    }
+    stage.commit();
+    initialized = true;
+  }
+  return stage;
+}
+
+// Look up every Prim(10k) by its Path.
+UBENCH(perf, stage_prim_path_lookup_10k)
+{
+  const Stage &stage = GetLookupBenchStage();
+
+  static std::vector<Path> paths;
+  if (paths.empty()) {
+    for (size_t i = 0; i < 100; i++) {
+      for (size_t j = 0; j < 100; j++) {
+        paths.emplace_back("/root" + std::to_string(i) + "/child" + std::to_string(j), "");
+      }
+    }
+  }
+
+  size_t nfound = 0;
+  for (const auto &path : paths) {
+    if (stage.GetPrimAtPath(path)) {
+      nfound++;
+    }
+  }
+  UBENCH_DO_NOTHING(&nfound);
+}
+
+// Look up every Prim(10k) by its prim_id.
+UBENCH(perf, stage_prim_id_lookup_10k)
+{
+  const Stage &stage = GetLookupBenchStage();
+
+  size_t nfound = 0;
+  for (uint64_t prim_id = 1; prim_id <= 100 * 101; prim_id++) {
+    const Prim *prim{nullptr};
+    if (stage.find_prim_by_prim_id(prim_id, prim)) {
+      nfound++;
+    }
+  }
+  UBENCH_DO_NOTHING(&nfound);
+}
+
 //int main(int argc, char **argv)
 //{
 //  benchmark_any_type();
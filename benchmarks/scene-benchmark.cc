@@ -0,0 +1,657 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// Scene-level benchmark. Load, export, compose and convert synthetic scenes,
+// then report throughput(MB/s, prims/s) and peak heap usage of each phase.
+//
+// Usage:
+//
+//   scene_benchmark_tinyusdz [--prims N] [--vertices M] [--samples K]
+//                            [--depth D] [--iterations I] [--json FILE]
+//
+// Results are printed as a table. `--json` additionally writes them as JSON
+// so that runs can be compared by scripts.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "asset-resolution.hh"
+#include "composition.hh"
+#include "scene-generator.hh"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "usdc-writer.hh"
+#include "usdz-writer.hh"
+
+#if defined(TINYUSDZ_WITH_TYDRA)
+#include "tydra/render-data.hh"
+#endif
+
+using namespace tinyusdz;
+
+//
+// Track live and peak bytes of heap allocations. The size of each allocation
+// is stored in front of the returned memory.
+//
+namespace {
+
+constexpr size_t kAllocHeaderSize = 16;  // Keep 16 byte alignment.
+
+std::atomic<uint64_t> g_live_bytes{0};
+std::atomic<uint64_t> g_peak_bytes{0};
+
+void *TrackedAlloc(size_t sz) {
+  void *p = std::malloc(sz + kAllocHeaderSize);
+  if (!p) {
+    return nullptr;
+  }
+  *reinterpret_cast<size_t *>(p) = sz;
+
+  uint64_t live = g_live_bytes.fetch_add(sz) + sz;
+  uint64_t peak = g_peak_bytes.load();
+  while ((live > peak) && !g_peak_bytes.compare_exchange_weak(peak, live)) {
+  }
+
+  return reinterpret_cast<uint8_t *>(p) + kAllocHeaderSize;
+}
+
+void TrackedFree(void *p) {
+  if (!p) {
+    return;
+  }
+  uint8_t *base = reinterpret_cast<uint8_t *>(p) - kAllocHeaderSize;
+  g_live_bytes -= *reinterpret_cast<size_t *>(base);
+  std::free(base);
+}
+
+}  // namespace
+
+void *operator new(size_t sz) {
+  void *p = TrackedAlloc(sz);
+  if (!p) {
+    std::abort();
+  }
+  return p;
+}
+
+void *operator new[](size_t sz) { return operator new(sz); }
+
+void *operator new(size_t sz, const std::nothrow_t &) noexcept {
+  return TrackedAlloc(sz);
+}
+
+void *operator new[](size_t sz, const std::nothrow_t &) noexcept {
+  return TrackedAlloc(sz);
+}
+
+void operator delete(void *p) noexcept { TrackedFree(p); }
+void operator delete[](void *p) noexcept { TrackedFree(p); }
+void operator delete(void *p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void *p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  TrackedFree(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  TrackedFree(p);
+}
+
+namespace {
+
+struct BenchConfig {
+  bench::SceneGeneratorConfig scene;
+  uint32_t iterations{3};
+  std::string json_filename;
+};
+
+struct PhaseResult {
+  std::string name;
+  uint64_t bytes{0};  // Input(or output) bytes processed in an iteration.
+  uint64_t prims{0};  // Prims processed in an iteration.
+  std::vector<double> seconds;
+  uint64_t peak_heap_bytes{0};  // Max heap growth during an iteration.
+
+  double min_seconds() const {
+    return seconds.empty() ? 0.0
+                           : *std::min_element(seconds.begin(), seconds.end());
+  }
+
+  double median_seconds() const {
+    if (seconds.empty()) {
+      return 0.0;
+    }
+    std::vector<double> s = seconds;
+    std::sort(s.begin(), s.end());
+    return s[s.size() / 2];
+  }
+
+  // Throughput is computed from the fastest iteration.
+  double mb_per_sec() const {
+    double t = min_seconds();
+    return (t > 0.0) ? (double(bytes) / (1024.0 * 1024.0)) / t : 0.0;
+  }
+
+  double prims_per_sec() const {
+    double t = min_seconds();
+    return (t > 0.0) ? double(prims) / t : 0.0;
+  }
+};
+
+struct PhaseStats {
+  uint64_t bytes{0};
+  uint64_t prims{0};
+};
+
+///
+/// Run `fn` `iterations` times. `reset` is called before each iteration
+/// outside of the measurement, so that releasing the result of the previous
+/// iteration is not counted.
+///
+bool RunPhase(const std::string &name, uint32_t iterations,
+              const std::function<void()> &reset,
+              const std::function<bool(PhaseStats *, std::string *)> &fn,
+              std::vector<PhaseResult> *results) {
+  PhaseResult result;
+  result.name = name;
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    reset();
+
+    uint64_t base_bytes = g_live_bytes.load();
+    g_peak_bytes = base_bytes;
+
+    PhaseStats stats;
+    std::string err;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ret = fn(&stats, &err);
+    auto end = std::chrono::steady_clock::now();
+
+    if (!ret) {
+      std::fprintf(stderr, "[%s] failed: %s\n", name.c_str(), err.c_str());
+      return false;
+    }
+
+    result.bytes = stats.bytes;
+    result.prims = stats.prims;
+    result.seconds.push_back(
+        std::chrono::duration<double>(end - start).count());
+    result.peak_heap_bytes =
+        (std::max)(result.peak_heap_bytes, g_peak_bytes.load() - base_bytes);
+  }
+
+  results->push_back(result);
+  return true;
+}
+
+uint64_t CountPrims(const Prim &prim) {
+  uint64_t n = 1;
+  for (const auto &child : prim.children()) {
+    n += CountPrims(child);
+  }
+  return n;
+}
+
+uint64_t CountPrims(const PrimSpec &ps) {
+  uint64_t n = 1;
+  for (const auto &child : ps.children()) {
+    n += CountPrims(child);
+  }
+  return n;
+}
+
+uint64_t CountPrims(const Layer &layer) {
+  uint64_t n = 0;
+  for (const auto &it : layer.primspecs()) {
+    n += CountPrims(it.second);
+  }
+  return n;
+}
+
+uint64_t CountPrims(const Stage &stage) {
+  uint64_t n = 0;
+  for (const auto &prim : stage.root_prims()) {
+    n += CountPrims(prim);
+  }
+  return n;
+}
+
+// Peak resident set size of the process. 0 when unavailable.
+uint64_t GetPeakRSS() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return uint64_t(usage.ru_maxrss);  // bytes
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;  // KB
+#endif
+  }
+#endif
+  return 0;
+}
+
+//
+// Serve layers of the composition scene from memory.
+//
+using MemoryAssetMap = std::map<std::string, std::string>;
+
+int MemoryARResolve(const char *asset_name,
+                    const std::vector<std::string> &search_paths,
+                    std::string *resolved_asset_name, std::string *err,
+                    void *userdata) {
+  (void)search_paths;
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!asset_name || !resolved_asset_name || !assets) {
+    return -2;
+  }
+
+  std::string name(asset_name);
+  if (name.compare(0, 2, "./") == 0) {
+    name = name.substr(2);
+  }
+
+  if (!assets->count(name)) {
+    return -1;
+  }
+
+  (*resolved_asset_name) = name;
+  return 0;
+}
+
+int MemoryARSize(const char *resolved_asset_name, uint64_t *nbytes,
+                 std::string *err, void *userdata) {
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!resolved_asset_name || !nbytes || !assets) {
+    return -2;
+  }
+
+  auto it = assets->find(resolved_asset_name);
+  if (it == assets->end()) {
+    return -1;
+  }
+
+  (*nbytes) = it->second.size();
+  return 0;
+}
+
+int MemoryARMap(const char *resolved_asset_name, const uint8_t **out_addr,
+                uint64_t *nbytes, std::string *err, void *userdata) {
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!resolved_asset_name || !out_addr || !nbytes || !assets) {
+    return -2;
+  }
+
+  auto it = assets->find(resolved_asset_name);
+  if (it == assets->end()) {
+    return -1;
+  }
+
+  (*out_addr) = reinterpret_cast<const uint8_t *>(it->second.data());
+  (*nbytes) = it->second.size();
+  return 0;
+}
+
+bool AppendToBuffer(const uint8_t *data, size_t size, void *userdata) {
+  std::vector<uint8_t> *buf = reinterpret_cast<std::vector<uint8_t> *>(userdata);
+  buf->insert(buf->end(), data, data + size);
+  return true;
+}
+
+std::string JSONString(const std::string &s) {
+  std::string dst = "\"";
+  for (char c : s) {
+    if ((c == '"') || (c == '\\')) {
+      dst += '\\';
+    }
+    dst += c;
+  }
+  dst += "\"";
+  return dst;
+}
+
+std::string ToJSON(const BenchConfig &config,
+                   const std::vector<PhaseResult> &results,
+                   uint64_t peak_rss) {
+  std::stringstream ss;
+  ss.precision(9);
+
+  ss << "{\n";
+  ss << "  \"config\": {\n";
+  ss << "    \"prims\": " << config.scene.num_prims << ",\n";
+  ss << "    \"vertices\": " << config.scene.num_vertices << ",\n";
+  ss << "    \"timesamples\": " << config.scene.num_timesamples << ",\n";
+  ss << "    \"depth\": " << config.scene.depth << ",\n";
+  ss << "    \"iterations\": " << config.iterations << "\n";
+  ss << "  },\n";
+  ss << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const PhaseResult &r = results[i];
+    ss << "    {\n";
+    ss << "      \"phase\": " << JSONString(r.name) << ",\n";
+    ss << "      \"bytes\": " << r.bytes << ",\n";
+    ss << "      \"prims\": " << r.prims << ",\n";
+    ss << "      \"min_seconds\": " << r.min_seconds() << ",\n";
+    ss << "      \"median_seconds\": " << r.median_seconds() << ",\n";
+    ss << "      \"mb_per_sec\": " << r.mb_per_sec() << ",\n";
+    ss << "      \"prims_per_sec\": " << r.prims_per_sec() << ",\n";
+    ss << "      \"peak_heap_bytes\": " << r.peak_heap_bytes << "\n";
+    ss << "    }" << ((i + 1 < results.size()) ? "," : "") << "\n";
+  }
+  ss << "  ],\n";
+  ss << "  \"peak_rss_bytes\": " << peak_rss << "\n";
+  ss << "}\n";
+
+  return ss.str();
+}
+
+void PrintResults(const std::vector<PhaseResult> &results, uint64_t peak_rss) {
+  std::printf("%-14s %12s %12s %10s %12s %14s\n", "phase", "min(ms)",
+              "median(ms)", "MB/s", "prims/s", "peak heap(MB)");
+  for (const auto &r : results) {
+    std::printf("%-14s %12.3f %12.3f %10.2f %12.0f %14.2f\n", r.name.c_str(),
+                r.min_seconds() * 1000.0, r.median_seconds() * 1000.0,
+                r.mb_per_sec(), r.prims_per_sec(),
+                double(r.peak_heap_bytes) / (1024.0 * 1024.0));
+  }
+  std::printf("peak RSS: %.2f MB\n", double(peak_rss) / (1024.0 * 1024.0));
+}
+
+bool ParseUInt(const char *s, uint32_t *v) {
+  char *end = nullptr;
+  unsigned long n = std::strtoul(s, &end, 10);
+  if (!end || (*end != '\0') || (n > 0xffffffffUL)) {
+    return false;
+  }
+  (*v) = uint32_t(n);
+  return true;
+}
+
+void PrintUsage(const char *prog) {
+  std::printf(
+      "Usage: %s [--prims N] [--vertices M] [--samples K] [--depth D] "
+      "[--iterations I] [--json FILE]\n",
+      prog);
+}
+
+bool ParseArgs(int argc, char **argv, BenchConfig *config) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-h") || (arg == "--help")) {
+      return false;
+    }
+
+    if (i + 1 >= argc) {
+      std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+      return false;
+    }
+    const char *value = argv[++i];
+
+    bool ok = true;
+    if (arg == "--prims") {
+      ok = ParseUInt(value, &config->scene.num_prims);
+    } else if (arg == "--vertices") {
+      ok = ParseUInt(value, &config->scene.num_vertices);
+    } else if (arg == "--samples") {
+      ok = ParseUInt(value, &config->scene.num_timesamples);
+    } else if (arg == "--depth") {
+      ok = ParseUInt(value, &config->scene.depth);
+    } else if (arg == "--iterations") {
+      ok = ParseUInt(value, &config->iterations) && (config->iterations > 0);
+    } else if (arg == "--json") {
+      config->json_filename = value;
+    } else {
+      std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+      return false;
+    }
+
+    if (!ok) {
+      std::fprintf(stderr, "Invalid value for %s: %s\n", arg.c_str(), value);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  BenchConfig config;
+  if (!ParseArgs(argc, argv, &config)) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const std::string usda = bench::GenerateUSDAScene(config.scene);
+  const bench::CompositionScene comp_scene =
+      bench::GenerateCompositionScene(config.scene);
+
+  std::vector<PhaseResult> results;
+  const uint32_t niter = config.iterations;
+
+  Stage stage;
+  if (!RunPhase(
+          "usda_load", niter, [&]() { stage = Stage(); },
+          [&](PhaseStats *stats, std::string *err) {
+            std::string warn;
+            if (!LoadUSDAFromMemory(
+                    reinterpret_cast<const uint8_t *>(usda.data()),
+                    usda.size(), "bench.usda", &stage, &warn, err)) {
+              return false;
+            }
+            stats->bytes = usda.size();
+            stats->prims = CountPrims(stage);
+            return true;
+          },
+          &results)) {
+    return EXIT_FAILURE;
+  }
+
+  std::string exported;
+  if (!RunPhase(
+          "usda_export", niter, [&]() { exported = std::string(); },
+          [&](PhaseStats *stats, std::string *err) {
+            (void)err;
+            exported = stage.ExportToString();
+            stats->bytes = exported.size();
+            stats->prims = results[0].prims;
+            return true;
+          },
+          &results)) {
+    return EXIT_FAILURE;
+  }
+
+  std::vector<uint8_t> usdc;
+  {
+    std::string warn, err;
+    Layer layer;
+    if (!LoadUSDALayerFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                 usda.size(), "bench.usda", &layer, &warn,
+                                 &err) ||
+        !usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err)) {
+      std::fprintf(stderr, "Skip USDC/USDZ phases. Failed to save USDC: %s\n",
+                   err.c_str());
+      usdc.clear();
+    }
+  }
+
+  if (!usdc.empty()) {
+    Stage usdc_stage;
+    if (!RunPhase(
+            "usdc_load", niter, [&]() { usdc_stage = Stage(); },
+            [&](PhaseStats *stats, std::string *err) {
+              std::string warn;
+              if (!LoadUSDCFromMemory(usdc.data(), usdc.size(), "bench.usdc",
+                                      &usdc_stage, &warn, err)) {
+                return false;
+              }
+              stats->bytes = usdc.size();
+              stats->prims = CountPrims(usdc_stage);
+              return true;
+            },
+            &results)) {
+      return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> usdz;
+    {
+      usdz::USDZWriter writer;
+      if (!writer.Open(AppendToBuffer, &usdz) ||
+          !writer.AddFile("root.usdc", usdc.data(), usdc.size()) ||
+          !writer.Close()) {
+        std::fprintf(stderr, "Failed to write USDZ: %s\n",
+                     writer.GetError().c_str());
+        return EXIT_FAILURE;
+      }
+    }
+
+    Stage usdz_stage;
+    if (!RunPhase(
+            "usdz_load", niter, [&]() { usdz_stage = Stage(); },
+            [&](PhaseStats *stats, std::string *err) {
+              std::string warn;
+              if (!LoadUSDZFromMemory(usdz.data(), usdz.size(), "bench.usdz",
+                                      &usdz_stage, &warn, err)) {
+                return false;
+              }
+              stats->bytes = usdz.size();
+              stats->prims = CountPrims(usdz_stage);
+              return true;
+            },
+            &results)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    MemoryAssetMap assets;
+    assets[bench::kCompositionSublayerName] = comp_scene.sub_layer;
+    assets[bench::kCompositionProtoName] = comp_scene.proto_layer;
+
+    AssetResolutionHandler handler;
+    handler.resolve_fun = MemoryARResolve;
+    handler.size_fun = MemoryARSize;
+    handler.map_fun = MemoryARMap;
+    handler.userdata = &assets;
+
+    const uint64_t comp_bytes = comp_scene.root_layer.size() +
+                                comp_scene.sub_layer.size() +
+                                comp_scene.proto_layer.size();
+
+    // "comp_prefetch" loads layers concurrently with `PrefetchLayers`
+    // before composition.
+    for (const bool prefetch : {false, true}) {
+      Stage comp_stage;
+      if (!RunPhase(
+              prefetch ? "comp_prefetch" : "composition", niter,
+              [&]() { comp_stage = Stage(); },
+              [&](PhaseStats *stats, std::string *err) {
+                std::string warn;
+
+                AssetResolutionResolver resolver;
+                resolver.register_asset_resolution_handler("usda", handler);
+
+                Layer root_layer;
+                if (!LoadLayerFromMemory(
+                        reinterpret_cast<const uint8_t *>(
+                            comp_scene.root_layer.data()),
+                        comp_scene.root_layer.size(), "root.usda",
+                        &root_layer, &warn, err)) {
+                  return false;
+                }
+
+                LayerCache layer_cache;
+                if (prefetch && !PrefetchLayers(resolver, root_layer,
+                                                &layer_cache, &warn, err)) {
+                  return false;
+                }
+
+                SublayersCompositionOptions sublayer_options;
+                sublayer_options.layer_cache = &layer_cache;
+
+                Layer sublayered;
+                if (!CompositeSublayers(resolver, root_layer, &sublayered,
+                                        &warn, err, sublayer_options)) {
+                  return false;
+                }
+
+                ReferencesCompositionOptions ref_options;
+                ref_options.layer_cache = &layer_cache;
+
+                Layer referenced;
+                if (!CompositeReferences(resolver, sublayered, &referenced,
+                                         &warn, err, ref_options)) {
+                  return false;
+                }
+
+                if (!LayerToStage(referenced, &comp_stage, &warn, err)) {
+                  return false;
+                }
+
+                stats->bytes = comp_bytes;
+                // Count PrimSpecs of the composited Layer, since
+                // `LayerToStage` does not reconstruct child Prims yet.
+                stats->prims = CountPrims(referenced);
+                return true;
+              },
+              &results)) {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+#if defined(TINYUSDZ_WITH_TYDRA)
+  {
+    tydra::RenderScene render_scene;
+    if (!RunPhase(
+            "render_scene", niter,
+            [&]() { render_scene = tydra::RenderScene(); },
+            [&](PhaseStats *stats, std::string *err) {
+              tydra::RenderSceneConverterEnv env(stage);
+              tydra::RenderSceneConverter converter;
+              if (!converter.ConvertToRenderScene(env, &render_scene)) {
+                (*err) += converter.GetError();
+                return false;
+              }
+              stats->prims = results[0].prims;
+              return true;
+            },
+            &results)) {
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+
+  const uint64_t peak_rss = GetPeakRSS();
+
+  PrintResults(results, peak_rss);
+
+  if (!config.json_filename.empty()) {
+    std::ofstream ofs(config.json_filename);
+    if (!ofs) {
+      std::fprintf(stderr, "Failed to open %s\n",
+                   config.json_filename.c_str());
+      return EXIT_FAILURE;
+    }
+    ofs << ToJSON(config, results, peak_rss);
+  }
+
+  return EXIT_SUCCESS;
+}
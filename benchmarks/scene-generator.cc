@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+#include "scene-generator.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace tinyusdz {
+namespace bench {
+
+namespace {
+
+struct Grid {
+  uint32_t width{2};
+  uint32_t height{2};
+};
+
+Grid MakeGrid(uint32_t num_vertices) {
+  Grid grid;
+  grid.width = (std::max)(
+      2u, uint32_t(std::ceil(std::sqrt(double(num_vertices)))));
+  grid.height = (std::max)(2u, (num_vertices + grid.width - 1) / grid.width);
+  return grid;
+}
+
+void Indent(std::string *s, uint32_t n) { s->append(n * 2, ' '); }
+
+void AppendNumber(std::string *s, double v) {
+  char buf[32];
+  int n = std::snprintf(buf, sizeof(buf), "%g", v);
+  s->append(buf, size_t(n));
+}
+
+void AppendNumber(std::string *s, uint32_t v) {
+  char buf[16];
+  int n = std::snprintf(buf, sizeof(buf), "%u", v);
+  s->append(buf, size_t(n));
+}
+
+void AppendMesh(std::string *s, const std::string &name, const Grid &grid,
+                uint32_t mesh_id, uint32_t num_timesamples, uint32_t indent) {
+  const uint32_t w = grid.width;
+  const uint32_t h = grid.height;
+  const double z = double(mesh_id) * 0.001;
+
+  Indent(s, indent);
+  s->append("def Mesh \"" + name + "\"\n");
+  Indent(s, indent);
+  s->append("{\n");
+
+  Indent(s, indent + 1);
+  s->append("int[] faceVertexCounts = [");
+  for (uint32_t i = 0; i < (w - 1) * (h - 1); i++) {
+    s->append(i ? ", 4" : "4");
+  }
+  s->append("]\n");
+
+  Indent(s, indent + 1);
+  s->append("int[] faceVertexIndices = [");
+  for (uint32_t y = 0; y < h - 1; y++) {
+    for (uint32_t x = 0; x < w - 1; x++) {
+      if (x || y) {
+        s->append(", ");
+      }
+      AppendNumber(s, y * w + x);
+      s->append(", ");
+      AppendNumber(s, y * w + x + 1);
+      s->append(", ");
+      AppendNumber(s, (y + 1) * w + x + 1);
+      s->append(", ");
+      AppendNumber(s, (y + 1) * w + x);
+    }
+  }
+  s->append("]\n");
+
+  Indent(s, indent + 1);
+  s->append("normal3f[] normals = [");
+  for (uint32_t i = 0; i < w * h; i++) {
+    s->append(i ? ", (0, 0, 1)" : "(0, 0, 1)");
+  }
+  s->append("] (\n");
+  Indent(s, indent + 2);
+  s->append("interpolation = \"vertex\"\n");
+  Indent(s, indent + 1);
+  s->append(")\n");
+
+  Indent(s, indent + 1);
+  s->append("point3f[] points = [");
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      s->append((x || y) ? ", (" : "(");
+      AppendNumber(s, double(x) / double(w - 1));
+      s->append(", ");
+      AppendNumber(s, double(y) / double(h - 1));
+      s->append(", ");
+      AppendNumber(s, z);
+      s->append(")");
+    }
+  }
+  s->append("]\n");
+
+  Indent(s, indent + 1);
+  s->append("texCoord2f[] primvars:st = [");
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      s->append((x || y) ? ", (" : "(");
+      AppendNumber(s, double(x) / double(w - 1));
+      s->append(", ");
+      AppendNumber(s, double(y) / double(h - 1));
+      s->append(")");
+    }
+  }
+  s->append("] (\n");
+  Indent(s, indent + 2);
+  s->append("interpolation = \"vertex\"\n");
+  Indent(s, indent + 1);
+  s->append(")\n");
+
+  Indent(s, indent + 1);
+  s->append("uniform token subdivisionScheme = \"none\"\n");
+
+  Indent(s, indent + 1);
+  if (num_timesamples) {
+    s->append("double3 xformOp:translate.timeSamples = {\n");
+    for (uint32_t t = 0; t < num_timesamples; t++) {
+      Indent(s, indent + 2);
+      AppendNumber(s, t);
+      s->append(": (");
+      AppendNumber(s, double(mesh_id % 100));
+      s->append(", ");
+      AppendNumber(s, double(t) * 0.1);
+      s->append(", 0),\n");
+    }
+    Indent(s, indent + 1);
+    s->append("}\n");
+  } else {
+    s->append("double3 xformOp:translate = (");
+    AppendNumber(s, double(mesh_id % 100));
+    s->append(", 0, 0)\n");
+  }
+
+  Indent(s, indent + 1);
+  s->append("uniform token[] xformOpOrder = [\"xformOp:translate\"]\n");
+
+  Indent(s, indent);
+  s->append("}\n");
+}
+
+void AppendHeader(std::string *s, const std::string &default_prim,
+                  const SceneGeneratorConfig &config,
+                  const std::string &extra_metas) {
+  s->append("#usda 1.0\n(\n");
+  s->append("  defaultPrim = \"" + default_prim + "\"\n");
+  if (config.num_timesamples) {
+    s->append("  startTimeCode = 0\n  endTimeCode = ");
+    AppendNumber(s, config.num_timesamples - 1);
+    s->append("\n");
+  }
+  s->append(extra_metas);
+  s->append("  upAxis = \"Y\"\n)\n\n");
+}
+
+}  // namespace
+
+std::string GenerateUSDAScene(const SceneGeneratorConfig &config) {
+  const Grid grid = MakeGrid(config.num_vertices);
+  const uint32_t depth = (std::max)(1u, config.depth);
+  const uint32_t group_size = (std::max)(1u, config.meshes_per_group);
+
+  std::string s;
+  AppendHeader(&s, "root", config, "");
+
+  s.append("def Xform \"root\"\n{\n");
+
+  uint32_t mesh_id = 0;
+  for (uint32_t g = 0; mesh_id < config.num_prims; g++) {
+    for (uint32_t d = 0; d < depth; d++) {
+      Indent(&s, d + 1);
+      s.append("def Xform \"");
+      if (d == 0) {
+        s.append("group_");
+        AppendNumber(&s, g);
+      } else {
+        s.append("level_");
+        AppendNumber(&s, d);
+      }
+      s.append("\"\n");
+      Indent(&s, d + 1);
+      s.append("{\n");
+    }
+
+    for (uint32_t i = 0; (i < group_size) && (mesh_id < config.num_prims);
+         i++, mesh_id++) {
+      AppendMesh(&s, "mesh_" + std::to_string(i), grid, mesh_id,
+                 config.num_timesamples, depth + 1);
+    }
+
+    for (uint32_t d = depth; d > 0; d--) {
+      Indent(&s, d);
+      s.append("}\n");
+    }
+  }
+
+  s.append("}\n");
+
+  return s;
+}
+
+CompositionScene GenerateCompositionScene(const SceneGeneratorConfig &config) {
+  CompositionScene scene;
+
+  scene.sub_layer = GenerateUSDAScene(config);
+
+  {
+    SceneGeneratorConfig proto_config = config;
+    proto_config.num_timesamples = 0;
+
+    std::string &s = scene.proto_layer;
+    AppendHeader(&s, "proto", proto_config, "");
+    AppendMesh(&s, "proto", MakeGrid(config.num_vertices), 0,
+               /* num_timesamples */ 0, 0);
+  }
+
+  {
+    std::string &s = scene.root_layer;
+    AppendHeader(&s, "instances", config,
+                 std::string("  subLayers = [@") + kCompositionSublayerName +
+                     "@]\n");
+
+    s.append("def Xform \"instances\"\n{\n");
+    for (uint32_t i = 0; i < config.num_prims; i++) {
+      s.append("  def \"instance_");
+      AppendNumber(&s, i);
+      s.append("\" (\n    prepend references = @");
+      s.append(kCompositionProtoName);
+      s.append("@\n  )\n  {\n    double3 xformOp:translate = (");
+      AppendNumber(&s, double(i));
+      s.append(", 0, 0)\n  }\n");
+    }
+    s.append("}\n");
+  }
+
+  return scene;
+}
+
+}  // namespace bench
+}  // namespace tinyusdz
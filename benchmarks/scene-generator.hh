@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// Synthetic USD scene generator for benchmarks.
+//
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace tinyusdz {
+namespace bench {
+
+struct SceneGeneratorConfig {
+  uint32_t num_prims{1000};      // The number of Mesh prims.
+  uint32_t num_vertices{256};    // Vertices per Mesh(rounded to a grid).
+  uint32_t num_timesamples{0};   // Time samples of `xformOp:translate` per
+                                 // Mesh. 0 = static.
+  uint32_t depth{4};             // Xform nesting depth above Meshes.
+  uint32_t meshes_per_group{16}; // The number of Meshes in a leaf Xform.
+};
+
+///
+/// Generate a scene as USDA text.
+///
+/// /root
+///   /group_0/level_1/.../level_{depth-1}
+///     /mesh_0 ... /mesh_{meshes_per_group-1}
+///   /group_1/...
+///
+/// Each Mesh has points, normals, texcoords and topology of a quad grid.
+/// `points` differ for each Mesh so that the data is not deduplicated.
+///
+std::string GenerateUSDAScene(const SceneGeneratorConfig &config);
+
+constexpr auto kCompositionSublayerName = "sublayer.usda";
+constexpr auto kCompositionProtoName = "proto.usda";
+
+struct CompositionScene {
+  std::string root_layer;
+  std::string sub_layer;    // kCompositionSublayerName
+  std::string proto_layer;  // kCompositionProtoName
+};
+
+///
+/// Generate layers to exercise composition.
+///
+/// The root layer has `subLayers = [@sublayer.usda@]`, where the sublayer is
+/// the scene of `GenerateUSDAScene`, and `num_prims` prims under `/instances`,
+/// each of them references a Mesh in `proto.usda`.
+///
+CompositionScene GenerateCompositionScene(const SceneGeneratorConfig &config);
+
+}  // namespace bench
+}  // namespace tinyusdz
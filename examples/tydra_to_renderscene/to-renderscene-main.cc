@@ -35,6 +35,8 @@ int main(int argc, char **argv) {
     std::cout
         << "  --dumpobj: Dump mesh as wavefront .obj(for visual debugging)\n";
     std::cout << "  --dumpusd: Dump scene as USD(USDA Ascii)\n";
+    std::cout << "  --threads N: # of threads to convert meshes(-1 = use all "
+                 "hardware threads)\n";
     return EXIT_FAILURE;
   }
 
@@ -48,6 +50,7 @@ int main(int argc, char **argv) {
   bool export_obj = false;
   bool export_usd = false;
   bool no_usdprint = false;
+  int num_threads = 1;
 
   std::string filepath;
   for (int i = 1; i < argc; i++) {
@@ -69,6 +72,13 @@ int main(int argc, char **argv) {
       timecode = std::stod(argv[i + 1]);
       std::cout << "Use timecode: " << timecode << "\n";
       i++;
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      if ((i + 1) >= argc) {
+        std::cerr << "arg is missing for --threads flag.\n";
+        return -1;
+      }
+      num_threads = std::stoi(argv[i + 1]);
+      i++;
     } else {
       filepath = argv[i];
     }
@@ -157,6 +167,7 @@ int main(int argc, char **argv) {
     std::cout << "Use timecode : " << timecode << "\n";
   }
   env.timecode = timecode;
+  env.scene_config.num_threads = num_threads;
   ret = converter.ConvertToRenderScene(env, &render_scene);
   if (!ret) {
     std::cerr << "Failed to convert USD Stage to RenderScene: \n"
@@ -794,6 +794,10 @@ bool AsciiParser::ReadBasicType(nonstd::optional<bool> *value) {
 }
 
 bool AsciiParser::ReadBasicType(int *value) {
+  if (MaybeFastInt(value)) {
+    return true;
+  }
+
   std::stringstream ss;
 
   // pxrUSD allow floating-point value to `int` type.
@@ -2301,6 +2305,77 @@ bool AsciiParser::ParseBasicTypeArray(std::vector<Path> *result) {
   return true;
 }
 
+template <typename T>
+bool AsciiParser::MaybeFastFloat(T *out) {
+  size_t n = ScanNumberLiteral(/* is_integer */nullptr);
+  if (n == 0) {
+    return false;
+  }
+
+  const char *first =
+      reinterpret_cast<const char *>(_sr->data()) + _sr->tell();
+  const char *last = first + n;
+
+  // `fast_float` does not accept leading '+'
+  const char *p = (*first == '+') ? (first + 1) : first;
+
+  T v;
+  auto ans = fast_float::from_chars(p, last, v);
+  if ((ans.ec != std::errc()) || (ans.ptr != last)) {
+    return false;
+  }
+
+  if (!_sr->seek_from_current(int64_t(n))) {
+    return false;
+  }
+  _curr_cursor.col += int(n);
+
+  (*out) = v;
+  return true;
+}
+
+bool AsciiParser::MaybeFastInt(int *out) {
+  bool is_integer{false};
+  size_t n = ScanNumberLiteral(&is_integer);
+  if ((n == 0) || !is_integer) {
+    return false;
+  }
+
+  const char *p = reinterpret_cast<const char *>(_sr->data()) + _sr->tell();
+  const char *last = p + n;
+
+  bool negative = false;
+  if ((*p == '+') || (*p == '-')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  // Accumulate in int64 and let the slow path report overflow.
+  int64_t v = 0;
+  for (; p < last; p++) {
+    v = v * 10 + int64_t(*p - '0');
+    if (v > int64_t((std::numeric_limits<int>::max)()) + 1) {
+      return false;
+    }
+  }
+  if (negative) {
+    v = -v;
+  }
+
+  if ((v > int64_t((std::numeric_limits<int>::max)())) ||
+      (v < int64_t((std::numeric_limits<int>::min)()))) {
+    return false;
+  }
+
+  if (!_sr->seek_from_current(int64_t(n))) {
+    return false;
+  }
+  _curr_cursor.col += int(n);
+
+  (*out) = int(v);
+  return true;
+}
+
 template <typename T>
 bool AsciiParser::MaybeNonFinite(T *out) {
   auto loc = CurrLoc();
@@ -2813,6 +2888,10 @@ bool AsciiParser::ReadBasicType(nonstd::optional<uint64_t> *value) {
 }
 
 bool AsciiParser::ReadBasicType(float *value) {
+  if (MaybeFastFloat(value)) {
+    return true;
+  }
+
   // -inf, inf, nan
   {
     float v;
@@ -2853,6 +2932,10 @@ bool AsciiParser::ReadBasicType(nonstd::optional<float> *value) {
 }
 
 bool AsciiParser::ReadBasicType(double *value) {
+  if (MaybeFastFloat(value)) {
+    return true;
+  }
+
   // -inf, inf, nan
   {
     double v;
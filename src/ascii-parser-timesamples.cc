@@ -270,6 +270,10 @@ bool AsciiParser::ParseTimeSamples(const std::string &type_name,
 
   DCOUT("Parse TimeSamples success. # of items = " << ts.size());
 
+  // Loaded TimeSamples are read-only, so they can be evaluated from multiple
+  // threads.
+  ts.freeze();
+
   if (ts_out) {
     (*ts_out) = std::move(ts);
   }
@@ -2115,141 +2115,84 @@ bool AsciiParser::PopParserState(ParseState *state) {
 }
 
 bool AsciiParser::SkipWhitespace() {
-  while (!Eof()) {
-    char c;
-    if (!Char1(&c)) {
-      // this should not happen.
-      return false;
-    }
-    _curr_cursor.col++;
+  // Scan the input buffer directly.
+  const char *first =
+      reinterpret_cast<const char *>(_sr->data()) + _sr->tell();
+  const char *last = reinterpret_cast<const char *>(_sr->data()) + _sr->size();
 
-    if ((c == ' ') || (c == '\t') || (c == '\f')) {
-      // continue
-    } else {
-      break;
-    }
+  const char *p = first;
+  while ((p < last) && ((*p == ' ') || (*p == '\t') || (*p == '\f'))) {
+    p++;
   }
 
-  // unwind 1 char
-  if (!_sr->seek_from_current(-1)) {
-    return false;
-  }
-  _curr_cursor.col--;
+  _curr_cursor.col += int(p - first);
 
-  return true;
+  return _sr->seek_from_current(int64_t(p - first));
 }
 
 bool AsciiParser::SkipWhitespaceAndNewline(const bool allow_semicolon) {
   // USDA also allow C-style ';' as a newline separator.
-  while (!Eof()) {
-    char c;
-    if (!Char1(&c)) {
-      // this should not happen.
-      return false;
-    }
+  // Scan the input buffer directly.
+  const char *first =
+      reinterpret_cast<const char *>(_sr->data()) + _sr->tell();
+  const char *last = reinterpret_cast<const char *>(_sr->data()) + _sr->size();
 
-    // printf("sws c = %c\n", c);
+  const char *p = first;
+  while (p < last) {
+    const char c = *p;
 
     if ((c == ' ') || (c == '\t') || (c == '\f')) {
       _curr_cursor.col++;
-      // continue
     } else if (allow_semicolon && (c == ';')) {
       _curr_cursor.col++;
-      // continue
     } else if (c == '\n') {
       _curr_cursor.col = 0;
       _curr_cursor.row++;
-      // continue
     } else if (c == '\r') {
       // CRLF?
-      if (_sr->tell() < (_sr->size() - 1)) {
-        char d;
-        if (!Char1(&d)) {
-          // this should not happen.
-          return false;
-        }
-
-        if (d == '\n') {
-          // CRLF
-        } else {
-          // unwind 1 char
-          if (!_sr->seek_from_current(-1)) {
-            // this should not happen.
-            return false;
-          }
-        }
+      if (((p + 1) < last) && (*(p + 1) == '\n')) {
+        p++;
       }
       _curr_cursor.col = 0;
       _curr_cursor.row++;
-      // continue
     } else {
       // end loop
-      if (!_sr->seek_from_current(-1)) {
-        return false;
-      }
       break;
     }
+    p++;
   }
 
-  return true;
+  return _sr->seek_from_current(int64_t(p - first));
 }
 
 bool AsciiParser::SkipCommentAndWhitespaceAndNewline(
     const bool allow_semicolon) {
   // Skip multiple line of comments.
   while (!Eof()) {
-    char c;
-    if (!Char1(&c)) {
-      // this should not happen.
+    if (!SkipWhitespaceAndNewline(allow_semicolon)) {
       return false;
     }
 
-    // printf("sws c = %c\n", c);
+    if (Eof()) {
+      break;
+    }
 
-    if (c == '#') {
-      if (!SkipUntilNewline()) {
-        return false;
-      }
-    } else if ((c == ' ') || (c == '\t') || (c == '\f')) {
-      _curr_cursor.col++;
-      // continue
-    } else if (allow_semicolon && (c == ';')) {
-      _curr_cursor.col++;
-      // continue
-    } else if (c == '\n') {
-      _curr_cursor.col = 0;
-      _curr_cursor.row++;
-      // continue
-    } else if (c == '\r') {
-      // CRLF?
-      if (_sr->tell() < (_sr->size() - 1)) {
-        char d;
-        if (!Char1(&d)) {
-          // this should not happen.
-          return false;
-        }
+    char c;
+    if (!LookChar1(&c)) {
+      return false;
+    }
 
-        if (d == '\n') {
-          // CRLF
-        } else {
-          // unwind 1 char
-          if (!_sr->seek_from_current(-1)) {
-            // this should not happen.
-            return false;
-          }
-        }
-      }
-      _curr_cursor.col = 0;
-      _curr_cursor.row++;
-      // continue
-    } else {
-      // std::cout << "unwind\n";
-      // end loop
-      if (!_sr->seek_from_current(-1)) {
-        return false;
-      }
+    if (c != '#') {
       break;
     }
+
+    if (!_sr->seek_from_current(1)) {
+      return false;
+    }
+
+    if (!SkipUntilNewline()) {
+      return false;
+    }
   }
 
   return true;
@@ -2965,6 +2908,70 @@ bool AsciiParser::LexFloat(std::string *result) {
   return true;
 }
 
+size_t AsciiParser::ScanNumberLiteral(bool *is_integer) {
+  // Same grammar with `LexFloat`, but scan the input buffer in-place.
+  const char *first =
+      reinterpret_cast<const char *>(_sr->data()) + _sr->tell();
+  const char *last = reinterpret_cast<const char *>(_sr->data()) + _sr->size();
+
+  auto is_digit = [](char c) { return (c >= '0') && (c <= '9'); };
+
+  const char *p = first;
+  if ((p < last) && ((*p == '+') || (*p == '-'))) {
+    p++;
+  }
+
+  const char *int_begin = p;
+  while ((p < last) && is_digit(*p)) {
+    p++;
+  }
+  size_t n_int = size_t(p - int_begin);
+
+  bool integer = true;
+  if ((p < last) && (*p == '.')) {
+    integer = false;
+    p++;
+    const char *frac_begin = p;
+    while ((p < last) && is_digit(*p)) {
+      p++;
+    }
+    if ((n_int == 0) && (p == frac_begin)) {
+      // `.` only
+      return 0;
+    }
+  } else if (n_int == 0) {
+    return 0;
+  }
+
+  if ((p < last) && ((*p == 'e') || (*p == 'E'))) {
+    integer = false;
+    p++;
+    if ((p < last) && ((*p == '+') || (*p == '-'))) {
+      p++;
+    }
+    const char *exp_begin = p;
+    while ((p < last) && is_digit(*p)) {
+      p++;
+    }
+    if (p == exp_begin) {
+      // Empty `E`
+      return 0;
+    }
+
+    // `LexFloat` treats sign characters after exponent digits(e.g. `1e+3-`)
+    // as a part of the exponent.
+    if ((p < last) && ((*p == '+') || (*p == '-'))) {
+      return 0;
+    }
+  }
+
+  if (is_integer) {
+    (*is_integer) = integer;
+  }
+
+  return size_t(p - first);
+}
+
 nonstd::optional<AsciiParser::VariableDef> AsciiParser::GetStageMetaDefinition(
     const std::string &name) {
   if (_supported_stage_metas.count(name)) {
@@ -3644,7 +3651,7 @@ bool AsciiParser::ParseBasicPrimAttr(bool array_qual,
   return true;
 }
 
-bool AsciiParser::ParsePrimProps(std::map<std::string, Property> *props,
+bool AsciiParser::ParsePrimProps(PropertyMap *props,
                                  std::vector<value::token> *propNames) {
   (void)propNames;
 
@@ -4519,7 +4526,7 @@ bool AsciiParser::ParsePrimProps(std::map<std::string, Property> *props,
 }
 
 // propNames stores list of property name in its appearance order.
-bool AsciiParser::ParseProperties(std::map<std::string, Property> *props,
+bool AsciiParser::ParseProperties(PropertyMap *props,
                                   std::vector<value::token> *propNames) {
   // property : primm_attr
   //          | 'rel' name '=' path
@@ -4899,7 +4906,7 @@ bool AsciiParser::ParseBlock(const Specifier spec, const int64_t primIdx,
     return false;
   }
 
-  std::map<std::string, Property> props;
+  PropertyMap props;
   std::vector<value::token> propNames;
   VariantSetList variantSetList;
 
@@ -5094,13 +5101,32 @@ bool AsciiParser::ParseBlock(const Specifier spec, const int64_t primIdx,
 /// Parser entry point
 /// TODO: Refactor and use unified code path regardless of LoadState.
 ///
-bool AsciiParser::Parse(const uint32_t load_states,
-                        const AsciiParserOption &parser_option) {
+void AsciiParser::SetLoadStates(const uint32_t load_states,
+                                const AsciiParserOption &parser_option) {
   _toplevel = (load_states & static_cast<uint32_t>(LoadState::Toplevel));
   _sub_layered = (load_states & static_cast<uint32_t>(LoadState::Sublayer));
   _referenced = (load_states & static_cast<uint32_t>(LoadState::Reference));
   _payloaded = (load_states & static_cast<uint32_t>(LoadState::Payload));
   _option = parser_option;
+}
+
+bool AsciiParser::Parse(const uint32_t load_states,
+                        const AsciiParserOption &parser_option) {
+  if (!ParseHeaderAndStageMetas(load_states, parser_option)) {
+    return false;
+  }
+
+  if (Eof()) {
+    // Empty USDA
+    return true;
+  }
+
+  return ParseRootPrimBlocks(load_states, parser_option);
+}
+
+bool AsciiParser::ParseHeaderAndStageMetas(
+    const uint32_t load_states, const AsciiParserOption &parser_option) {
+  SetLoadStates(load_states, parser_option);
 
   bool header_ok = ParseMagicHeader();
   if (!header_ok) {
@@ -5139,6 +5165,13 @@ bool AsciiParser::Parse(const uint32_t load_states,
     PUSH_WARN("Stage metadata processing callback is not set.");
   }
 
+  return true;
+}
+
+bool AsciiParser::ParseRootPrimBlocks(const uint32_t load_states,
+                                      const AsciiParserOption &parser_option) {
+  SetLoadStates(load_states, parser_option);
+
   PushPrimPath("/");
 
   // parse blocks
@@ -5189,6 +5222,152 @@ bool AsciiParser::Parse(const uint32_t load_states,
   return true;
 }
 
+bool AsciiParser::ScanRootPrimBlocks(std::vector<BlockRange> *blocks) {
+  if (!blocks) {
+    return false;
+  }
+
+  blocks->clear();
+
+  const char *base = reinterpret_cast<const char *>(_sr->data());
+  const char *p = base + _sr->tell();
+  const char *last = base + _sr->size();
+
+  Cursor cursor = _curr_cursor;
+
+  // Advance `p` by one character with tracking the cursor.
+  auto advance = [&]() {
+    if (*p == '\n') {
+      cursor.row++;
+      cursor.col = 0;
+    } else if (*p == '\r') {
+      if (((p + 1) < last) && (*(p + 1) == '\n')) {
+        p++;
+      }
+      cursor.row++;
+      cursor.col = 0;
+    } else {
+      cursor.col++;
+    }
+    p++;
+  };
+
+  // Skip until `n` repeats of `delim`(e.g. `"""`). '\' escapes the next
+  // character when `escape` is true.
+  auto skip_until = [&](const char delim, const size_t n, const bool escape) {
+    while ((p < last) && (*p != '\0')) {
+      if (escape && (*p == '\\')) {
+        advance();
+        if ((p < last) && (*p != '\0')) {
+          advance();
+        }
+        continue;
+      }
+
+      if ((*p == delim) && ((p + n) <= last)) {
+        size_t k = 1;
+        while ((k < n) && (*(p + k) == delim)) {
+          k++;
+        }
+        if (k == n) {
+          for (size_t i = 0; i < n; i++) {
+            advance();
+          }
+          return true;
+        }
+      }
+      advance();
+    }
+    return false;
+  };
+
+  BlockRange block;
+  block.begin = uint64_t(p - base);
+  block.cursor = cursor;
+
+  // Nesting level of `()`, `[]` and `{}`
+  int depth = 0;
+  bool in_block = false;
+
+  while ((p < last) && (*p != '\0')) {
+    const char c = *p;
+
+    if ((c == '"') || (c == '\'')) {
+      size_t n = 1;
+      if (((p + 2) < last) && (*(p + 1) == c) && (*(p + 2) == c)) {
+        n = 3;
+      }
+      for (size_t i = 0; i < n; i++) {
+        advance();
+      }
+      if (!skip_until(c, n, /* escape */ true)) {
+        return false;
+      }
+      in_block = true;
+    } else if (c == '@') {
+      size_t n = 1;
+      if (((p + 2) < last) && (*(p + 1) == '@') && (*(p + 2) == '@')) {
+        n = 3;
+      }
+      for (size_t i = 0; i < n; i++) {
+        advance();
+      }
+      if (!skip_until('@', n, /* escape */ (n == 3))) {
+        return false;
+      }
+      in_block = true;
+    } else if (c == '<') {
+      advance();
+      if (!skip_until('>', 1, /* escape */ false)) {
+        return false;
+      }
+      in_block = true;
+    } else if (c == '#') {
+      while ((p < last) && (*p != '\0') && (*p != '\n') && (*p != '\r')) {
+        advance();
+      }
+    } else if ((c == '(') || (c == '[') || (c == '{')) {
+      advance();
+      depth++;
+      in_block = true;
+    } else if ((c == ')') || (c == ']') || (c == '}')) {
+      advance();
+      depth--;
+      if (depth < 0) {
+        return false;
+      }
+
+      if ((c == '}') && (depth == 0)) {
+        // end of root Prim block.
+        block.end = uint64_t(p - base);
+        blocks->push_back(block);
+
+        block.begin = block.end;
+        block.cursor = cursor;
+        in_block = false;
+      }
+    } else {
+      if ((c != ' ') && (c != '\t') && (c != '\f') && (c != '\n') &&
+          (c != '\r')) {
+        in_block = true;
+      }
+      advance();
+    }
+  }
+
+  if (in_block || (depth != 0)) {
+    // Incomplete block.
+    return false;
+  }
+
+  // Include trailing whitespaces and comments to the last block.
+  if (!blocks->empty()) {
+    blocks->back().end = uint64_t(p - base);
+  }
+
+  return true;
+}
+
 bool ParseUnregistredValue(const std::string &_typeName, const std::string &str,
                            value::Value *value, std::string *err) {
   if (!value) {
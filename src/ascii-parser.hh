@@ -190,7 +190,7 @@ class AsciiParser {
   struct VariantContent {
     PrimMetaMap metas;
     std::vector<int64_t> primIndices;  // primIdx of Reconstrcuted Prim.
-    std::map<std::string, Property> props;
+    PropertyMap props;
     std::vector<value::token> properties;
 
     // for nested `variantSet` 
@@ -256,7 +256,7 @@ class AsciiParser {
           const Path &full_path, const Specifier spec,
           const std::string &primTypeName, const Path &prim_name,
           const int64_t primIdx, const int64_t parentPrimIdx,
-          const std::map<std::string, Property> &properties,
+          const PropertyMap &properties,
           const PrimMetaMap &in_meta, const VariantSetList &in_variantSetList)>;
 
   ///
@@ -288,7 +288,7 @@ class AsciiParser {
       const Path &full_path, const Specifier spec,
       const std::string &primTypeName, const Path &prim_name,
       const int64_t primIdx, const int64_t parentPrimIdx,
-      const std::map<std::string, Property> &properties,
+      const PropertyMap &properties,
       const PrimMetaMap &in_meta, const VariantSetList &in_variantSetLists)>;
 
   void RegisterPrimSpecFunction(PrimSpecFunction fun) { _primspec_fun = fun; }
@@ -326,6 +326,50 @@ class AsciiParser {
       const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
       const AsciiParserOption &parser_option = AsciiParserOption());
 
+  ///
+  /// `Parse` is composed of `ParseHeaderAndStageMetas` and
+  /// `ParseRootPrimBlocks`. These are exposed to parse root Prim blocks of a
+  /// USDA in parallel.
+  ///
+  /// Parse magic header and Stage metas. Input stream is advanced to the
+  /// beginning of root Prim blocks(or the end of input).
+  ///
+  bool ParseHeaderAndStageMetas(
+      const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
+      const AsciiParserOption &parser_option = AsciiParserOption());
+
+  ///
+  /// Parse root Prim blocks(`def`, `over` or `class`) from the current
+  /// position until the end of input.
+  ///
+  bool ParseRootPrimBlocks(
+      const uint32_t load_states = static_cast<uint32_t>(LoadState::Toplevel),
+      const AsciiParserOption &parser_option = AsciiParserOption());
+
+  struct BlockRange {
+    uint64_t begin{0};  // byte offset in StreamReader
+    uint64_t end{0};
+    Cursor cursor;  // cursor at `begin`
+  };
+
+  ///
+  /// Find the byte range of each root Prim block from the current position by
+  /// a lightweight scan(only brackets, strings, paths, asset paths and
+  /// comments are recognized. No syntax check). Ranges are contiguous, i.e.
+  /// whitespaces and comments between blocks are included in the range.
+  /// Input stream position is not changed.
+  ///
+  /// Return false when the input looks malformed(e.g. unbalanced brackets or
+  /// unterminated string). Use `ParseRootPrimBlocks` to get detailed errors.
+  ///
+  bool ScanRootPrimBlocks(std::vector<BlockRange> *blocks);
+
+  ///
+  /// Set the cursor(row, col) of the current position. Used when parsing a
+  /// part of USDA.
+  ///
+  void SetCursor(const Cursor &cursor) { _curr_cursor = cursor; }
+
   ///
   /// Parse TimeSample value with specified array type of
   /// `type_id`(value::TypeId) (You can obrain type_id from string using
@@ -682,6 +726,24 @@ class AsciiParser {
 
   bool LexFloat(std::string *result);
 
+  ///
+  /// Scan a floating-point(or integer) literal directly over the input buffer
+  /// without allocation. The stream position is not changed.
+  /// Returns the length of the literal in bytes, or 0 when the input does not
+  /// start with a well-formed literal(the caller should fall back to
+  /// `LexFloat` in this case to report an error).
+  /// `is_integer` is set to true when the literal has neither fraction nor
+  /// exponent part.
+  ///
+  size_t ScanNumberLiteral(bool *is_integer);
+
+  // Fast path for number literals: parse it in-place with `fast_float`.
+  // Return false(without consuming the input) when the fast path is not
+  // applicable, e.g. `inf`, `nan` or malformed literal.
+  template <typename T>
+  bool MaybeFastFloat(T *out);
+  bool MaybeFastInt(int *out);
+
   bool Expect(char expect_c);
 
   bool ReadStringLiteral(
@@ -738,7 +800,7 @@ class AsciiParser {
   }
 
   bool ParseRelationship(Relationship *result);
-  bool ParseProperties(std::map<std::string, Property> *props,
+  bool ParseProperties(PropertyMap *props,
                        std::vector<value::token> *propNames);
 
   //
@@ -791,8 +853,11 @@ class AsciiParser {
   ///
   void Setup();
 
+  void SetLoadStates(const uint32_t load_states,
+                     const AsciiParserOption &parser_option);
+
   nonstd::optional<std::pair<ListEditQual, MetaVariable>> ParsePrimMeta();
-  bool ParsePrimProps(std::map<std::string, Property> *props,
+  bool ParsePrimProps(PropertyMap *props,
                       std::vector<value::token> *propNames);
 
   template <typename T>
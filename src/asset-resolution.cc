@@ -136,7 +136,27 @@ bool AssetResolutionResolver::open_asset(const std::string &resolvedPath, const
   std::string ext = io::GetFileExtension(resolvedPath);
 
   if (_asset_resolution_handlers.count(ext)) {
-    if (_asset_resolution_handlers.at(ext).size_fun && _asset_resolution_handlers.at(ext).read_fun) {
+    if (_asset_resolution_handlers.at(ext).map_fun) {
+      // Use custom handler's userdata
+      void *userdata = _asset_resolution_handlers.at(ext).userdata;
+
+      const uint8_t *addr{nullptr};
+      uint64_t sz{0};
+      int ret = _asset_resolution_handlers.at(ext).map_fun(resolvedPath.c_str(), &addr, &sz, err, userdata);
+      if (ret != 0) {
+        if (err) {
+          (*err) += "Map asset through handler failed.\n";
+        }
+        return false;
+      }
+
+      DCOUT("asset_size: " << sz);
+
+      // Memory is retained by the handler.
+      asset_out->set_view(addr, size_t(sz));
+
+      return true;
+    } else if (_asset_resolution_handlers.at(ext).size_fun && _asset_resolution_handlers.at(ext).read_fun) {
 
       // Use custom handler's userdata
       void *userdata = _asset_resolution_handlers.at(ext).userdata;
@@ -181,9 +201,39 @@ bool AssetResolutionResolver::open_asset(const std::string &resolvedPath, const
     }
   }
 
+  size_t max_bytes = 1024 * 1024 * _max_asset_bytes_in_mb;
+
+  if (_use_mmap && io::IsMMapSupported()) {
+    io::MMapFileHandle handle;
+    std::string _err;
+    if (io::MMapFile(resolvedPath, &handle, /* writable */false, &_err)) {
+      // Unmap when the last Asset referencing this mapping is released.
+      std::shared_ptr<io::MMapFileHandle> holder(
+          new io::MMapFileHandle(handle), [](io::MMapFileHandle *p) {
+            std::string unmap_err;
+            // Ignore unmap result for now.
+            io::UnmapFile(*p, &unmap_err);
+            delete p;
+          });
+
+      if (handle.size > max_bytes) {
+        if (err) {
+          (*err) += "Asset size exceeds the limit: " + resolvedPath + "\n";
+        }
+        return false;
+      }
+
+      asset_out->set_view(holder->addr, size_t(holder->size), holder);
+
+      return true;
+    }
+
+    // Fallback to read a file(e.g. empty file cannot be mmapped)
+    DCOUT("mmap failed. Fallback to read file: " << _err);
+  }
+
   // Default: read from a file.
   std::vector<uint8_t> data;
-  size_t max_bytes = 1024 * 1024 * _max_asset_bytes_in_mb;
   if (!io::ReadWholeFile(&data, err, resolvedPath, max_bytes,
                            /* userdata */ nullptr)) {
 
@@ -199,4 +249,42 @@ bool AssetResolutionResolver::open_asset(const std::string &resolvedPath, const
   return true;
 }
 
+bool AssetResolutionResolver::get_modification_stamp(
+    const std::string &resolvedPath, AssetModificationStamp *stamp) const {
+  if (!stamp) {
+    return false;
+  }
+
+  std::string ext = io::GetFileExtension(resolvedPath);
+
+  if (_asset_resolution_handlers.count(ext)) {
+    const AssetResolutionHandler &handler = _asset_resolution_handlers.at(ext);
+    if (handler.size_fun) {
+      uint64_t sz{0};
+      std::string err;
+      if (handler.size_fun(resolvedPath.c_str(), &sz, &err, handler.userdata) !=
+          0) {
+        return false;
+      }
+
+      stamp->mtime = 0;
+      stamp->size = sz;
+      return true;
+    } else if (handler.map_fun || handler.read_fun) {
+      // Custom handler without `size_fun`.
+      return false;
+    }
+  }
+
+  uint64_t mtime{0};
+  uint64_t sz{0};
+  if (!io::GetFileModificationStamp(resolvedPath, &mtime, &sz)) {
+    return false;
+  }
+
+  stamp->mtime = mtime;
+  stamp->size = sz;
+  return true;
+}
+
 }  // namespace tinyusdz
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -21,22 +22,76 @@ namespace tinyusdz {
 /// Abstract class for asset(e.g. file, memory, uri, ...)
 /// Similar to ArAsset in pxrUSD.
 ///
+/// Asset either owns its content(`set_data`) or references external
+/// memory without a copy(`set_view`). For a view, an optional `holder` keeps
+/// the backing memory(e.g. mmapped file) alive while any copy of the Asset is
+/// alive.
+///
 class Asset {
  public:
-  size_t size() const { return buf_.size(); }
+  size_t size() const { return is_view_ ? view_size_ : buf_.size(); }
+
+  ///
+  /// Read-only access to the content. Never copies the content of a view.
+  ///
+  const uint8_t *cdata() const { return is_view_ ? view_ : buf_.data(); }
 
-  const uint8_t *data() const { return buf_.data(); }
+  const uint8_t *data() const { return cdata(); }
 
-  uint8_t *data() { return buf_.data(); }
+  ///
+  /// Writable access to the content.
+  /// NOTE: When the Asset is a view, the whole content is copied into the
+  /// Asset's own buffer first(copy-on-write). Use `cdata()` for read access.
+  ///
+  uint8_t *data() {
+    materialize();
+    return buf_.data();
+  }
 
-  void resize(size_t sz) { buf_.resize(sz); }
+  ///
+  /// NOTE: Copies the content into the Asset's own buffer when the Asset is a
+  /// view.
+  ///
+  void resize(size_t sz) {
+    materialize();
+    buf_.resize(sz);
+  }
 
   void shrink_to_fit() { buf_.shrink_to_fit(); }
 
-  void set_data(const std::vector<uint8_t> &&rhs) {
+  void set_data(std::vector<uint8_t> &&rhs) {
+    release_view();
+    buf_ = std::move(rhs);
+  }
+
+  void set_data(const std::vector<uint8_t> &rhs) {
+    release_view();
     buf_ = rhs;
   }
 
+  ///
+  /// Reference memory `[addr, addr + sz)` without a copy.
+  ///
+  /// @param[in] addr Address of the content.
+  /// @param[in] sz Size of the content in bytes.
+  /// @param[in] holder Optional. Retains the memory pointed by `addr`. When
+  /// nullptr, the app must retain the memory while the Asset is used.
+  ///
+  void set_view(const uint8_t *addr, size_t sz,
+                std::shared_ptr<const void> holder = nullptr) {
+    buf_.clear();
+    buf_.shrink_to_fit();
+    view_ = addr;
+    view_size_ = sz;
+    holder_ = std::move(holder);
+    is_view_ = true;
+  }
+
+  ///
+  /// @return true when the Asset references external memory(no copy).
+  ///
+  bool is_view() const { return is_view_; }
+
   void set_name(const std::string &name) {
     name_ = name;
   }
@@ -62,13 +117,52 @@ class Asset {
   }
 
  private:
+  // Copy the content of the view into `buf_`.
+  void materialize() {
+    if (is_view_) {
+      std::vector<uint8_t> buf(view_, view_ + view_size_);
+      release_view();
+      buf_ = std::move(buf);
+    }
+  }
+
+  void release_view() {
+    view_ = nullptr;
+    view_size_ = 0;
+    holder_.reset();
+    is_view_ = false;
+  }
+
   std::string version_; // optional. 
   std::string name_;
   std::string resolved_name_;
   std::vector<uint8_t> buf_;
+
+  // For view
+  bool is_view_{false};
+  const uint8_t *view_{nullptr};
+  size_t view_size_{0};
+  std::shared_ptr<const void> holder_;
 };
 
 
+///
+/// Modification stamp of an asset. Used to detect the change of an asset's
+/// content(e.g. `LayerCache` in composition).
+///
+struct AssetModificationStamp {
+  uint64_t mtime{0};  // Last modification time(seconds since epoch). 0 = unknown
+  uint64_t size{0};   // Asset size in bytes.
+
+  bool operator==(const AssetModificationStamp &rhs) const {
+    return (mtime == rhs.mtime) && (size == rhs.size);
+  }
+
+  bool operator!=(const AssetModificationStamp &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
 struct ResolverAssetInfo {
   std::string version;
   std::string assetName;
@@ -125,11 +219,26 @@ typedef int (*FSReadAsset)(const char *resolved_asset_name, uint64_t req_nbytes,
 typedef int (*FSWriteAsset)(const char *asset_name, const char *resolved_asset_name, const uint8_t *buffer,
                            const uint64_t nbytes, std::string *err, void *userdata);
 
+// Optional. Return the address of the asset content without a copy(e.g. an
+// asset in memory-mapped USDZ archive). The memory must be retained by the
+// handler(`userdata`) while the opened Asset is used.
+//
+// @param[in] resolved_asset_name Resolved Asset name or filepath
+// @param[out] out_addr Address of the asset content.
+// @param[out] nbytes Bytes of this asset.
+// @param[out] err Error message.
+// @param[inout] userdata Userdata.
+//
+// @return 0 upon success. negative value = error
+typedef int (*FSMapAsset)(const char *resolved_asset_name, const uint8_t **out_addr,
+                          uint64_t *nbytes, std::string *err, void *userdata);
+
 struct AssetResolutionHandler {
   FSResolveAsset resolve_fun{nullptr};
   FSSizeAsset size_fun{nullptr};
   FSReadAsset read_fun{nullptr};
   FSWriteAsset write_fun{nullptr};
+  FSMapAsset map_fun{nullptr}; // optional. Used in `open_asset` when non-null.
   void *userdata{nullptr};
 };
 
@@ -158,6 +267,7 @@ class AssetResolutionResolver {
       _asset_resolution_handlers = rhs._asset_resolution_handlers;
       _userdata = rhs._userdata;
       _search_paths = rhs._search_paths;
+      _use_mmap = rhs._use_mmap;
     }
   }
 
@@ -167,6 +277,7 @@ class AssetResolutionResolver {
       _asset_resolution_handlers = rhs._asset_resolution_handlers;
       _userdata = rhs._userdata;
       _search_paths = rhs._search_paths;
+      _use_mmap = rhs._use_mmap;
     }
     return (*this);
   }
@@ -177,6 +288,7 @@ class AssetResolutionResolver {
       _asset_resolution_handlers = rhs._asset_resolution_handlers;
       _userdata = rhs._userdata;
       _search_paths = std::move(rhs._search_paths);
+      _use_mmap = rhs._use_mmap;
     }
     return (*this);
   }
@@ -261,6 +373,10 @@ class AssetResolutionResolver {
   ///
   /// Open asset from the resolved Path.
   ///
+  /// The opened Asset is a view(no copy) when the handler provides `map_fun`,
+  /// or when the asset is read by the built-in file handler and mmap is
+  /// enabled(`set_use_mmap`). Otherwise the content is copied into the Asset.
+  ///
   /// @param[in] resolvedPath Resolved path(through `resolve()`)
   /// @param[in] assetPath Asset path(could be empty)
   /// @param[out] asset Asset.
@@ -272,6 +388,21 @@ class AssetResolutionResolver {
   bool open_asset(const std::string &resolvedPath, const std::string &assetPath,
                   Asset *asset, std::string *warn, std::string *err) const;
 
+  ///
+  /// Get the modification stamp of the resolved asset.
+  ///
+  /// The built-in file handler reports the last modification time and the
+  /// file size. A custom handler reports the size only(through `size_fun`).
+  ///
+  /// @param[in] resolvedPath Resolved path(through `resolve()`)
+  /// @param[out] stamp Modification stamp.
+  ///
+  /// @return false when the stamp is not available(e.g. asset not found, no
+  /// `size_fun` in the custom handler).
+  ///
+  bool get_modification_stamp(const std::string &resolvedPath,
+                              AssetModificationStamp *stamp) const;
+
   void set_userdata(void *userdata) { _userdata = userdata; }
   void *get_userdata() { return _userdata; }
   const void *get_userdata() const { return _userdata; }
@@ -286,12 +417,22 @@ class AssetResolutionResolver {
     return _max_asset_bytes_in_mb;
   }
 
+  ///
+  /// Use mmap to open an asset with the built-in file handler(when the system
+  /// supports mmap). Default false(read the whole file into the Asset).
+  /// The mapping is retained by the opened Asset(and its copies).
+  ///
+  void set_use_mmap(bool onoff) { _use_mmap = onoff; }
+
+  bool get_use_mmap() const { return _use_mmap; }
+
  private:
   //ResolvePathHandler _resolve_path_handler{nullptr};
   void *_userdata{nullptr};
   std::string _current_working_path{"./"};
   std::vector<std::string> _search_paths;
   mutable size_t _max_asset_bytes_in_mb{1024*1024}; // default 1 TB
+  bool _use_mmap{false};
 
   std::map<std::string, AssetResolutionHandler> _asset_resolution_handlers;
 
@@ -6,6 +6,12 @@
 #include <set>
 #include <stack>
 
+#if !defined(__wasi__)
+#include <atomic>
+#include <thread>
+#define TINYUSDZ_COMPOSITION_PARALLEL_PREFETCH
+#endif
+
 #if defined(__linux__)
 #include <unistd.h>
 #endif
@@ -76,6 +82,72 @@ RECONSTRUCT_PRIM_DECL(Shader);
 
 }  // namespace prim
 
+std::string LayerCache::resolve(const AssetResolutionResolver &resolver,
+                                const std::string &asset_path) {
+  std::string key = asset_path;
+  key += '\n';
+  key += resolver.current_working_path();
+  for (const auto &search_path : resolver.search_paths()) {
+    key += '\n';
+    key += search_path;
+  }
+
+  auto it = _resolved_paths.find(key);
+  if (it != _resolved_paths.end()) {
+    _stats.resolve_hits++;
+    return it->second;
+  }
+
+  _stats.resolve_misses++;
+
+  std::string resolved_path = resolver.resolve(asset_path);
+  if (resolved_path.size()) {
+    // Do not cache not-found result, since the asset may be added later.
+    _resolved_paths[key] = resolved_path;
+  }
+
+  return resolved_path;
+}
+
+std::shared_ptr<const Layer> LayerCache::find(
+    const std::string &key, const AssetModificationStamp &stamp) {
+  auto it = _layers.find(key);
+  if (it == _layers.end()) {
+    _stats.misses++;
+    return nullptr;
+  }
+
+  if (it->second.stamp != stamp) {
+    // Asset has been modified.
+    _layers.erase(it);
+    _stats.misses++;
+    _stats.reloads++;
+    return nullptr;
+  }
+
+  _stats.hits++;
+  return it->second.layer;
+}
+
+std::shared_ptr<const Layer> LayerCache::lookup(
+    const std::string &key, const AssetModificationStamp &stamp) const {
+  auto it = _layers.find(key);
+  if ((it == _layers.end()) || (it->second.stamp != stamp)) {
+    return nullptr;
+  }
+
+  return it->second.layer;
+}
+
+void LayerCache::insert(const std::string &key,
+                        const AssetModificationStamp &stamp,
+                        const std::shared_ptr<const Layer> &layer) {
+  Entry entry;
+  entry.stamp = stamp;
+  entry.layer = layer;
+  _layers[key] = std::move(entry);
+}
+
 namespace {
 
 bool IsVisited(const std::vector<std::set<std::string>> layer_names_stack,
@@ -156,13 +228,160 @@ bool PropagateAssetResolverState(uint32_t depth, PrimSpec &ps,
   return true;
 }
 
+// Set the asset resolution state of the PrimSpec(or Layer) which references
+// an asset to `resolver`. Empty values keep the current state.
+void SetReferencingAssetState(AssetResolutionResolver &resolver,
+                              const std::string &current_working_path,
+                              const std::vector<std::string> &search_paths) {
+  if (current_working_path.size()) {
+    resolver.set_current_working_path(current_working_path);
+  }
+
+  if (search_paths.size()) {
+    resolver.set_search_paths(search_paths);
+  }
+}
+
+// Set the asset resolution state for the resolved asset to `resolver`.
+// This state is stored to the loaded Layer for nested composition.
+void SetResolvedAssetState(AssetResolutionResolver &resolver,
+                           const std::vector<std::string> &search_paths,
+                           const std::string &resolved_path) {
+  resolver.set_search_paths(search_paths);
+
+  // Use resolved asset_path's basedir for current working path.
+  // Add resolved asset_path's basedir to search path.
+  std::string base_dir = io::GetBaseDir(resolved_path);
+  if (base_dir.size()) {
+    DCOUT(fmt::format("Add `{}' to asset search path.", base_dir));
+
+    resolver.set_current_working_path(base_dir);
+
+    resolver.add_search_path(base_dir);
+  }
+}
+
+// Key of a Layer in LayerCache.
+// The asset resolution state stored to the Layer is also a part of the key,
+// since the state depends on the search paths of the referencing PrimSpec.
+std::string MakeLayerCacheKey(const std::string &resolved_path,
+                              const AssetResolutionResolver &resolver) {
+  std::string key = resolved_path;
+  key += '\n';
+  key += resolver.current_working_path();
+  for (const auto &search_path : resolver.search_paths()) {
+    key += '\n';
+    key += search_path;
+  }
+  return key;
+}
+
+// Read an asset at `resolved_path` as Layer. The state of `resolver` is stored
+// to the Layer.
+// Thread-safe when asset resolution handlers and fileformat handlers are
+// thread-safe(`resolver` is not shared between threads).
+bool ReadLayerFromAsset(
+    AssetResolutionResolver &resolver,
+    const std::map<std::string, FileFormatHandler> &fileformats,
+    const std::string &resolved_path, const std::string &asset_path,
+    Layer *layer, std::string *warn, std::string *err,
+    const USDLoadOptions &load_options = USDLoadOptions()) {
+  std::string ext = GetExtension(asset_path);
+
+  Asset asset;
+  if (!resolver.open_asset(resolved_path, asset_path, &asset, warn, err)) {
+    PUSH_ERROR_AND_RETURN(
+        fmt::format("Failed to open asset `{}`.", resolved_path));
+  }
+
+  DCOUT("Opened resolved assst: " << resolved_path
+                                  << ", asset_path: " << asset_path);
+
+  std::string _warn;
+  std::string _err;
+
+  if (IsUSDFileFormat(asset_path)) {
+    if (!LoadLayerFromMemory(asset.cdata(), asset.size(), asset_path, layer,
+                             &_warn, &_err, load_options)) {
+      PUSH_ERROR_AND_RETURN(
+          fmt::format("Failed to open `{}` as Layer: {}", asset_path, _err));
+    }
+  } else if (IsMtlxFileFormat(asset_path)) {
+    PrimSpec ps;
+    if (!LoadMaterialXFromAsset(asset, asset_path, ps, &_warn, &_err)) {
+      PUSH_ERROR_AND_RETURN(
+          fmt::format("Failed to open mtlx asset `{}`", asset_path));
+    }
+
+    ps.name() = "MaterialX";
+    layer->primspecs()["MaterialX"] = ps;
+
+  } else {
+    if (fileformats.count(ext)) {
+      PrimSpec ps;
+      const FileFormatHandler &handler = fileformats.at(ext);
+
+      if (!handler.reader(asset, ps, &_warn, &_err, handler.userdata)) {
+        PUSH_ERROR_AND_RETURN(fmt::format(
+            "Failed to read asset `{}` error: {}", asset_path, _err));
+      }
+
+      if (ps.name().empty()) {
+        PUSH_ERROR_AND_RETURN(fmt::format(
+            "PrimSpec element_name is empty. asset `{}`", asset_path));
+      }
+
+      layer->primspecs()[ps.name()] = ps;
+      DCOUT("Read asset from custom fileformat handler: " << ext);
+    } else {
+      PUSH_ERROR_AND_RETURN(fmt::format(
+          "FileFormat handler not found for asset `{}`", asset_path));
+    }
+  }
+
+  DCOUT("layer = " << print_layer(*layer, 0));
+
+  // TODO: Recursively resolve `references`
+
+  if (_warn.size()) {
+    if (warn) {
+      (*warn) += _warn;
+    }
+  }
+
+  // Store assetresolution state to each PrimSpec for nested composition.
+  for (auto &item : layer->primspecs()) {
+    if (!PropagateAssetResolverState(0, item.second,
+                                     resolver.current_working_path(),
+                                     resolver.search_paths())) {
+      PUSH_ERROR_AND_RETURN(
+          "Store AssetResolver state to each PrimSpec failed.\n");
+    }
+  }
+
+  // FIXME: This may be redundant, since assetresulution state is stored in
+  // each PrimSpec.
+  // TODO: Remove layer-level assetresulution state store?
+  //
+  // save assetresolution state for nested composition.
+  layer->set_asset_resolution_state(resolver.current_working_path(),
+                                    resolver.search_paths(),
+                                    resolver.get_userdata());
+
+  return true;
+}
+
 // TODO: support loading non-USD asset
-bool LoadAsset(AssetResolutionResolver &resolver,
+//
+// Loaded Layer is shared through `layer_cache` when non-null. The Layer
+// returned to `dst_layer` must not be modified.
+bool LoadAsset(AssetResolutionResolver &resolver, LayerCache *layer_cache,
                const std::string &current_working_path,
                const std::vector<std::string> &search_paths,
                const std::map<std::string, FileFormatHandler> &fileformats,
                const value::AssetPath &assetPath, const Path &primPath,
-               Layer *dst_layer, const PrimSpec **dst_primspec_root,
+               std::shared_ptr<const Layer> *dst_layer,
+               const PrimSpec **dst_primspec_root,
                const bool error_when_no_prims_found,
                const bool error_when_asset_not_found,
                const bool error_when_unsupported_fileformat, std::string *warn,
@@ -181,17 +400,13 @@ bool LoadAsset(AssetResolutionResolver &resolver,
   }
 
   // TODO: Use std::stack to manage AssetResolutionResolver state?
-  if (current_working_path.size()) {
-    resolver.set_current_working_path(current_working_path);
-  }
-
-  if (search_paths.size()) {
-    resolver.set_search_paths(search_paths);
-  }
+  SetReferencingAssetState(resolver, current_working_path, search_paths);
 
   // resolve path
   // TODO: Store resolved path to Reference?
-  std::string resolved_path = resolver.resolve(asset_path);
+  std::string resolved_path = layer_cache
+                                  ? layer_cache->resolve(resolver, asset_path)
+                                  : resolver.resolve(asset_path);
 
   DCOUT("Loading references: " << resolved_path
                                << ", asset_path: " << asset_path);
@@ -228,27 +443,7 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
   }
 
-  resolver.set_search_paths(search_paths);
-
-  // Use resolved asset_path's basedir for current working path.
-  // Add resolved asset_path's basedir to search path.
-  std::string base_dir = io::GetBaseDir(resolved_path);
-  if (base_dir.size()) {
-    DCOUT(fmt::format("Add `{}' to asset search path.", base_dir));
-
-    resolver.set_current_working_path(base_dir);
-
-    resolver.add_search_path(base_dir);
-  }
-
-  Asset asset;
-  if (!resolver.open_asset(resolved_path, asset_path, &asset, warn, err)) {
-    PUSH_ERROR_AND_RETURN(
-        fmt::format("Failed to open asset `{}`.", resolved_path));
-  }
-
-  DCOUT("Opened resolved assst: " << resolved_path
-                                  << ", asset_path: " << asset_path);
+  SetResolvedAssetState(resolver, search_paths, resolved_path);
 
   if (IsBuiltinFileFormat(asset_path)) {
     if (IsUSDFileFormat(asset_path) || IsMtlxFileFormat(asset_path)) {
@@ -282,65 +477,44 @@ bool LoadAsset(AssetResolutionResolver &resolver,
     }
   }
 
-  Layer layer;
-  std::string _warn;
-  std::string _err;
-
-  if (IsUSDFileFormat(asset_path)) {
-    if (!LoadLayerFromMemory(asset.data(), asset.size(), asset_path, &layer,
-                             &_warn, &_err)) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("Failed to open `{}` as Layer: {}", asset_path, _err));
-    }
-  } else if (IsMtlxFileFormat(asset_path)) {
+  if (IsMtlxFileFormat(asset_path)) {
     // primPath must be '</MaterialX>'
     if (primPath.prim_part() != "/MaterialX") {
       PUSH_ERROR_AND_RETURN("Prim path must be </MaterialX>, but got: " +
                             primPath.prim_part());
     }
+  }
 
-    PrimSpec ps;
-    if (!LoadMaterialXFromAsset(asset, asset_path, ps, &_warn, &_err)) {
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("Failed to open mtlx asset `{}`", asset_path));
-    }
-
-    ps.name() = "MaterialX";
-    layer.primspecs()["MaterialX"] = ps;
-
-  } else {
-    if (fileformats.count(ext)) {
-      PrimSpec ps;
-      const FileFormatHandler &handler = fileformats.at(ext);
-
-      if (!handler.reader(asset, ps, &_warn, &_err, handler.userdata)) {
-        PUSH_ERROR_AND_RETURN(fmt::format("Failed to read asset `{}` error: {}",
-                                          asset_path, _err));
-      }
+  std::shared_ptr<const Layer> shared_layer;
+  std::string cache_key;
+  AssetModificationStamp stamp;
 
-      if (ps.name().empty()) {
-        PUSH_ERROR_AND_RETURN(fmt::format(
-            "PrimSpec element_name is empty. asset `{}`", asset_path));
-      }
+  if (layer_cache) {
+    // Stamp is zero when it is not available. In this case the cached Layer is
+    // always reused.
+    resolver.get_modification_stamp(resolved_path, &stamp);
 
-      layer.primspecs()[ps.name()] = ps;
-      DCOUT("Read asset from custom fileformat handler: " << ext);
-    } else {
-      PUSH_ERROR_AND_RETURN(fmt::format(
-          "FileFormat handler not found for asset `{}`", asset_path));
-    }
+    cache_key = MakeLayerCacheKey(resolved_path, resolver);
+    shared_layer = layer_cache->find(cache_key, stamp);
   }
 
-  DCOUT("layer = " << print_layer(layer, 0));
+  if (!shared_layer) {
+    std::shared_ptr<Layer> layer = std::make_shared<Layer>();
+    if (!ReadLayerFromAsset(resolver, fileformats, resolved_path, asset_path,
+                            layer.get(), warn, err)) {
+      return false;
+    }
 
-  // TODO: Recursively resolve `references`
+    // The Layer is not modified after this, so it can be shared.
+    shared_layer = layer;
 
-  if (_warn.size()) {
-    if (warn) {
-      (*warn) += _warn;
+    if (layer_cache) {
+      layer_cache->insert(cache_key, stamp, shared_layer);
     }
   }
 
+  const Layer &layer = *shared_layer;
+
   if (layer.primspecs().empty()) {
     if (error_when_no_prims_found) {
       PUSH_ERROR_AND_RETURN(fmt::format("No prims in layer `{}`", asset_path));
@@ -350,7 +524,7 @@ bool LoadAsset(AssetResolutionResolver &resolver,
       (*dst_primspec_root) = nullptr;
     }
 
-    (*dst_layer) = std::move(layer);
+    (*dst_layer) = shared_layer;
 
     return true;
   }
@@ -384,26 +558,10 @@ bool LoadAsset(AssetResolutionResolver &resolver,
       PUSH_ERROR_AND_RETURN("Internal error: PrimSpec pointer is nullptr.");
     }
 
-    if (!PropagateAssetResolverState(0, *const_cast<PrimSpec *>(src_ps),
-                                     resolver.current_working_path(),
-                                     resolver.search_paths())) {
-      PUSH_ERROR_AND_RETURN(
-          "Store AssetResolver state to each PrimSpec failed.\n");
-    }
-
     (*dst_primspec_root) = src_ps;
   }
 
-  // FIXME: This may be redundant, since assetresulution state is stored in
-  // each PrimSpec.
-  // TODO: Remove layer-level assetresulution state store?
-  //
-  // save assetresolution state for nested composition.
-  layer.set_asset_resolution_state(resolver.current_working_path(),
-                                   resolver.search_paths(),
-                                   resolver.get_userdata());
-
-  (*dst_layer) = std::move(layer);
+  (*dst_layer) = shared_layer;
 
   return true;
 }
@@ -488,15 +646,19 @@ bool CompositeSublayersRec(AssetResolutionResolver &resolver,
                       sublayer_asset_path, in_layer.name()));
     }
 
-    std::string layer_filepath = resolver.resolve(sublayer_asset_path);
+    std::string layer_filepath =
+        options.layer_cache
+            ? options.layer_cache->resolve(resolver, sublayer_asset_path)
+            : resolver.resolve(sublayer_asset_path);
     if (layer_filepath.empty()) {
       PUSH_ERROR_AND_RETURN(fmt::format("{} not found in path: {}",
                                         sublayer_asset_path,
                                         resolver.search_paths_str()));
     }
 
-    tinyusdz::Layer sublayer;
-    if (!LoadAsset(resolver, in_layer.get_current_working_path(),
+    std::shared_ptr<const Layer> sublayer;
+    if (!LoadAsset(resolver, options.layer_cache,
+                   in_layer.get_current_working_path(),
                    in_layer.get_asset_search_paths(), options.fileformats,
                    layer.assetPath, /* not_used */ Path::make_root_path(),
                    &sublayer, /* primspec_root */ nullptr,
@@ -510,7 +672,9 @@ bool CompositeSublayersRec(AssetResolutionResolver &resolver,
     curr_layer_names.insert(sublayer_asset_path);
 
     // Recursively load subLayer
-    if (!CompositeSublayersRec(resolver, sublayer, layer_names_stack,
+    // sublayer is nullptr when the asset is skipped(e.g. unsupported fileformat)
+    if (sublayer &&
+        !CompositeSublayersRec(resolver, *sublayer, layer_names_stack,
                                composited_layer, warn, err, options)) {
       return false;
     }
@@ -527,10 +691,18 @@ bool CompositeSublayers(AssetResolutionResolver &resolver,
                         const Layer &in_layer, Layer *composited_layer,
                         std::string *warn, std::string *err,
                         SublayersCompositionOptions options) {
+  performance::ScopedPhase phase(options.stats, "composition:sublayers");
+
   if (!composited_layer) {
     return false;
   }
 
+  // Share loaded Layers in this composition pass.
+  LayerCache local_layer_cache;
+  if (!options.layer_cache) {
+    options.layer_cache = &local_layer_cache;
+  }
+
   std::vector<std::set<std::string>> layer_names_stack;
 
   // keep metas from the root layer
@@ -645,7 +817,7 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
     if ((qual == ListEditQual::ResetToExplicit) ||
         (qual == ListEditQual::Prepend)) {
       for (const auto &reference : refecences) {
-        Layer layer;
+        std::shared_ptr<const Layer> layer;
         const PrimSpec *src_ps{nullptr};
 
         if (reference.asset_path.GetAssetPath().empty()) {
@@ -667,7 +839,8 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
           DCOUT("reference.prim_path = " << reference.prim_path);
           DCOUT("primspec.cwp = " << cwp);
           DCOUT("primspec.search_paths = " << search_paths);
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
+          if (!LoadAsset(resolver, options.layer_cache, cwp, search_paths,
+                         options.fileformats,
                          reference.asset_path, reference.prim_path, &layer,
                          &src_ps, /* error_when_no_prims_found */ true,
                          options.error_when_asset_not_found,
@@ -711,7 +884,7 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
       PUSH_ERROR_AND_RETURN("Invalid listedit qualifier to for `references`.");
     } else if (qual == ListEditQual::Append) {
       for (const auto &reference : refecences) {
-        Layer layer;
+        std::shared_ptr<const Layer> layer;
         const PrimSpec *src_ps{nullptr};
 
         if (reference.asset_path.GetAssetPath().empty()) {
@@ -729,7 +902,8 @@ bool CompositeReferencesRec(uint32_t depth, AssetResolutionResolver &resolver,
                             reference.prim_path.full_path_name()));
           }
         } else {
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
+          if (!LoadAsset(resolver, options.layer_cache, cwp, search_paths,
+                         options.fileformats,
                          reference.asset_path, reference.prim_path, &layer,
                          &src_ps, /* error_when_no_prims */ true,
                          options.error_when_asset_not_found,
@@ -802,7 +976,7 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
         std::string asset_path = pl.asset_path.GetAssetPath();
         DCOUT("asset_path = " << asset_path);
 
-        Layer layer;
+        std::shared_ptr<const Layer> layer;
         const PrimSpec *src_ps{nullptr};
 
         if (pl.asset_path.GetAssetPath().empty()) {
@@ -820,7 +994,8 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
           }
         } else {
 
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
+          if (!LoadAsset(resolver, options.layer_cache, cwp, search_paths,
+                         options.fileformats,
                          pl.asset_path, pl.prim_path, &layer, &src_ps,
                          /* error_when_no_prims_found */ true,
                          options.error_when_asset_not_found,
@@ -865,7 +1040,7 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
       for (const auto &pl : payloads) {
         std::string asset_path = pl.asset_path.GetAssetPath();
 
-        Layer layer;
+        std::shared_ptr<const Layer> layer;
         const PrimSpec *src_ps{nullptr};
 
         if (pl.asset_path.GetAssetPath().empty()) {
@@ -883,7 +1058,8 @@ bool CompositePayloadRec(uint32_t depth, AssetResolutionResolver &resolver,
           }
         } else {
 
-          if (!LoadAsset(resolver, cwp, search_paths, options.fileformats,
+          if (!LoadAsset(resolver, options.layer_cache, cwp, search_paths,
+                         options.fileformats,
                          pl.asset_path, pl.prim_path, &layer, &src_ps,
                          /* error_when_no_prims_found */ true,
                          options.error_when_asset_not_found,
@@ -1024,10 +1200,18 @@ bool CompositeReferences(AssetResolutionResolver &resolver,
                          const Layer &in_layer, Layer *composited_layer,
                          std::string *warn, std::string *err,
                          ReferencesCompositionOptions options) {
+  performance::ScopedPhase phase(options.stats, "composition:references");
+
   if (!composited_layer) {
     return false;
   }
 
+  // Share loaded Layers in this composition pass.
+  LayerCache local_layer_cache;
+  if (!options.layer_cache) {
+    options.layer_cache = &local_layer_cache;
+  }
+
   std::vector<std::string> search_paths = in_layer.get_asset_search_paths();
 
   Layer dst = in_layer;  // deep copy
@@ -1048,10 +1232,18 @@ bool CompositeReferences(AssetResolutionResolver &resolver,
 bool CompositePayload(AssetResolutionResolver &resolver, const Layer &in_layer,
                       Layer *composited_layer, std::string *warn,
                       std::string *err, PayloadCompositionOptions options) {
+  performance::ScopedPhase phase(options.stats, "composition:payload");
+
   if (!composited_layer) {
     return false;
   }
 
+  // Share loaded Layers in this composition pass.
+  LayerCache local_layer_cache;
+  if (!options.layer_cache) {
+    options.layer_cache = &local_layer_cache;
+  }
+
   Layer dst = in_layer;  // deep copy
 
   for (auto &item : dst.primspecs()) {
@@ -1068,6 +1260,250 @@ bool CompositePayload(AssetResolutionResolver &resolver, const Layer &in_layer,
   return true;
 }
 
+namespace {
+
+//
+// Resolve `LayerPrefetchOptions::num_threads`.
+//
+size_t GetNumPrefetchThreads(const int num_threads) {
+  size_t n = 1;
+#if defined(TINYUSDZ_COMPOSITION_PARALLEL_PREFETCH)
+  if (num_threads == -1) {
+    n = size_t((std::max)(1, int(std::thread::hardware_concurrency())));
+  } else if (num_threads > 1) {
+    n = size_t(num_threads);
+  }
+  // Limit to 1024 threads.
+  n = (std::min)(size_t(1024), n);
+#else
+  (void)num_threads;
+#endif
+  return n;
+}
+
+//
+// Run `fn(i)` for each i in [0, n) with a pool of `num_threads` threads.
+//
+template <typename F>
+void ParallelFor(const size_t n, size_t num_threads, const F &fn) {
+#if defined(TINYUSDZ_COMPOSITION_PARALLEL_PREFETCH)
+  num_threads = (std::min)(num_threads, n);
+  if (num_threads > 1) {
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next{0};
+
+    for (size_t t = 0; t < num_threads; t++) {
+      workers.emplace_back([&]() {
+        while (true) {
+          size_t i = next++;
+          if (i >= n) {
+            break;
+          }
+          fn(i);
+        }
+      });
+    }
+
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    return;
+  }
+#else
+  (void)num_threads;
+#endif
+
+  for (size_t i = 0; i < n; i++) {
+    fn(i);
+  }
+}
+
+struct PrefetchRequest {
+  AssetResolutionResolver resolver;  // State for loading the asset.
+  std::string asset_path;
+  std::string resolved_path;
+  std::string cache_key;
+  AssetModificationStamp stamp;
+
+  // Result
+  std::shared_ptr<Layer> layer;
+  std::string warn;
+  std::string err;
+  bool ok{false};
+};
+
+class PrefetchCollector {
+ public:
+  PrefetchCollector(const AssetResolutionResolver &resolver,
+                    LayerCache *layer_cache,
+                    const LayerPrefetchOptions &options)
+      : _resolver(resolver), _layer_cache(layer_cache), _options(options) {
+    // Copy constructor does not copy the current working path.
+    _resolver.set_current_working_path(resolver.current_working_path());
+  }
+
+  ///
+  /// Collect assets referenced from `layer`.
+  /// Assets which are already in the cache are added to `cached_layers`.
+  ///
+  void Collect(const Layer &layer, std::vector<PrefetchRequest> *requests,
+               std::vector<std::shared_ptr<const Layer>> *cached_layers) {
+    if (_options.sublayers) {
+      for (const auto &sublayer : layer.metas().subLayers) {
+        Add(layer.get_current_working_path(), layer.get_asset_search_paths(),
+            sublayer.assetPath, requests, cached_layers);
+      }
+    }
+
+    for (const auto &item : layer.primspecs()) {
+      CollectRec(0, item.second, requests, cached_layers);
+    }
+  }
+
+ private:
+  void CollectRec(uint32_t depth, const PrimSpec &ps,
+                  std::vector<PrefetchRequest> *requests,
+                  std::vector<std::shared_ptr<const Layer>> *cached_layers) {
+    if (depth > (1024 * 1024 * 128)) {
+      return;
+    }
+
+    if (_options.references && ps.metas().references) {
+      for (const auto &reference : ps.metas().references.value().second) {
+        Add(ps.get_current_working_path(), ps.get_asset_search_paths(),
+            reference.asset_path, requests, cached_layers);
+      }
+    }
+
+    if (_options.payload && ps.metas().payload) {
+      for (const auto &pl : ps.metas().payload.value().second) {
+        Add(ps.get_current_working_path(), ps.get_asset_search_paths(),
+            pl.asset_path, requests, cached_layers);
+      }
+    }
+
+    for (const auto &child : ps.children()) {
+      CollectRec(depth + 1, child, requests, cached_layers);
+    }
+  }
+
+  // Resolve the asset in the same way as `LoadAsset`, so that the cache key
+  // matches.
+  void Add(const std::string &current_working_path,
+           const std::vector<std::string> &search_paths,
+           const value::AssetPath &assetPath,
+           std::vector<PrefetchRequest> *requests,
+           std::vector<std::shared_ptr<const Layer>> *cached_layers) {
+    const std::string &asset_path = assetPath.GetAssetPath();
+    if (asset_path.empty() || !IsUSDFileFormat(asset_path)) {
+      return;
+    }
+
+    PrefetchRequest req;
+    req.resolver = _resolver;
+    req.resolver.set_current_working_path(_resolver.current_working_path());
+    SetReferencingAssetState(req.resolver, current_working_path, search_paths);
+
+    req.resolved_path = _layer_cache->resolve(req.resolver, asset_path);
+    if (req.resolved_path.empty()) {
+      // Reported in composition.
+      return;
+    }
+
+    SetResolvedAssetState(req.resolver, search_paths, req.resolved_path);
+    req.resolver.get_modification_stamp(req.resolved_path, &req.stamp);
+    req.cache_key = MakeLayerCacheKey(req.resolved_path, req.resolver);
+
+    if (_visited.count(req.cache_key)) {
+      return;
+    }
+    _visited.insert(req.cache_key);
+
+    if (auto layer = _layer_cache->lookup(req.cache_key, req.stamp)) {
+      cached_layers->push_back(layer);
+      return;
+    }
+
+    req.asset_path = asset_path;
+    requests->emplace_back(std::move(req));
+  }
+
+  AssetResolutionResolver _resolver;
+  LayerCache *_layer_cache{nullptr};
+  const LayerPrefetchOptions &_options;
+  std::set<std::string> _visited;  // cache keys
+};
+
+}  // namespace
+
+bool PrefetchLayers(const AssetResolutionResolver &resolver, const Layer &layer,
+                    LayerCache *layer_cache, std::string *warn,
+                    std::string *err, const LayerPrefetchOptions &options) {
+  performance::ScopedPhase phase(options.stats, "composition:prefetch");
+
+  if (!layer_cache) {
+    PUSH_ERROR_AND_RETURN("`layer_cache` is nullptr.");
+  }
+
+  const size_t num_threads = GetNumPrefetchThreads(options.num_threads);
+
+  // Parallelize over assets, not inside an asset.
+  USDLoadOptions load_options;
+  if (num_threads > 1) {
+    load_options.num_threads = 1;
+  }
+
+  PrefetchCollector collector(resolver, layer_cache, options);
+
+  std::vector<PrefetchRequest> requests;
+  std::vector<std::shared_ptr<const Layer>> layers;  // Layers to traverse.
+  collector.Collect(layer, &requests, &layers);
+
+  for (uint32_t depth = 0; depth < options.max_depth; depth++) {
+    if (requests.empty() && layers.empty()) {
+      break;
+    }
+
+    ParallelFor(requests.size(), num_threads, [&](size_t i) {
+      PrefetchRequest &req = requests[i];
+      req.layer = std::make_shared<Layer>();
+      req.ok = ReadLayerFromAsset(req.resolver, /* fileformats */ {},
+                                  req.resolved_path, req.asset_path,
+                                  req.layer.get(), &req.warn, &req.err,
+                                  load_options);
+    });
+
+    // Register Layers in the order of collection.
+    for (const auto &req : requests) {
+      if (!req.ok) {
+        // Loaded again(and reported) in composition.
+        DCOUT("Prefetch failed: " << req.resolved_path << ": " << req.err);
+        continue;
+      }
+
+      if (req.warn.size()) {
+        PUSH_WARN(req.warn);
+      }
+
+      layer_cache->insert(req.cache_key, req.stamp, req.layer);
+      layer_cache->add_prefetched_count(1);
+      layers.push_back(req.layer);
+    }
+
+    // Collect assets of the next level.
+    std::vector<PrefetchRequest> next_requests;
+    std::vector<std::shared_ptr<const Layer>> next_layers;
+    for (const auto &l : layers) {
+      collector.Collect(*l, &next_requests, &next_layers);
+    }
+
+    requests = std::move(next_requests);
+    layers = std::move(next_layers);
+  }
+
+  return true;
+}
+
 bool CompositeVariant(const Layer &in_layer, Layer *composited_layer,
                       std::string *warn, std::string *err) {
   if (!composited_layer) {
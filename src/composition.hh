@@ -5,7 +5,13 @@
 //
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "asset-resolution.hh"
+#include "performance.hh"
 #include "prim-types.hh"
 
 // TODO
@@ -30,6 +36,93 @@ enum class LoadState : uint32_t {
   Payload = 1 << 3     // load USD from Prim meta payload
 };
 
+///
+/// Registry of Layers loaded in `subLayers`, `references` and `payload`
+/// composition.
+///
+/// Layers are keyed by the resolved asset path(and the asset search paths
+/// stored to the Layer) and validated with the modification stamp of the
+/// asset, so an asset referenced many times is read and parsed only once.
+/// Cached Layers are immutable and shared with `std::shared_ptr`.
+/// Asset path resolution results are also cached.
+///
+/// When `layer_cache` in the composition options is nullptr, a temporary
+/// LayerCache is used for each composition pass. Set the same LayerCache to
+/// options to share it across composition passes or Stages.
+///
+/// NOTE: Resolution results are not validated. Call `clear()` when the
+/// AssetResolutionResolver setting(e.g. asset resolution handlers) changes or
+/// assets are added/removed.
+/// Not thread-safe.
+///
+class LayerCache {
+ public:
+  struct Stats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t reloads{0};  // The number of cached Layers reloaded since its
+                          // modification stamp changed. Included in `misses`
+    uint64_t resolve_hits{0};
+    uint64_t resolve_misses{0};
+    uint64_t prefetched{0};  // The number of Layers loaded by `PrefetchLayers`
+  };
+
+  ///
+  /// Resolve asset path with the current state(current working path and
+  /// search paths) of `resolver`. Returns empty string when the asset is not
+  /// found(not cached).
+  ///
+  std::string resolve(const AssetResolutionResolver &resolver,
+                      const std::string &asset_path);
+
+  ///
+  /// Find a cached Layer.
+  ///
+  /// @param[in] key Key(See `LoadAsset` in composition.cc)
+  /// @param[in] stamp Current modification stamp of the asset. The cached
+  /// Layer is discarded when the stamp differs.
+  ///
+  /// @return nullptr when not found.
+  ///
+  std::shared_ptr<const Layer> find(const std::string &key,
+                                    const AssetModificationStamp &stamp);
+
+  ///
+  /// Same as `find`, but does not update statistics nor discard the Layer.
+  ///
+  std::shared_ptr<const Layer> lookup(const std::string &key,
+                                      const AssetModificationStamp &stamp) const;
+
+  void insert(const std::string &key, const AssetModificationStamp &stamp,
+              const std::shared_ptr<const Layer> &layer);
+
+  // Used by `PrefetchLayers`.
+  void add_prefetched_count(uint64_t n) { _stats.prefetched += n; }
+
+  // The number of cached Layers.
+  size_t size() const { return _layers.size(); }
+
+  const Stats &stats() const { return _stats; }
+
+  void reset_stats() { _stats = Stats(); }
+
+  // Clear cached Layers and resolution results. Stats are not cleared.
+  void clear() {
+    _layers.clear();
+    _resolved_paths.clear();
+  }
+
+ private:
+  struct Entry {
+    AssetModificationStamp stamp;
+    std::shared_ptr<const Layer> layer;
+  };
+
+  std::map<std::string, Entry> _layers;
+  std::map<std::string, std::string> _resolved_paths;
+  Stats _stats;
+};
+
 struct SublayersCompositionOptions {
   // The maximum depth for nested `subLayers`
   uint32_t max_depth = 1024u;
@@ -45,6 +138,12 @@ struct SublayersCompositionOptions {
 
   // File formats
   std::map<std::string, FileFormatHandler> fileformats;
+
+  // Record the wall time of composition when non-null.
+  performance::LoadStats *stats{nullptr};
+
+  // Layer registry shared across composition passes when non-null.
+  LayerCache *layer_cache{nullptr};
 };
 
 struct ReferencesCompositionOptions {
@@ -59,6 +158,12 @@ struct ReferencesCompositionOptions {
 
   // File formats
   std::map<std::string, FileFormatHandler> fileformats;
+
+  // Record the wall time of composition when non-null.
+  performance::LoadStats *stats{nullptr};
+
+  // Layer registry shared across composition passes when non-null.
+  LayerCache *layer_cache{nullptr};
 };
 
 struct PayloadCompositionOptions {
@@ -73,6 +178,33 @@ struct PayloadCompositionOptions {
 
   // File formats
   std::map<std::string, FileFormatHandler> fileformats;
+
+  // Record the wall time of composition when non-null.
+  performance::LoadStats *stats{nullptr};
+
+  // Layer registry shared across composition passes when non-null.
+  LayerCache *layer_cache{nullptr};
+};
+
+struct LayerPrefetchOptions {
+  // # of threads to read and parse Layers.
+  // 1: Load serially. -1: Use all available hardware threads.
+  // Threading is disabled on WASI.
+  // NOTE: Asset resolution handlers registered to AssetResolutionResolver
+  // must be thread-safe when using 2 or more threads.
+  int num_threads{-1};
+
+  // The maximum depth of nested `subLayers`, `references` and `payload` to
+  // follow.
+  uint32_t max_depth = 1024u;
+
+  // Arcs to follow.
+  bool sublayers{true};
+  bool references{true};
+  bool payload{true};
+
+  // Record the wall time of prefetch when non-null.
+  performance::LoadStats *stats{nullptr};
 };
 
 ///
@@ -156,6 +288,33 @@ bool CompositePayload(
     Layer *composited_layer, std::string *warn, std::string *err,
     const PayloadCompositionOptions options = PayloadCompositionOptions());
 
+///
+/// Load USD assets reachable through `subLayers`, `references` and `payload`
+/// from `layer` into `layer_cache` concurrently.
+///
+/// Assets are collected level by level(assets referenced from `layer`, then
+/// assets referenced from them, ...), and each level is read and parsed on a
+/// worker pool. PrimSpecs are not merged here. Pass the same `layer_cache` to
+/// `CompositeSublayers`, `CompositeReferences` and `CompositePayload`, which
+/// then merge the prefetched Layers in the same(deterministic) order as
+/// without prefetch.
+///
+/// Only USD assets(usd, usda, usdc) are prefetched. Assets referenced in
+/// variants and assets failed to load are not prefetched. They are loaded(and
+/// errors are reported) in the composition functions.
+///
+/// @param[in] resolver AssetResolutionResolver. The state of `resolver` is not
+/// modified.
+/// @param[in] layer Layer to start traversal.
+/// @param[inout] layer_cache LayerCache to store loaded Layers.
+///
+/// @return false when `layer_cache` is nullptr.
+///
+bool PrefetchLayers(
+    const AssetResolutionResolver &resolver, const Layer &layer,
+    LayerCache *layer_cache, std::string *warn, std::string *err,
+    const LayerPrefetchOptions &options = LayerPrefetchOptions());
+
 ///
 /// Resolve `variantSet` for each PrimSpec, and return composited(flattened) Layer
 /// to `composited_layer` in `layer`.
@@ -316,9 +316,7 @@ inline void hash_combine(std::size_t &seed, const T &v) {
 
 struct PathHasher {
   size_t operator()(const Path &path) const {
-    size_t seed = std::hash<std::string>()(path.prim_part());
-    hash_combine(seed, std::hash<std::string>()(path.prop_part()));
-    //hash_combine(seed, std::hash<std::string>()(path.GetLocalPart()));
+    size_t seed = size_t(path.hash());
     hash_combine(seed, std::hash<bool>()(path.is_valid()));
 
     return seed;
@@ -327,12 +325,8 @@ struct PathHasher {
 
 struct PathKeyEqual {
   bool operator()(const Path &lhs, const Path &rhs) const {
-    bool ret = lhs.prim_part() == rhs.prim_part();
-    ret &= lhs.prop_part() == rhs.prop_part();
-    //ret &= lhs.GetLocalPart() == rhs.GetLocalPart();
-    ret &= lhs.is_valid() == rhs.is_valid();
-
-    return ret;
+    // Paths with the same string share the same node.
+    return (lhs.node() == rhs.node()) && (lhs.is_valid() == rhs.is_valid());
   }
 };
 
@@ -495,6 +489,10 @@ class CrateValue {
     return value_;
   }
 
+  value::Value &get_raw() {
+    return value_;
+  }
+
  private:
   value::Value value_;
 };
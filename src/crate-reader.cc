@@ -21,6 +21,11 @@
 #include <thread>
 #endif
 
+#if !defined(__wasi__)
+#include <atomic>
+#define TINYUSDZ_CRATE_PARALLEL_UNPACK
+#endif
+
 #include <unordered_set>
 #include <stack>
 
@@ -107,6 +112,20 @@ CrateReader::CrateReader(StreamReader *sr, const CrateReaderConfig &config) : _s
 
 }
 
+CrateReader::CrateReader(const CrateReader *parent, StreamReader *sr)
+    : _sr(sr), _parent(parent), _impl(nullptr) {
+  _config = parent->_config;
+  _config.numThreads = 1;
+
+  _version[0] = parent->_version[0];
+  _version[1] = parent->_version[1];
+  _version[2] = parent->_version[2];
+
+  // Start from the parent's usage so that `maxMemoryBudget` check is still
+  // effective(approximately) in each worker.
+  _memoryUsage = parent->_memoryUsage;
+}
+
 CrateReader::~CrateReader() {
   //delete _impl;
   //_impl = nullptr;
@@ -129,9 +148,10 @@ bool CrateReader::HasField(const std::string &key) const {
 }
 
 nonstd::optional<crate::Field> CrateReader::GetField(crate::Index index) const {
+  const std::vector<crate::Field> &fields = TableOwner()._fields;
 
-  if (index.value < _fields.size()) {
-    return _fields[index.value];
+  if (index.value < fields.size()) {
+    return fields[index.value];
   } else {
     return nonstd::nullopt;
   }
@@ -139,8 +159,9 @@ nonstd::optional<crate::Field> CrateReader::GetField(crate::Index index) const {
 
 const nonstd::optional<value::token> CrateReader::GetToken(
     crate::Index token_index) const {
-  if (token_index.value < _tokens.size()) {
-    return _tokens[token_index.value];
+  const std::vector<value::token> &tokens = TableOwner()._tokens;
+  if (token_index.value < tokens.size()) {
+    return tokens[token_index.value];
   } else {
     return nonstd::nullopt;
   }
@@ -149,9 +170,11 @@ const nonstd::optional<value::token> CrateReader::GetToken(
 // Get string token from string index.
 const nonstd::optional<value::token> CrateReader::GetStringToken(
     crate::Index string_index) const {
+  const std::vector<crate::Index> &string_indices =
+      TableOwner()._string_indices;
 
-  if (string_index.value < _string_indices.size()) {
-    crate::Index s_idx = _string_indices[string_index.value];
+  if (string_index.value < string_indices.size()) {
+    crate::Index s_idx = string_indices[string_index.value];
     return GetToken(s_idx);
   } else {
     PUSH_ERROR("String index out of range: " +
@@ -161,35 +184,40 @@ const nonstd::optional<value::token> CrateReader::GetStringToken(
 }
 
 nonstd::optional<Path> CrateReader::GetPath(crate::Index index) const {
+  const std::vector<Path> &paths = TableOwner()._paths;
 
-  if (index.value < _paths.size()) {
+  if (index.value < paths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  return _paths[index.value];
+  return paths[index.value];
 }
 
 nonstd::optional<Path> CrateReader::GetElementPath(crate::Index index) const {
-  if (index.value < _elemPaths.size()) {
+  const std::vector<Path> &elemPaths = TableOwner()._elemPaths;
+
+  if (index.value < elemPaths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  return _elemPaths[index.value];
+  return elemPaths[index.value];
 }
 
 nonstd::optional<std::string> CrateReader::GetPathString(
     crate::Index index) const {
-  if (index.value < _paths.size()) {
+  const std::vector<Path> &paths = TableOwner()._paths;
+
+  if (index.value < paths.size()) {
     // ok
   } else {
     return nonstd::nullopt;
   }
 
-  const Path &p = _paths[index.value];
+  const Path &p = paths[index.value];
 
   return p.full_path_name();
 }
@@ -344,6 +372,10 @@ bool CrateReader::ReadCompressedInts(Int *out,
 
   REDUCE_MEMORY_USAGE(compBufferSize);
 
+  if (ret) {
+    _decompressedBytes += sizeof(Int) * num_ints;
+  }
+
   return ret;
 }
 
@@ -902,6 +934,9 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "# of `times` elements and # of values in Crate differs.");
   }
 
+  std::vector<value::Value> values;
+  values.reserve(size_t(num_values));
+
   for (size_t i = 0; i < num_values; i++) {
 
     crate::ValueRep rep;
@@ -919,7 +954,7 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
       PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to unpack value of TimeSample's value element.");
     }
 
-    d->add_sample(times[i], value.get_raw());
+    values.emplace_back(std::move(value.get_raw()));
 
     // UnpackValueRep() will change StreamReader's read position.
     // Revert to next ValueRep location here.
@@ -933,6 +968,14 @@ bool CrateReader::ReadTimeSamples(value::TimeSamples *d) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to seek over TimeSamples's values.");
   }
 
+  // Sorted at once when `times` is not in ascending order.
+  if (!d->set_samples(std::move(times), std::move(values))) {
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to set TimeSamples values.");
+  }
+
+  // Loaded TimeSamples are read-only, so they can be evaluated from multiple
+  // threads.
+  d->freeze();
 
   return true;
 }
@@ -5317,6 +5360,9 @@ bool CrateReader::ReadCompressedPaths(const uint64_t maxNumPaths) {
     }
   }
 
+  // pathIndexes, elementTokenIndexes and jumps
+  _decompressedBytes += 3 * sizeof(int32_t) * size_t(numEncodedPaths);
+
 #ifdef TINYUSDZ_LOCAL_DEBUG_PRINT
   for (size_t i = 0; i < pathIndexes.size(); i++) {
     DCOUT("pathIndexes[" << i << "] = " << pathIndexes[i]);
@@ -5554,6 +5600,7 @@ bool CrateReader::ReadTokens() {
                                            size_t(uncompressedSize), &_err)) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to decompress data of Tokens.");
   }
+  _decompressedBytes += uncompressedSize;
 
   // Split null terminated string into _tokens.
   const char *ps = chars.data();
@@ -5575,6 +5622,8 @@ bool CrateReader::ReadTokens() {
     return i;
   };
 
+  _tokens.reserve(size_t(num_tokens));
+
   // TODO(syoyo): Check if input string has exactly `n` tokens(`n` null
   // characters)
   for (size_t i = 0; i < num_tokens; i++) {
@@ -5588,13 +5637,9 @@ bool CrateReader::ReadTokens() {
       return false;
     }
 
-    std::string str;
-    if (len > 0) {
-      str = std::string(pcurr, len);
-    } else {
-      // Empty string allowed
-      str = std::string();
-    }
+    // Intern the token string directly from the buffer.
+    // Empty string allowed
+    value::token tok(pcurr, len);
 
     pcurr += len + 1;  // +1 = '\0'
     nbytes_remain = size_t(pe - pcurr);
@@ -5603,8 +5648,6 @@ bool CrateReader::ReadTokens() {
       return false;
     }
 
-    value::token tok(str);
-
     DCOUT("token[" << i << "] = " << tok);
     _tokens.push_back(tok);
 
@@ -5765,6 +5808,7 @@ bool CrateReader::ReadFields() {
                                  size_t(reps_size), uncompressed_size, &_err)) {
       PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to read Fields ValueRep data.");
     }
+    _decompressedBytes += uncompressed_size;
 
     for (size_t i = 0; i < num_fields; i++) {
       _fields[i].value_rep = crate::ValueRep(reps_data[i]);
@@ -5878,6 +5922,7 @@ bool CrateReader::ReadFieldSets() {
     _err += err;
     return false;
   }
+  _decompressedBytes += sizeof(uint32_t) * size_t(num_fieldsets);
 
   for (size_t i = 0; i != num_fieldsets; ++i) {
     DCOUT("fieldset_index[" << i << "] = " << tmp[i]);
@@ -5890,18 +5935,133 @@ bool CrateReader::ReadFieldSets() {
   return true;
 }
 
+bool CrateReader::UnpackLiveFields(const std::vector<LiveFieldSlot> &slots,
+                                   size_t start, size_t end) {
+  for (size_t i = start; i < end; i++) {
+    const LiveFieldSlot &slot = slots[i];
+
+    DCOUT("fieldIndex = " << (slot.field_index.value));
+    auto fieldv = GetField(slot.field_index);
+    if (!fieldv) {
+      PUSH_ERROR("Invalid live field set data.");
+      return false;
+    }
+
+    const crate::Field &field = fieldv.value();
+    if (auto tokv = GetToken(field.token_index)) {
+      slot.pair->first = tokv.value().str();
+
+      if (!UnpackValueRep(field.value_rep, &slot.pair->second)) {
+        PUSH_ERROR("BuildLiveFieldSets: Failed to unpack ValueRep : "
+                   << field.value_rep.GetStringRepr());
+        return false;
+      }
+    } else {
+      PUSH_ERROR("Invalid token index.");
+    }
+  }
+
+  return true;
+}
+
+bool CrateReader::UnpackLiveFieldsParallel(
+    const std::vector<LiveFieldSlot> &slots, size_t num_threads) {
+#if defined(TINYUSDZ_CRATE_PARALLEL_UNPACK)
+  // Fields are distributed in small chunks, since the cost of unpacking a
+  // field varies a lot(e.g. inlined int vs. compressed `point3f[]`)
+  constexpr size_t kChunkSize = 64;
+
+  num_threads =
+      (std::min)(num_threads, (slots.size() + kChunkSize - 1) / kChunkSize);
+
+  struct WorkerResult {
+    bool ok{true};
+    std::string err;
+    std::string warn;
+    uint64_t memoryUsage{0};
+    uint64_t decompressedBytes{0};
+  };
+
+  std::vector<WorkerResult> results(num_threads);
+  std::vector<std::thread> workers;
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+
+  const uint64_t baseMemoryUsage = _memoryUsage;
+
+  for (size_t t = 0; t < num_threads; t++) {
+    workers.emplace_back([&, t]() {
+      // Each worker has its own read cursor.
+      StreamReader sr(_sr->data(), _sr->size(), _sr->swap_endian());
+      CrateReader worker(this, &sr);
+
+      while (!failed.load()) {
+        size_t start = next.fetch_add(kChunkSize);
+        if (start >= slots.size()) {
+          break;
+        }
+        size_t end = (std::min)(start + kChunkSize, slots.size());
+
+        if (!worker.UnpackLiveFields(slots, start, end)) {
+          results[t].ok = false;
+          failed = true;
+          break;
+        }
+      }
+
+      results[t].err = worker._err;
+      results[t].warn = worker._warn;
+      results[t].memoryUsage = worker._memoryUsage - baseMemoryUsage;
+      results[t].decompressedBytes = worker._decompressedBytes;
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  bool ok = true;
+  for (const auto &result : results) {
+    _err += result.err;
+    _warn += result.warn;
+    _memoryUsage += result.memoryUsage;
+    _decompressedBytes += result.decompressedBytes;
+    ok &= result.ok;
+  }
+
+  if (!ok) {
+    return false;
+  }
+
+  if (_memoryUsage > _config.maxMemoryBudget) {
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "Reached to max memory budget.");
+  }
+
+  return true;
+#else
+  (void)num_threads;
+  return UnpackLiveFields(slots, 0, slots.size());
+#endif
+}
+
 bool CrateReader::BuildLiveFieldSets() {
-  for (auto fsBegin = _fieldset_indices.begin(),
-            fsEnd = std::find(fsBegin, _fieldset_indices.end(), crate::Index());
-       fsBegin != _fieldset_indices.end();
-       fsBegin = fsEnd + 1, fsEnd = std::find(fsBegin, _fieldset_indices.end(),
-                                              crate::Index())) {
+  //
+  // First allocate the destination of all fields, then unpack values.
+  // Values are unpacked to the preallocated slot, so the result is identical
+  // regardless of the number of threads used.
+  //
+  std::vector<LiveFieldSlot> slots;
+
+  auto fsBegin = _fieldset_indices.begin();
+  while (fsBegin != _fieldset_indices.end()) {
+    auto fsEnd = std::find(fsBegin, _fieldset_indices.end(), crate::Index());
+
+    auto fsStart = fsBegin;
     auto &pairs = _live_fieldsets[crate::Index(
-        uint32_t(fsBegin - _fieldset_indices.begin()))];
+        uint32_t(fsStart - _fieldset_indices.begin()))];
 
     pairs.resize(size_t(fsEnd - fsBegin));
     DCOUT("range size = " << (fsEnd - fsBegin));
-    // TODO(syoyo): Parallelize.
     for (size_t i = 0; fsBegin != fsEnd; ++fsBegin, ++i) {
       if (fsBegin->value < _fields.size()) {
         // ok
@@ -5910,18 +6070,69 @@ bool CrateReader::BuildLiveFieldSets() {
         return false;
       }
 
-      DCOUT("fieldIndex = " << (fsBegin->value));
-      auto const &field = _fields[fsBegin->value];
-      if (auto tokv = GetToken(field.token_index)) {
-        pairs[i].first = tokv.value().str();
-
-        if (!UnpackValueRep(field.value_rep, &pairs[i].second)) {
-          PUSH_ERROR("BuildLiveFieldSets: Failed to unpack ValueRep : "
-                     << field.value_rep.GetStringRepr());
-          return false;
+      if (_config.lazyArrayUnpack) {
+        const crate::Field &field = _fields[fsBegin->value];
+        const crate::ValueRep &rep = field.value_rep;
+        bool is_timesamples =
+            rep.GetType() ==
+            static_cast<int32_t>(CrateDataTypeId::CRATE_DATA_TYPE_TIME_SAMPLES);
+        if ((rep.IsArray() || is_timesamples) && !rep.IsInlined()) {
+          // Only set the field name. Value is unpacked in `GetLiveFieldSet`.
+          if (auto tokv = GetToken(field.token_index)) {
+            pairs[i].first = tokv.value().str();
+          } else {
+            PUSH_ERROR("Invalid token index.");
+          }
+          _deferred_fields[crate::Index(uint32_t(
+                               fsStart - _fieldset_indices.begin()))]
+              .push_back(std::make_pair(i, *fsBegin));
+          continue;
         }
-      } else {
-        PUSH_ERROR("Invalid token index.");
+      }
+
+      LiveFieldSlot slot;
+      slot.field_index = *fsBegin;
+      slot.pair = &pairs[i];
+      slots.push_back(slot);
+    }
+
+    if (fsEnd == _fieldset_indices.end()) {
+      break;
+    }
+    fsBegin = fsEnd + 1;
+  }
+
+  size_t num_threads = size_t((std::max)(1, _config.numThreads));
+
+  // Threading does not pay off for tiny Crate data.
+  constexpr size_t kMinSlotsForThreading = 1024;
+
+  if ((num_threads > 1) && (slots.size() >= kMinSlotsForThreading)) {
+    if (!UnpackLiveFieldsParallel(slots, num_threads)) {
+      return false;
+    }
+  } else {
+    if (!UnpackLiveFields(slots, 0, slots.size())) {
+      return false;
+    }
+  }
+
+  if (_config.lazyArrayUnpack) {
+    // Count how many times each deferred field is requested through
+    // `GetLiveFieldSet`, so that its decoded value is kept only while it is
+    // still referenced by a Spec not yet reconstructed.
+    std::unordered_map<uint32_t, size_t> fieldset_refcount;
+    for (const auto &spec : _specs) {
+      fieldset_refcount[spec.fieldset_index.value]++;
+    }
+
+    for (const auto &item : _deferred_fields) {
+      auto rit = fieldset_refcount.find(item.first.value);
+      if (rit == fieldset_refcount.end()) {
+        continue;
+      }
+      for (const auto &field : item.second) {
+        _deferred_field_refcount[field.second.value] += rit->second;
       }
     }
   }
@@ -5945,6 +6156,69 @@ bool CrateReader::BuildLiveFieldSets() {
   return true;
 }
 
+bool CrateReader::GetLiveFieldSet(const crate::Index &fieldset_index,
+                                  FieldValuePairVector *fvs) {
+  if (!fvs) {
+    return false;
+  }
+
+  const auto it = _live_fieldsets.find(fieldset_index);
+  if (it == _live_fieldsets.end()) {
+    PUSH_ERROR_AND_RETURN_TAG(kTag, "FieldSet id: " << fieldset_index.value
+                                                    << " not found.");
+  }
+
+  // Values are copy-on-write, so this does not copy array data.
+  (*fvs) = it->second;
+
+  const auto dit = _deferred_fields.find(fieldset_index);
+  if (dit == _deferred_fields.end()) {
+    return true;
+  }
+
+  for (const auto &item : dit->second) {
+    size_t pos = item.first;
+    if (pos >= fvs->size()) {
+      PUSH_ERROR_AND_RETURN_TAG(kTag, "Invalid deferred field position.");
+    }
+
+    const uint32_t field_index = item.second.value;
+
+    auto cit = _decoded_fields.find(field_index);
+    if (cit == _decoded_fields.end()) {
+      auto fieldv = GetField(item.second);
+      if (!fieldv) {
+        PUSH_ERROR_AND_RETURN_TAG(kTag, "Invalid live field set data.");
+      }
+
+      crate::CrateValue value;
+      if (!UnpackValueRep(fieldv.value().value_rep, &value)) {
+        PUSH_ERROR_AND_RETURN_TAG(
+            kTag, "Failed to unpack ValueRep : "
+                      << fieldv.value().value_rep.GetStringRepr());
+      }
+
+      cit = _decoded_fields.emplace(field_index, std::move(value)).first;
+    }
+
+    // Keep the decoded value while other Specs still reference it, and
+    // release it to the caller on the last reference.
+    auto rit = _deferred_field_refcount.find(field_index);
+    if ((rit != _deferred_field_refcount.end()) && (rit->second > 1)) {
+      rit->second--;
+      (*fvs)[pos].second = cit->second;
+    } else {
+      if (rit != _deferred_field_refcount.end()) {
+        _deferred_field_refcount.erase(rit);
+      }
+      (*fvs)[pos].second = std::move(cit->second);
+      _decoded_fields.erase(cit);
+    }
+  }
+
+  return true;
+}
+
 bool CrateReader::ReadSpecs() {
   if ((_specs_index < 0) || (_specs_index >= int64_t(_toc.sections.size()))) {
     PUSH_ERROR("Invalid index for `SPECS` section.");
@@ -6112,6 +6386,9 @@ bool CrateReader::ReadSpecs() {
     }
   }
 
+  // path indexes, fieldset indexes and spec types
+  _decompressedBytes += 3 * sizeof(uint32_t) * size_t(num_specs);
+
 #ifdef TINYUSDZ_LOCAL_DEBUG_PRINT
   for (size_t i = 0; i != num_specs; ++i) {
     DCOUT("spec[" << i << "].pathIndex  = " << _specs[i].path_index.value
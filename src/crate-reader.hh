@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 //
@@ -22,8 +23,19 @@ namespace crate {
 #define TINYUSDZ_CRATE_USE_FOR_BASED_PATH_INDEX_DECODER
 
 struct CrateReaderConfig {
+  // # of threads used for unpacking field values in `BuildLiveFieldSets`.
+  // -1 = use system's # of threads.
   int numThreads = -1;
 
+  // Lazy value unpacking.
+  // When true, `BuildLiveFieldSets` does not unpack array values and
+  // TimeSamples(which are usually large) but only keeps its ValueRep.
+  // Such values are unpacked on the first `GetLiveFieldSet` call which
+  // requests it, and the decoded value is cached in CrateReader only until the
+  // last Spec referencing it is requested, so an app can reduce the peak
+  // memory usage.
+  bool lazyArrayUnpack = false;
+
   // For malcious Crate data.
   // Set limits to prevent infinite-loop, buffer-overrun, out-of-memory, etc.
   size_t maxTOCSections = 32;
@@ -180,6 +192,12 @@ class CrateReader {
     return size_t(_memoryUsage / 1024 / 1024);
   }
 
+  // Approximated memory usage in bytes
+  uint64_t GetMemoryUsage() const { return _memoryUsage; }
+
+  // Total bytes produced by decompression(LZ4 and integer compression)
+  uint64_t GetDecompressedBytes() const { return _decompressedBytes; }
+
   /// -------------------------------------
   /// Following Methods are valid after successfull parsing of Crate data.
   ///
@@ -205,10 +223,30 @@ class CrateReader {
 
   const std::vector<crate::Spec> &GetSpecs() const { return _specs; }
 
+  ///
+  /// NOTE: When `lazyArrayUnpack` is enabled, array values and TimeSamples in
+  /// the fieldsets are not yet unpacked(empty value).
+  /// Use `GetLiveFieldSet` to get fully unpacked fieldset.
+  ///
   const std::map<crate::Index, FieldValuePairVector> &GetLiveFieldSets() const {
     return _live_fieldsets;
   }
 
+  ///
+  /// Get the list of (field name, unpacked value) of the fieldset.
+  /// When `lazyArrayUnpack` is enabled, deferred values are unpacked here.
+  /// A deferred value is decoded at most once while any Spec referencing it is
+  /// not yet requested, and is released from the reader on its last request.
+  ///
+  /// @param[in] fieldset_index Fieldset index(Spec::fieldset_index)
+  /// @param[out] fvs Unpacked fieldset.
+  /// @return false when `fieldset_index` is invalid or failed to unpack values.
+  ///
+  bool GetLiveFieldSet(const crate::Index &fieldset_index,
+                       FieldValuePairVector *fvs);
+
+  bool IsLazyArrayUnpack() const { return _config.lazyArrayUnpack; }
+
 #if 0
   // FIXME: May not need this
   const std::vector<Path> &GetPaths() const {
@@ -294,6 +332,28 @@ class CrateReader {
       size_t curIndex, const Path &parentPath);
 #endif
 
+  // Worker reader for parallel value unpacking. Shares `parent`'s
+  // tokens/strings/fields/paths tables, but has its own stream position,
+  // error message and memory usage counter.
+  CrateReader(const CrateReader *parent, StreamReader *sr);
+
+  // Return the reader which owns tokens/strings/fields/paths tables.
+  const CrateReader &TableOwner() const {
+    return _parent ? *_parent : *this;
+  }
+
+  // Destination of an unpacked field in `_live_fieldsets`.
+  struct LiveFieldSlot {
+    crate::Index field_index;
+    FieldValuePair *pair{nullptr};
+  };
+
+  // Unpack slots in range [start, end)
+  bool UnpackLiveFields(const std::vector<LiveFieldSlot> &slots, size_t start,
+                        size_t end);
+  bool UnpackLiveFieldsParallel(const std::vector<LiveFieldSlot> &slots,
+                                size_t num_threads);
+
   bool UnpackValueRep(const crate::ValueRep &rep, crate::CrateValue *value);
   bool UnpackInlinedValueRep(const crate::ValueRep &rep,
                              crate::CrateValue *value);
@@ -408,7 +468,20 @@ class CrateReader {
   std::map<crate::Index, FieldValuePairVector>
       _live_fieldsets;  // <fieldset index, List of field with unpacked Values>
 
+  // Fields whose value unpacking is deferred(`lazyArrayUnpack` mode).
+  // <fieldset index, List of (position in the fieldset, field index)>
+  std::map<crate::Index, std::vector<std::pair<size_t, crate::Index>>>
+      _deferred_fields;
+
+  // Decoded value of deferred fields shared by multiple Specs.
+  // <field index, value>
+  std::unordered_map<uint32_t, crate::CrateValue> _decoded_fields;
+
+  // <field index, # of remaining `GetLiveFieldSet` requests>
+  std::unordered_map<uint32_t, size_t> _deferred_field_refcount;
+
   const StreamReader *_sr{};
+  const CrateReader *_parent{nullptr};  // non-null for worker reader
 
   void PushError(const std::string &s) const { _err += s; }
   void PushWarn(const std::string &s) const { _warn += s; }
@@ -423,6 +496,8 @@ class CrateReader {
   // Approximated uncompressed memory usage(vertices, `tokens`, ...) in bytes.
   uint64_t _memoryUsage{0};
 
+  uint64_t _decompressedBytes{0};
+
   class Impl;
   Impl *_impl;
 };
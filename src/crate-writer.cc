@@ -1,8 +1,18 @@
-#include <limits>
+// SPDX-License-Identifier: MIT
+// Copyright 2022 - Present, Syoyo Fujita.
+//
+// Crate(binary) writer
+//
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <sstream>
 
 #include "crate-writer.hh"
+#include "integerCoding.h"
+#include "lz4-compression.hh"
 #include "value-types.hh"
 
 #ifdef __clang__
@@ -17,17 +27,21 @@
 #pragma clang diagnostic pop
 #endif
 
+#include "common-macros.inc"
+
 namespace tinyusdz {
 namespace crate {
 
 namespace {
 
-struct FltBit {
-  union {
-    float f;
-    uint32_t i;
-  };
-};
+// Crate version to write.
+constexpr uint8_t kVersion[3] = {0, 8, 0};
+
+// Bootstrap header: ident(8) + version(8) + tocOffset(8) + reserved(8 * 8)
+constexpr size_t kBootStrapSize = 88;
+
+// Max number of distinct values to encode float array with look-up table.
+constexpr size_t kMaxLUTSize = 1024;
 
 struct DblBit {
   union {
@@ -40,7 +54,7 @@ template<typename T>
 bool Compare(const T &lhs, const T &rhs) {
   return lhs == rhs;
 }
- 
+
 // Use bitfield comparison for floating-point value,
 // This may give slightly different result compared to pxrUSD implementation
 // (which uses `==` for floating point comparison)
@@ -52,19 +66,14 @@ bool Compare(const double &lhs, const double &rhs) {
   return (a.i == b.i);
 }
 
-template<>
-bool Compare(const float &lhs, const float &rhs) {
-  FltBit a; a.f = lhs;
-  FltBit b; b.f = rhs;
-
-  return (a.i == b.i);
-}
-
-} // namespace
-
 // IsExactlyRepresented in pxrUSD.
 template<typename Tfrom, typename Tto>
 nonstd::optional<Tto> TryExactlyRepresentable(const Tfrom &from) {
+  // NaN cannot be represented(and static_cast from NaN is UB)
+  if (!(from == from)) {
+    return nonstd::nullopt;
+  }
+
   // NOTE: pxrUSD uses lowest() for minval, not min()
   Tfrom minval = static_cast<Tfrom>(std::numeric_limits<Tto>::lowest());
   Tfrom maxval = static_cast<Tfrom>(std::numeric_limits<Tto>::max());
@@ -86,7 +95,85 @@ nonstd::optional<Tto> TryExactlyRepresentable(const Tfrom &from) {
   return nonstd::nullopt;
 }
 
-// NOTE `Inline` payload is 6bytes.
+inline double ToDouble(const value::half &h) {
+  return double(value::half_to_float(h));
+}
+inline double ToDouble(const float f) { return double(f); }
+inline double ToDouble(const double d) { return d; }
+inline double ToDouble(const int32_t i) { return double(i); }
+
+// Bit representation of floating point value(for LUT construction).
+template<typename T>
+uint64_t FloatBits(const T &v) {
+  static_assert(sizeof(T) <= sizeof(uint64_t), "");
+  uint64_t bits{0};
+  memcpy(&bits, &v, sizeof(T));
+  return bits;
+}
+
+void AppendBytes(const void *p, size_t n, std::vector<uint8_t> *dst) {
+  if (n == 0) {
+    return;
+  }
+  const uint8_t *src = reinterpret_cast<const uint8_t *>(p);
+  dst->insert(dst->end(), src, src + n);
+}
+
+template<typename T>
+void AppendPOD(const T &v, std::vector<uint8_t> *dst) {
+  AppendBytes(&v, sizeof(T), dst);
+}
+
+// Encode N components of vector as int8 x N.
+template<typename T, size_t N>
+nonstd::optional<uint32_t> TryEncodeInlineVec(const std::array<T, N> &v) {
+  static_assert(N <= 4, "");
+  uint32_t dst{0};
+
+  // Check if each component of the vector can be represented by int8.
+  std::array<int8_t, N> ivec;
+  for (size_t i = 0; i < N; i++) {
+    if (auto f = TryExactlyRepresentable<double, int8_t>(ToDouble(v[i]))) {
+      ivec[i] = f.value();
+    } else {
+      return nonstd::nullopt;
+    }
+  }
+
+  memcpy(&dst, &ivec[0], sizeof(ivec));
+  return dst;
+}
+
+// Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
+template<typename M, size_t N>
+nonstd::optional<uint32_t> TryEncodeInlineMatrix(const M &v) {
+  uint32_t dst{0};
+
+  std::array<int8_t, N> diag;
+  for (size_t i = 0; i < N; i++) {
+    for (size_t j = 0; j < N; j++) {
+      if (i == j) {
+        // diag
+        if (auto f = TryExactlyRepresentable<double, int8_t>(v.m[i][j])) {
+          diag[i] = f.value();
+        } else {
+          return nonstd::nullopt;
+        }
+      } else {
+        if (!Compare(v.m[i][j], 0.0)) {
+          return nonstd::nullopt;
+        }
+      }
+    }
+  }
+
+  memcpy(&dst, &diag[0], sizeof(diag));
+  return dst;
+}
+
+} // namespace
+
+// NOTE `Inline` payload is 6bytes, but we only use 4 bytes as done in pxrUSD.
 //
 // - Inlineable value
 //   - double as float format
@@ -95,7 +182,7 @@ nonstd::optional<Tto> TryExactlyRepresentable(const Tfrom &from) {
 //   - Diagonal matrix as int8 x N  (n = 2, 3 or 4)
 //   - empty dictionary
 
-inline nonstd::optional<uint32_t> TryEncodeInline(double v) {
+nonstd::optional<uint32_t> TryEncodeInline(double v) {
   uint32_t dst;
 
   nonstd::optional<float> f = TryExactlyRepresentable<double, float>(v);
@@ -108,7 +195,7 @@ inline nonstd::optional<uint32_t> TryEncodeInline(double v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
+nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
   uint32_t dst;
 
   nonstd::optional<uint32_t> f = TryExactlyRepresentable<uint64_t, uint32_t>(v);
@@ -121,7 +208,7 @@ inline nonstd::optional<uint32_t> TryEncodeInline(uint64_t v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
+nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
   uint32_t dst;
 
   nonstd::optional<int32_t> f = TryExactlyRepresentable<int64_t, int32_t>(v);
@@ -134,165 +221,1401 @@ inline nonstd::optional<uint32_t> TryEncodeInline(int64_t v) {
   return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3f v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(const value::float2 &v) {
+  return TryEncodeInlineVec(v);
+}
 
-  // Check if each component of the vector can be represented by int8.
-  std::array<int8_t, 3> ivec;
-  for (size_t i = 0; i < 3; i++) {
-    if (auto f = TryExactlyRepresentable<float, int8_t>(v[i])) {
-      ivec[i] = f.value();
-    } else {
-      return nonstd::nullopt;
-    }
-  }
+nonstd::optional<uint32_t> TryEncodeInline(const value::float3 &v) {
+  return TryEncodeInlineVec(v);
+}
 
-  memcpy(&dst, &ivec[0], sizeof(ivec));
-  return dst;
+nonstd::optional<uint32_t> TryEncodeInline(const value::float4 &v) {
+  return TryEncodeInlineVec(v);
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::vector3d v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(const value::double2 &v) {
+  return TryEncodeInlineVec(v);
+}
 
-  // Check if each component of the vector can be represented by int8.
-  std::array<int8_t, 3> ivec;
-  for (size_t i = 0; i < 3; i++) {
-    if (auto f = TryExactlyRepresentable<double, int8_t>(v[i])) {
-      ivec[i] = f.value();
-    } else {
-      return nonstd::nullopt;
-    }
-  }
+nonstd::optional<uint32_t> TryEncodeInline(const value::double3 &v) {
+  return TryEncodeInlineVec(v);
+}
 
-  memcpy(&dst, &ivec[0], sizeof(ivec));
-  return dst;
+nonstd::optional<uint32_t> TryEncodeInline(const value::double4 &v) {
+  return TryEncodeInlineVec(v);
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::color4f v) {
-  uint32_t dst;
+nonstd::optional<uint32_t> TryEncodeInline(const value::half2 &v) {
+  return TryEncodeInlineVec(v);
+}
 
-  // Check if each component of the vector can be represented by int8.
-  std::array<int8_t, 4> ivec;
-  for (size_t i = 0; i < 4; i++) {
-    if (auto f = TryExactlyRepresentable<float, int8_t>(v[i])) {
-      ivec[i] = f.value();
-    } else {
-      return nonstd::nullopt;
-    }
+nonstd::optional<uint32_t> TryEncodeInline(const value::half3 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::half4 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int2 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int3 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::int4 &v) {
+  return TryEncodeInlineVec(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix2d &v) {
+  return TryEncodeInlineMatrix<value::matrix2d, 2>(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix3d &v) {
+  return TryEncodeInlineMatrix<value::matrix3d, 3>(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix4d &v) {
+  return TryEncodeInlineMatrix<value::matrix4d, 4>(v);
+}
+
+nonstd::optional<uint32_t> TryEncodeInline(const value::dict &v) {
+  uint32_t dst{0};
+
+  if (v.empty()) {
+    return dst;
   }
 
-  memcpy(&dst, &ivec[0], sizeof(ivec));
-  return dst;
+  return nonstd::nullopt;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::color4d v) {
-  uint32_t dst;
+// -- CrateWriter --------------------------------------------------------------
 
-  // Check if each component of the vector can be represented by int8.
-  std::array<int8_t, 4> ivec;
-  for (size_t i = 0; i < 4; i++) {
-    if (auto f = TryExactlyRepresentable<double, int8_t>(v[i])) {
-      ivec[i] = f.value();
-    } else {
-      return nonstd::nullopt;
-    }
+CrateWriter::CrateWriter(const CrateWriterConfig &config) : _config(config) {
+  // Reserve TokenIndex 0 for an empty token, since the property element of
+  // PATHS is encoded as negative TokenIndex(so TokenIndex 0 cannot be used
+  // for it).
+  AddToken(std::string());
+
+  // Root path is always PathIndex 0.
+  _path_nodes.emplace_back();
+  _path_to_index[std::string()] = 0;
+
+  // Bootstrap header. `tocOffset` is filled in `Write`.
+  _buf.resize(kBootStrapSize, 0);
+}
+
+TokenIndex CrateWriter::AddToken(const std::string &token) {
+  auto it = _token_to_index.find(token);
+  if (it != _token_to_index.end()) {
+    return TokenIndex(it->second);
   }
 
-  memcpy(&dst, &ivec[0], sizeof(ivec));
-  return dst;
+  uint32_t idx = uint32_t(_tokens.size());
+  _tokens.push_back(token);
+  _token_to_index.emplace(token, idx);
+
+  return TokenIndex(idx);
 }
 
-//
-// TODO: Implement more TryEncodeInline for scalar value types
-//
+StringIndex CrateWriter::AddString(const std::string &str) {
+  auto it = _string_to_index.find(str);
+  if (it != _string_to_index.end()) {
+    return StringIndex(it->second);
+  }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix2d v) {
-  uint32_t dst;
+  uint32_t idx = uint32_t(_strings.size());
+  _strings.push_back(AddToken(str));
+  _string_to_index.emplace(str, idx);
 
-  // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
-  std::array<int8_t, 2> diag;
-  for (size_t i = 0; i < 2; i++) {
-    for (size_t j = 0; j < 2; j++) {
-      if (i == j) {
-        // diag
-        if (auto f = TryExactlyRepresentable<double, int8_t>(v.m[i][j])) {
-          diag[i] = f.value();
-        } else {
-          return nonstd::nullopt;
+  return StringIndex(idx);
+}
+
+bool CrateWriter::AddPath(const Path &path, PathIndex *index) {
+  if (!index) {
+    return false;
+  }
+
+  if (!path.is_valid() || (path.prim_part().empty() && path.prop_part().empty())) {
+    // Empty path. Assign an index which is not encoded into the path tree.
+    // The reader leaves `Path()` for it.
+    if (!_empty_path_index) {
+      _empty_path_index = uint32_t(_path_nodes.size());
+      _path_nodes.emplace_back();
+    }
+    (*index) = PathIndex(_empty_path_index.value());
+    return true;
+  }
+
+  if (!path.is_absolute_path()) {
+    PUSH_ERROR_AND_RETURN("Relative path is not supported: " << path.full_path_name());
+  }
+
+  // Split prim part into elements: prim names and variant selections.
+  // e.g. "/root/geom{shapes=sphere}child" -> ["root", "geom", "{shapes=sphere}", "child"]
+  std::vector<std::string> elements;
+  {
+    const std::string &prim_part = path.prim_part();
+    std::string elem;
+    for (size_t i = 0; i < prim_part.size(); i++) {
+      const char c = prim_part[i];
+      if (c == '/') {
+        if (!elem.empty()) {
+          elements.push_back(elem);
+          elem.clear();
         }
-      } else {
-        if (!Compare(v.m[i][j], 0.0)) {
-          return nonstd::nullopt;
+      } else if (c == '{') {
+        if (!elem.empty()) {
+          elements.push_back(elem);
+          elem.clear();
+        }
+        size_t end = prim_part.find('}', i);
+        if (end == std::string::npos) {
+          PUSH_ERROR_AND_RETURN("Invalid variant selection path: " << prim_part);
         }
+        elements.push_back(prim_part.substr(i, end - i + 1));
+        i = end;
+      } else {
+        elem += c;
       }
     }
+    if (!elem.empty()) {
+      elements.push_back(elem);
+    }
   }
 
-  memcpy(&dst, &diag[0], sizeof(diag));
-  return dst;
-}
+  std::string key;
+  uint32_t parent = 0;  // root
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix3d v) {
-  uint32_t dst;
+  auto add_element = [&](const std::string &elem, bool is_property) {
+    key += (is_property ? "." : "/") + elem;
 
-  // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
-  std::array<int8_t, 3> diag;
-  for (size_t i = 0; i < 3; i++) {
-    for (size_t j = 0; j < 3; j++) {
-      if (i == j) {
-        // diag
-        if (auto f = TryExactlyRepresentable<double, int8_t>(v.m[i][j])) {
-          diag[i] = f.value();
-        } else {
-          return nonstd::nullopt;
-        }
-      } else {
-        if (!Compare(v.m[i][j], 0.0)) {
-          return nonstd::nullopt;
-        }
-      }
+    auto it = _path_to_index.find(key);
+    if (it != _path_to_index.end()) {
+      parent = it->second;
+      return;
     }
+
+    int32_t tok = int32_t(AddToken(elem).value);
+
+    PathNode node;
+    node.element_token = is_property ? -tok : tok;
+
+    uint32_t idx = uint32_t(_path_nodes.size());
+    _path_nodes.emplace_back(std::move(node));
+    _path_nodes[parent].children.push_back(idx);
+    _path_to_index.emplace(key, idx);
+
+    parent = idx;
+  };
+
+  for (const auto &elem : elements) {
+    add_element(elem, /* is_property */false);
   }
 
-  memcpy(&dst, &diag[0], sizeof(diag));
-  return dst;
+  if (!path.prop_part().empty()) {
+    add_element(path.prop_part(), /* is_property */true);
+  }
+
+  (*index) = PathIndex(parent);
+  return true;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::matrix4d v) {
-  uint32_t dst;
+FieldIndex CrateWriter::AddField(const Field &field) {
+  auto it = _field_to_index.find(field);
+  if (it != _field_to_index.end()) {
+    return FieldIndex(it->second);
+  }
 
-  // Check if a matrix is a diagonal matrix and its diagonal component can be represented by int8.
-  std::array<int8_t, 4> diag;
-  for (size_t i = 0; i < 4; i++) {
-    for (size_t j = 0; j < 4; j++) {
-      if (i == j) {
-        // diag
-        if (auto f = TryExactlyRepresentable<double, int8_t>(v.m[i][j])) {
-          diag[i] = f.value();
-        } else {
-          return nonstd::nullopt;
-        }
-      } else {
-        if (!Compare(v.m[i][j], 0.0)) {
-          return nonstd::nullopt;
-        }
-      }
+  uint32_t idx = uint32_t(_fields.size());
+  _fields.push_back(field);
+  _field_to_index.emplace(field, idx);
+
+  return FieldIndex(idx);
+}
+
+FieldSetIndex CrateWriter::AddFieldSet(const std::vector<FieldIndex> &fieldset) {
+  auto it = _fieldset_to_index.find(fieldset);
+  if (it != _fieldset_to_index.end()) {
+    return FieldSetIndex(it->second);
+  }
+
+  // FieldSetIndex is the start position in flattened fieldsets.
+  uint32_t idx = uint32_t(_fieldsets.size());
+  _fieldsets.insert(_fieldsets.end(), fieldset.begin(), fieldset.end());
+  _fieldsets.push_back(FieldIndex());  // terminator(~0)
+  _fieldset_to_index.emplace(fieldset, idx);
+
+  return FieldSetIndex(idx);
+}
+
+bool CrateWriter::AddSpec(const Path &path, SpecType spec_type,
+                          const FieldValueRepPairVector &fields) {
+  PathIndex path_index;
+  if (!AddPath(path, &path_index)) {
+    return false;
+  }
+
+  std::vector<FieldIndex> fieldset;
+  for (const auto &fv : fields) {
+    Field field;
+    field.token_index = AddToken(fv.first);
+    field.value_rep = fv.second;
+    fieldset.push_back(AddField(field));
+  }
+
+  Spec spec;
+  spec.path_index = path_index;
+  spec.fieldset_index = AddFieldSet(fieldset);
+  spec.spec_type = spec_type;
+
+  _specs.push_back(spec);
+
+  return true;
+}
+
+uint64_t CrateWriter::WriteValueData(CrateDataTypeId ty,
+                                     const std::vector<uint8_t> &data) {
+  std::string key;
+  if (_config.dedupValues) {
+    key.reserve(data.size() + 1);
+    key += char(ty);
+    key.append(reinterpret_cast<const char *>(data.data()), data.size());
+
+    auto it = _value_data_to_offset.find(key);
+    if (it != _value_data_to_offset.end()) {
+      return it->second;
     }
   }
 
-  memcpy(&dst, &diag[0], sizeof(diag));
-  return dst;
+  uint64_t offset = uint64_t(_buf.size());
+  _buf.insert(_buf.end(), data.begin(), data.end());
+
+  if (_config.dedupValues) {
+    _value_data_to_offset.emplace(std::move(key), offset);
+  }
+
+  return offset;
 }
 
-inline nonstd::optional<uint32_t> TryEncodeInline(value::dict v) {
-  uint32_t dst{0};
+template <typename Int>
+bool CrateWriter::WriteCompressedInts(const std::vector<Int> &ints,
+                                      std::vector<uint8_t> *dst) {
+  using Compressor =
+      typename std::conditional<sizeof(Int) == 4, Usd_IntegerCompression,
+                                Usd_IntegerCompression64>::type;
+
+  std::vector<char> comp_buffer(Compressor::GetCompressedBufferSize(ints.size()));
+
+  std::string err;
+  size_t comp_size = Compressor::CompressToBuffer(ints.data(), ints.size(),
+                                                  comp_buffer.data(), &err);
+  if ((comp_size == 0) || !err.empty()) {
+    PUSH_ERROR_AND_RETURN("Failed to compress integers. " << err);
+  }
 
+  AppendPOD(uint64_t(comp_size), dst);
+  AppendBytes(comp_buffer.data(), comp_size, dst);
+
+  return true;
+}
+
+template <typename T>
+bool CrateWriter::PackInlinableScalar(const T &v, CrateDataTypeId ty,
+                                      ValueRep *rep) {
+  if (auto d = TryEncodeInline(v)) {
+    (*rep) = ValueRep(int32_t(ty), /* inlined */true, /* array */false, d.value());
+    return true;
+  }
+
+  return PackRawScalar(v, ty, rep);
+}
+
+template <typename T>
+bool CrateWriter::PackRawScalar(const T &v, CrateDataTypeId ty,
+                                ValueRep *rep) {
+  std::vector<uint8_t> data;
+  AppendPOD(v, &data);
+
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+template <typename T>
+bool CrateWriter::PackRawArray(const std::vector<T> &v, CrateDataTypeId ty,
+                               ValueRep *rep) {
   if (v.empty()) {
-    return dst;
+    // payload 0 = empty array.
+    (*rep) = ValueRep(int32_t(ty), false, true, 0);
+    return true;
   }
 
-  return nonstd::nullopt;
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(v.size()), &data);
+  AppendBytes(v.data(), sizeof(T) * v.size(), &data);
+
+  (*rep) = ValueRep(int32_t(ty), false, true, WriteValueData(ty, data));
+  return true;
+}
+
+template <typename T>
+bool CrateWriter::PackIntArray(const std::vector<T> &v, CrateDataTypeId ty,
+                               ValueRep *rep) {
+  if (v.empty()) {
+    (*rep) = ValueRep(int32_t(ty), false, true, 0);
+    return true;
+  }
+
+  bool compress = _config.compressArrays && (v.size() >= kMinCompressedArraySize);
+
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(v.size()), &data);
+  if (compress) {
+    if (!WriteCompressedInts(v, &data)) {
+      return false;
+    }
+  } else {
+    AppendBytes(v.data(), sizeof(T) * v.size(), &data);
+  }
+
+  (*rep) = ValueRep(int32_t(ty), false, true, WriteValueData(ty, data));
+  if (compress) {
+    rep->SetIsCompressed();
+  }
+  return true;
+}
+
+template <typename T>
+bool CrateWriter::PackFloatArray(const std::vector<T> &v, CrateDataTypeId ty,
+                                 ValueRep *rep) {
+  if (v.empty()) {
+    (*rep) = ValueRep(int32_t(ty), false, true, 0);
+    return true;
+  }
+
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(v.size()), &data);
+
+  bool compressed = false;
+
+  if (_config.compressArrays && (v.size() >= kMinCompressedArraySize)) {
+    // Same strategy as in pxrUSD:
+    //
+    // 1. Integral values: compressed int32 array('i')
+    // 2. Few distinct values: look-up table + compressed indices('t')
+    // 3. Otherwise: Store as is.
+    std::vector<int32_t> ints(v.size());
+    bool all_ints = true;
+    for (size_t i = 0; i < v.size(); i++) {
+      if (auto iv = TryExactlyRepresentable<double, int32_t>(ToDouble(v[i]))) {
+        ints[i] = iv.value();
+      } else {
+        all_ints = false;
+        break;
+      }
+    }
+
+    if (all_ints) {
+      data.push_back(uint8_t('i'));
+      if (!WriteCompressedInts(ints, &data)) {
+        return false;
+      }
+      compressed = true;
+    } else {
+      std::vector<T> lut;
+      std::unordered_map<uint64_t, uint32_t> lut_map;
+      std::vector<uint32_t> indices(v.size());
+      bool use_lut = true;
+      for (size_t i = 0; i < v.size(); i++) {
+        uint64_t bits = FloatBits(v[i]);
+        auto it = lut_map.find(bits);
+        if (it != lut_map.end()) {
+          indices[i] = it->second;
+        } else {
+          if ((lut.size() >= kMaxLUTSize) || (lut.size() * 4 >= v.size())) {
+            use_lut = false;
+            break;
+          }
+          indices[i] = uint32_t(lut.size());
+          lut_map.emplace(bits, uint32_t(lut.size()));
+          lut.push_back(v[i]);
+        }
+      }
+
+      if (use_lut) {
+        data.push_back(uint8_t('t'));
+        AppendPOD(uint32_t(lut.size()), &data);
+        AppendBytes(lut.data(), sizeof(T) * lut.size(), &data);
+        if (!WriteCompressedInts(indices, &data)) {
+          return false;
+        }
+        compressed = true;
+      }
+    }
+  }
+
+  if (!compressed) {
+    AppendBytes(v.data(), sizeof(T) * v.size(), &data);
+  }
+
+  (*rep) = ValueRep(int32_t(ty), false, true, WriteValueData(ty, data));
+  if (compressed) {
+    rep->SetIsCompressed();
+  }
+  return true;
+}
+
+bool CrateWriter::PackIndices(const std::vector<uint32_t> &indices,
+                              CrateDataTypeId ty, bool is_array,
+                              ValueRep *rep) {
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(indices.size()), &data);
+  AppendBytes(indices.data(), sizeof(uint32_t) * indices.size(), &data);
+
+  (*rep) = ValueRep(int32_t(ty), false, is_array, WriteValueData(ty, data));
+  return true;
+}
+
+ValueRep CrateWriter::PackSpecifier(Specifier spec) {
+  uint32_t d{0};  // Def
+  if (spec == Specifier::Over) {
+    d = 1;
+  } else if (spec == Specifier::Class) {
+    d = 2;
+  }
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_SPECIFIER), true,
+                  false, d);
+}
+
+ValueRep CrateWriter::PackVariability(Variability variability) {
+  uint32_t d{0};  // Varying
+  if (variability == Variability::Uniform) {
+    d = 1;
+  } else if (variability == Variability::Config) {
+    d = 2;
+  }
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_VARIABILITY), true,
+                  false, d);
+}
+
+ValueRep CrateWriter::PackToken(const value::token &tok) {
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_TOKEN), true, false,
+                  AddToken(tok.str()).value);
+}
+
+ValueRep CrateWriter::PackString(const std::string &str) {
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_STRING), true,
+                  false, AddString(str).value);
+}
+
+ValueRep CrateWriter::PackBool(bool b) {
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_BOOL), true, false,
+                  b ? 1 : 0);
+}
+
+ValueRep CrateWriter::PackValueBlock() {
+  return ValueRep(int32_t(CrateDataTypeId::CRATE_DATA_TYPE_VALUE_BLOCK), true,
+                  false, 0);
+}
+
+bool CrateWriter::PackTokenVector(const std::vector<value::token> &v,
+                                  ValueRep *rep) {
+  std::vector<uint32_t> indices;
+  for (const auto &tok : v) {
+    indices.push_back(AddToken(tok.str()).value);
+  }
+
+  return PackIndices(indices, CrateDataTypeId::CRATE_DATA_TYPE_TOKEN_VECTOR,
+                     false, rep);
+}
+
+bool CrateWriter::PackStringVector(const std::vector<std::string> &v,
+                                   ValueRep *rep) {
+  std::vector<uint32_t> indices;
+  for (const auto &s : v) {
+    indices.push_back(AddString(s).value);
+  }
+
+  return PackIndices(indices, CrateDataTypeId::CRATE_DATA_TYPE_STRING_VECTOR,
+                     false, rep);
+}
+
+bool CrateWriter::PackPathVector(const std::vector<Path> &v, ValueRep *rep) {
+  std::vector<uint32_t> indices;
+  for (const auto &path : v) {
+    PathIndex idx;
+    if (!AddPath(path, &idx)) {
+      return false;
+    }
+    indices.push_back(idx.value);
+  }
+
+  return PackIndices(indices, CrateDataTypeId::CRATE_DATA_TYPE_PATH_VECTOR,
+                     false, rep);
+}
+
+bool CrateWriter::PackLayerOffsetVector(const std::vector<LayerOffset> &v,
+                                        ValueRep *rep) {
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(v.size()), &data);
+  for (const auto &offset : v) {
+    AppendPOD(offset._offset, &data);
+    AppendPOD(offset._scale, &data);
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_LAYER_OFFSET_VECTOR;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackVariantSelectionMap(const VariantSelectionMap &m,
+                                          ValueRep *rep) {
+  std::vector<uint8_t> data;
+  AppendPOD(uint64_t(m.size()), &data);
+  for (const auto &item : m) {
+    AppendPOD(AddString(item.first).value, &data);
+    AppendPOD(AddString(item.second).value, &data);
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_VARIANT_SELECTION_MAP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::EncodeIndex(const Path &path, std::vector<uint8_t> *dst) {
+  PathIndex idx;
+  if (!AddPath(path, &idx)) {
+    return false;
+  }
+  AppendPOD(idx.value, dst);
+  return true;
+}
+
+bool CrateWriter::EncodeReference(const Reference &ref,
+                                  std::vector<uint8_t> *dst) {
+  AppendPOD(AddString(ref.asset_path.GetAssetPath()).value, dst);
+  if (!EncodeIndex(ref.prim_path, dst)) {
+    return false;
+  }
+  AppendPOD(ref.layerOffset._offset, dst);
+  AppendPOD(ref.layerOffset._scale, dst);
+
+  // customData is serialized in place(not a ValueRep).
+  return EncodeDictionary(ref.customData, dst);
+}
+
+bool CrateWriter::EncodePayload(const Payload &p, std::vector<uint8_t> *dst) {
+  AppendPOD(AddString(p.asset_path.GetAssetPath()).value, dst);
+  if (!EncodeIndex(p.prim_path, dst)) {
+    return false;
+  }
+  AppendPOD(p.layerOffset._offset, dst);
+  AppendPOD(p.layerOffset._scale, dst);
+  return true;
+}
+
+bool CrateWriter::PackPayload(const Payload &p, ValueRep *rep) {
+  std::vector<uint8_t> data;
+  if (!EncodePayload(p, &data)) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_PAYLOAD;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+template <typename T, typename F>
+bool CrateWriter::EncodeListOp(const ListOp<T> &lop, F encode_items,
+                               std::vector<uint8_t> *dst) {
+  uint8_t bits{0};
+  bits |= lop.IsExplicit() ? ListOpHeader::IsExplicitBit : 0;
+  bits |= lop.HasExplicitItems() ? ListOpHeader::HasExplicitItemsBit : 0;
+  bits |= lop.HasAddedItems() ? ListOpHeader::HasAddedItemsBit : 0;
+  bits |= lop.HasPrependedItems() ? ListOpHeader::HasPrependedItemsBit : 0;
+  bits |= lop.HasAppendedItems() ? ListOpHeader::HasAppendedItemsBit : 0;
+  bits |= lop.HasDeletedItems() ? ListOpHeader::HasDeletedItemsBit : 0;
+  bits |= lop.HasOrderedItems() ? ListOpHeader::HasOrderedItemsBit : 0;
+  AppendPOD(bits, dst);
+
+  // Same order with the reader.
+  if (lop.HasExplicitItems() && !encode_items(lop.GetExplicitItems(), dst)) {
+    return false;
+  }
+  if (lop.HasAddedItems() && !encode_items(lop.GetAddedItems(), dst)) {
+    return false;
+  }
+  if (lop.HasPrependedItems() && !encode_items(lop.GetPrependedItems(), dst)) {
+    return false;
+  }
+  if (lop.HasAppendedItems() && !encode_items(lop.GetAppendedItems(), dst)) {
+    return false;
+  }
+  if (lop.HasDeletedItems() && !encode_items(lop.GetDeletedItems(), dst)) {
+    return false;
+  }
+  if (lop.HasOrderedItems() && !encode_items(lop.GetOrderedItems(), dst)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool CrateWriter::PackTokenListOp(const ListOp<value::token> &lop,
+                                  ValueRep *rep) {
+  std::vector<uint8_t> data;
+  bool ret = EncodeListOp(
+      lop,
+      [this](const std::vector<value::token> &items, std::vector<uint8_t> *dst) {
+        AppendPOD(uint64_t(items.size()), dst);
+        for (const auto &item : items) {
+          AppendPOD(AddToken(item.str()).value, dst);
+        }
+        return true;
+      },
+      &data);
+  if (!ret) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_TOKEN_LIST_OP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackStringListOp(const ListOp<std::string> &lop,
+                                   ValueRep *rep) {
+  std::vector<uint8_t> data;
+  bool ret = EncodeListOp(
+      lop,
+      [this](const std::vector<std::string> &items, std::vector<uint8_t> *dst) {
+        AppendPOD(uint64_t(items.size()), dst);
+        for (const auto &item : items) {
+          AppendPOD(AddString(item).value, dst);
+        }
+        return true;
+      },
+      &data);
+  if (!ret) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_STRING_LIST_OP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackPathListOp(const ListOp<Path> &lop, ValueRep *rep) {
+  std::vector<uint8_t> data;
+  bool ret = EncodeListOp(
+      lop,
+      [this](const std::vector<Path> &items, std::vector<uint8_t> *dst) {
+        AppendPOD(uint64_t(items.size()), dst);
+        for (const auto &item : items) {
+          if (!EncodeIndex(item, dst)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      &data);
+  if (!ret) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_PATH_LIST_OP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackReferenceListOp(const ListOp<Reference> &lop,
+                                      ValueRep *rep) {
+  std::vector<uint8_t> data;
+  bool ret = EncodeListOp(
+      lop,
+      [this](const std::vector<Reference> &items, std::vector<uint8_t> *dst) {
+        AppendPOD(uint64_t(items.size()), dst);
+        for (const auto &item : items) {
+          if (!EncodeReference(item, dst)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      &data);
+  if (!ret) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_REFERENCE_LIST_OP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackPayloadListOp(const ListOp<Payload> &lop,
+                                    ValueRep *rep) {
+  std::vector<uint8_t> data;
+  bool ret = EncodeListOp(
+      lop,
+      [this](const std::vector<Payload> &items, std::vector<uint8_t> *dst) {
+        AppendPOD(uint64_t(items.size()), dst);
+        for (const auto &item : items) {
+          if (!EncodePayload(item, dst)) {
+            return false;
+          }
+        }
+        return true;
+      },
+      &data);
+  if (!ret) {
+    return false;
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_PAYLOAD_LIST_OP;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+
+bool CrateWriter::EncodeDictionary(const CustomDataType &dict,
+                                   std::vector<uint8_t> *dst) {
+  // Layout
+  //
+  // - # of elements(uint64)
+  // - [key(StringIndex), offset to ValueRep(int64), ValueRep] * n
+  //
+  // The value data itself is written to the data section before.
+  AppendPOD(uint64_t(dict.size()), dst);
+
+  for (const auto &item : dict) {
+    ValueRep rep;
+    if (!PackValue(item.second.get_raw_value(), &rep)) {
+      PUSH_ERROR_AND_RETURN("Failed to pack the value of Dictionary element `"
+                            << item.first << "`");
+    }
+
+    AppendPOD(AddString(item.first).value, dst);
+    // The ValueRep follows right after the offset.
+    AppendPOD(int64_t(sizeof(int64_t)), dst);
+    AppendPOD(rep.GetData(), dst);
+  }
+
+  return true;
+}
+
+bool CrateWriter::PackDictionary(const CustomDataType &dict, ValueRep *rep) {
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_DICTIONARY;
+
+  if (dict.empty()) {
+    (*rep) = ValueRep(int32_t(ty), true, false, 0);
+    return true;
+  }
+
+  std::vector<uint8_t> data;
+  if (!EncodeDictionary(dict, &data)) {
+    return false;
+  }
+
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackTimeSamples(const value::TimeSamples &ts,
+                                  ValueRep *rep) {
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<value::Value> &values = ts.get_values();
+
+  std::vector<ValueRep> value_reps;
+  value_reps.reserve(times.size());
+
+  for (size_t i = 0; i < times.size(); i++) {
+    ValueRep sample_rep;
+    if (ts.is_blocked(i) ||
+        (values[i].type_id() == value::TypeId::TYPE_ID_VALUEBLOCK)) {
+      sample_rep = PackValueBlock();
+    } else if (!PackValue(values[i], &sample_rep)) {
+      PUSH_ERROR_AND_RETURN("Failed to pack TimeSamples value at time "
+                            << times[i]);
+    }
+    value_reps.push_back(sample_rep);
+  }
+
+  ValueRep times_rep;
+  if (!PackFloatArray(times, CrateDataTypeId::CRATE_DATA_TYPE_DOUBLE,
+                      &times_rep)) {
+    return false;
+  }
+
+  // Layout
+  //
+  // - offset to `times` ValueRep(int64)
+  // - `times` ValueRep(double[])
+  // - offset to values(int64)
+  // - # of values(uint64)
+  // - ValueRep * n
+  std::vector<uint8_t> data;
+  AppendPOD(int64_t(sizeof(int64_t)), &data);
+  AppendPOD(times_rep.GetData(), &data);
+  AppendPOD(int64_t(sizeof(int64_t)), &data);
+  AppendPOD(uint64_t(value_reps.size()), &data);
+  for (const auto &r : value_reps) {
+    AppendPOD(r.GetData(), &data);
+  }
+
+  auto ty = CrateDataTypeId::CRATE_DATA_TYPE_TIME_SAMPLES;
+  (*rep) = ValueRep(int32_t(ty), false, false, WriteValueData(ty, data));
+  return true;
+}
+
+bool CrateWriter::PackValue(const value::Value &v, ValueRep *rep) {
+  if (!rep) {
+    return false;
+  }
+
+  if (v.type_id() == value::TypeId::TYPE_ID_VALUEBLOCK) {
+    (*rep) = PackValueBlock();
+    return true;
+  }
+
+  if (v.type_id() == value::TypeId::TYPE_ID_TIMESAMPLES) {
+    if (const auto pv = v.as<value::TimeSamples>()) {
+      return PackTimeSamples(*pv, rep);
+    }
+    PUSH_ERROR_AND_RETURN("Internal error: failed to get TimeSamples.");
+  }
+
+  // token[] and Path[] have its own TypeId(no array bit).
+  // token[] value is stored as token array(VtArray<TfToken> in pxrUSD).
+  if (v.type_id() == value::TypeId::TYPE_ID_TOKEN_VECTOR) {
+    return PackArray(v, rep);
+  }
+
+  if (v.type_id() == value::TypeId::TYPE_ID_PATH_VECTOR) {
+    if (const auto pv = v.as<std::vector<Path>>()) {
+      return PackPathVector(*pv, rep);
+    }
+    PUSH_ERROR_AND_RETURN("Internal error: failed to get Path[].");
+  }
+
+  if (v.type_id() & value::TYPE_ID_1D_ARRAY_BIT) {
+    return PackArray(v, rep);
+  }
+
+  return PackScalar(v, rep);
+}
+
+bool CrateWriter::PackScalar(const value::Value &v, ValueRep *rep) {
+  using DT = CrateDataTypeId;
+
+#define PACK_INLINE_BITS(__tyid, __ty, __crate_ty)                \
+  case value::TypeId::__tyid: {                                   \
+    if (const auto pv = v.as<__ty>()) {                           \
+      uint32_t d{0};                                              \
+      memcpy(&d, pv, sizeof(__ty));                               \
+      (*rep) = ValueRep(int32_t(DT::__crate_ty), true, false, d); \
+      return true;                                                \
+    }                                                             \
+    break;                                                        \
+  }
+
+#define PACK_INLINABLE(__tyid, __ty, __crate_ty)            \
+  case value::TypeId::__tyid: {                             \
+    if (const auto pv = v.as<__ty>()) {                     \
+      return PackInlinableScalar(*pv, DT::__crate_ty, rep); \
+    }                                                       \
+    break;                                                  \
+  }
+
+#define PACK_RAW(__tyid, __ty, __crate_ty)            \
+  case value::TypeId::__tyid: {                       \
+    if (const auto pv = v.as<__ty>()) {               \
+      return PackRawScalar(*pv, DT::__crate_ty, rep); \
+    }                                                 \
+    break;                                            \
+  }
+
+  switch (v.underlying_type_id()) {
+    case value::TypeId::TYPE_ID_BOOL: {
+      if (const auto pv = v.as<bool>()) {
+        (*rep) = PackBool(*pv);
+        return true;
+      }
+      break;
+    }
+    PACK_INLINE_BITS(TYPE_ID_UCHAR, uint8_t, CRATE_DATA_TYPE_UCHAR)
+    PACK_INLINE_BITS(TYPE_ID_INT32, int32_t, CRATE_DATA_TYPE_INT)
+    PACK_INLINE_BITS(TYPE_ID_UINT32, uint32_t, CRATE_DATA_TYPE_UINT)
+    PACK_INLINE_BITS(TYPE_ID_HALF, value::half, CRATE_DATA_TYPE_HALF)
+    PACK_INLINE_BITS(TYPE_ID_FLOAT, float, CRATE_DATA_TYPE_FLOAT)
+    PACK_INLINABLE(TYPE_ID_INT64, int64_t, CRATE_DATA_TYPE_INT64)
+    PACK_INLINABLE(TYPE_ID_UINT64, uint64_t, CRATE_DATA_TYPE_UINT64)
+    PACK_INLINABLE(TYPE_ID_DOUBLE, double, CRATE_DATA_TYPE_DOUBLE)
+    PACK_INLINABLE(TYPE_ID_HALF2, value::half2, CRATE_DATA_TYPE_VEC2H)
+    PACK_INLINABLE(TYPE_ID_HALF3, value::half3, CRATE_DATA_TYPE_VEC3H)
+    PACK_INLINABLE(TYPE_ID_HALF4, value::half4, CRATE_DATA_TYPE_VEC4H)
+    PACK_INLINABLE(TYPE_ID_FLOAT2, value::float2, CRATE_DATA_TYPE_VEC2F)
+    PACK_INLINABLE(TYPE_ID_FLOAT3, value::float3, CRATE_DATA_TYPE_VEC3F)
+    PACK_INLINABLE(TYPE_ID_FLOAT4, value::float4, CRATE_DATA_TYPE_VEC4F)
+    PACK_INLINABLE(TYPE_ID_DOUBLE2, value::double2, CRATE_DATA_TYPE_VEC2D)
+    PACK_INLINABLE(TYPE_ID_DOUBLE3, value::double3, CRATE_DATA_TYPE_VEC3D)
+    PACK_INLINABLE(TYPE_ID_DOUBLE4, value::double4, CRATE_DATA_TYPE_VEC4D)
+    PACK_INLINABLE(TYPE_ID_INT2, value::int2, CRATE_DATA_TYPE_VEC2I)
+    PACK_INLINABLE(TYPE_ID_INT3, value::int3, CRATE_DATA_TYPE_VEC3I)
+    PACK_INLINABLE(TYPE_ID_INT4, value::int4, CRATE_DATA_TYPE_VEC4I)
+    PACK_INLINABLE(TYPE_ID_MATRIX2D, value::matrix2d, CRATE_DATA_TYPE_MATRIX2D)
+    PACK_INLINABLE(TYPE_ID_MATRIX3D, value::matrix3d, CRATE_DATA_TYPE_MATRIX3D)
+    PACK_INLINABLE(TYPE_ID_MATRIX4D, value::matrix4d, CRATE_DATA_TYPE_MATRIX4D)
+    PACK_RAW(TYPE_ID_QUATH, value::quath, CRATE_DATA_TYPE_QUATH)
+    PACK_RAW(TYPE_ID_QUATF, value::quatf, CRATE_DATA_TYPE_QUATF)
+    PACK_RAW(TYPE_ID_QUATD, value::quatd, CRATE_DATA_TYPE_QUATD)
+    case value::TypeId::TYPE_ID_TIMECODE: {
+      if (const auto pv = v.as<value::timecode>()) {
+        return PackInlinableScalar(pv->value, DT::CRATE_DATA_TYPE_DOUBLE, rep);
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_TOKEN: {
+      if (const auto pv = v.as<value::token>()) {
+        (*rep) = PackToken(*pv);
+        return true;
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_STRING: {
+      if (const auto pv = v.as<std::string>()) {
+        (*rep) = PackString(*pv);
+        return true;
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_STRING_DATA: {
+      if (const auto pv = v.as<value::StringData>()) {
+        (*rep) = PackString(pv->value);
+        return true;
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_ASSET_PATH: {
+      if (const auto pv = v.as<value::AssetPath>()) {
+        // Inlined AssetPath is encoded as TokenIndex.
+        (*rep) = ValueRep(int32_t(DT::CRATE_DATA_TYPE_ASSET_PATH), true, false,
+                          AddToken(pv->GetAssetPath()).value);
+        return true;
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_CUSTOMDATA: {
+      if (const auto pv = v.as<CustomDataType>()) {
+        return PackDictionary(*pv, rep);
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_DICT: {
+      if (const auto pv = v.as<value::dict>()) {
+        if (auto d = TryEncodeInline(*pv)) {
+          (*rep) = ValueRep(int32_t(DT::CRATE_DATA_TYPE_DICTIONARY), true,
+                            false, d.value());
+          return true;
+        }
+        PUSH_ERROR_AND_RETURN("Non-empty `dict` type is not supported. Use `dictionary`(CustomDataType) instead.");
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+#undef PACK_INLINE_BITS
+#undef PACK_INLINABLE
+#undef PACK_RAW
+
+  PUSH_ERROR_AND_RETURN("Unsupported value type for Crate: " << v.type_name());
+}
+
+bool CrateWriter::PackArray(const value::Value &v, ValueRep *rep) {
+  using DT = CrateDataTypeId;
+
+#define PACK_ARRAY(__tyid, __ty, __crate_ty, __func)              \
+  case value::TypeId::__tyid: {                                   \
+    if (const auto pv = v.as<std::vector<__ty>>()) {              \
+      return __func(*pv, DT::__crate_ty, rep);                    \
+    }                                                             \
+    break;                                                        \
+  }
+
+  switch (v.underlying_type_id() & (~value::TYPE_ID_1D_ARRAY_BIT)) {
+    case value::TypeId::TYPE_ID_BOOL: {
+      if (const auto pv = v.as<std::vector<bool>>()) {
+        // bool is encoded as 8bit value.
+        std::vector<uint8_t> data(pv->size());
+        for (size_t i = 0; i < pv->size(); i++) {
+          data[i] = (*pv)[i] ? 1 : 0;
+        }
+        return PackRawArray(data, DT::CRATE_DATA_TYPE_BOOL, rep);
+      }
+      break;
+    }
+    PACK_ARRAY(TYPE_ID_INT32, int32_t, CRATE_DATA_TYPE_INT, PackIntArray)
+    PACK_ARRAY(TYPE_ID_UINT32, uint32_t, CRATE_DATA_TYPE_UINT, PackIntArray)
+    PACK_ARRAY(TYPE_ID_INT64, int64_t, CRATE_DATA_TYPE_INT64, PackIntArray)
+    PACK_ARRAY(TYPE_ID_UINT64, uint64_t, CRATE_DATA_TYPE_UINT64, PackIntArray)
+    PACK_ARRAY(TYPE_ID_HALF, value::half, CRATE_DATA_TYPE_HALF, PackFloatArray)
+    PACK_ARRAY(TYPE_ID_FLOAT, float, CRATE_DATA_TYPE_FLOAT, PackFloatArray)
+    PACK_ARRAY(TYPE_ID_DOUBLE, double, CRATE_DATA_TYPE_DOUBLE, PackFloatArray)
+    PACK_ARRAY(TYPE_ID_HALF2, value::half2, CRATE_DATA_TYPE_VEC2H, PackRawArray)
+    PACK_ARRAY(TYPE_ID_HALF3, value::half3, CRATE_DATA_TYPE_VEC3H, PackRawArray)
+    PACK_ARRAY(TYPE_ID_HALF4, value::half4, CRATE_DATA_TYPE_VEC4H, PackRawArray)
+    PACK_ARRAY(TYPE_ID_FLOAT2, value::float2, CRATE_DATA_TYPE_VEC2F, PackRawArray)
+    PACK_ARRAY(TYPE_ID_FLOAT3, value::float3, CRATE_DATA_TYPE_VEC3F, PackRawArray)
+    PACK_ARRAY(TYPE_ID_FLOAT4, value::float4, CRATE_DATA_TYPE_VEC4F, PackRawArray)
+    PACK_ARRAY(TYPE_ID_DOUBLE2, value::double2, CRATE_DATA_TYPE_VEC2D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_DOUBLE3, value::double3, CRATE_DATA_TYPE_VEC3D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_DOUBLE4, value::double4, CRATE_DATA_TYPE_VEC4D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_INT2, value::int2, CRATE_DATA_TYPE_VEC2I, PackRawArray)
+    PACK_ARRAY(TYPE_ID_INT3, value::int3, CRATE_DATA_TYPE_VEC3I, PackRawArray)
+    PACK_ARRAY(TYPE_ID_INT4, value::int4, CRATE_DATA_TYPE_VEC4I, PackRawArray)
+    PACK_ARRAY(TYPE_ID_MATRIX2D, value::matrix2d, CRATE_DATA_TYPE_MATRIX2D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_MATRIX3D, value::matrix3d, CRATE_DATA_TYPE_MATRIX3D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_MATRIX4D, value::matrix4d, CRATE_DATA_TYPE_MATRIX4D, PackRawArray)
+    PACK_ARRAY(TYPE_ID_QUATH, value::quath, CRATE_DATA_TYPE_QUATH, PackRawArray)
+    PACK_ARRAY(TYPE_ID_QUATF, value::quatf, CRATE_DATA_TYPE_QUATF, PackRawArray)
+    PACK_ARRAY(TYPE_ID_QUATD, value::quatd, CRATE_DATA_TYPE_QUATD, PackRawArray)
+    case value::TypeId::TYPE_ID_TIMECODE: {
+      if (const auto pv = v.as<std::vector<value::timecode>>()) {
+        std::vector<double> data(pv->size());
+        for (size_t i = 0; i < pv->size(); i++) {
+          data[i] = (*pv)[i].value;
+        }
+        return PackFloatArray(data, DT::CRATE_DATA_TYPE_DOUBLE, rep);
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_TOKEN_VECTOR:
+    case value::TypeId::TYPE_ID_TOKEN: {
+      if (const auto pv = v.as<std::vector<value::token>>()) {
+        if (pv->empty()) {
+          (*rep) = ValueRep(int32_t(DT::CRATE_DATA_TYPE_TOKEN), false, true, 0);
+          return true;
+        }
+        std::vector<uint32_t> indices;
+        for (const auto &tok : *pv) {
+          indices.push_back(AddToken(tok.str()).value);
+        }
+        return PackIndices(indices, DT::CRATE_DATA_TYPE_TOKEN, true, rep);
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_ASSET_PATH: {
+      if (const auto pv = v.as<std::vector<value::AssetPath>>()) {
+        if (pv->empty()) {
+          (*rep) = ValueRep(int32_t(DT::CRATE_DATA_TYPE_ASSET_PATH), false, true, 0);
+          return true;
+        }
+        // AssetPath array is encoded as StringIndex.
+        std::vector<uint32_t> indices;
+        for (const auto &apath : *pv) {
+          indices.push_back(AddString(apath.GetAssetPath()).value);
+        }
+        return PackIndices(indices, DT::CRATE_DATA_TYPE_ASSET_PATH, true, rep);
+      }
+      break;
+    }
+    case value::TypeId::TYPE_ID_STRING:
+    case value::TypeId::TYPE_ID_STRING_DATA: {
+      std::vector<uint32_t> indices;
+      if (const auto pv = v.as<std::vector<std::string>>()) {
+        for (const auto &s : *pv) {
+          indices.push_back(AddString(s).value);
+        }
+      } else if (const auto pvd = v.as<std::vector<value::StringData>>()) {
+        for (const auto &s : *pvd) {
+          indices.push_back(AddString(s.value).value);
+        }
+      } else {
+        break;
+      }
+
+      if (indices.empty()) {
+        // CrateReader cannot read zero-length string array.
+        PUSH_ERROR_AND_RETURN("Empty string[] cannot be stored in Crate.");
+      }
+      return PackIndices(indices, DT::CRATE_DATA_TYPE_STRING, true, rep);
+    }
+    default:
+      break;
+  }
+
+#undef PACK_ARRAY
+
+  PUSH_ERROR_AND_RETURN("Unsupported array value type for Crate: " << v.type_name());
+}
+
+// -- Sections -----------------------------------------------------------------
+
+namespace {
+
+Section MakeSection(const char *name, size_t start, size_t end) {
+  Section s;
+  strncpy(s.name, name, kSectionNameMaxLength);
+  s.start = int64_t(start);
+  s.size = int64_t(end - start);
+  return s;
+}
+
+} // namespace
+
+bool CrateWriter::WriteTokensSection() {
+  size_t start = _buf.size();
+
+  // Null-terminated strings.
+  std::vector<char> chars;
+  for (const auto &tok : _tokens) {
+    chars.insert(chars.end(), tok.begin(), tok.end());
+    chars.push_back('\0');
+  }
+
+  // The reader requires uncompressedSize >= 3 + num_tokens(and >= 4).
+  // Trailing null characters are ignored.
+  while (chars.size() < (std::max)(size_t(4), _tokens.size() + 3)) {
+    chars.push_back('\0');
+  }
+
+  std::vector<char> compressed(LZ4Compression::GetCompressedBufferSize(chars.size()));
+  std::string err;
+  size_t compressed_size = LZ4Compression::CompressToBuffer(
+      chars.data(), compressed.data(), chars.size(), &err);
+  if ((compressed_size == 0) || (compressed_size == ~size_t(0))) {
+    PUSH_ERROR_AND_RETURN("Failed to compress tokens. " << err);
+  }
+
+  AppendPOD(uint64_t(_tokens.size()), &_buf);
+  AppendPOD(uint64_t(chars.size()), &_buf);
+  AppendPOD(uint64_t(compressed_size), &_buf);
+  AppendBytes(compressed.data(), compressed_size, &_buf);
+
+  _sections.push_back(MakeSection("TOKENS", start, _buf.size()));
+  return true;
+}
+
+bool CrateWriter::WriteStringsSection() {
+  size_t start = _buf.size();
+
+  AppendPOD(uint64_t(_strings.size()), &_buf);
+  for (const auto &idx : _strings) {
+    AppendPOD(idx.value, &_buf);
+  }
+
+  _sections.push_back(MakeSection("STRINGS", start, _buf.size()));
+  return true;
+}
+
+bool CrateWriter::WriteFieldsSection() {
+  size_t start = _buf.size();
+
+  AppendPOD(uint64_t(_fields.size()), &_buf);
+
+  if (_fields.size()) {
+    std::vector<uint32_t> token_indices(_fields.size());
+    std::vector<uint64_t> reps(_fields.size());
+    for (size_t i = 0; i < _fields.size(); i++) {
+      token_indices[i] = _fields[i].token_index.value;
+      reps[i] = _fields[i].value_rep.GetData();
+    }
+
+    if (!WriteCompressedInts(token_indices, &_buf)) {
+      return false;
+    }
+
+    // ValueReps are LZ4 compressed.
+    size_t reps_bytes = reps.size() * sizeof(uint64_t);
+    std::vector<char> compressed(LZ4Compression::GetCompressedBufferSize(reps_bytes));
+    std::string err;
+    size_t compressed_size = LZ4Compression::CompressToBuffer(
+        reinterpret_cast<const char *>(reps.data()), compressed.data(),
+        reps_bytes, &err);
+    if ((compressed_size == 0) || (compressed_size == ~size_t(0))) {
+      PUSH_ERROR_AND_RETURN("Failed to compress Field ValueReps. " << err);
+    }
+
+    AppendPOD(uint64_t(compressed_size), &_buf);
+    AppendBytes(compressed.data(), compressed_size, &_buf);
+  }
+
+  _sections.push_back(MakeSection("FIELDS", start, _buf.size()));
+  return true;
+}
+
+bool CrateWriter::WriteFieldSetsSection() {
+  size_t start = _buf.size();
+
+  std::vector<uint32_t> indices(_fieldsets.size());
+  for (size_t i = 0; i < _fieldsets.size(); i++) {
+    indices[i] = _fieldsets[i].value;
+  }
+
+  AppendPOD(uint64_t(indices.size()), &_buf);
+  if (!WriteCompressedInts(indices, &_buf)) {
+    return false;
+  }
+
+  _sections.push_back(MakeSection("FIELDSETS", start, _buf.size()));
+  return true;
+}
+
+void CrateWriter::EncodePaths(const std::vector<uint32_t> &siblings,
+                              std::vector<uint32_t> *path_indices,
+                              std::vector<int32_t> *element_token_indices,
+                              std::vector<int32_t> *jumps) {
+  // Same encoding as pxrUSD's `_WriteCompressedPathData`: paths are stored in
+  // depth-first order, and `jump` tells where the next sibling is.
+  //
+  //   -2 : leaf(no child, no sibling)
+  //   -1 : has child only(child is the next element)
+  //    0 : has sibling only(sibling is the next element)
+  //   >0 : has both. child is the next element, sibling is at (this + jump)
+  for (size_t i = 0; i < siblings.size(); i++) {
+    const uint32_t idx = siblings[i];
+    const PathNode &node = _path_nodes[idx];
+
+    size_t this_index = path_indices->size();
+    path_indices->push_back(idx);
+    element_token_indices->push_back(node.element_token);
+    jumps->push_back(0);
+
+    bool has_child = !node.children.empty();
+    bool has_sibling = (i + 1) < siblings.size();
+
+    if (has_child) {
+      EncodePaths(node.children, path_indices, element_token_indices, jumps);
+    }
+
+    if (has_child && has_sibling) {
+      (*jumps)[this_index] = int32_t(path_indices->size() - this_index);
+    } else if (has_child) {
+      (*jumps)[this_index] = -1;
+    } else if (has_sibling) {
+      (*jumps)[this_index] = 0;
+    } else {
+      (*jumps)[this_index] = -2;
+    }
+  }
+}
+
+bool CrateWriter::WritePathsSection() {
+  size_t start = _buf.size();
+
+  std::vector<uint32_t> path_indices;
+  std::vector<int32_t> element_token_indices;
+  std::vector<int32_t> jumps;
+
+  // Root path(index 0)
+  EncodePaths({0}, &path_indices, &element_token_indices, &jumps);
+
+  AppendPOD(uint64_t(_path_nodes.size()), &_buf);
+  AppendPOD(uint64_t(path_indices.size()), &_buf);
+
+  if (!WriteCompressedInts(path_indices, &_buf)) {
+    return false;
+  }
+  if (!WriteCompressedInts(element_token_indices, &_buf)) {
+    return false;
+  }
+  if (!WriteCompressedInts(jumps, &_buf)) {
+    return false;
+  }
+
+  _sections.push_back(MakeSection("PATHS", start, _buf.size()));
+  return true;
+}
+
+bool CrateWriter::WriteSpecsSection() {
+  size_t start = _buf.size();
+
+  std::vector<uint32_t> path_indices(_specs.size());
+  std::vector<uint32_t> fieldset_indices(_specs.size());
+  std::vector<uint32_t> spec_types(_specs.size());
+  for (size_t i = 0; i < _specs.size(); i++) {
+    path_indices[i] = _specs[i].path_index.value;
+    fieldset_indices[i] = _specs[i].fieldset_index.value;
+    spec_types[i] = uint32_t(_specs[i].spec_type);
+  }
+
+  AppendPOD(uint64_t(_specs.size()), &_buf);
+
+  if (!WriteCompressedInts(path_indices, &_buf)) {
+    return false;
+  }
+  if (!WriteCompressedInts(fieldset_indices, &_buf)) {
+    return false;
+  }
+  if (!WriteCompressedInts(spec_types, &_buf)) {
+    return false;
+  }
+
+  _sections.push_back(MakeSection("SPECS", start, _buf.size()));
+  return true;
+}
+
+bool CrateWriter::WriteTOC() {
+  uint64_t toc_offset = uint64_t(_buf.size());
+
+  AppendPOD(uint64_t(_sections.size()), &_buf);
+  for (const auto &section : _sections) {
+    AppendBytes(section.name, sizeof(section.name), &_buf);
+    AppendPOD(section.start, &_buf);
+    AppendPOD(section.size, &_buf);
+  }
+
+  // Bootstrap
+  memcpy(_buf.data(), "PXR-USDC", 8);
+  memcpy(_buf.data() + 8, kVersion, 3);
+  memcpy(_buf.data() + 16, &toc_offset, sizeof(uint64_t));
+
+  return true;
+}
+
+bool CrateWriter::Write(std::vector<uint8_t> *output) {
+  if (!output) {
+    PUSH_ERROR_AND_RETURN("`output` is nullptr.");
+  }
+
+  if (_specs.empty()) {
+    PUSH_ERROR_AND_RETURN("No Spec to write.");
+  }
+
+  if (!_sections.empty()) {
+    PUSH_ERROR_AND_RETURN("`Write` can be called only once.");
+  }
+
+  if (!WriteTokensSection()) {
+    return false;
+  }
+  if (!WriteStringsSection()) {
+    return false;
+  }
+  if (!WriteFieldsSection()) {
+    return false;
+  }
+  if (!WriteFieldSetsSection()) {
+    return false;
+  }
+  if (!WritePathsSection()) {
+    return false;
+  }
+  if (!WriteSpecsSection()) {
+    return false;
+  }
+  if (!WriteTOC()) {
+    return false;
+  }
+
+  (*output) = std::move(_buf);
+  _buf.clear();
+
+  return true;
 }
 
-} // namespace crate 
+} // namespace crate
 } // namespace tinyusdz
@@ -5,10 +5,243 @@
 //
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "crate-format.hh"
+#include "prim-types.hh"
+#include "value-types.hh"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Weverything"
+#endif
+
+#include "nonstd/optional.hpp"
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
 namespace tinyusdz {
 namespace crate {
 
+//
+// Try to encode a value into 4 bytes of `Inlined` ValueRep payload.
+// Return nullopt when the value cannot be inlined.
+//
+nonstd::optional<uint32_t> TryEncodeInline(double v);
+nonstd::optional<uint32_t> TryEncodeInline(uint64_t v);
+nonstd::optional<uint32_t> TryEncodeInline(int64_t v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::float4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::double4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::half2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::half3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::half4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::int2 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::int3 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::int4 &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix2d &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix3d &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::matrix4d &v);
+nonstd::optional<uint32_t> TryEncodeInline(const value::dict &v);
+
+struct CrateWriterConfig {
+  // Compress int arrays and integral(or low-cardinality) float arrays whose
+  // length is kMinCompressedArraySize or more, as done in pxrUSD.
+  bool compressArrays = true;
+
+  // Share identical non-inlined value data(e.g. the same `points` array
+  // used in multiple Prims) in the file.
+  bool dedupValues = true;
+};
+
+///
+/// Crate(binary data) writer
+///
+/// Usage:
+///
+///   1. Register every Spec path with `AddPath` in the traversal order
+///      (children order of the path tree follows the registration order).
+///   2. Pack field values with `Pack*` to get `ValueRep`s, then `AddSpec`.
+///   3. `Write` to serialize the data into a memory.
+///
+/// Tokens, strings, paths, fields, fieldsets and non-inlined value data are
+/// deduplicated.
+///
+class CrateWriter {
+ public:
+  using FieldValueRepPairVector = std::vector<std::pair<std::string, ValueRep>>;
+
+  CrateWriter(const CrateWriterConfig &config = CrateWriterConfig());
+
+  TokenIndex AddToken(const std::string &token);
+  StringIndex AddString(const std::string &str);
+
+  ///
+  /// Register `path` and its ancestors to the path tree.
+  /// An empty(invalid) path is also allowed(e.g. `primPath` of Reference),
+  /// but it is not encoded into the path tree.
+  ///
+  /// Return false when `path` is a relative path.
+  ///
+  bool AddPath(const Path &path, PathIndex *index);
+
+  FieldIndex AddField(const Field &field);
+  FieldSetIndex AddFieldSet(const std::vector<FieldIndex> &fieldset);
+
+  bool AddSpec(const Path &path, SpecType spec_type,
+               const FieldValueRepPairVector &fields);
+
+  ///
+  /// Pack a value into ValueRep. Non-inlinable value is written to the data
+  /// section.
+  ///
+  /// Supported value types are:
+  ///
+  /// - Attribute value types(scalar and 1D array. Role types are stored with
+  ///   its underlying type. e.g. `color3f` -> `float3`)
+  /// - token, string, asset path, dictionary, token[], string[], double[]
+  /// - value::TimeSamples
+  /// - ValueBlock
+  ///
+  bool PackValue(const value::Value &v, ValueRep *rep);
+
+  bool PackTimeSamples(const value::TimeSamples &ts, ValueRep *rep);
+  bool PackDictionary(const CustomDataType &dict, ValueRep *rep);
+
+  ValueRep PackSpecifier(Specifier spec);
+  ValueRep PackVariability(Variability variability);
+  ValueRep PackToken(const value::token &tok);
+  ValueRep PackString(const std::string &str);
+  ValueRep PackBool(bool b);
+  ValueRep PackValueBlock();
+
+  bool PackTokenVector(const std::vector<value::token> &v, ValueRep *rep);
+  bool PackStringVector(const std::vector<std::string> &v, ValueRep *rep);
+  bool PackPathVector(const std::vector<Path> &v, ValueRep *rep);
+  bool PackLayerOffsetVector(const std::vector<LayerOffset> &v, ValueRep *rep);
+  bool PackVariantSelectionMap(const VariantSelectionMap &m, ValueRep *rep);
+  bool PackPayload(const Payload &p, ValueRep *rep);
+
+  bool PackTokenListOp(const ListOp<value::token> &lop, ValueRep *rep);
+  bool PackStringListOp(const ListOp<std::string> &lop, ValueRep *rep);
+  bool PackPathListOp(const ListOp<Path> &lop, ValueRep *rep);
+  bool PackReferenceListOp(const ListOp<Reference> &lop, ValueRep *rep);
+  bool PackPayloadListOp(const ListOp<Payload> &lop, ValueRep *rep);
+
+  ///
+  /// Serialize Crate data.
+  ///
+  bool Write(std::vector<uint8_t> *output);
+
+  const std::string &GetError() const { return _err; }
+  const std::string &GetWarning() const { return _warn; }
+
+ private:
+  struct PathNode {
+    int32_t element_token{0};  // negative for property element.
+    std::vector<uint32_t> children;
+  };
+
+  // Append bytes to the data section and return its offset.
+  uint64_t WriteValueData(CrateDataTypeId ty, const std::vector<uint8_t> &data);
+
+  bool PackArray(const value::Value &v, ValueRep *rep);
+  bool PackScalar(const value::Value &v, ValueRep *rep);
+
+  // Try `TryEncodeInline` first, then write the value data.
+  template <typename T>
+  bool PackInlinableScalar(const T &v, CrateDataTypeId ty, ValueRep *rep);
+
+  template <typename T>
+  bool PackRawScalar(const T &v, CrateDataTypeId ty, ValueRep *rep);
+
+  template <typename T>
+  bool PackRawArray(const std::vector<T> &v, CrateDataTypeId ty,
+                    ValueRep *rep);
+
+  template <typename T>
+  bool PackIntArray(const std::vector<T> &v, CrateDataTypeId ty,
+                    ValueRep *rep);
+
+  // T = half, float or double
+  template <typename T>
+  bool PackFloatArray(const std::vector<T> &v, CrateDataTypeId ty,
+                      ValueRep *rep);
+
+  // Write `n` + uint32 indices. `is_array` sets Array bit of ValueRep.
+  bool PackIndices(const std::vector<uint32_t> &indices, CrateDataTypeId ty,
+                   bool is_array, ValueRep *rep);
+
+  bool EncodeIndex(const Path &path, std::vector<uint8_t> *dst);
+  bool EncodeDictionary(const CustomDataType &dict, std::vector<uint8_t> *dst);
+  bool EncodeReference(const Reference &ref, std::vector<uint8_t> *dst);
+  bool EncodePayload(const Payload &p, std::vector<uint8_t> *dst);
+
+  template <typename T, typename F>
+  bool EncodeListOp(const ListOp<T> &lop, F encode_items,
+                    std::vector<uint8_t> *dst);
+
+  bool WriteTokensSection();
+  bool WriteStringsSection();
+  bool WriteFieldsSection();
+  bool WriteFieldSetsSection();
+  bool WritePathsSection();
+  bool WriteSpecsSection();
+  bool WriteTOC();
+
+  template <typename Int>
+  bool WriteCompressedInts(const std::vector<Int> &ints,
+                           std::vector<uint8_t> *dst);
+
+  void EncodePaths(const std::vector<uint32_t> &siblings,
+                   std::vector<uint32_t> *path_indices,
+                   std::vector<int32_t> *element_token_indices,
+                   std::vector<int32_t> *jumps);
+
+  void PushError(const std::string &s) { _err += s; }
+  void PushWarn(const std::string &s) { _warn += s; }
+
+  CrateWriterConfig _config;
+
+  std::vector<std::string> _tokens;
+  std::unordered_map<std::string, uint32_t> _token_to_index;
+
+  std::vector<TokenIndex> _strings;
+  std::unordered_map<std::string, uint32_t> _string_to_index;
+
+  // path index == index of `_path_nodes`
+  std::vector<PathNode> _path_nodes;
+  std::unordered_map<std::string, uint32_t> _path_to_index;
+  nonstd::optional<uint32_t> _empty_path_index;
+
+  std::vector<Field> _fields;
+  std::unordered_map<Field, uint32_t, FieldHasher, FieldKeyEqual>
+      _field_to_index;
+
+  std::vector<FieldIndex> _fieldsets;  // flattened. Each set is terminated by ~0
+  std::unordered_map<std::vector<FieldIndex>, uint32_t, FieldSetHasher>
+      _fieldset_to_index;
+
+  std::vector<Spec> _specs;
+
+  // Header + value data + sections.
+  std::vector<uint8_t> _buf;
+  std::unordered_map<std::string, uint64_t> _value_data_to_offset;
+
+  std::vector<Section> _sections;
+
+  std::string _err;
+  std::string _warn;
+};
 
 } // namespace crate
 } // namespace tinyusdz
-
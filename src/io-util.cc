@@ -2,6 +2,9 @@
 // Copyright 2022 - 2023, Syoyo Fujita.
 // Copyright 2023 - Present, Light Transport Entertainment Inc.
 //
+#include <sys/stat.h>
+#include <sys/types.h>
+
 #include <algorithm>
 #include <fstream>
 
@@ -894,6 +897,35 @@ bool FileExists(const std::string &filepath, void *userdata) {
   return ret;
 }
 
+bool GetFileModificationStamp(const std::string &filepath, uint64_t *mtime,
+                              uint64_t *size) {
+  if (!mtime || !size) {
+    return false;
+  }
+
+#if defined(TINYUSDZ_ANDROID_LOAD_FROM_ASSETS)
+  // Assets in APK are read-only.
+  (void)filepath;
+  return false;
+#elif defined(_WIN32)
+  struct _stat64 st;
+  if (_wstat64(UTF8ToWchar(filepath).c_str(), &st) != 0) {
+    return false;
+  }
+  (*mtime) = uint64_t(st.st_mtime);
+  (*size) = uint64_t(st.st_size);
+  return true;
+#else
+  struct stat st;
+  if (stat(filepath.c_str(), &st) != 0) {
+    return false;
+  }
+  (*mtime) = uint64_t(st.st_mtime);
+  (*size) = uint64_t(st.st_size);
+  return true;
+#endif
+}
+
 std::string FindFile(const std::string &filename,
                      const std::vector<std::string> &search_paths) {
   // TODO: Use ghc filesystem?
@@ -102,6 +102,14 @@ std::string ExpandFilePath(const std::string &filepath,
 
 bool FileExists(const std::string &filepath, void *userdata = nullptr);
 
+///
+/// Get the last modification time(seconds since epoch) and the size of a file.
+/// Returns false when the file does not exist or the information is not
+/// available on the system.
+///
+bool GetFileModificationStamp(const std::string &filepath, uint64_t *mtime,
+                              uint64_t *size);
+
 ///
 /// Find file from search paths.
 /// Returns empty string if a file is not found.
@@ -3,6 +3,7 @@
 #include "performance.hh"
 
 #include <chrono>
+#include <sstream>
 
 namespace tinyusdz {
 namespace performance {
@@ -11,10 +12,107 @@ double now() {
   auto t = std::chrono::system_clock::now();
 
   // to milliseconds.
-  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()); 
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch());
 
   return double(ms.count());
 }
 
+namespace {
+
+double MonotonicNowMs() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(t).count();
+}
+
+std::string EscapeJSONString(const std::string &s) {
+  std::string dst;
+  for (char c : s) {
+    if ((c == '"') || (c == '\\')) {
+      dst += '\\';
+      dst += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      dst += ' ';
+    } else {
+      dst += c;
+    }
+  }
+  return dst;
+}
+
+}  // namespace
+
+LoadCounts &LoadCounts::operator+=(const LoadCounts &rhs) {
+  num_prims += rhs.num_prims;
+  num_attributes += rhs.num_attributes;
+  num_relationships += rhs.num_relationships;
+  num_timesamples += rhs.num_timesamples;
+  num_arrays += rhs.num_arrays;
+  array_bytes += rhs.array_bytes;
+  return *this;
+}
+
+double LoadStats::total_ms(const std::string &name) const {
+  double t = 0.0;
+  for (const auto &phase : phases) {
+    if (phase.name == name) {
+      t += phase.duration_ms;
+    }
+  }
+  return t;
+}
+
+size_t LoadStats::begin_phase(const char *name) {
+  PhaseTiming phase;
+  phase.name = name;
+  phase.depth = _depth++;
+  phase.start_ms = MonotonicNowMs();
+  phases.emplace_back(std::move(phase));
+  return phases.size() - 1;
+}
+
+void LoadStats::end_phase(size_t idx) {
+  if (_depth > 0) {
+    _depth--;
+  }
+
+  if (idx < phases.size()) {
+    phases[idx].duration_ms = MonotonicNowMs() - phases[idx].start_ms;
+  }
+}
+
+std::string ToChromeTraceJSON(const LoadStats &stats) {
+  std::stringstream ss;
+  ss.precision(15);
+
+  ss << "{\"traceEvents\":[";
+  for (size_t i = 0; i < stats.phases.size(); i++) {
+    const PhaseTiming &phase = stats.phases[i];
+    if (i > 0) {
+      ss << ",";
+    }
+    // Complete event. Timestamps are in [us].
+    ss << "\n{\"name\":\"" << EscapeJSONString(phase.name)
+       << "\",\"cat\":\"tinyusdz\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+       << ",\"ts\":" << (phase.start_ms * 1000.0)
+       << ",\"dur\":" << (phase.duration_ms * 1000.0) << "}";
+  }
+  ss << "\n],\n";
+
+  ss << "\"displayTimeUnit\":\"ms\",\n";
+  ss << "\"otherData\":{";
+  ss << "\"bytes_read\":" << stats.bytes_read;
+  ss << ",\"bytes_decompressed\":" << stats.bytes_decompressed;
+  ss << ",\"num_prims\":" << stats.counts.num_prims;
+  ss << ",\"num_attributes\":" << stats.counts.num_attributes;
+  ss << ",\"num_relationships\":" << stats.counts.num_relationships;
+  ss << ",\"num_timesamples\":" << stats.counts.num_timesamples;
+  ss << ",\"num_arrays\":" << stats.counts.num_arrays;
+  ss << ",\"array_bytes\":" << stats.counts.array_bytes;
+  ss << ",\"peak_memory_estimate\":" << stats.peak_memory_estimate;
+  ss << "}}\n";
+
+  return ss.str();
+}
+
 } // namespace performance
 } // namespace tinyusdz
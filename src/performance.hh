@@ -1,15 +1,117 @@
 // SPDX-License-Identifier: Apache 2.0
 // Copyright 2022 - Present, Light Transport Entertainment, Inc.
-// 
-// Simple timing utility
+//
+// Simple timing utility and load statistics.
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace tinyusdz {
 namespace performance {
 
 // Return current time in [ms]
 double now();
 
+///
+/// Wall time of a phase(e.g. "usdc:read_paths").
+///
+struct PhaseTiming {
+  std::string name;
+  double start_ms{0.0};     // Monotonic clock. The origin is arbitrary.
+  double duration_ms{0.0};
+  uint32_t depth{0};        // Nesting level. 0 = toplevel phase.
+};
+
+///
+/// The number of objects loaded.
+///
+struct LoadCounts {
+  uint64_t num_prims{0};
+  uint64_t num_attributes{0};
+  uint64_t num_relationships{0};
+  uint64_t num_timesamples{0};  // Sum of the number of samples.
+  uint64_t num_arrays{0};       // Array values(default value or time sample).
+  uint64_t array_bytes{0};      // Approximated byte size of array values.
+
+  LoadCounts &operator+=(const LoadCounts &rhs);
+};
+
+///
+/// Statistics of USD load and Tydra conversion.
+///
+/// Pass a pointer to LoadStats(e.g. `USDLoadOptions::stats`) to collect
+/// statistics. Nothing is recorded when the pointer is nullptr, so the cost is
+/// negligible when statistics are not requested.
+///
+/// Statistics are accumulated, so the same LoadStats can be used for multiple
+/// loads(e.g. Load USD, then convert it to RenderScene). Not thread-safe.
+///
+struct LoadStats {
+  std::vector<PhaseTiming> phases;  // In the order of start time.
+
+  uint64_t bytes_read{0};          // Bytes of USDA/USDC data parsed.
+  uint64_t bytes_decompressed{0};  // USDC: Bytes produced by decompression.
+
+  LoadCounts counts;
+
+  // Estimated peak memory usage of decoded data in bytes(input data is not
+  // included).
+  uint64_t peak_memory_estimate{0};
+
+  ///
+  /// Sum of durations of phases with `name`.
+  ///
+  double total_ms(const std::string &name) const;
+
+  void update_peak_memory(uint64_t bytes) {
+    if (bytes > peak_memory_estimate) {
+      peak_memory_estimate = bytes;
+    }
+  }
+
+  void clear() { (*this) = LoadStats(); }
+
+  // Used by ScopedPhase.
+  size_t begin_phase(const char *name);
+  void end_phase(size_t idx);
+
+ private:
+  uint32_t _depth{0};
+};
+
+///
+/// Record the wall time of the current scope as a phase. No-op when `stats` is
+/// nullptr.
+///
+class ScopedPhase {
+ public:
+  ScopedPhase(LoadStats *stats, const char *name) : _stats(stats) {
+    if (_stats) {
+      _idx = _stats->begin_phase(name);
+    }
+  }
+
+  ~ScopedPhase() {
+    if (_stats) {
+      _stats->end_phase(_idx);
+    }
+  }
+
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+ private:
+  LoadStats *_stats{nullptr};
+  size_t _idx{0};
+};
+
+///
+/// Export phases as Chrome trace event JSON(viewable in chrome://tracing or
+/// Perfetto). Counters are stored in `otherData`.
+///
+std::string ToChromeTraceJSON(const LoadStats &stats);
+
 } // performance
 } // namespace tinyusdz
-
@@ -246,14 +246,15 @@ std::string print_typed_timesamples(const TypedTimeSamples<T> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << samples[i].value;
+      ss << values[i];
     }
     ss << ",\n";
   }
@@ -270,14 +271,15 @@ std::string print_typed_token_timesamples(const TypedTimeSamples<T> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << quote(to_string(samples[i].value));
+      ss << quote(to_string(values[i]));
     }
     ss << ",\n";
   }
@@ -293,14 +295,15 @@ static std::string print_str_timesamples(const TypedTimeSamples<std::string> &v,
 
   ss << "{\n";
 
-  const auto &samples = v.get_samples();
+  const auto &times = v.get_times();
+  const auto &values = v.get_values();
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    ss << pprint::Indent(indent + 1) << samples[i].t << ": ";
-    if (samples[i].blocked) {
+  for (size_t i = 0; i < times.size(); i++) {
+    ss << pprint::Indent(indent + 1) << times[i] << ": ";
+    if (v.is_blocked(i)) {
       ss << "None";
     } else {
-      ss << buildEscapedAndQuotedStringForUSDA(samples[i].value);
+      ss << buildEscapedAndQuotedStringForUSDA(values[i]);
     }
     ss << ",\n";
   }
@@ -1288,8 +1291,8 @@ std::string print_timesamples(const value::TimeSamples &v,
 
   for (size_t i = 0; i < v.size(); i++) {
     ss << pprint::Indent(indent + 1);
-    ss << v.get_samples()[i].t << ": "
-       << value::pprint_value(v.get_samples()[i].value);
+    ss << v.get_times()[i] << ": "
+       << value::pprint_value(v.get_values()[i]);
     ss << ",\n";  // USDA allow ',' for the last item
   }
   ss << pprint::Indent(indent) << "}\n";
@@ -1454,7 +1457,7 @@ std::string print_prop(const Property &prop, const std::string &prop_name,
   return ss.str();
 }
 
-std::string print_props(const std::map<std::string, Property> &props,
+std::string print_props(const PropertyMap &props,
                         uint32_t indent) {
   std::stringstream ss;
 
@@ -1468,7 +1471,7 @@ std::string print_props(const std::map<std::string, Property> &props,
 }
 
 // Print user-defined (custom) properties.
-std::string print_props(const std::map<std::string, Property> &props,
+std::string print_props(const PropertyMap &props,
                         std::set<std::string> &tok_table,
                         const std::vector<value::token> &propNames,
                         uint32_t indent) {
@@ -4627,8 +4630,9 @@ std::string print_layer(const Layer &layer, const uint32_t indent) {
 // prim-pprint.hh
 namespace prim {
 
-std::string print_prim(const Prim &prim, const uint32_t indent) {
-  std::stringstream ss;
+void print_prim(std::ostream &ss, const Prim &prim, const uint32_t indent) {
+  // Child Prims are written to `ss` directly(not concatenated as a string),
+  // so only the text of a single Prim is held in memory at once.
 
   // Currently, Prim's elementName is read from name variable in concrete Prim
   // class(e.g. Xform::name).
@@ -4693,7 +4697,7 @@ std::string print_prim(const Prim &prim, const uint32_t indent) {
             value::token nameTok = variant.metas().variantChildren.value()[i];
             const auto it = primNameTable.find(nameTok.str());
             if (it != primNameTable.end()) {
-              ss << print_prim(*(it->second), indent + 3);
+              print_prim(ss, *(it->second), indent + 3);
               if (i != (variant.primChildren().size() - 1)) {
                 ss << "\n";
               }
@@ -4704,7 +4708,7 @@ std::string print_prim(const Prim &prim, const uint32_t indent) {
 
         } else {
           for (size_t i = 0; i < variant.primChildren().size(); i++) {
-            ss << print_prim(variant.primChildren()[i], indent + 3);
+            print_prim(ss, variant.primChildren()[i], indent + 3);
             if (i != (variant.primChildren().size() - 1)) {
               ss << "\n";
             }
@@ -4744,7 +4748,7 @@ std::string print_prim(const Prim &prim, const uint32_t indent) {
                           prim.metas().primChildren.size(), nameTok.str()));
         const auto it = primNameTable.find(nameTok.str());
         if (it != primNameTable.end()) {
-          ss << print_prim(*(it->second), indent + 1);
+          print_prim(ss, *(it->second), indent + 1);
         } else {
           // TODO: Report warning?
         }
@@ -4755,13 +4759,17 @@ std::string print_prim(const Prim &prim, const uint32_t indent) {
         if (i > 0) {
           ss << "\n";
         }
-        ss << print_prim(prim.children()[i], indent + 1);
+        print_prim(ss, prim.children()[i], indent + 1);
       }
     }
   }
 
   ss << pprint::Indent(indent) << "}\n";
+}
 
+std::string print_prim(const Prim &prim, const uint32_t indent) {
+  std::stringstream ss;
+  print_prim(ss, prim, indent);
   return ss.str();
 }
 
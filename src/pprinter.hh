@@ -256,13 +256,13 @@ std::string print_prop(const Property &prop, const std::string &prop_name,
 
 // Print properties.
 // TODO: Deprecate this function.
-std::string print_props(const std::map<std::string, Property> &props,
+std::string print_props(const PropertyMap &props,
                         uint32_t indent);
 
 // tok_table: Manages property is already printed(built-in props) or not.
 // propNames: Specify the order of property to print
 // When `propNames` is empty, print all of items in `props`.
-std::string print_props(const std::map<std::string, Property> &props,
+std::string print_props(const PropertyMap &props,
                         /* input */ std::set<std::string> &tok_table,
                         const std::vector<value::token> &propNames,
                         uint32_t indent);
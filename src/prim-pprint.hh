@@ -4,8 +4,9 @@
  
 #pragma once
 
-#include <string>
 #include <cstdint>
+#include <ostream>
+#include <string>
 
 #include "prim-types.hh"
 
@@ -20,6 +21,11 @@ std::string print_payload(const PayloadList &payload, const uint32_t indent);
 std::string print_layeroffset(const LayerOffset &layeroffset, const uint32_t indent);
 
 std::string print_prim(const Prim &prim, const uint32_t indent=0);
+
+///
+/// Write Prim(and its descendants) in USDA to `os`.
+///
+void print_prim(std::ostream &os, const Prim &prim, const uint32_t indent=0);
 std::string print_primspec(const PrimSpec &primspec, const uint32_t indent=0);
 
 } // namespace prim
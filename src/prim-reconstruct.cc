@@ -137,14 +137,16 @@ static nonstd::optional<Animatable<T>> ConvertToAnimatable(const primvar::PrimVa
   }
 
   if (var.has_timesamples()) {
-    for (size_t i = 0; i < var.ts_raw().size(); i++) {
-      const value::TimeSamples::Sample &s = var.ts_raw().get_samples()[i];
+    const value::TimeSamples &ts = var.ts_raw();
+    dst.reserve_timesamples(ts.size());
+    for (size_t i = 0; i < ts.size(); i++) {
+      const double t = ts.get_times()[i];
 
       // Attribute Block?
-      if (s.blocked) {
-        dst.add_blocked_sample(s.t);
-      } else if (auto pv = s.value.get_value<T>()) {
-        dst.add_sample(s.t, pv.value());
+      if (ts.is_blocked(i)) {
+        dst.add_blocked_sample(t);
+      } else if (auto pv = ts.get_values()[i].get_value<T>()) {
+        dst.add_sample(t, pv.value());
       } else {
         // Type mismatch
         DCOUT(i << "/" << var.ts_raw().size() << " type mismatch.");
@@ -152,6 +154,9 @@ static nonstd::optional<Animatable<T>> ConvertToAnimatable(const primvar::PrimVa
       }
     }
 
+    // Loaded timesamples are read-only.
+    dst.freeze_timesamples();
+
     ok = true;
   }
 
@@ -196,18 +201,20 @@ nonstd::optional<Animatable<Extent>> ConvertToAnimatable(const primvar::PrimVar
   }
 
   if (var.has_timesamples()) {
-    for (size_t i = 0; i < var.ts_raw().size(); i++) {
-      const value::TimeSamples::Sample &s = var.ts_raw().get_samples()[i];
+    const value::TimeSamples &ts = var.ts_raw();
+    dst.reserve_timesamples(ts.size());
+    for (size_t i = 0; i < ts.size(); i++) {
+      const double t = ts.get_times()[i];
 
       // Attribute Block?
-      if (s.blocked) {
-        dst.add_blocked_sample(s.t);
-      } else if (auto pv = s.value.get_value<std::vector<value::float3>>()) {
+      if (ts.is_blocked(i)) {
+        dst.add_blocked_sample(t);
+      } else if (auto pv = ts.get_values()[i].get_value<std::vector<value::float3>>()) {
         if (pv.value().size() == 2) {
           Extent ext;
           ext.lower = pv.value()[0];
           ext.upper = pv.value()[1];
-          dst.add_sample(s.t, ext);
+          dst.add_sample(t, ext);
         } else {
           DCOUT(i << "/" << var.ts_raw().size() << " array size mismatch.");
           return nonstd::nullopt;
@@ -219,6 +226,8 @@ nonstd::optional<Animatable<Extent>> ConvertToAnimatable(const primvar::PrimVar
       }
     }
 
+    dst.freeze_timesamples();
+
     value_ok = true;
     //return std::move(dst);
   }
@@ -1800,6 +1809,8 @@ bool ParseTimeSampledEnumProperty(
         }
       }
 
+      animatable_value.freeze_timesamples();
+
       has_timesamples = true;
       //return true;
 
@@ -1928,10 +1939,49 @@ bool ParseTimeSampledEnumProperty(
    } \
  }
 
+void AccumulateLoadCounts(const PropertyMap &properties,
+                          performance::LoadCounts *counts) {
+  if (!counts) {
+    return;
+  }
+
+  counts->num_prims++;
+
+  for (const auto &prop : properties) {
+    if (prop.second.is_relationship()) {
+      counts->num_relationships++;
+      continue;
+    }
+
+    if (!prop.second.is_attribute()) {
+      continue;
+    }
+
+    counts->num_attributes++;
+
+    const primvar::PrimVar &var = prop.second.get_attribute().get_var();
+    if (var.has_value() && var.value_raw().is_array()) {
+      counts->num_arrays++;
+      counts->array_bytes += var.value_raw().array_data_size();
+    }
+
+    if (var.has_timesamples()) {
+      const value::TimeSamples &ts = var.ts_raw();
+      counts->num_timesamples += ts.size();
+      for (const auto &v : ts.get_values()) {
+        if (v.is_array()) {
+          counts->num_arrays++;
+          counts->array_bytes += v.array_data_size();
+        }
+      }
+    }
+  }
+}
+
 bool ReconstructXformOpsFromProperties(
   const Specifier &spec,
   std::set<std::string> &table, /* inout */
-  const std::map<std::string, Property> &properties,
+  const PropertyMap &properties,
   std::vector<XformOp> *xformOps,
   std::string *err)
 {
@@ -2531,7 +2581,7 @@ namespace {
 
 bool ReconstructMaterialBindingProperties(
   std::set<std::string> &table, /* inout */
-  const std::map<std::string, Property> &properties,
+  const PropertyMap &properties,
   MaterialBinding *mb, /* inout */
   std::string *err)
 {
@@ -2631,7 +2681,7 @@ bool ReconstructMaterialBindingProperties(
 
 bool ReconstructCollectionProperties(
   std::set<std::string> &table, /* inout */
-  const std::map<std::string, Property> &properties,
+  const PropertyMap &properties,
   Collection *coll, /* inout */
   std::string *warn,
   std::string *err,
@@ -2724,7 +2774,7 @@ bool ReconstructCollectionProperties(
 bool ReconstructGPrimProperties(
   const Specifier &spec,
   std::set<std::string> &table, /* inout */
-  const std::map<std::string, Property> &properties,
+  const PropertyMap &properties,
   GPrim *gprim, /* inout */
   std::string *warn,
   std::string *err,
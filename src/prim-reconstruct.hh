@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "performance.hh"
 #include "prim-types.hh"
 
 namespace tinyusdz {
@@ -20,6 +21,13 @@ struct PrimReconstructOptions
 };
 
 
+///
+/// Count a Prim and its properties, time samples and array values in
+/// `properties`(for load statistics). No-op when `counts` is nullptr.
+///
+void AccumulateLoadCounts(const PropertyMap &properties,
+                          performance::LoadCounts *counts);
+
 ///
 /// Reconstruct property with `xformOp:***` namespace in `properties` to `XformOp` class.
 /// Corresponding property are looked up from names in `xformOpOrder`(`token[]`) property.
@@ -4,6 +4,11 @@
 #include <cstdio>
 #include <limits>
 #include <numeric>
+#include <unordered_map>
+
+#if !defined(__wasi__)
+#include <mutex>
+#endif
 //
 #include "prim-types.hh"
 #include "str-util.hh"
@@ -86,9 +91,8 @@ bool operator==(const Path &lhs, const Path &rhs) {
     return false;
   }
 
-  // Currently simply compare string.
-  // FIXME: Better Path identity check.
-  return (lhs.full_path_name() == rhs.full_path_name());
+  // Paths with the same string share the same node.
+  return (lhs.node() == rhs.node());
 }
 
 bool ConvertTokenAttributeToStringAttribute(
@@ -130,10 +134,217 @@ bool ConvertTokenAttributeToStringAttribute(
   
 
 
+//
+// -- PathNodePool
+//
+
+namespace {
+
+// Split the pool to reduce lock contention.
+constexpr size_t kNumPathNodePoolShards = 64;
+
+struct PathNodePoolShard {
+#if !defined(__wasi__)
+  std::mutex mutex;
+#endif
+  // key = hash of the path string. Nodes with the same hash are chained.
+  std::unordered_multimap<uint64_t, const PathNode *> nodes;
+};
+
+struct PathNodePoolStorage {
+  PathNodePoolShard shards[kNumPathNodePoolShards];
+};
+
+// Allocated on the first use and never freed(same as TokenPool).
+PathNodePoolStorage &GetPathNodePoolStorage() {
+  static PathNodePoolStorage *s_storage = new PathNodePoolStorage();
+  return *s_storage;
+}
+
+constexpr uint64_t kFNVOffsetBasis = 14695981039346656037ull;
+
+// Continue FNV-1a hashing, so that the hash of a child node can be computed
+// from the parent's hash without concatenating strings.
+uint64_t HashAppend(uint64_t h, const char *str, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    h ^= uint64_t(uint8_t(str[i]));
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+bool IsRootPrimNode(const PathNode *node) {
+  return node && (node->prim_part.size() == 1) && (node->prim_part[0] == '/');
+}
+
+// Find a node matching `match` in the shard for hash `h`, or create a new node
+// with `create`.
+template <class MatchFun, class CreateFun>
+const PathNode *FindOrCreatePathNode(uint64_t h, MatchFun match,
+                                     CreateFun create) {
+  PathNodePoolShard &shard =
+      GetPathNodePoolStorage().shards[size_t(h % kNumPathNodePoolShards)];
+
+  {
+#if !defined(__wasi__)
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+    auto range = shard.nodes.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (match(*(it->second))) {
+        return it->second;
+      }
+    }
+  }
+
+  // Create the node outside of the lock, since creating a prim node may
+  // intern its parent node(which may live in the same shard).
+  PathNode *node = create();
+  node->hash = h;
+
+#if !defined(__wasi__)
+  std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+  // Other thread may have created the same node.
+  auto range = shard.nodes.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (match(*(it->second))) {
+      delete node;
+      return it->second;
+    }
+  }
+  shard.nodes.emplace(h, node);
+
+  return node;
+}
+
+}  // namespace
+
+const PathNode *PathNodePool::InternPrim(const std::string &prim_part) {
+  if (prim_part.empty()) {
+    return nullptr;
+  }
+
+  const uint64_t h =
+      HashAppend(kFNVOffsetBasis, prim_part.data(), prim_part.size());
+
+  return FindOrCreatePathNode(
+      h,
+      [&prim_part](const PathNode &node) {
+        return !node.is_property && (node.prim_part == prim_part);
+      },
+      [&prim_part]() {
+        PathNode *node = new PathNode();
+        node->prim_part = prim_part;
+
+        // The parent is the prim part before the last '/'.
+        size_t n = prim_part.find_last_of('/');
+        if (n == std::string::npos) {
+          // relative path(e.g. "bora")
+          node->element = prim_part;
+        } else if (prim_part.size() == 1) {
+          // root. elementName is empty.
+        } else {
+          node->parent = InternPrim(n == 0 ? std::string("/")
+                                           : prim_part.substr(0, n));
+          node->element = prim_part.substr(n + 1);
+        }
+        return node;
+      });
+}
+
+const PathNode *PathNodePool::InternPrimChild(const PathNode *parent,
+                                              const std::string &element) {
+  if (parent && parent->is_property) {
+    return nullptr;
+  }
+
+  if (element.find('/') != std::string::npos) {
+    // Not a single element. Parse the path string.
+    std::string s = (parent && !IsRootPrimNode(parent)) ? parent->prim_part : "";
+    s += "/" + element;
+    return InternPrim(s);
+  }
+
+  if (!parent) {
+    parent = InternPrim("/");
+  }
+
+  const bool is_root = IsRootPrimNode(parent);
+
+  uint64_t h = parent->hash;
+  if (!is_root) {
+    h = HashAppend(h, "/", 1);
+  }
+  h = HashAppend(h, element.data(), element.size());
+
+  return FindOrCreatePathNode(
+      h,
+      [parent, &element](const PathNode &node) {
+        return !node.is_property && (node.parent == parent) &&
+               (node.element == element) &&
+               (node.prim_part.size() ==
+                (IsRootPrimNode(parent) ? 0 : parent->prim_part.size()) + 1 +
+                    element.size());
+      },
+      [parent, is_root, &element]() {
+        PathNode *node = new PathNode();
+        node->parent = parent;
+        node->prim_part =
+            is_root ? ("/" + element) : (parent->prim_part + "/" + element);
+        node->element = element;
+        return node;
+      });
+}
+
+const PathNode *PathNodePool::InternProperty(const PathNode *prim,
+                                             const std::string &prop) {
+  if (prop.empty()) {
+    return prim;
+  }
+
+  if (prim && prim->is_property) {
+    prim = prim->parent;
+  }
+
+  uint64_t h = HashAppend(prim ? prim->hash : kFNVOffsetBasis, ".", 1);
+  h = HashAppend(h, prop.data(), prop.size());
+
+  return FindOrCreatePathNode(
+      h,
+      [prim, &prop](const PathNode &node) {
+        return node.is_property && (node.parent == prim) &&
+               (node.element == prop);
+      },
+      [prim, &prop]() {
+        PathNode *node = new PathNode();
+        node->parent = prim;
+        node->element = prop;
+        node->is_property = true;
+        return node;
+      });
+}
+
+size_t PathNodePool::Size() {
+  size_t n = 0;
+  for (auto &shard : GetPathNodePoolStorage().shards) {
+#if !defined(__wasi__)
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+    n += shard.nodes.size();
+  }
+  return n;
+}
+
 //
 // -- Path
 //
 
+const std::string &Path::EmptyString() {
+  static const std::string *s_empty = new std::string();
+  return *s_empty;
+}
+
 Path::Path(const std::string &p, const std::string &prop) {
   //
   // For absolute path, starts with '/' and no other '/' exists.
@@ -148,8 +359,6 @@ Path::Path(const std::string &p, const std::string &prop) {
   auto slash_fun = [](const char c) { return c == '/'; };
   auto dot_fun = [](const char c) { return c == '.'; };
 
-  std::vector<std::string> prims = split(p, "/");
-
   // TODO: More checks('{', '[', ...)
 
   if (prop.size()) {
@@ -167,6 +376,13 @@ Path::Path(const std::string &p, const std::string &prop) {
     }
   }
 
+  if (p.empty()) {
+    // property only path.
+    _node = PathNodePool::InternProperty(nullptr, prop);
+    _valid = true;
+    return;
+  }
+
   if (p[0] == '/') {
     // absolute path
 
@@ -174,18 +390,7 @@ Path::Path(const std::string &p, const std::string &prop) {
 
     if (ndots == 0) {
       // absolute prim.
-      _prim_part = p;
-
-      if (prop.size()) {
-        _prop_part = prop;
-        _element = prop;
-      } else {
-        if (prims.size()) {
-          _element = prims[prims.size() - 1];
-        } else {
-          _element = p;
-        }
-      }
+      _node = PathNodePool::InternProperty(PathNodePool::InternPrim(p), prop);
       _valid = true;
     } else if (ndots == 1) {
       // prim_part contains property name.
@@ -208,17 +413,10 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      if (loc <= 0) {
-        // this should not happen though.
-        _valid = false;
-      }
-
       // split
-      std::string prop_name = p.substr(size_t(loc));
-
-      _prop_part = prop_name.erase(0, 1);  // remove '.'
-      _prim_part = p.substr(0, size_t(loc));
-      _element = _prop_part;  // elementName is property path
+      _node = PathNodePool::InternProperty(
+          PathNodePool::InternPrim(p.substr(0, size_t(loc))),
+          p.substr(size_t(loc) + 1));
 
       _valid = true;
 
@@ -230,43 +428,16 @@ Path::Path(const std::string &p, const std::string &prop) {
   } else if (p[0] == '.') {
     // maybe relative(e.g. "./xform", "../xform")
     // FIXME: Support relative path fully
-
-#if 0
-    auto nslashes = std::count_if(p.begin(), p.end(), slash_fun);
-    if (nslashes > 0) {
-      _valid = false;
-      return;
-    }
-
-    _prop_part = p;
-    _prop_part = _prop_part.erase(0, 1);
-    _valid = true;
-#else
-    _prim_part = p;
-    if (prop.size()) {
-      _prop_part = prop;
-      _element = prop;
-    } else {
-      if (prims.size()) {
-        _element = prims[prims.size() - 1];
-      } else {
-        _element = p;
-      }
-    }
+    _node = PathNodePool::InternProperty(PathNodePool::InternPrim(p), prop);
     _valid = true;
 
-#endif
-
   } else {
     // prim.prop
 
     auto ndots = std::count_if(p.begin(), p.end(), dot_fun);
     if (ndots == 0) {
       // relative prim.
-      _prim_part = p;
-      if (prop.size()) {
-        _prop_part = prop;
-      }
+      _node = PathNodePool::InternProperty(PathNodePool::InternPrim(p), prop);
       _valid = true;
     } else if (ndots == 1) {
       if (p.size() < 3) {
@@ -282,13 +453,8 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      if (loc <= 0) {
-        // this should not happen though.
-        _valid = false;
-      }
-
       // split
-      std::string prop_name = p.substr(size_t(loc));
+      std::string prop_name = p.substr(size_t(loc) + 1);
 
       // Check if No '/' in prop_part
       if (std::count_if(prop_name.begin(), prop_name.end(), slash_fun) > 0) {
@@ -296,8 +462,8 @@ Path::Path(const std::string &p, const std::string &prop) {
         return;
       }
 
-      _prim_part = p.substr(0, size_t(loc));
-      _prop_part = prop_name.erase(0, 1);  // remove '.'
+      _node = PathNodePool::InternProperty(
+          PathNodePool::InternPrim(p.substr(0, size_t(loc))), prop_name);
 
       _valid = true;
 
@@ -308,6 +474,25 @@ Path::Path(const std::string &p, const std::string &prop) {
   }
 }
 
+std::string Path::variant_part() const {
+  const std::string &elem = prim_part();
+  size_t n = elem.find_last_of('/');
+  size_t loc = elem.find('{', (n == std::string::npos) ? 0 : n);
+  if (loc == std::string::npos) {
+    return std::string();
+  }
+  return elem.substr(loc);
+}
+
+Path &Path::make_relative() {
+  if (is_absolute_path() && (prim_part().size() > 1)) {
+    // Remove first '/'
+    const PathNode *prim = PathNodePool::InternPrim(prim_part().substr(1));
+    _node = PathNodePool::InternProperty(prim, prop_part());
+  }
+  return *this;
+}
+
 Path Path::append_property(const std::string &elem) {
   Path &p = (*this);
 
@@ -334,8 +519,7 @@ Path Path::append_property(const std::string &elem) {
     return p;
   } else {
     // TODO: Validate property path.
-    p._prop_part = elem;
-    p._element = elem;
+    p._node = PathNodePool::InternProperty(prim_node(), elem);
 
     return p;
   }
@@ -508,6 +692,17 @@ bool Path::has_prefix(const Path &prefix) const {
       return true;
     }
 
+    if (is_absolute_path() && prefix.is_absolute_path()) {
+      // Walk up the node tree.
+      const PathNode *prefix_node = prefix.prim_node();
+      for (const PathNode *node = prim_node(); node; node = node->parent) {
+        if (node == prefix_node) {
+          return true;
+        }
+      }
+      return false;
+    }
+
     const std::vector<std::string> prim_names = split(prim_part(), "/");
     const std::vector<std::string> prefix_prim_names =
         split(prefix.prim_part(), "/");
@@ -554,14 +749,16 @@ Path Path::append_element(const std::string &elem) {
     return p;
   }
 
+  const PathNode *prim = prim_node();
+  const std::string &prop = prop_part();
+
   // {variant=value}
   if (is_variantElementName(elem)) {
     std::array<std::string, 2> variant;
     if (tokenize_variantElement(elem, &variant)) {
-      _variant_part = variant[0];
-      _variant_selection_part = variant[0];
-      _prim_part += elem;
-      _element = elem;
+      // Variant selection is a part of the element name(no '/').
+      p._node = PathNodePool::InternProperty(
+          PathNodePool::InternPrim(prim_part() + elem), prop);
       return p;
     } else {
       p._valid = false;
@@ -578,16 +775,9 @@ Path Path::append_element(const std::string &elem) {
     p._valid = false;
     return p;
   } else {
-    // std::cout << "elem " << elem << "\n";
-    if ((p._prim_part.size() == 1) && (p._prim_part[0] == '/')) {
-      p._prim_part += elem;
-    } else {
-      // TODO: Validate element name.
-      p._prim_part += '/' + elem;
-    }
-
-    // Also store raw element name
-    p._element = elem;
+    // TODO: Validate element name.
+    p._node = PathNodePool::InternProperty(
+        PathNodePool::InternPrimChild(prim, elem), prop);
 
     return p;
   }
@@ -603,23 +793,22 @@ Path Path::get_parent_path() const {
     return p;
   }
 
+  Path p;
+  p._valid = true;
+
   if (is_prim_property_path()) {
     // return prim part
-    return Path(prim_part(), "");
+    p._node = prim_node();
+    return p;
   }
 
-  size_t n = _prim_part.find_last_of('/');
-  if (n == std::string::npos) {
+  if (!_node || !_node->parent) {
     // relative path(e.g. "bora") or propery only path(e.g. ".myval").
     return Path();
   }
 
-  if (n == 0) {
-    // return root
-    return Path("/", "");
-  }
-
-  return Path(_prim_part.substr(0, n), "");
+  p._node = _node->parent;
+  return p;
 }
 
 Path Path::get_parent_prim_path() const {
@@ -631,35 +820,183 @@ Path Path::get_parent_prim_path() const {
     return *this;
   }
 
+  Path p;
+  p._valid = true;
+
   if (is_prim_property_path()) {
     // return prim part
-    return Path(prim_part(), "");
+    p._node = prim_node();
+    return p;
   }
 
-  size_t n = _prim_part.find_last_of('/');
-  if (n == std::string::npos) {
+  if (!_node || !_node->parent) {
     // this should never happen though.
     return Path();
   }
 
-  if (n == 0) {
-    // return root
-    return Path("/", "");
+  p._node = _node->parent;
+  return p;
+}
+
+//
+// -- PropertyMap
+//
+
+constexpr size_t PropertyMap::kNotFound;
+
+namespace {
+
+uint64_t HashPropertyName(const std::string &name) {
+  return HashAppend(kFNVOffsetBasis, name.data(), name.size());
+}
+
+}  // namespace
+
+void PropertyMap::clear() {
+  _items.clear();
+  _hashes.clear();
+  _order.clear();
+  _rank.clear();
+  _table.clear();
+}
+
+size_t PropertyMap::find_index(const std::string &key) const {
+  if (_table.empty()) {
+    return kNotFound;
   }
 
-  return Path(_prim_part.substr(0, n), "");
+  const uint64_t h = HashPropertyName(key);
+  const size_t mask = _table.size() - 1;
+
+  // linear probing.
+  for (size_t i = size_t(h) & mask;; i = (i + 1) & mask) {
+    uint32_t v = _table[i];
+    if (v == 0) {
+      return kNotFound;
+    }
+    size_t idx = size_t(v - 1);
+    if ((_hashes[idx] == h) && (_items[idx].first == key)) {
+      return idx;
+    }
+  }
 }
 
-const std::string &Path::element_name() const {
-  if (_element.empty()) {
-    // Get last item.
-    std::vector<std::string> tokenized_prim_names = split(prim_part(), "/");
-    if (tokenized_prim_names.size()) {
-      _element = tokenized_prim_names[size_t(tokenized_prim_names.size() - 1)];
+void PropertyMap::insert_table(size_t idx) {
+  const size_t mask = _table.size() - 1;
+  for (size_t i = size_t(_hashes[idx]) & mask;; i = (i + 1) & mask) {
+    if (_table[i] == 0) {
+      _table[i] = uint32_t(idx + 1);
+      return;
     }
   }
+}
+
+void PropertyMap::reserve(size_t n) {
+  _items.reserve(n);
+  _hashes.reserve(n);
+  _order.reserve(n);
+  _rank.reserve(n);
+
+  if ((n * 2) > _table.size()) {
+    rebuild_index(n);
+  }
+}
+
+void PropertyMap::rebuild_index(size_t capacity) {
+  // Keep the load factor <= 0.5
+  size_t table_size = 8;
+  while (table_size < (std::max)(_items.size(), capacity) * 2) {
+    table_size *= 2;
+  }
+
+  _table.assign(table_size, 0);
+  for (size_t i = 0; i < _items.size(); i++) {
+    insert_table(i);
+  }
+
+  _rank.resize(_order.size());
+  for (size_t i = 0; i < _order.size(); i++) {
+    _rank[_order[i]] = uint32_t(i);
+  }
+}
+
+std::pair<PropertyMap::iterator, bool> PropertyMap::emplace(
+    const std::string &key, Property &&prop) {
+  size_t idx = find_index(key);
+  if (idx != kNotFound) {
+    return std::make_pair(iterator(this, _rank[idx]), false);
+  }
+
+  idx = _items.size();
+  _items.emplace_back(key, std::move(prop));
+  _hashes.push_back(HashPropertyName(key));
+
+  auto it = std::lower_bound(_order.begin(), _order.end(), key,
+                             [this](uint32_t i, const std::string &k) {
+                               return _items[i].first < k;
+                             });
+  size_t pos = size_t(std::distance(_order.begin(), it));
+  _order.insert(it, uint32_t(idx));
+
+  if ((_items.size() * 2) > _table.size()) {
+    rebuild_index();
+  } else {
+    insert_table(idx);
+    _rank.push_back(0);
+    for (size_t i = pos; i < _order.size(); i++) {
+      _rank[_order[i]] = uint32_t(i);
+    }
+  }
+
+  return std::make_pair(iterator(this, pos), true);
+}
+
+PropertyMap::iterator PropertyMap::erase(const_iterator it) {
+  if (it._pos >= _order.size()) {
+    return end();
+  }
+
+  size_t pos = it._pos;
+  size_t idx = _order[pos];
+
+  _items.erase(_items.begin() + std::ptrdiff_t(idx));
+  _hashes.erase(_hashes.begin() + std::ptrdiff_t(idx));
+  _order.erase(_order.begin() + std::ptrdiff_t(pos));
+  for (auto &i : _order) {
+    if (i > idx) {
+      i--;
+    }
+  }
+
+  rebuild_index();
+
+  return iterator(this, pos);
+}
+
+size_t PropertyMap::erase(const std::string &key) {
+  size_t idx = find_index(key);
+  if (idx == kNotFound) {
+    return 0;
+  }
+
+  erase(const_iterator(this, _rank[idx]));
+  return 1;
+}
+
+std::pair<PropertyMap::const_iterator, PropertyMap::const_iterator>
+PropertyMap::prefix_range(const std::string &prefix) const {
+  auto first = std::lower_bound(_order.begin(), _order.end(), prefix,
+                                [this](uint32_t i, const std::string &k) {
+                                  return _items[i].first < k;
+                                });
+  auto last = first;
+  while ((last != _order.end()) && startsWith(_items[*last].first, prefix)) {
+    last++;
+  }
 
-  return _element;
+  return std::make_pair(
+      const_iterator(this, size_t(std::distance(_order.begin(), first))),
+      const_iterator(this, size_t(std::distance(_order.begin(), last))));
 }
 
 nonstd::optional<Kind> KindFromString(const std::string &str) {
@@ -13,11 +13,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -310,13 +312,71 @@ enum class Variability {
 // Use ValidatePrimPath() in path-util.hh
 bool ValidatePrimElementName(const std::string &tok);
 
+///
+/// Interned node of a Path.
+///
+/// A prim node represents the prim part of a Path(e.g. `/muda/bora`) and a
+/// property node represents the prim part + property name(e.g.
+/// `/muda/bora.dora`). Nodes are shared by all Paths with the same string and
+/// linked to the parent node, so a Path is a single pointer: copy, equality
+/// and hash are O(1) and getting the parent does not touch strings.
+///
+/// Nodes are immutable and never released during the lifetime of the
+/// process(same as TokenPool).
+///
+struct PathNode {
+  // Prim node: Parent prim node(the prim part before the last '/').
+  //   nullptr for the root path("/") and for a relative path without '/'.
+  // Property node: Owner prim node. nullptr for property-only path(".dora")
+  const PathNode *parent{nullptr};
+
+  std::string prim_part;  // Full prim part. Empty for a property node.
+  std::string element;    // Element name(Prim's name or property name)
+
+  uint64_t hash{0};  // FNV-1a hash of the full path string.
+  bool is_property{false};
+};
+
+///
+/// Thread-safe global PathNode pool.
+///
+class PathNodePool {
+ public:
+  ///
+  /// Find or create a prim node for the prim part string `prim_part`.
+  /// Returns nullptr for empty string.
+  ///
+  static const PathNode *InternPrim(const std::string &prim_part);
+
+  ///
+  /// Find or create a prim node of `parent` + '/' + `element`.
+  /// `parent` nullptr is treated as the root path.
+  ///
+  static const PathNode *InternPrimChild(const PathNode *parent,
+                                         const std::string &element);
+
+  ///
+  /// Find or create a property node of `prim` + '.' + `prop`.
+  /// `prim` nullptr creates property-only path. Returns `prim` for empty
+  /// `prop`.
+  ///
+  static const PathNode *InternProperty(const PathNode *prim,
+                                        const std::string &prop);
+
+  ///
+  /// The number of interned nodes.
+  ///
+  static size_t Size();
+};
+
 ///
 /// Simlar to SdfPath.
-/// NOTE: We are doging refactoring of Path class, so the following comment may
-/// not be correct.
 ///
-/// We don't need the performance for USDZ, so use naiive implementation
-/// to represent Path.
+/// Path is a handle to an interned PathNode, so Path is cheap to copy and
+/// compare. Prefer AppendPrim()/AppendProperty()/get_parent_path() to
+/// constructing a Path from strings, since they look up the node pool
+/// without parsing and concatenating strings.
+///
 /// Path is something like Unix path, delimited by `/`, ':' and '.'
 /// Square brackets('<', '>' is not included)
 ///
@@ -356,9 +416,8 @@ class Path {
   Path() : _valid(false) {}
 
   static Path make_root_path() {
-    Path p = Path("/", "");
-    // elementPath is empty for root.
-    p._element = "";
+    Path p;
+    p._node = PathNodePool::InternPrim("/");
     p._valid = true;
     return p;
   }
@@ -369,53 +428,40 @@ class Path {
   // "/aaa", "" => /aaa (prim only)
   // "", "bora" => .bora (property only)
   //
-  // Note: This constructor may fail to extract elementName from given `prim`
-  // and `prop`. It is highly recommended to use AppendPrim() and AppendProperty
-  // to. construct Path hierarchy(e.g. `/aaa/xform/geom.points`) so that
-  // elementName is set correctly.
+  // Note: It is highly recommended to use AppendPrim() and AppendProperty
+  // to. construct Path hierarchy(e.g. `/aaa/xform/geom.points`), since they
+  // does not parse strings.
   Path(const std::string &prim, const std::string &prop);
 
-  // : prim_part(prim), valid(true) {}
-  // Path(const std::string &prim, const std::string &prop)
-  //    : prim_part(prim), prop_part(prop) {}
-
-  Path(const Path &rhs) = default;
-
-  Path &operator=(const Path &rhs) {
-    this->_valid = rhs._valid;
-
-    this->_prim_part = rhs._prim_part;
-    this->_prop_part = rhs._prop_part;
-    this->_element = rhs._element;
-
-    return (*this);
-  }
-
   std::string full_path_name() const {
     std::string s;
     if (!_valid) {
       s += "#INVALID#";
     }
 
-    s += _prim_part;
-    if (_prop_part.empty()) {
+    s += prim_part();
+    if (!is_property_node()) {
       return s;
     }
 
-    s += "." + _prop_part;
+    s += "." + _node->element;
 
     return s;
   }
 
-  const std::string &prim_part() const { return _prim_part; }
-  const std::string &prop_part() const { return _prop_part; }
+  const std::string &prim_part() const {
+    const PathNode *node = prim_node();
+    return node ? node->prim_part : EmptyString();
+  }
 
-  const std::string &variant_part() const {
-    _variant_part_str =
-        "{" + _variant_part + "=" + _variant_selection_part + "}";
-    return _variant_part_str;
+  const std::string &prop_part() const {
+    return is_property_node() ? _node->element : EmptyString();
   }
 
+  // Variant selection of the element(e.g. `{variantColor=green}`). Empty when
+  // the element has no variant selection.
+  std::string variant_part() const;
+
   void set_path_type(const PathType ty) { _path_type = ty; }
 
   bool get_path_type(PathType &ty) {
@@ -435,47 +481,21 @@ class Path {
     }
 
     // TODO: RelationalAttribute
-    if (_prim_part.empty()) {
-      return false;
-    }
-
-    if (_prop_part.size()) {
-      return true;
-    }
-
-    return false;
+    return is_prim_property_path();
   }
 
   // Is Prim path?
-  bool is_prim_path() const {
-    if (_prop_part.size()) {
-      return false;
-    }
-
-    if (_prim_part.size()) {
-      return true;
-    }
-
-    return false;
-  }
+  bool is_prim_path() const { return _node && !_node->is_property; }
 
   // Is Prim's property path?
   // True when both PrimPart and PropPart are not empty.
   bool is_prim_property_path() const {
-    if (_prim_part.empty()) {
-      return false;
-    }
-    if (_prop_part.size()) {
-      return true;
-    }
-    return false;
+    return is_property_node() && _node->parent;
   }
 
   bool is_valid() const { return _valid; }
 
-  bool is_empty() {
-    return (_prim_part.empty() && _variant_part.empty() && _prop_part.empty());
-  }
+  bool is_empty() const { return _node == nullptr; }
 
   // static Path RelativePath() { return Path("."); }
 
@@ -495,7 +515,19 @@ class Path {
 
   // Get element name(the last element of Path. i.e. Prim's name, Property's
   // name)
-  const std::string &element_name() const;
+  const std::string &element_name() const {
+    return _node ? _node->element : EmptyString();
+  }
+
+  ///
+  /// Hash of the path string. O(1).
+  ///
+  uint64_t hash() const { return _node ? _node->hash : 0; }
+
+  ///
+  /// Interned node. Paths with the same string have the same node.
+  ///
+  const PathNode *node() const { return _node; }
 
   ///
   /// Split a path to the root(common ancestor) and its siblings
@@ -566,7 +598,8 @@ class Path {
       return false;
     }
 
-    if ((_prim_part.size() == 1) && (_prim_part[0] == '/')) {
+    const std::string &prim = prim_part();
+    if ((prim.size() == 1) && (prim[0] == '/')) {
       return true;
     }
 
@@ -585,9 +618,10 @@ class Path {
       return false;
     }
 
-    if ((_prim_part.size() > 1) && (_prim_part[0] == '/')) {
+    const std::string &prim = prim_part();
+    if ((prim.size() > 1) && (prim[0] == '/')) {
       // no other '/' except for the fist one
-      if (_prim_part.find_last_of('/') == 0) {
+      if (prim.find_last_of('/') == 0) {
         return true;
       }
     }
@@ -596,7 +630,8 @@ class Path {
   }
 
   bool is_absolute_path() const {
-    if (_prim_part.size() && _prim_part[0] == '/') {
+    const std::string &prim = prim_part();
+    if (prim.size() && prim[0] == '/') {
       return true;
     }
 
@@ -604,35 +639,15 @@ class Path {
   }
 
   bool is_relative_path() const {
-    if (_prim_part.size()) {
+    if (prim_part().size()) {
       return !is_absolute_path();
     }
 
     return true;  // prop part only
   }
 
-#if 0 // TODO: rmove
-  bool is_variant_selection_path() const {
-    if (!is_valid()) {
-      return false;
-    }
-
-    if (_variant_part.size()) {
-      return true;
-    }
-
-    return false;
-  }
-#endif
-
   // Strip '/'
-  Path &make_relative() {
-    if (is_absolute_path() && (_prim_part.size() > 1)) {
-      // Remove first '/'
-      _prim_part.erase(0, 1);
-    }
-    return *this;
-  }
+  Path &make_relative();
 
   const Path make_relative(Path &&rhs) {
     (*this) = std::move(rhs);
@@ -650,7 +665,7 @@ class Path {
   // To sort paths lexicographically.
   // TODO: consider abs and relative path correctly
   bool operator<(const Path &rhs) const {
-    if (full_path_name() == rhs.full_path_name()) {
+    if ((_node == rhs._node) && (_valid == rhs._valid)) {
       return false;
     }
 
@@ -662,13 +677,15 @@ class Path {
   }
 
  private:
-  std::string _prim_part;     // e.g. /Model/MyMesh, MySphere
-  std::string _prop_part;     // e.g. visibility (`.` is not included)
-  std::string _variant_part;  // e.g. `variantColor` for {variantColor=green}
-  std::string _variant_selection_part;  // e.g. `green` for {variantColor=green}
-                                        // . Could be empty({variantColor=}).
-  mutable std::string _variant_part_str;  // str buffer for variant_part()
-  mutable std::string _element;           // Element name
+  static const std::string &EmptyString();
+
+  bool is_property_node() const { return _node && _node->is_property; }
+
+  const PathNode *prim_node() const {
+    return is_property_node() ? _node->parent : _node;
+  }
+
+  const PathNode *_node{nullptr};  // Prim node or property node.
 
   nonstd::optional<PathType> _path_type;  // Currently optional.
 
@@ -1135,26 +1152,59 @@ using PropMetas = AttrMetas;
 // 2: (3.0, false)
 //
 
+// See value::TimeSamples for the thread safety and `freeze()`.
 template <typename T>
 struct TypedTimeSamples {
  public:
+  // AoS representation of a sample. Used for `get_samples()`.
   struct Sample {
     double t;
     T value;
     bool blocked{false};
   };
 
-  bool empty() const { return _samples.empty(); }
+  bool empty() const { return _times.empty(); }
 
-  void update() const {
-    std::sort(_samples.begin(), _samples.end(),
-              [](const Sample &a, const Sample &b) { return a.t < b.t; });
+  // Samples are always sorted. Kept for backward compatibility.
+  void update() const {}
+
+  void clear() {
+    thaw();
+
+    _times.clear();
+    _values.clear();
+    _blocked.clear();
+  }
 
-    _dirty = false;
+  void reserve(size_t n) {
+    thaw();
 
-    return;
+    _times.reserve(n);
+    _values.reserve(n);
+    _blocked.reserve(n);
   }
 
+  ///
+  /// Finalize samples(release extra capacity) and mark the container as
+  /// read-only. Modification to frozen TimeSamples unfreezes it.
+  ///
+  void freeze() {
+    if (_frozen) {
+      return;
+    }
+
+    _times.shrink_to_fit();
+    _values.shrink_to_fit();
+    _blocked.shrink_to_fit();
+    _frozen = true;
+  }
+
+  /// Make the container modifiable again. Caller must ensure no other thread
+  /// is reading it.
+  void unfreeze() { _frozen = false; }
+
+  bool is_frozen() const { return _frozen; }
+
   // Get value at specified time.
   // For non-interpolatable types(includes enums and unknown types)
   //
@@ -1175,19 +1225,15 @@ struct TypedTimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
-
     if (value::TimeCode(t).is_default()) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      (*dst) = _samples[0].value;
+      (*dst) = _values[0];
       return true;
     } else {
 
-      if (_samples.size() == 1) {
-        (*dst) = _samples[0].value;
+      if (_times.size() == 1) {
+        (*dst) = _values[0];
         return true;
       }
 
@@ -1202,13 +1248,11 @@ struct TypedTimeSamples {
       // t 1.0 => 200(time 1.0)
       //
       // This can be achieved by using upper_bound, and subtract 1 from the found position.
-      auto it = std::upper_bound(
-        _samples.begin(), _samples.end(), t,
-        [](double tval, const Sample &a) { return tval < a.t; });
+      auto it = std::upper_bound(_times.begin(), _times.end(), t);
 
-      const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
+      const auto it_minus_1 = (it == _times.begin()) ? _times.begin() : (it - 1);
 
-      (*dst) = it_minus_1->value;
+      (*dst) = _values[size_t(std::distance(_times.begin(), it_minus_1))];
       return true;
     }
 
@@ -1230,42 +1274,36 @@ struct TypedTimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
-
     if (value::TimeCode(t).is_default()) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      (*dst) = _samples[0].value;
+      (*dst) = _values[0];
       return true;
     } else {
 
-      if (_samples.size() == 1) {
-        (*dst) = _samples[0].value;
+      if (_times.size() == 1) {
+        (*dst) = _values[0];
         return true;
       }
 
-      auto it = std::lower_bound(
-        _samples.begin(), _samples.end(), t,
-        [](const Sample &a, double tval) { return a.t < tval; });
+      auto it = std::lower_bound(_times.begin(), _times.end(), t);
 
       if (interp == value::TimeSampleInterpolationType::Linear) {
 
         // MS STL does not allow seek vector iterator before begin
         // Issue #110
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
+        const auto it_minus_1 = (it == _times.begin()) ? _times.begin() : (it - 1);
 
         size_t idx0 = size_t((std::max)(
             int64_t(0),
-            (std::min)(int64_t(_samples.size() - 1),
-                     int64_t(std::distance(_samples.begin(), it_minus_1)))));
+            (std::min)(int64_t(_times.size() - 1),
+                     int64_t(std::distance(_times.begin(), it_minus_1)))));
         size_t idx1 =
-            size_t((std::max)(int64_t(0), (std::min)(int64_t(_samples.size() - 1),
+            size_t((std::max)(int64_t(0), (std::min)(int64_t(_times.size() - 1),
                                                  int64_t(idx0) + 1)));
 
-        double tl = _samples[idx0].t;
-        double tu = _samples[idx1].t;
+        double tl = _times[idx0];
+        double tu = _times[idx1];
 
         double dt = (t - tl);
         if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
@@ -1278,33 +1316,18 @@ struct TypedTimeSamples {
         // Just in case.
         dt = (std::max)(0.0, (std::min)(1.0, dt));
 
-        const value::Value &pv0 = _samples[idx0].value;
-        const value::Value &pv1 = _samples[idx1].value;
-
-        if (pv0.type_id() != pv1.type_id()) {
-          // Type mismatch.
-          return false;
-        }
-
-        // To concrete type
-        const T *p0 = pv0.as<T>();
-        const T *p1 = pv1.as<T>();
-
-        if (!p0 || !p1) {
-          return false;
-        }
-
-        const T p = lerp(*p0, *p1, dt);
+        // Values are stored with concrete type, so no type check is required.
+        const T p = lerp(_values[idx0], _values[idx1], dt);
 
         (*dst) = std::move(p);
         return true;
       } else {
-        if (it == _samples.end()) {
+        if (it == _times.end()) {
           // ???
           return false;
         }
 
-        (*dst) = it->value;
+        (*dst) = _values[size_t(std::distance(_times.begin(), it))];
         return true;
       }
     }
@@ -1312,111 +1335,170 @@ struct TypedTimeSamples {
     return false;
   }
 
-  void add_sample(const Sample &s) {
-    _samples.push_back(s);
-    _dirty = true;
+  bool add_sample(const Sample &s) {
+    return insert_sample(s.t, s.value, s.blocked);
   }
 
-  void add_sample(const double t, const T &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    _samples.emplace_back(s);
-    _dirty = true;
+  bool add_sample(const double t, const T &v) {
+    return insert_sample(t, v, false);
   }
 
-  void add_blocked_sample(const double t) {
-    Sample s;
-    s.t = t;
-    s.blocked = true;
-    _samples.emplace_back(s);
-    _dirty = true;
+  bool add_blocked_sample(const double t) {
+    return insert_sample(t, T(), true);
   }
 
-  bool has_sample_at(const double t) const {
-    if (_dirty) {
-      update();
+  ///
+  /// Overwrite the sample at time `t`, or add a new sample when there is no
+  /// sample at `t`.
+  ///
+  bool set_sample(const double t, const T &v) {
+    thaw();
+
+    size_t idx;
+    if (find_sample_index(t, &idx)) {
+      _values[idx] = v;
+      _blocked[idx] = false;
+      return true;
     }
 
-    const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &s) {
-      return tinyusdz::math::is_close(t, s.t);
-    });
+    return insert_sample(t, v, false);
+  }
 
-    return (it != _samples.end());
+  bool has_sample_at(const double t) const {
+    size_t idx;
+    return find_sample_index(t, &idx);
   }
 
-  bool get_sample_at(const double t, Sample **dst) {
+  ///
+  /// Get a pointer to the value at time `t`. Returns false when there is no
+  /// sample at `t`(or the sample is blocked).
+  ///
+  bool get_sample_at(const double t, T **dst) {
     if (!dst) {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
+    thaw();
 
-    const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &sample) {
-      return math::is_close(t, sample.t);
-    });
+    size_t idx;
+    if (!find_sample_index(t, &idx)) {
+      return false;
+    }
 
-    if (it != _samples.end()) {
-      (*dst) = &(*it); 
+    if (_blocked[idx]) {
+      return false;
     }
-    return false;
+
+    (*dst) = &_values[idx];
+    return true;
   }
 
-  const std::vector<Sample> &get_samples() const {
-    if (_dirty) {
-      update();
+  // Sorted sample times.
+  const std::vector<double> &get_times() const { return _times; }
+
+  // Sample values in the order of `get_times()`.
+  const std::vector<T> &get_values() const { return _values; }
+
+  // Returns false when `idx` is out-of-range.
+  bool is_blocked(size_t idx) const {
+    if (idx >= _blocked.size()) {
+      return false;
     }
 
-    return _samples;
+    return _blocked[idx];
   }
 
-  std::vector<Sample> &samples() {
-    if (_dirty) {
-      update();
-    }
+  using SampleView = value::TimeSampleView<T, Sample>;
+  using MutableSampleView = value::TimeSampleView<T, Sample, false>;
+
+  ///
+  /// Samples in AoS style(no copy). Prefer `get_times()`, `get_values()` and
+  /// `is_blocked()` in new code.
+  ///
+  SampleView get_samples() const {
+    return SampleView(_times, _values, _blocked);
+  }
 
-    return _samples;
+  ///
+  /// DEPRECATED. Modifiable samples. Use `get_sample_at()` or `set_sample()`.
+  ///
+  MutableSampleView samples() {
+    thaw();
+    return MutableSampleView(_times, _values, _blocked);
   }
 
   // From typeless timesamples.
   bool from_timesamples(const value::TimeSamples &ts) {
-    std::vector<Sample> buf;
+    thaw();
+
+    std::vector<T> values;
+    values.reserve(ts.size());
+
     for (size_t i = 0; i < ts.size(); i++) {
-      if (ts.get_samples()[i].value.type_id() != value::TypeTraits<T>::type_id()) {
-        return false;
-      }
-      Sample s;
-      s.t = ts.get_samples()[i].t;
-      s.blocked = ts.get_samples()[i].blocked;
-      if (const auto pv = ts.get_samples()[i].value.as<T>()) {
-        s.value = (*pv);
+      if (const auto pv = ts.get_values()[i].as<T>()) {
+        values.push_back(*pv);
       } else {
         return false;
       }
-
-      buf.push_back(s);
     }
 
-
-    _samples = std::move(buf);
-    _dirty = true;
+    _times = ts.get_times();
+    _values = std::move(values);
+    _blocked.resize(ts.size());
+    for (size_t i = 0; i < ts.size(); i++) {
+      _blocked[i] = ts.is_blocked(i);
+    }
 
     return true;
   }
 
   size_t size() const {
-    if (_dirty) {
-      update();
-    }
-    return _samples.size();
+    return _times.size();
   }
 
  private:
-  // Need to be sorted when looking up the value.
-  mutable std::vector<Sample> _samples;
-  mutable bool _dirty{false};
+  // Binary search with `is_close` tolerance.
+  bool find_sample_index(const double t, size_t *idx) const {
+    auto it = std::lower_bound(_times.begin(), _times.end(), t);
+    if ((it != _times.end()) && math::is_close(t, *it)) {
+      (*idx) = size_t(std::distance(_times.begin(), it));
+      return true;
+    }
+    if ((it != _times.begin()) && math::is_close(t, *(it - 1))) {
+      (*idx) = size_t(std::distance(_times.begin(), it - 1));
+      return true;
+    }
+
+    return false;
+  }
+
+  void thaw() { _frozen = false; }
+
+  bool insert_sample(const double t, const T &v, bool blocked) {
+    thaw();
+
+    if (_times.empty() || (_times.back() <= t)) {
+      // fast path: samples are usually added in time order.
+      _times.push_back(t);
+      _values.push_back(v);
+      _blocked.push_back(blocked);
+      return true;
+    }
+
+    auto it = std::upper_bound(_times.begin(), _times.end(), t);
+    size_t idx = size_t(std::distance(_times.begin(), it));
+
+    _times.insert(it, t);
+    _values.insert(_values.begin() + std::ptrdiff_t(idx), v);
+    _blocked.insert(_blocked.begin() + std::ptrdiff_t(idx), blocked);
+    return true;
+  }
+
+  // Samples are stored in SoA layout and kept sorted by time.
+  std::vector<double> _times;
+  std::vector<T> _values;
+  std::vector<bool> _blocked;
+  bool _frozen{false};
 };
 
 //
@@ -1510,6 +1592,11 @@ struct Animatable {
   // Add None(ValueBlock) sample to timesamples
   void add_blocked_sample(const double t) { _ts.add_blocked_sample(t); }
 
+  void reserve_timesamples(size_t n) { _ts.reserve(n); }
+
+  // Finalize timesamples. See TypedTimeSamples::freeze()
+  void freeze_timesamples() { _ts.freeze(); }
+
   // Scalar
   void set(const T &v) {
     _value = v;
@@ -1542,7 +1629,7 @@ struct Animatable {
   }
 
   void clear_timesamples() {
-    _ts.samples().clear();
+    _ts = TypedTimeSamples<T>();
   }
 
   bool has_value() const {
@@ -3011,6 +3098,169 @@ struct XformOp {
   bool _is_blocked{false};
 };
 
+///
+/// Container of Properties keyed by property name.
+///
+/// Properties are stored contiguously(in insertion order) and looked up with
+/// an open-addressing hash table. Iteration is in the order of property
+/// name(same as std::map<std::string, Property>), so Properties in the same
+/// namespace(e.g. `primvars:`) are adjacent and can be enumerated with
+/// prefix_range() without visiting other Properties.
+///
+/// The interface is a subset of std::map. Unlike std::map, inserting or
+/// erasing a Property invalidates references and iterators to Properties.
+///
+class PropertyMap {
+ public:
+  using key_type = std::string;
+  using mapped_type = Property;
+  using value_type = std::pair<std::string, Property>;
+  using size_type = size_t;
+
+  template <bool IsConst>
+  class Iterator {
+   public:
+    using map_type =
+        typename std::conditional<IsConst, const PropertyMap, PropertyMap>::type;
+    using value_type = PropertyMap::value_type;
+    using reference = typename std::conditional<IsConst, const value_type &,
+                                                value_type &>::type;
+    using pointer = typename std::conditional<IsConst, const value_type *,
+                                              value_type *>::type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    Iterator() = default;
+    Iterator(map_type *map, size_t pos) : _map(map), _pos(pos) {}
+
+    // iterator -> const_iterator
+    template <bool C = IsConst, typename std::enable_if<C, int>::type = 0>
+    Iterator(const Iterator<false> &rhs) : _map(rhs._map), _pos(rhs._pos) {}
+
+    reference operator*() const { return _map->_items[_map->_order[_pos]]; }
+    pointer operator->() const { return &(operator*()); }
+
+    Iterator &operator++() {
+      _pos++;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it = *this;
+      _pos++;
+      return it;
+    }
+    Iterator &operator--() {
+      _pos--;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator it = *this;
+      _pos--;
+      return it;
+    }
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+      return (lhs._map == rhs._map) && (lhs._pos == rhs._pos);
+    }
+    friend bool operator!=(const Iterator &lhs, const Iterator &rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    template <bool>
+    friend class Iterator;
+    friend class PropertyMap;
+
+    map_type *_map{nullptr};
+    size_t _pos{0};  // position in the name order.
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, _items.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, _items.size()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_t size() const { return _items.size(); }
+  bool empty() const { return _items.empty(); }
+
+  void clear();
+
+  ///
+  /// Reserve storage for `n` Properties.
+  ///
+  void reserve(size_t n);
+
+  iterator find(const std::string &key) {
+    size_t idx = find_index(key);
+    return iterator(this, (idx == kNotFound) ? _items.size() : _rank[idx]);
+  }
+
+  const_iterator find(const std::string &key) const {
+    size_t idx = find_index(key);
+    return const_iterator(this,
+                          (idx == kNotFound) ? _items.size() : _rank[idx]);
+  }
+
+  size_t count(const std::string &key) const {
+    return (find_index(key) == kNotFound) ? 0 : 1;
+  }
+
+  // Same as std::map::at(), `key` must exist.
+  Property &at(const std::string &key) {
+    return _items.at(find_index(key)).second;
+  }
+  const Property &at(const std::string &key) const {
+    return _items.at(find_index(key)).second;
+  }
+
+  Property &operator[](const std::string &key) {
+    return emplace(key, Property()).first->second;
+  }
+
+  ///
+  /// Insert a Property when `key` does not exist.
+  ///
+  /// @returns The iterator to the Property of `key` and true when inserted.
+  ///
+  std::pair<iterator, bool> emplace(const std::string &key, Property &&prop);
+  std::pair<iterator, bool> emplace(const std::string &key,
+                                    const Property &prop) {
+    return emplace(key, Property(prop));
+  }
+
+  std::pair<iterator, bool> insert(const value_type &v) {
+    return emplace(v.first, v.second);
+  }
+
+  size_t erase(const std::string &key);
+  iterator erase(const_iterator it);
+
+  ///
+  /// Properties whose name starts with `prefix`(e.g. "primvars:"), in the
+  /// order of name. O(log N) + the number of Properties found.
+  ///
+  std::pair<const_iterator, const_iterator> prefix_range(
+      const std::string &prefix) const;
+
+ private:
+  static constexpr size_t kNotFound = (std::numeric_limits<size_t>::max)();
+
+  size_t find_index(const std::string &key) const;
+  void insert_table(size_t idx);
+  void rebuild_index(size_t capacity = 0);
+
+  std::vector<value_type> _items;  // In insertion order.
+  std::vector<uint64_t> _hashes;   // Hash of the name of _items[i].
+  std::vector<uint32_t> _order;    // Item indices sorted by name.
+  std::vector<uint32_t> _rank;     // Position of _items[i] in _order.
+  std::vector<uint32_t> _table;    // Item index + 1. 0 = empty slot.
+};
+
 // forward decl
 class MaterialBinding;
 struct Model;
@@ -3027,15 +3277,15 @@ struct Variant {
   const PrimMeta &metas() const { return _metas; }
   PrimMeta &metas() { return _metas; }
 
-  std::map<std::string, Property> &properties() { return _props; }
-  const std::map<std::string, Property> &properties() const { return _props; }
+  PropertyMap &properties() { return _props; }
+  const PropertyMap &properties() const { return _props; }
 
   const std::vector<Prim> &primChildren() const { return _primChildren; }
   std::vector<Prim> &primChildren() { return _primChildren; }
 
  private:
   // std::vector<int64_t> primIndices;
-  std::map<std::string, Property> _props;
+  PropertyMap _props;
 
   // std::string _name; // variant name
   PrimMeta _metas;
@@ -3380,7 +3630,7 @@ struct Model : public Collection, MaterialBinding {
 
   // std::map<std::string, VariantSet> variantSets;
 
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   const std::vector<value::token> &primChildrenNames() const {
     return _primChildren;
@@ -3403,7 +3653,7 @@ struct Klass {
 
   std::vector<std::pair<ListEditQual, Reference>> references;
 
-  std::map<std::string, Property> props;
+  PropertyMap props;
 };
 #endif
 
@@ -3548,7 +3798,7 @@ struct Scope : Collection, MaterialBinding {
 
   std::map<std::string, VariantSet> variantSet;
 
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   const std::vector<value::token> &primChildrenNames() const {
     return _primChildren;
@@ -4071,8 +4321,6 @@ class PrimSpec {
 
   PrimMeta &metas() { return _metas; }
 
-  using PropertyMap = std::map<std::string, Property>;
-
   const PropertyMap &props() const { return _props; }
   PropertyMap &props() { return _props; }
 
@@ -4576,7 +4824,7 @@ DEFINE_TYPE_TRAIT(Extent, "float3[]", TYPE_ID_EXTENT, 2);  // float3[2]
 
 namespace prim {
 
-using PropertyMap = std::map<std::string, Property>;
+using PropertyMap = tinyusdz::PropertyMap;
 using ReferenceList = std::pair<ListEditQual, std::vector<Reference>>;
 using PayloadList = std::pair<ListEditQual, std::vector<Payload>>;
 
@@ -34,67 +34,36 @@ bool PrimVar::get_interpolated_value(const double t, const value::TimeSampleInte
   }
 
   if (has_timesamples()) {
-    const std::vector<value::TimeSamples::Sample> &samples = _ts.get_samples();
-
-    if (samples.empty()) {
+    if (_ts.empty()) {
       // ???
       return false;
     }
 
+    const std::vector<value::Value> &values = _ts.get_values();
+
     if (value::TimeCode(t).is_default())  {
       // FIXME: Use the first item for now.
-      if (samples[0].blocked) {
+      if (_ts.is_blocked(0)) {
         return false;
       }
 
-      (*dst) = samples[0].value;
+      (*dst) = values[0];
       return true;
     } else {
 
       if (tinterp == value::TimeSampleInterpolationType::Held || !value::IsLerpSupportedType(_value.type_id())) {
 
-        auto it = std::upper_bound(
-          samples.begin(), samples.end(), t,
-          [](double tval, const value::TimeSamples::Sample &a) { return tval < a.t; });
-
-        const auto it_minus_1 = (it == samples.begin()) ? samples.begin() : (it - 1);
-
-        (*dst) = it_minus_1->value;
+        (*dst) = values[_ts.held_index(t)];
         return true;
 
       } else { // Lerp 
 
-        // TODO: Unify code in prim-types.hh
-        auto it = std::lower_bound(
-            samples.begin(), samples.end(), t,
-            [](const value::TimeSamples::Sample &a, double tval) { return a.t < tval; });
-
-        const auto it_minus_1 = (it == samples.begin()) ? samples.begin() : (it - 1);
-
-        size_t idx0 = size_t(std::max(
-            int64_t(0),
-            std::min(int64_t(samples.size() - 1),
-                     int64_t(std::distance(samples.begin(), it_minus_1)))));
-        size_t idx1 =
-            size_t(std::max(int64_t(0), std::min(int64_t(samples.size() - 1),
-                                                 int64_t(idx0) + 1)));
-
-        double tl = samples[idx0].t;
-        double tu = samples[idx1].t;
-
-        double dt = (t - tl);
-        if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
-          // slope is zero.
-          dt = 0.0;
-        } else {
-          dt /= (tu - tl);
-        }
-
-        // Just in case.
-        dt = std::max(0.0, std::min(1.0, dt));
-
-        const value::Value &p0 = samples[idx0].value;
-        const value::Value &p1 = samples[idx1].value;
+        size_t idx0, idx1;
+        double dt;
+        _ts.lerp_indices(t, &idx0, &idx1, &dt);
+
+        const value::Value &p0 = values[idx0];
+        const value::Value &p1 = values[idx1];
 
         bool ret = value::Lerp(p0, p1, dt, dst);
         return ret;
@@ -161,8 +161,12 @@ struct PrimVar {
   }
 
   nonstd::optional<value::TimeSamples::Sample> get_timesample(size_t idx) const {
-    if (idx < _ts.get_samples().size()) {
-      return _ts.get_samples()[idx];
+    if (idx < _ts.size()) {
+      value::TimeSamples::Sample s;
+      s.t = _ts.get_times()[idx];
+      s.value = _ts.get_values()[idx];
+      s.blocked = _ts.is_blocked(idx);
+      return s;
     }
     return nonstd::nullopt;
   }
@@ -191,11 +195,11 @@ struct PrimVar {
       return nonstd::nullopt;
     }
 
-    if (idx >= _ts.get_samples().size()) {
+    if (idx >= _ts.size()) {
       return nonstd::nullopt;
     }
 
-    return _ts.get_samples()[idx].blocked;
+    return _ts.is_blocked(idx);
   }
 
   // For Scalar only
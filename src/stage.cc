@@ -85,6 +85,47 @@ nonstd::optional<const Prim *> GetPrimAtPathRec(const Prim *parent,
   return nonstd::nullopt;
 }
 
+///
+/// Get Prim from the location(child index at each depth) stored in Prim
+/// lookup index. Returns nullptr when the location no longer exists, or the
+/// Prim at the location does not have the Prim path `abs_path`(when
+/// `abs_path` is given), i.e. the Prim hierarchy was modified after the index
+/// was built.
+///
+const Prim *ResolvePrimLocation(const std::vector<Prim> &root_prims,
+                                const std::vector<uint32_t> &location,
+                                const std::string *abs_path) {
+  const std::vector<Prim> *prims = &root_prims;
+  const Prim *prim{nullptr};
+  size_t pos = 0;
+
+  for (const uint32_t idx : location) {
+    if (idx >= prims->size()) {
+      return nullptr;
+    }
+
+    prim = &(*prims)[idx];
+
+    if (abs_path) {
+      const std::string &elementName = prim->element_path().prim_part();
+      if ((pos >= abs_path->size()) || ((*abs_path)[pos] != '/') ||
+          (abs_path->compare(pos + 1, elementName.size(), elementName) !=
+           0)) {
+        return nullptr;
+      }
+      pos += 1 + elementName.size();
+    }
+
+    prims = &prim->children();
+  }
+
+  if (abs_path && (pos != abs_path->size())) {
+    return nullptr;
+  }
+
+  return prim;
+}
+
 }  // namespace
 
 //
@@ -113,29 +154,23 @@ nonstd::expected<const Prim *, std::string> Stage::GetPrimAtPath(
         "Path is not absolute. Non-absolute Path is TODO.\n");
   }
 
-  if (_dirty) {
-    DCOUT("clear cache.");
-    // Clear cache.
-    _prim_path_cache.clear();
-
-    _dirty = false;
-  } else {
-    // First find from a cache.
-    auto ret = _prim_path_cache.find(path.prim_part());
-    if (ret != _prim_path_cache.end()) {
-      DCOUT("Found cache.");
-      return ret->second;
+  if (IsPrimIndexValid()) {
+    auto ret = _prim_path_index.find(path.full_path_name());
+    if (ret != _prim_path_index.end()) {
+      if (const Prim *prim = ResolvePrimLocation(
+              _root_nodes, _prim_locations[ret->second], &ret->first)) {
+        return prim;
+      }
     }
   }
 
-
   // Brute-force search.
+  // Prim lookup index is not yet built(`commit()` is not called), or the Prim
+  // hierarchy was modified through non-const accessors after the index was
+  // built.
   for (const auto &parent : _root_nodes) {
     if (auto pv =
             GetPrimAtPathRec(&parent, /* root */ "", path, /* depth */ 0)) {
-      // Add to cache.
-      // Assume pointer address does not change unless dirty state.
-      _prim_path_cache[path.prim_part()] = pv.value();
       return pv.value();
     }
   }
@@ -219,26 +254,23 @@ bool Stage::find_prim_by_prim_id(const uint64_t prim_id, const Prim *&prim,
     return false;
   }
 
-  if (_prim_id_dirty) {
-    DCOUT("clear prim_id cache.");
-    // Clear cache.
-    _prim_id_cache.clear();
-
-    _prim_id_dirty = false;
-  } else {
-    // First find from a cache.
-    auto ret = _prim_id_cache.find(prim_id);
-    if (ret != _prim_id_cache.end()) {
-      DCOUT("Found cache.");
-      prim = ret->second;
-      return true;
+  if (IsPrimIndexValid()) {
+    auto ret = _prim_id_index.find(prim_id);
+    if (ret != _prim_id_index.end()) {
+      const Prim *p = ResolvePrimLocation(_root_nodes,
+                                          _prim_locations[ret->second],
+                                          /* abs_path */ nullptr);
+      if (p && (p->prim_id() == int64_t(prim_id))) {
+        prim = p;
+        return true;
+      }
     }
   }
 
+  // Brute-force search.
   const Prim *p{nullptr};
   for (const auto &root : root_prims()) {
     if (FindPrimByPrimIdRec(prim_id, &root, &p, 0, err)) {
-      _prim_id_cache[prim_id] = p;
       prim = p;
       return true;
     }
@@ -260,6 +292,86 @@ bool Stage::find_prim_by_prim_id(const uint64_t prim_id, Prim *&prim,
   return true;
 }
 
+namespace {
+
+void BuildPrimIndexRec(
+    const Prim &prim, const std::string &parent_path,
+    std::vector<uint32_t> &location,
+    std::vector<std::vector<uint32_t>> &locations,
+    std::unordered_map<std::string, size_t> &path_index,
+    std::unordered_map<uint64_t, size_t> &prim_id_index) {
+  if (location.size() > 1024 * 1024 * 128) {
+    // too deep node.
+    return;
+  }
+
+  // Build the key in the same way as `GetPrimAtPathRec`.
+  std::string abs_path = parent_path + "/" + prim.element_path().prim_part();
+
+  size_t loc_id = locations.size();
+  locations.push_back(location);
+
+  // Do not overwrite an existing entry, so that the first Prim in depth-first
+  // order wins(same result as brute-force search).
+  path_index.emplace(abs_path, loc_id);
+  if (prim.prim_id() > 0) {
+    prim_id_index.emplace(uint64_t(prim.prim_id()), loc_id);
+  }
+
+  for (size_t i = 0; i < prim.children().size(); i++) {
+    location.push_back(uint32_t(i));
+    BuildPrimIndexRec(prim.children()[i], abs_path, location, locations,
+                      path_index, prim_id_index);
+    location.pop_back();
+  }
+}
+
+}  // namespace
+
+Stage::Stage(const Stage &rhs) { (*this) = rhs; }
+
+Stage &Stage::operator=(const Stage &rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  _root_nodes = rhs._root_nodes;
+  _root_node_nameSet = rhs._root_node_nameSet;
+  name = rhs.name;
+  default_root_node = rhs.default_root_node;
+  stage_metas = rhs.stage_metas;
+  _err = rhs._err;
+  _warn = rhs._warn;
+  _prim_id_allocator = rhs._prim_id_allocator;
+
+  // Prim lookup index stores Prim locations(not pointers), so it is also
+  // valid for the copied Prims.
+  _prim_locations = rhs._prim_locations;
+  _prim_path_index = rhs._prim_path_index;
+  _prim_id_index = rhs._prim_id_index;
+  _prim_index_valid = rhs._prim_index_valid;
+
+  return *this;
+}
+
+void Stage::RebuildPrimIndex() {
+  _prim_locations.clear();
+  _prim_path_index.clear();
+  _prim_id_index.clear();
+
+  for (size_t i = 0; i < _root_nodes.size(); i++) {
+    AddToPrimIndex(i);
+  }
+
+  _prim_index_valid = true;
+}
+
+void Stage::AddToPrimIndex(const size_t root_idx) {
+  std::vector<uint32_t> location{uint32_t(root_idx)};
+  BuildPrimIndexRec(_root_nodes[root_idx], /* root */ "", location,
+                    _prim_locations, _prim_path_index, _prim_id_index);
+}
+
 nonstd::expected<const Prim *, std::string> Stage::GetPrimFromRelativePath(
     const Prim &root, const Path &path) const {
   // TODO: Resolve "../"
@@ -461,9 +573,13 @@ void PrimPrintRec(std::stringstream &ss, const Prim &prim, uint32_t indent) {
 }  // namespace
 
 std::string Stage::ExportToString(bool relative_path) const {
-  (void)relative_path; // TODO
-
   std::stringstream ss;
+  ExportToStream(ss, relative_path);
+  return ss.str();
+}
+
+void Stage::ExportToStream(std::ostream &ss, bool relative_path) const {
+  (void)relative_path; // TODO
 
   ss << "#usda 1.0\n";
 
@@ -490,7 +606,7 @@ std::string Stage::ExportToString(bool relative_path) const {
       const auto it = primNameTable.find(nameTok.str());
       if (it != primNameTable.end()) {
         //PrimPrintRec(ss, *(it->second), 0);
-        ss << prim::print_prim(*(it->second), 0);
+        prim::print_prim(ss, *(it->second), 0);
         if (i != (stage_metas.primChildren.size() - 1)) {
           ss << "\n";
         }
@@ -501,15 +617,13 @@ std::string Stage::ExportToString(bool relative_path) const {
   } else {
     for (size_t i = 0; i < _root_nodes.size(); i++) {
       //PrimPrintRec(ss, _root_nodes[i], 0);
-      ss << prim::print_prim(_root_nodes[i], 0);
+      prim::print_prim(ss, _root_nodes[i], 0);
 
       if (i != (_root_nodes.size() - 1)) {
         ss << "\n";
       }
     }
   }
-
-  return ss.str();
 }
 
 bool Stage::allocate_prim_id(uint64_t *prim_id) const {
@@ -598,8 +712,7 @@ bool Stage::compute_absolute_prim_path_and_assign_prim_id(
     }
   }
 
-  // TODO: Only set dirty when prim_id changed.
-  _prim_id_dirty = true;
+  RebuildPrimIndex();
 
   return true;
 }
@@ -614,6 +727,8 @@ bool Stage::compute_absolute_prim_path() {
     }
   }
 
+  RebuildPrimIndex();
+
   return true;
 }
 
@@ -679,9 +794,14 @@ bool Stage::add_root_prim(Prim &&prim, bool rename_prim_name) {
 
 
   _root_node_nameSet.insert(elementName);
+
   _root_nodes.emplace_back(std::move(prim));
 
-  _dirty = true;
+  // Incrementally update Prim lookup index. Existing entries are Prim
+  // locations, so they stay valid when root Prims are relocated.
+  if (IsPrimIndexValid()) {
+    AddToPrimIndex(_root_nodes.size() - 1);
+  }
 
   return true;
 
@@ -746,7 +866,7 @@ bool Stage::replace_root_prim(const std::string &prim_name, Prim &&prim) {
     _root_nodes.emplace_back(std::move(prim)); // add
   }
 
-  _dirty = true;
+  _prim_index_valid = false;
 
   return true;
 }
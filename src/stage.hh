@@ -4,6 +4,9 @@
 // Stage: Similar to Scene or Scene graph
 #pragma once
 
+#include <ostream>
+#include <unordered_map>
+
 #include "composition.hh"
 #include "prim-types.hh"
 
@@ -21,6 +24,18 @@ class PrimRange;
 // Similar to UsdStage, but much more something like a Scene(scene graph)
 class Stage {
  public:
+  Stage() = default;
+
+  ///
+  /// Copying a Stage rebuilds the Prim lookup index of the copy(the index
+  /// stores pointers to Prims owned by the Stage).
+  ///
+  Stage(const Stage &rhs);
+  Stage &operator=(const Stage &rhs);
+
+  Stage(Stage &&rhs) = default;
+  Stage &operator=(Stage &&rhs) = default;
+
   // pxrUSD compat API ----------------------------------------
   static Stage CreateInMemory() { return Stage(); }
 
@@ -55,6 +70,13 @@ class Stage {
 
   // pxrUSD compat API end -------------------------------------
 
+  ///
+  /// Write Stage as ASCII(USDA) representation to `os`.
+  /// Produces the same text as `ExportToString`, but Prims are written to
+  /// `os` one by one, so the whole USDA text is not held in memory.
+  ///
+  void ExportToStream(std::ostream &os, bool relative_path = false) const;
+
   ///
   /// Get Prim from a children of given root Prim.
   /// Path must be relative Path.
@@ -200,6 +222,8 @@ class Stage {
   /// - Compute absolute path and set it to Prim::abs_path for each Prim
   /// currently added to this Stage.
   /// - Assign unique ID to Prim
+  /// - Rebuild Prim lookup index(Path -> Prim, prim_id -> Prim) used in
+  /// `GetPrimAtPath` and `find_prim_by_prim_id`
   ///
   /// @param[in] force_assign_prim_id true Overwrite `prim_id` of each Prim.
   /// false only assign Prim id when `prim_id` is -1(preserve user-assgiend
@@ -221,6 +245,7 @@ class Stage {
 
   ///
   /// Compute absolute Prim path for Prims in this Stage.
+  /// Also rebuilds Prim lookup index.
   ///
   bool compute_absolute_prim_path();
 
@@ -295,17 +320,43 @@ class Stage {
   mutable std::string _err;
   mutable std::string _warn;
 
-  // Cached prim path.
-  // key : prim_part string (e.g. "/path/bora")
-  mutable std::map<std::string, const Prim *> _prim_path_cache;
+  ///
+  /// Rebuild Prim lookup index from current Prim hierarchy.
+  ///
+  void RebuildPrimIndex();
 
-  // Cached prim_id -> Prim lookup
-  // key : prim_id
-  mutable std::map<uint64_t, const Prim *> _prim_id_cache;
+  ///
+  /// Add root Prim at `root_idx` and its descendants to Prim lookup index.
+  ///
+  void AddToPrimIndex(const size_t root_idx);
 
-  mutable bool _dirty{true}; // True when Stage content changes(addition, deletion, composition/flatten, etc.)
+  ///
+  /// Prim lookup index is built by `commit()`(or
+  /// `compute_absolute_prim_path()`).
+  ///
+  bool IsPrimIndexValid() const {
+    return _prim_index_valid;
+  }
 
-  mutable bool _prim_id_dirty{true}; // True when Prim Id assignent changed(TODO: Unify with `_dirty` flag)
+  // Prim lookup index. Never modified in const methods, so lookup can be
+  // done from multiple threads.
+  //
+  // The index stores the location of a Prim(child index at each depth.
+  // first item is the index of root Prim) instead of a pointer, so an entry
+  // never dangles when the Prim hierarchy is modified through non-const
+  // `root_prims()`/`Prim::children()`. The Prim at the location is verified
+  // (Prim path or prim_id) on lookup, and lookup falls back to brute-force
+  // search when it does not match or no entry is found.
+  std::vector<std::vector<uint32_t>> _prim_locations;
+
+  // key : absolute Prim path string (e.g. "/path/bora"), value : index to
+  // `_prim_locations`
+  std::unordered_map<std::string, size_t> _prim_path_index;
+
+  // key : prim_id, value : index to `_prim_locations`
+  std::unordered_map<uint64_t, size_t> _prim_id_index;
+
+  bool _prim_index_valid{false};
 
   mutable HandleAllocator<uint64_t> _prim_id_allocator;
 };
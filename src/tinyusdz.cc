@@ -124,7 +124,9 @@ bool LoadUSDCFromMemory(const uint8_t *addr, const size_t length,
 
   usdc::USDCReaderConfig config;
   config.numThreads = options.num_threads;
+  config.lazy_array_unpack = options.lazy_array_unpack;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
+  config.stats = options.stats;
   usdc::USDCReader reader(&sr, config);
 
   if (!reader.ReadUSDC()) {
@@ -264,39 +266,273 @@ struct USDZAssetInfo {
   size_t byte_end;
 };
 
-bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
-                     std::vector<USDZAssetInfo> *assets, std::string *warn,
-                     std::string *err) {
-  (void)warn;
+//
+// PK zip format:
+// https://users.cs.jmu.edu/buchhofp/forensics/formats/pkzip.html
+// https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+//
+constexpr uint32_t kZIPLocalFileHeaderSignature = 0x04034b50;
+constexpr uint32_t kZIPCentralDirectoryHeaderSignature = 0x02014b50;
+constexpr uint32_t kZIPEndOfCentralDirectorySignature = 0x06054b50;
+constexpr uint32_t kZIP64EndOfCentralDirectorySignature = 0x06064b50;
+constexpr uint32_t kZIP64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+
+constexpr size_t kZIPLocalFileHeaderSize = 30;
+constexpr size_t kZIPCentralDirectoryHeaderSize = 46;
+constexpr size_t kZIPEndOfCentralDirectorySize = 22;
+constexpr size_t kZIP64EndOfCentralDirectorySize = 56;
+constexpr size_t kZIP64EndOfCentralDirectoryLocatorSize = 20;
+
+// ZIP data is little endian.
+template <typename T>
+T ReadZIPValue(const uint8_t *p) {
+  T v;
+  memcpy(&v, p, sizeof(T));
+  return v;
+}
 
-  if (!addr) {
+///
+/// Find End of central directory record(EOCD) from the end of ZIP data.
+/// Return false when EOCD is not found.
+///
+bool FindZIPEndOfCentralDirectory(const uint8_t *addr, const size_t length,
+                                  size_t *eocd_offset) {
+  if (length < kZIPEndOfCentralDirectorySize) {
+    return false;
+  }
+
+  // EOCD is followed by an archive comment(up to 65535 bytes).
+  const size_t search_end =
+      (length > kZIPEndOfCentralDirectorySize + 65535)
+          ? (length - kZIPEndOfCentralDirectorySize - 65535)
+          : 0;
+
+  for (size_t offset = length - kZIPEndOfCentralDirectorySize + 1;
+       offset-- > search_end;) {
+    if (ReadZIPValue<uint32_t>(addr + offset) ==
+        kZIPEndOfCentralDirectorySignature) {
+      const uint16_t comment_len = ReadZIPValue<uint16_t>(addr + offset + 20);
+      if (offset + kZIPEndOfCentralDirectorySize + comment_len == length) {
+        (*eocd_offset) = offset;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+///
+/// Build the asset list from the central directory of ZIP data.
+///
+bool ParseZIPCentralDirectory(const uint8_t *addr, const size_t length,
+                              const size_t eocd_offset,
+                              std::vector<USDZAssetInfo> *assets,
+                              std::string *err) {
+  uint64_t num_entries = ReadZIPValue<uint16_t>(addr + eocd_offset + 10);
+  uint64_t cd_size = ReadZIPValue<uint32_t>(addr + eocd_offset + 12);
+  uint64_t cd_offset = ReadZIPValue<uint32_t>(addr + eocd_offset + 16);
+
+  if ((num_entries == 0xffff) || (cd_size == 0xffffffff) ||
+      (cd_offset == 0xffffffff)) {
+    // ZIP64
+    if (eocd_offset < kZIP64EndOfCentralDirectoryLocatorSize) {
+      if (err) {
+        (*err) += "ZIP64 end of central directory locator not found.\n";
+      }
+      return false;
+    }
+
+    const uint8_t *locator =
+        addr + eocd_offset - kZIP64EndOfCentralDirectoryLocatorSize;
+    if (ReadZIPValue<uint32_t>(locator) !=
+        kZIP64EndOfCentralDirectoryLocatorSignature) {
+      if (err) {
+        (*err) += "ZIP64 end of central directory locator not found.\n";
+      }
+      return false;
+    }
+
+    const uint64_t eocd64_offset = ReadZIPValue<uint64_t>(locator + 8);
+    if ((eocd64_offset > length) ||
+        ((length - eocd64_offset) < kZIP64EndOfCentralDirectorySize) ||
+        (ReadZIPValue<uint32_t>(addr + eocd64_offset) !=
+         kZIP64EndOfCentralDirectorySignature)) {
+      if (err) {
+        (*err) += "Invalid ZIP64 end of central directory record.\n";
+      }
+      return false;
+    }
+
+    num_entries = ReadZIPValue<uint64_t>(addr + eocd64_offset + 32);
+    cd_size = ReadZIPValue<uint64_t>(addr + eocd64_offset + 40);
+    cd_offset = ReadZIPValue<uint64_t>(addr + eocd64_offset + 48);
+  }
+
+  if ((cd_offset > length) || (cd_size > (length - cd_offset))) {
     if (err) {
-      (*err) += "null for `addr` argument.\n";
+      (*err) += "Invalid central directory offset or size in ZIP data.\n";
     }
     return false;
   }
 
-  if (length < (11 * 8) + 30) {  // 88 for USDC header, 30 for ZIP header
-    // ???
+  // Each entry occupies 46 bytes or more.
+  if (num_entries > (cd_size / kZIPCentralDirectoryHeaderSize)) {
     if (err) {
-      (*err) += "File size too short. Looks like this file is not a USDZ\n";
+      (*err) += "Invalid number of entries in ZIP central directory.\n";
     }
     return false;
   }
 
+  if (assets) {
+    assets->reserve(size_t(num_entries));
+  }
+
+  const uint8_t *cd = addr + cd_offset;
+  size_t offset = 0;
+  for (uint64_t i = 0; i < num_entries; i++) {
+    if ((cd_size - offset) < kZIPCentralDirectoryHeaderSize) {
+      if (err) {
+        (*err) += "Truncated ZIP central directory.\n";
+      }
+      return false;
+    }
+
+    const uint8_t *header = cd + offset;
+    if (ReadZIPValue<uint32_t>(header) != kZIPCentralDirectoryHeaderSignature) {
+      if (err) {
+        (*err) += "Invalid ZIP central directory header signature.\n";
+      }
+      return false;
+    }
+
+    const uint16_t compr_method = ReadZIPValue<uint16_t>(header + 10);
+    uint64_t uncompr_bytes = ReadZIPValue<uint32_t>(header + 24);
+    uint64_t compr_bytes = ReadZIPValue<uint32_t>(header + 20);
+    const uint16_t name_len = ReadZIPValue<uint16_t>(header + 28);
+    const uint16_t extra_field_len = ReadZIPValue<uint16_t>(header + 30);
+    const uint16_t comment_len = ReadZIPValue<uint16_t>(header + 32);
+    uint64_t local_header_offset = ReadZIPValue<uint32_t>(header + 42);
+
+    const size_t entry_size = kZIPCentralDirectoryHeaderSize + name_len +
+                              extra_field_len + comment_len;
+    if ((cd_size - offset) < entry_size) {
+      if (err) {
+        (*err) += "Truncated ZIP central directory.\n";
+      }
+      return false;
+    }
+
+    // ZIP64 extended information extra field. Only fields whose value is
+    // 0xffffffff in the header are stored, in this order.
+    {
+      const uint8_t *extra = header + kZIPCentralDirectoryHeaderSize + name_len;
+      size_t p = 0;
+      while (p + 4 <= extra_field_len) {
+        const uint16_t id = ReadZIPValue<uint16_t>(extra + p);
+        const uint16_t sz = ReadZIPValue<uint16_t>(extra + p + 2);
+        if (p + 4 + sz > extra_field_len) {
+          break;
+        }
+
+        if (id == 0x0001) {
+          const uint8_t *field = extra + p + 4;
+          size_t q = 0;
+          if ((uncompr_bytes == 0xffffffff) && (q + 8 <= sz)) {
+            uncompr_bytes = ReadZIPValue<uint64_t>(field + q);
+            q += 8;
+          }
+          if ((compr_bytes == 0xffffffff) && (q + 8 <= sz)) {
+            compr_bytes = ReadZIPValue<uint64_t>(field + q);
+            q += 8;
+          }
+          if ((local_header_offset == 0xffffffff) && (q + 8 <= sz)) {
+            local_header_offset = ReadZIPValue<uint64_t>(field + q);
+            q += 8;
+          }
+          break;
+        }
+
+        p += 4 + sz;
+      }
+    }
+
+    std::string varname(reinterpret_cast<const char *>(header) +
+                            kZIPCentralDirectoryHeaderSize,
+                        name_len);
+
+    // USDZ only supports uncompressed ZIP
+    if ((compr_method != 0) || (compr_bytes != uncompr_bytes)) {
+      if (err) {
+        (*err) += "Compressed ZIP is not supported for USDZ\n";
+      }
+      return false;
+    }
+
+    // Data offset is determined by the local file header, since its extra
+    // field(used for 64 bytes alignment) may differ from the central one.
+    if ((local_header_offset > length) ||
+        ((length - local_header_offset) < kZIPLocalFileHeaderSize) ||
+        (ReadZIPValue<uint32_t>(addr + local_header_offset) !=
+         kZIPLocalFileHeaderSignature)) {
+      if (err) {
+        (*err) += "Invalid local file header offset in ZIP data: " + varname +
+                  "\n";
+      }
+      return false;
+    }
+
+    const uint8_t *local_header = addr + local_header_offset;
+    const uint64_t data_offset = local_header_offset + kZIPLocalFileHeaderSize +
+                                 ReadZIPValue<uint16_t>(local_header + 26) +
+                                 ReadZIPValue<uint16_t>(local_header + 28);
+
+    if ((data_offset > length) || (uncompr_bytes > (length - data_offset))) {
+      if (err) {
+        (*err) += "Invalid ZIP data\n";
+      }
+      return false;
+    }
+
+    // In usdz, data must be aligned at 64bytes boundary.
+    if ((data_offset % 64) != 0) {
+      if (err) {
+        (*err) += "Data offset must be mulitple of 64bytes for USDZ, but got " +
+                  std::to_string(data_offset) + ".\n";
+      }
+      return false;
+    }
+
+    if (assets) {
+      USDZAssetInfo info;
+      DCOUT("USDZasset[" << assets->size() << "] " << varname << ", byte_begin " << data_offset << ", length " << uncompr_bytes << "\n");
+      info.filename = std::move(varname);
+      info.byte_begin = size_t(data_offset);
+      info.byte_end = size_t(data_offset + uncompr_bytes);
+
+      assets->push_back(std::move(info));
+    }
+
+    offset += entry_size;
+  }
+
+  return true;
+}
+
+///
+/// Scan local file headers from the beginning of ZIP data.
+/// Used when the central directory is not available(e.g. only the header part of USDZ data is given).
+///
+bool ScanZIPLocalFileHeaders(const uint8_t *addr, const size_t length,
+                             std::vector<USDZAssetInfo> *assets,
+                             std::string *err) {
   size_t offset = 0;
-  while ((offset + 30) < length) {
-    //
-    // PK zip format:
-    // https://users.cs.jmu.edu/buchhofp/forensics/formats/pkzip.html
-    //
-    std::vector<char> local_header(30);
-    memcpy(local_header.data(), addr + offset, 30);
+  while ((offset + kZIPLocalFileHeaderSize) < length) {
+    const uint8_t *local_header = addr + offset;
 
     // Check signagure(first 4 bytes)
     // Must be \x50\x4b\x03\x04
-    if ((local_header[0] == 0x50) && (local_header[1] == 0x4b) &&
-        (local_header[2] == 0x03) && (local_header[3] == 0x04)) {
+    if (ReadZIPValue<uint32_t>(local_header) == kZIPLocalFileHeaderSignature) {
       // ok
 
       // TODO: Check other header info(version, flags, crc32)
@@ -314,11 +550,10 @@ bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
       }
     }
 
-    offset += 30;
+    offset += kZIPLocalFileHeaderSize;
 
     // read in the variable name
-    uint16_t name_len;
-    memcpy(&name_len, &local_header[26], sizeof(uint16_t));
+    const uint16_t name_len = ReadZIPValue<uint16_t>(local_header + 26);
     if ((offset + name_len) > length) {
       if (err) {
         (*err) += "Invalid ZIP data\n";
@@ -326,14 +561,12 @@ bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
       return false;
     }
 
-    std::string varname(name_len, ' ');
-    memcpy(&varname[0], addr + offset, name_len);
+    const size_t name_offset = offset;
 
     offset += name_len;
 
     // read in the extra field
-    uint16_t extra_field_len;
-    memcpy(&extra_field_len, &local_header[28], sizeof(uint16_t));
+    const uint16_t extra_field_len = ReadZIPValue<uint16_t>(local_header + 28);
     if (extra_field_len > 0) {
       if (offset + extra_field_len > length) {
         if (err) {
@@ -354,10 +587,9 @@ bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
       return false;
     }
 
-    uint16_t compr_method = *reinterpret_cast<uint16_t *>(&local_header[0] + 8);
-    // uint32_t compr_bytes = *reinterpret_cast<uint32_t*>(&local_header[0]+18);
-    uint32_t uncompr_bytes;
-    memcpy(&uncompr_bytes, &local_header[22], sizeof(uncompr_bytes));
+    const uint16_t compr_method = ReadZIPValue<uint16_t>(local_header + 8);
+    // uint32_t compr_bytes = ReadZIPValue<uint32_t>(local_header + 18);
+    const uint32_t uncompr_bytes = ReadZIPValue<uint32_t>(local_header + 22);
 
     // USDZ only supports uncompressed ZIP
     if (compr_method != 0) {
@@ -369,12 +601,13 @@ bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
 
     if (assets) {
       USDZAssetInfo info;
-      DCOUT("USDZasset[" << assets->size() << "] " << varname << ", byte_begin " << offset << ", length " << uncompr_bytes << "\n");
-      info.filename = varname;
+      info.filename = std::string(
+          reinterpret_cast<const char *>(addr) + name_offset, name_len);
+      DCOUT("USDZasset[" << assets->size() << "] " << info.filename << ", byte_begin " << offset << ", length " << uncompr_bytes << "\n");
       info.byte_begin = offset;
       info.byte_end = offset + uncompr_bytes;
 
-      assets->push_back(info);
+      assets->push_back(std::move(info));
     }
 
     offset += uncompr_bytes;
@@ -383,6 +616,52 @@ bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
   return true;
 }
 
+///
+/// Parse USDZ(ZIP) header.
+///
+/// When `assets` is given, the asset list is built from the central directory
+/// (one read per entry, no scan over the whole data). Falls back to scanning
+/// local file headers when the central directory is not found.
+///
+bool ParseUSDZHeader(const uint8_t *addr, const size_t length,
+                     std::vector<USDZAssetInfo> *assets, std::string *warn,
+                     std::string *err) {
+  (void)warn;
+
+  if (!addr) {
+    if (err) {
+      (*err) += "null for `addr` argument.\n";
+    }
+    return false;
+  }
+
+  if (length < (11 * 8) + 30) {  // 88 for USDC header, 30 for ZIP header
+    // ???
+    if (err) {
+      (*err) += "File size too short. Looks like this file is not a USDZ\n";
+    }
+    return false;
+  }
+
+  if (ReadZIPValue<uint32_t>(addr) != kZIPLocalFileHeaderSignature) {
+    if (err) {
+      (*err) += "PKZIP header not found.\n";
+    }
+    return false;
+  }
+
+  if (assets) {
+    size_t eocd_offset;
+    if (FindZIPEndOfCentralDirectory(addr, length, &eocd_offset)) {
+      return ParseZIPCentralDirectory(addr, length, eocd_offset, assets, err);
+    }
+
+    DCOUT("ZIP central directory not found. Scan local file headers.");
+  }
+
+  return ScanZIPLocalFileHeaders(addr, length, assets, err);
+}
+
 }  // namespace
 
 bool LoadUSDZFromMemory(const uint8_t *addr, const size_t length,
@@ -390,8 +669,11 @@ bool LoadUSDZFromMemory(const uint8_t *addr, const size_t length,
                         std::string *warn, std::string *err,
                         const USDLoadOptions &options) {
   std::vector<USDZAssetInfo> assets;
-  if (!ParseUSDZHeader(addr, length, &assets, warn, err)) {
-    return false;
+  {
+    performance::ScopedPhase phase(options.stats, "usdz:read_index");
+    if (!ParseUSDZHeader(addr, length, &assets, warn, err)) {
+      return false;
+    }
   }
 
 #ifdef TINYUSDZ_LOCAL_DEBUG_PRINT
@@ -728,6 +1010,8 @@ bool LoadUSDAFromMemory(const uint8_t *addr, const size_t length,
   tinyusdz::usda::USDAReaderConfig config;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
   config.allow_unknown_apiSchema = !options.strict_apiSchema_check;
+  config.numThreads = options.usda_parallel_parse ? options.num_threads : 1;
+  config.stats = options.stats;
   reader.set_reader_config(config);
 
   reader.SetBaseDir(base_dir);
@@ -911,6 +1195,9 @@ bool ReadUSDZAssetInfoFromMemory(const uint8_t *addr, const size_t length, const
     return false;
   }
 
+  asset->asset_map.clear();
+  asset->asset_map.reserve(assetInfos.size());
+
   for (size_t i = 0; i < assetInfos.size(); i++) {
     if (assetInfos[i].byte_begin > length) {
       if (err) {
@@ -924,10 +1211,17 @@ bool ReadUSDZAssetInfoFromMemory(const uint8_t *addr, const size_t length, const
       }
       return false;
     }
-    // Assume same filename does not exist.
-    asset->asset_map[assetInfos[i].filename] = std::make_pair(assetInfos[i].byte_begin, assetInfos[i].byte_end);
+
+    bool inserted = asset->asset_map.emplace(assetInfos[i].filename, std::make_pair(assetInfos[i].byte_begin, assetInfos[i].byte_end)).second;
+    if (!inserted) {
+      if (warn) {
+        (*warn) += "Duplicated asset name in USDZ. Use the first one: " + assetInfos[i].filename + "\n";
+      }
+    }
   }
 
+  asset->mapping.reset();
+
   if (asset_on_memory) {
     asset->data.clear();
     asset->addr = addr;
@@ -946,11 +1240,58 @@ bool ReadUSDZAssetInfoFromMemory(const uint8_t *addr, const size_t length, const
 bool ReadUSDZAssetInfoFromFile(const std::string &_filename, USDZAsset *asset,
   std::string *warn, std::string *err, size_t max_memory_limit_in_mb) {
 
+  if (!asset) {
+    return false;
+  }
+
   std::string filepath = io::ExpandFilePath(_filename, /* userdata */ nullptr);
   std::string base_dir = io::GetBaseDir(_filename);
 
-  std::vector<uint8_t> data;
   size_t max_bytes = 1024ull * 1024ull * max_memory_limit_in_mb;
+
+  if (io::IsMMapSupported()) {
+    io::MMapFileHandle handle;
+
+    {
+      std::string _err;
+      if (!io::MMapFile(filepath, &handle, /* writable */false, &_err)) {
+        if (err) {
+          (*err) += _err + "\n";
+        }
+        return false;
+      }
+
+      if (_err.size()) {
+        if (warn) {
+          (*warn) += _err + "\n";
+        }
+      }
+    }
+
+    // Unmapped when the last reference is released.
+    std::shared_ptr<const void> mapping(static_cast<const void *>(handle.addr), [handle](const void *) {
+      std::string _err;
+      // Ignore unmap result for now.
+      io::UnmapFile(handle, &_err);
+    });
+
+    if (handle.size > max_bytes) {
+      if (err) {
+        (*err) += "File size too large: " + filepath + "\n";
+      }
+      return false;
+    }
+
+    if (!ReadUSDZAssetInfoFromMemory(handle.addr, size_t(handle.size), /* asset_on_memory */true, asset, warn, err)) {
+      return false;
+    }
+
+    asset->mapping = std::move(mapping);
+
+    return true;
+  }
+
+  std::vector<uint8_t> data;
   if (!io::ReadWholeFile(&data, err, filepath, max_bytes,
                          /* userdata */ nullptr)) {
     return false;
@@ -1137,8 +1478,10 @@ bool LoadUSDCLayerFromMemory(const uint8_t *addr, const size_t length,
 
   usdc::USDCReaderConfig config;
   config.numThreads = options.num_threads;
+  config.lazy_array_unpack = options.lazy_array_unpack;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
   config.allow_unknown_apiSchemas = !options.strict_apiSchema_check;
+  config.stats = options.stats;
   usdc::USDCReader reader(&sr, config);
 
   if (!reader.ReadUSDC()) {
@@ -1218,6 +1561,8 @@ bool LoadUSDALayerFromMemory(const uint8_t *addr, const size_t length,
 
   tinyusdz::usda::USDAReaderConfig config;
   config.strict_allowedToken_check = options.strict_allowedToken_check;
+  config.numThreads = options.usda_parallel_parse ? options.num_threads : 1;
+  config.stats = options.stats;
   reader.set_reader_config(config);
 
   uint32_t load_states = static_cast<uint32_t>(tinyusdz::LoadState::Toplevel);
@@ -1371,7 +1716,7 @@ bool LoadLayerFromAsset(AssetResolutionResolver &resolver, const std::string &re
     PUSH_ERROR_AND_RETURN(fmt::format("Failed to open asset `{}`.", resolved_asset_name));
   }
 
-  return LoadLayerFromMemory(asset.data(), asset.size(), resolved_asset_name, layer, warn, err,
+  return LoadLayerFromMemory(asset.cdata(), asset.size(), resolved_asset_name, layer, warn, err,
                            options);
 }
 
@@ -1412,7 +1757,7 @@ int USDZResolveAsset(const char *asset_name, const std::vector<std::string> &sea
 
   const USDZAsset *passet = reinterpret_cast<const USDZAsset *>(userdata);
 
-  if (passet->asset_map.count(asset_path)) {
+  if (passet->asset_map.find(asset_path) != passet->asset_map.end()) {
     DCOUT("Resolved asset: " << asset_name << " as " << asset_path);
     (*resolved_asset_name) = asset_path;
     return 0;
@@ -1446,14 +1791,15 @@ int USDZSizeAsset(const char *resolved_asset_name, uint64_t *nbytes, std::string
 
   const USDZAsset *passet = reinterpret_cast<const USDZAsset *>(userdata);
 
-  if (!passet->asset_map.count(resolved_asset_name)) {
+  const auto it = passet->asset_map.find(resolved_asset_name);
+  if (it == passet->asset_map.end()) {
     if (err) {
       (*err) += "resolved_asset_name `" + std::string(resolved_asset_name) + "` not found in USDZAsset.\n";
     }
     return -1;
   }
 
-  std::pair<size_t, size_t> byte_range = passet->asset_map.at(resolved_asset_name);
+  const std::pair<size_t, size_t> &byte_range = it->second;
 
   if (byte_range.first >= byte_range.second) {
     if (err) {
@@ -1498,14 +1844,15 @@ int USDZReadAsset(const char *resolved_asset_name, uint64_t req_bytes, uint8_t *
 
   const USDZAsset *passet = reinterpret_cast<const USDZAsset *>(userdata);
 
-  if (!passet->asset_map.count(resolved_asset_name)) {
+  const auto it = passet->asset_map.find(resolved_asset_name);
+  if (it == passet->asset_map.end()) {
     if (err) {
       (*err) += "resolved_asset_name `" + std::string(resolved_asset_name) + "` not found in USDZAsset.\n";
     }
     return -1;
   }
 
-  std::pair<size_t, size_t> byte_range = passet->asset_map.at(resolved_asset_name);
+  const std::pair<size_t, size_t> &byte_range = it->second;
 
   if (byte_range.first >= byte_range.second) {
     if (err) {
@@ -1523,14 +1870,79 @@ int USDZReadAsset(const char *resolved_asset_name, uint64_t req_bytes, uint8_t *
     return -2;
   }
 
-  if (byte_range.first + sz > passet->data.size()) {
+  if (byte_range.first + sz > passet->content_size()) {
+    if (err) {
+      (*err) += "Invalid USDZAsset size: " + std::string(resolved_asset_name) + "\n";
+    }
+    return -2;
+  }
+
+  memcpy(out_buf, passet->content() + byte_range.first, sz);
+  (*nbytes) = sz;
+
+  return 0;
+}
+
+int USDZMapAsset(const char *resolved_asset_name, const uint8_t **out_addr, uint64_t *nbytes, std::string *err, void *userdata) {
+  if (!userdata) {
+    if (err) {
+      (*err) += "`userdata` must be non-null.\n";
+    }
+    return -1;
+  }
+
+  if (!resolved_asset_name) {
+    if (err) {
+      (*err) += "`resolved_asset_name` must be non-null.\n";
+    }
+    return -2;
+  }
+
+  if (!out_addr) {
+    if (err) {
+      (*err) += "`out_addr` must be non-null.\n";
+    }
+    return -2;
+  }
+
+  if (!nbytes) {
+    if (err) {
+      (*err) += "`nbytes` must be non-null.\n";
+    }
+    return -2;
+  }
+
+  const USDZAsset *passet = reinterpret_cast<const USDZAsset *>(userdata);
+
+  const auto it = passet->asset_map.find(resolved_asset_name);
+  if (it == passet->asset_map.end()) {
+    if (err) {
+      (*err) += "resolved_asset_name `" + std::string(resolved_asset_name) + "` not found in USDZAsset.\n";
+    }
+    return -1;
+  }
+
+  const std::pair<size_t, size_t> &byte_range = it->second;
+
+  if (byte_range.first >= byte_range.second) {
+    if (err) {
+      (*err) += "Invalid USDZAsset byte range.\n";
+    }
+    return -2;
+  }
+
+  size_t sz = byte_range.second - byte_range.first;
+
+  if (byte_range.first + sz > passet->content_size()) {
     if (err) {
       (*err) += "Invalid USDZAsset size: " + std::string(resolved_asset_name) + "\n";
     }
     return -2;
   }
 
-  memcpy(out_buf, passet->data.data() + byte_range.first, sz);
+  // USDZ entries are stored without compression, so the asset can be
+  // referenced directly.
+  (*out_addr) = passet->content() + byte_range.first;
   (*nbytes) = sz;
 
   return 0;
@@ -1558,6 +1970,7 @@ bool SetupUSDZAssetResolution(
   handler.resolve_fun = USDZResolveAsset;
   handler.size_fun = USDZSizeAsset;
   handler.read_fun = USDZReadAsset;
+  handler.map_fun = USDZMapAsset;
   handler.write_fun = nullptr;
   handler.userdata = reinterpret_cast<void *>(const_cast<USDZAsset *>(pusdzAsset));
 
@@ -10,7 +10,9 @@
 #include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,7 @@
 //#include "usdVox.hh"
 #include "stage.hh"
 #include "asset-resolution.hh"
+#include "performance.hh"
 
 
 namespace tinyusdz {
@@ -62,6 +65,22 @@ struct USDLoadOptions {
   // device.
   int32_t max_memory_limit_in_mb{16384};  // in [mb] Default 16GB
 
+  ///
+  /// USDC only. Defer unpacking array values and TimeSamples until the
+  /// Prim/Property using it is reconstructed, instead of unpacking all values
+  /// in Crate data upfront. A value shared by multiple Prims/Properties is
+  /// unpacked once, and released from the reader after its last use.
+  /// Reduces peak memory usage when loading large USDC.
+  ///
+  bool lazy_array_unpack{false};
+
+  ///
+  /// USDA only. Parse root Prim blocks of a large USDA(e.g. a flattened scene
+  /// with many root Prims) in parallel with `num_threads` threads.
+  /// Default false(parse sequentially).
+  ///
+  bool usda_parallel_parse{false};
+
   ///
   /// TODO: Deprecate
   /// Loads asset data(e.g. texture image, audio). Default is true.
@@ -119,6 +138,12 @@ struct USDLoadOptions {
   std::map<std::string, FileFormatHandler> fileformats;
 
   Axis upAxis{Axis::Y};
+
+  ///
+  /// Load statistics(phase timings, decompressed bytes, the number of loaded
+  /// objects, ...) are accumulated to `stats` when non-null.
+  ///
+  performance::LoadStats *stats{nullptr};
 };
 
 
@@ -219,24 +244,63 @@ bool LoadUSDZFromMemory(const uint8_t *addr, const size_t length,
 struct USDZAsset
 {
   // key: asset name(USD, Image, Audio, ...), value = byte begin/end in USDZ data.
-  std::map<std::string, std::pair<size_t, size_t>> asset_map;
+  std::unordered_map<std::string, std::pair<size_t, size_t>> asset_map;
 
   // When mmapped, `data` is empty, and `addr`(Usually pointer to mmaped address) and `size`  are set.
   // When non-mmapped, `data` holds the copy of whole USDZ data.
   std::vector<uint8_t> data; // USDZ itself
   const uint8_t *addr{nullptr};
   size_t size{0}; // in bytes.
+
+  // Keeps the file mapping alive when USDZ data is mmapped by `ReadUSDZAssetInfoFromFile`.
+  // The mapping is released when the last USDZAsset sharing it is destroyed.
+  std::shared_ptr<const void> mapping;
   
   bool is_mmaped() const {
-    return !data.empty();
+    return data.empty() && (addr != nullptr);
+  }
+
+  // Address and size of USDZ content(either `data` or `addr`)
+  const uint8_t *content() const {
+    return is_mmaped() ? addr : data.data();
+  }
+
+  size_t content_size() const {
+    return is_mmaped() ? size : data.size();
+  }
+
+  ///
+  /// Find an asset by name.
+  /// USDZ entries are stored without compression, so `asset_addr` points to the asset content in USDZ data(no copy).
+  ///
+  /// @return false when the asset is not found or its byte range is invalid.
+  ///
+  bool find_asset(const std::string &name, const uint8_t **asset_addr, size_t *asset_size) const {
+    const auto it = asset_map.find(name);
+    if (it == asset_map.end()) {
+      return false;
+    }
+
+    const std::pair<size_t, size_t> &byte_range = it->second;
+    if ((byte_range.first > byte_range.second) || (byte_range.second > content_size())) {
+      return false;
+    }
+
+    if (asset_addr) {
+      (*asset_addr) = content() + byte_range.first;
+    }
+    if (asset_size) {
+      (*asset_size) = byte_range.second - byte_range.first;
+    }
+    return true;
   }
 };
 
 ///
 /// Read USDZ(zip) asset info from a file.
 ///
-/// Whole file content(USDZ) is copied into USDZAsset::data.
-/// If you want to save memory to load USDZ with assets, first read USDZ conent into memory(or Use io-util.hh::MMapFile() to mmap file), then use `ReadUSDZAssetInfoFromMemory with `assert_on_memory` true.
+/// The file is mmapped when mmap is supported on the system(USDZAsset::mapping retains the mapping), otherwise whole file content(USDZ) is copied into USDZAsset::data.
+/// Asset lookup uses the ZIP central directory, so the cost does not depend on the size of assets.
 ///
 /// @param[in] filename USDZ filename(UTF-8)
 /// @param[out] asset USDZ asset info.
@@ -282,6 +346,7 @@ bool SetupUSDZAssetResolution(
 int USDZResolveAsset(const char *asset_name, const std::vector<std::string> &search_paths, std::string *resolved_asset_name, std::string *err, void *userdata);
 int USDZSizeAsset(const char *resolved_asset_name, uint64_t *nbytes, std::string *err, void *userdata);
 int USDZReadAsset(const char *resolved_asset_name, uint64_t req_bytes, uint8_t *out_buf, uint64_t *nbytes, std::string *err, void *userdata);
+int USDZMapAsset(const char *resolved_asset_name, const uint8_t **out_addr, uint64_t *nbytes, std::string *err, void *userdata);
 
 ///
 /// Load USDC(binary) from a file.
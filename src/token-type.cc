@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+#include "token-type.hh"
+
+#if !defined(TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE)
+
+#include <cstring>
+#include <unordered_map>
+
+#if !defined(__wasi__)
+#include <mutex>
+#define TINYUSDZ_TOKEN_POOL_USE_MUTEX
+#endif
+
+namespace tinyusdz {
+
+namespace {
+
+// Split the pool to reduce lock contention.
+constexpr size_t kNumTokenPoolShards = 64;
+
+struct TokenPoolShard {
+#if defined(TINYUSDZ_TOKEN_POOL_USE_MUTEX)
+  std::mutex mutex;
+#endif
+  // key = hash of the string. Entries with the same hash are chained.
+  std::unordered_multimap<uint64_t, const TokenEntry *> entries;
+};
+
+struct TokenPoolStorage {
+  TokenPoolShard shards[kNumTokenPoolShards];
+};
+
+// Allocated on the first use and never freed, so that Tokens are valid
+// while static objects are destructed.
+TokenPoolStorage &GetTokenPoolStorage() {
+  static TokenPoolStorage *s_storage = new TokenPoolStorage();
+  return *s_storage;
+}
+
+}  // namespace
+
+uint64_t TokenPool::Hash(const char *str, size_t len) {
+  // FNV-1a
+  uint64_t h = 14695981039346656037ull;
+  for (size_t i = 0; i < len; i++) {
+    h ^= uint64_t(uint8_t(str[i]));
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+const TokenEntry *TokenPool::Intern(const char *str, size_t len) {
+  const uint64_t h = Hash(str, len);
+
+  TokenPoolShard &shard =
+      GetTokenPoolStorage().shards[size_t(h % kNumTokenPoolShards)];
+
+#if defined(TINYUSDZ_TOKEN_POOL_USE_MUTEX)
+  std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+
+  auto range = shard.entries.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::string &s = it->second->str;
+    if ((s.size() == len) && (std::memcmp(s.data(), str, len) == 0)) {
+      return it->second;
+    }
+  }
+
+  TokenEntry *entry = new TokenEntry();
+  entry->str = std::string(str, len);
+  entry->hash = h;
+  shard.entries.emplace(h, entry);
+
+  return entry;
+}
+
+size_t TokenPool::Size() {
+  size_t n = 0;
+  for (auto &shard : GetTokenPoolStorage().shards) {
+#if defined(TINYUSDZ_TOKEN_POOL_USE_MUTEX)
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+    n += shard.entries.size();
+  }
+  return n;
+}
+
+}  // namespace tinyusdz
+
+#endif  // !TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
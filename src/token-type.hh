@@ -7,18 +7,17 @@
 //
 // `token` is primarily used for a short-length string.
 //
-// Unlike pxrUSD, `Token` class does not acquire a lock by default. This means
-// there is a potential hash collision for the hash value of `Token` string, but
-// TinyUSDZ does not require token(string) hashes are unique inside of TinyUSDZ
-// library. If you need pxrUSD-like behavior of `Token` class(i.e, you want a
-// token hash with no collision), you can compile TinyUSDZ with
-// TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE.
-// (Also you need to include foonathan/string_id c++ files(Please see <tinyusdz>/CMakeLists.txt) to your project)
+// By default, `Token` is a pointer to an immutable string interned in the
+// global token pool(TokenPool). Constructing a Token looks up the pool(with a
+// lock), but copy, equality and hash are O(1) and do not touch the string.
+// Interned strings are never released during the lifetime of the process, so
+// the pool grows with the number of unique token strings.
 //
 // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
 //   - Use foonathan/string_id to implement Token class.
 //   - database(token storage) is accessed with mutex so an application should
 //   not frequently construct Token class among threads.
+//   - (Also you need to include foonathan/string_id c++ files(Please see <tinyusdz>/CMakeLists.txt) to your project)
 //
 // ---
 //
@@ -45,7 +44,8 @@
 #endif
 
 #else  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
-#include <functional>
+#include <cstddef>
+#include <cstdint>
 #endif  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
 
 namespace tinyusdz {
@@ -93,6 +93,11 @@ class Token {
     str_ = sid::string_id(str, TokenStorage::GetInstance());
   }
 
+  explicit Token(const char *str, size_t len) {
+    str_ = sid::string_id(std::string(str, len).c_str(),
+                          TokenStorage::GetInstance());
+  }
+
   const std::string str() const {
     if (!str_) {
       return std::string();
@@ -143,49 +148,89 @@ struct TokenKeyEqual {
 
 #else  // TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE
 
+///
+/// Interned token string. Immutable and never released.
+///
+struct TokenEntry {
+  std::string str;
+  uint64_t hash{0};
+};
+
+///
+/// Thread-safe global token pool.
+///
+class TokenPool {
+ public:
+  ///
+  /// Intern a string and return its entry. Returns the same entry for the same
+  /// string. `len` must be greater than 0.
+  ///
+  static const TokenEntry *Intern(const char *str, size_t len);
+
+  ///
+  /// The number of interned strings.
+  ///
+  static size_t Size();
+
+  ///
+  /// Hash of a string(same as TokenEntry::hash).
+  ///
+  static uint64_t Hash(const char *str, size_t len);
+};
+
 class Token {
  public:
   Token() {}
 
-  explicit Token(const std::string &str) { str_ = str; }
-
-  explicit Token(const char *str) { str_ = str; }
-
-  const std::string &str() const { return str_; }
-
-  bool valid() const {
-    if (str().empty()) {
-      return false;
+  explicit Token(const std::string &str) {
+    if (str.size()) {
+      entry_ = TokenPool::Intern(str.data(), str.size());
     }
+  }
 
-    return true;
+  explicit Token(const char *str) {
+    if (str && str[0] != '\0') {
+      entry_ = TokenPool::Intern(str, std::char_traits<char>::length(str));
+    }
   }
 
-  // No string hash for TinyUSDZ
-#if 0
-  uint64_t hash() const {
-    if (!str_) {
-      return 0;
+  explicit Token(const char *str, size_t len) {
+    if (str && len) {
+      entry_ = TokenPool::Intern(str, len);
     }
+  }
 
-    // Assume non-zero hash value for non-empty string.
-    return str_.value().hash_code();
+  const std::string &str() const {
+    return entry_ ? entry_->str : EmptyString();
   }
-#endif
+
+  bool valid() const { return entry_ != nullptr; }
+
+  // Precomputed hash. 0 for an empty token.
+  uint64_t hash() const { return entry_ ? entry_->hash : 0; }
+
+  // Identity of the token string. Equal tokens have the same id(nullptr for
+  // an empty token).
+  const void *id() const { return entry_; }
 
  private:
-  std::string str_;
+  static const std::string &EmptyString() {
+    static const std::string *s = new std::string();
+    return *s;
+  }
+
+  const TokenEntry *entry_{nullptr};
 };
 
 struct TokenHasher {
   inline size_t operator()(const Token &tok) const {
-    return std::hash<std::string>()(tok.str());
+    return size_t(tok.hash());
   }
 };
 
 struct TokenKeyEqual {
   bool operator()(const Token &lhs, const Token &rhs) const {
-    return lhs.str() == rhs.str();
+    return lhs.id() == rhs.id();
   }
 };
 
@@ -200,6 +245,11 @@ inline bool operator!=(const Token &lhs, const Token &rhs) {
 }
 
 inline bool operator<(const Token &lhs, const Token &rhs) {
+#if !defined(TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE)
+  if (lhs.id() == rhs.id()) {
+    return false;
+  }
+#endif
   return lhs.str() < rhs.str();
 }
 
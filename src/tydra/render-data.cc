@@ -24,9 +24,17 @@
 //   - [ ] Better build of index buffer
 //     - [ ] Preserve the order of 'points' variable(mesh.points, Skin
 //     indices/weights, BlendShape points, ...) as much as possible.
-//     - Implement spatial hash
+//     - [x] Implement spatial hash
 //
+#include <map>
 #include <numeric>
+#include <set>
+
+#if !defined(__wasi__)
+#include <atomic>
+#include <thread>
+#define TINYUSDZ_TYDRA_PARALLEL_CONVERT
+#endif
 
 #include "image-loader.hh"
 #include "image-util.hh"
@@ -34,6 +42,7 @@
 #include "linear-algebra.hh"
 #include "math-util.inc"
 #include "pprinter.hh"
+#include "prim-pprint.hh"
 #include "prim-types.hh"
 #include "str-util.hh"
 #include "tiny-format.hh"
@@ -103,6 +112,62 @@ inline std::string to_string(const UVTexture::Channel channel) {
   return "[[InternalError. Invalid UVTexture::Channel]]";
 }
 
+//
+// Resolve `RenderSceneConverterConfig::num_threads`.
+//
+size_t GetNumThreads(const int num_threads) {
+  size_t n = 1;
+#if defined(TINYUSDZ_TYDRA_PARALLEL_CONVERT)
+  if (num_threads == -1) {
+    n = size_t((std::max)(1, int(std::thread::hardware_concurrency())));
+  } else if (num_threads > 1) {
+    n = size_t(num_threads);
+  }
+  // Limit to 1024 threads.
+  n = (std::min)(size_t(1024), n);
+#else
+  (void)num_threads;
+#endif
+  return n;
+}
+
+//
+// Run `fn(i)` for each i in [0, n) with a pool of `num_threads` threads.
+//
+template <typename F>
+void ParallelFor(const size_t n, size_t num_threads, const F &fn) {
+#if defined(TINYUSDZ_TYDRA_PARALLEL_CONVERT)
+  num_threads = (std::min)(num_threads, n);
+  if (num_threads > 1) {
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next{0};
+
+    for (size_t t = 0; t < num_threads; t++) {
+      workers.emplace_back([&]() {
+        while (true) {
+          size_t i = next++;
+          if (i >= n) {
+            break;
+          }
+          fn(i);
+        }
+      });
+    }
+
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    return;
+  }
+#else
+  (void)num_threads;
+#endif
+
+  for (size_t i = 0; i < n; i++) {
+    fn(i);
+  }
+}
+
 //
 // Convert vertex attribute with Uniform variability(interpolation) to
 // facevarying variability, by replicating uniform value per face over face
@@ -2473,12 +2538,179 @@ bool RenderSceneConverter::ConvertVertexVariabilityImpl(
   return true;
 }
 
-bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
+namespace {
+
+//
+// Vertex welding for BuildVertexIndicesImpl.
+//
+// Face-varying corners are grouped by its point index(counting sort), then
+// corners in each group whose vertex attributes are the same within `eps`
+// (math::is_close) are merged. Groups are independent, so they are processed
+// in parallel.
+//
+// In most cases a group contains a few corners(valence of the point), and
+// corners are compared against every representative corner in the group.
+// For a large group(e.g. apex of a fan), representative corners are looked up
+// by spatial hash: attributes are quantized to a grid of `eps` cell size and
+// hashed into 64bit. Similar corners straddling a cell boundary are not
+// merged in this case.
+//
+constexpr size_t kWeldMaxLinearScan = 32;
+
+// Minimum number of corners processed per thread.
+constexpr size_t kWeldMinCornersPerThread = 16 * 1024;
+
+// The number of points processed per task.
+constexpr size_t kWeldPointsPerTask = 4096;
+
+inline uint64_t WeldHashCombine(uint64_t h, uint64_t v) {
+  v *= 0x9e3779b97f4a7c15ull;
+  v ^= v >> 32;
+  h ^= v;
+  h *= 0xbf58476d1ce4e5b9ull;
+  return h ^ (h >> 29);
+}
+
+inline uint64_t WeldQuantize(const float v, const double inv_cell) {
+  if ((inv_cell <= 0.0) || !std::isfinite(v)) {
+    // Use bit pattern.
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(float));
+    return uint64_t(bits);
+  }
+
+  // Clamp to avoid overflow. `eps` is meaningless for such a large value
+  // anyway.
+  double q = std::floor(double(v) * inv_cell);
+  q = (std::max)(-4.0e18, (std::min)(4.0e18, q));
+  return uint64_t(int64_t(q));
+}
+
+///
+/// Find a representative corner for each face-varying corner.
+///
+/// @param[in] point_indices Point index of each corner.
+/// @param[in] num_points The number of points(max point index + 1).
+/// @param[in] attribs Vertex attributes of each corner. `stride` floats per
+/// corner.
+/// @param[in] eps Allowed relative error(see math::is_close).
+/// @param[out] reps Corner index each corner is merged into. The first corner
+/// of merged corners is the representative, so `reps[i] <= i`.
+///
+void WeldCorners(const std::vector<uint32_t> &point_indices,
+                 const size_t num_points, const std::vector<float> &attribs,
+                 const size_t stride, const float eps, size_t num_threads,
+                 std::vector<uint32_t> *reps) {
+  const size_t n = point_indices.size();
+  reps->resize(n);
+
+  // Group corners by point index. Corners in a group are in ascending order.
+  std::vector<uint32_t> offsets(num_points + 1, 0);
+  for (size_t i = 0; i < n; i++) {
+    offsets[point_indices[i] + 1]++;
+  }
+  for (size_t i = 0; i < num_points; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  std::vector<uint32_t> corners(n);
+  {
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+      corners[cursor[point_indices[i]]++] = uint32_t(i);
+    }
+  }
+
+  const double inv_cell = (eps > 0.0f) ? (1.0 / double(eps)) : 0.0;
+
+  auto Hash = [&](const uint32_t c) -> uint64_t {
+    const float *a = attribs.data() + size_t(c) * stride;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t k = 0; k < stride; k++) {
+      h = WeldHashCombine(h, WeldQuantize(a[k], inv_cell));
+    }
+    return h;
+  };
+
+  auto IsClose = [&](const uint32_t c0, const uint32_t c1) -> bool {
+    const float *a = attribs.data() + size_t(c0) * stride;
+    const float *b = attribs.data() + size_t(c1) * stride;
+    for (size_t k = 0; k < stride; k++) {
+      // Bitwise equal(also handles NaN)
+      if (memcmp(&a[k], &b[k], sizeof(float)) == 0) {
+        continue;
+      }
+      if (!math::is_close(a[k], b[k], eps)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  num_threads = (std::min)(
+      num_threads, (std::max)(size_t(1), n / kWeldMinCornersPerThread));
+
+  const size_t num_tasks =
+      (num_points + kWeldPointsPerTask - 1) / kWeldPointsPerTask;
+
+  ParallelFor(num_tasks, num_threads, [&](size_t t) {
+    const size_t p_begin = t * kWeldPointsPerTask;
+    const size_t p_end = (std::min)(num_points, p_begin + kWeldPointsPerTask);
+
+    std::vector<uint32_t> group_reps;
+    std::unordered_map<uint64_t, uint32_t> cell_to_rep;
+
+    for (size_t p = p_begin; p < p_end; p++) {
+      group_reps.clear();
+      cell_to_rep.clear();
+
+      for (size_t j = offsets[p]; j < offsets[p + 1]; j++) {
+        const uint32_t c = corners[j];
+        uint32_t rep = c;
+
+        if (group_reps.size() <= kWeldMaxLinearScan) {
+          for (const uint32_t r : group_reps) {
+            if (IsClose(c, r)) {
+              rep = r;
+              break;
+            }
+          }
+        } else {
+          if (cell_to_rep.empty()) {
+            for (const uint32_t r : group_reps) {
+              cell_to_rep.emplace(Hash(r), r);
+            }
+          }
+
+          auto it = cell_to_rep.find(Hash(c));
+          if ((it != cell_to_rep.end()) && IsClose(c, it->second)) {
+            rep = it->second;
+          }
+        }
+
+        if (rep == c) {
+          group_reps.push_back(c);
+          if (!cell_to_rep.empty()) {
+            cell_to_rep.emplace(Hash(c), c);
+          }
+        }
+
+        (*reps)[c] = rep;
+      }
+    }
+  });
+}
+
+}  // namespace
+
+bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh,
+                                                  const float eps,
+                                                  const size_t num_threads) {
   //
   // - If mesh is triangulated, use triangulatedFaceVertexIndices, otherwise use
   // faceVertxIndices.
   // - Make vertex attributes 'facevarying' variability
-  // - Assign same id for similar(currently identitical) vertex attribute.
+  // - Assign same id for similar vertex attribute(within `eps`).
   // - Reorder vertex attributes to 'vertex' variability.
   //
 
@@ -2487,17 +2719,7 @@ bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
           ? mesh.triangulatedFaceVertexIndices
           : mesh.usdFaceVertexIndices;
 
-  DefaultVertexInput<DefaultPackedVertexData> vertex_input;
-
   size_t num_fvs = fvIndices.size();
-  vertex_input.point_indices = fvIndices;
-  vertex_input.uv0s.assign(num_fvs, {0.0f, 0.0f});
-  vertex_input.uv1s.assign(num_fvs, {0.0f, 0.0f});
-  vertex_input.normals.assign(num_fvs, {0.0f, 0.0f, 0.0f});
-  vertex_input.tangents.assign(num_fvs, {0.0f, 0.0f, 0.0f});
-  vertex_input.binormals.assign(num_fvs, {0.0f, 0.0f, 0.0f});
-  vertex_input.colors.assign(num_fvs, {0.0f, 0.0f, 0.0f});
-  vertex_input.opacities.assign(num_fvs, 0.0f);
 
   if (mesh.normals.vertex_count()) {
     if (!mesh.normals.is_facevarying()) {
@@ -2613,45 +2835,87 @@ bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
                 mesh.vertex_opacities.get_data().data())
           : nullptr;
 
+  uint32_t num_points = 0;
   for (size_t i = 0; i < num_fvs; i++) {
     size_t fvi = fvIndices[i];
     if (fvi >= num_fvs) {
       PUSH_ERROR_AND_RETURN(fmt::format(
           "Invalid faceVertexIndex {}. Must be less than {}", fvi, num_fvs));
     }
+    num_points = (std::max)(num_points, uint32_t(fvi + 1));
+  }
 
-    if (normals_ptr) {
-      vertex_input.normals[i] = normals_ptr[i];
-    }
-    if (texcoord0_ptr) {
-      vertex_input.uv0s[i] = texcoord0_ptr[i];
-    }
-    if (texcoord1_ptr) {
-      vertex_input.uv1s[i] = texcoord1_ptr[i];
-    }
-    if (tangents_ptr) {
-      vertex_input.tangents[i] = tangents_ptr[i];
-    }
-    if (binormals_ptr) {
-      vertex_input.binormals[i] = binormals_ptr[i];
-    }
-    if (colors_ptr) {
-      vertex_input.colors[i] = colors_ptr[i];
-    }
-    if (opacities_ptr) {
-      vertex_input.opacities[i] = opacities_ptr[i];
-    }
+  //
+  // Pack vertex attributes of each corner, then weld corners.
+  //
+  const size_t stride = (normals_ptr ? 3 : 0) + (texcoord0_ptr ? 2 : 0) +
+                        (texcoord1_ptr ? 2 : 0) + (tangents_ptr ? 3 : 0) +
+                        (binormals_ptr ? 3 : 0) + (colors_ptr ? 3 : 0) +
+                        (opacities_ptr ? 1 : 0);
+
+  std::vector<float> attribs(num_fvs * stride);
+  {
+    auto Pack = [&](const float *src, size_t ncomps, size_t &offset) {
+      if (!src) {
+        return;
+      }
+      for (size_t i = 0; i < num_fvs; i++) {
+        for (size_t k = 0; k < ncomps; k++) {
+          attribs[i * stride + offset + k] = src[i * ncomps + k];
+        }
+      }
+      offset += ncomps;
+    };
+
+    size_t offset = 0;
+    Pack(reinterpret_cast<const float *>(normals_ptr), 3, offset);
+    Pack(reinterpret_cast<const float *>(texcoord0_ptr), 2, offset);
+    Pack(reinterpret_cast<const float *>(texcoord1_ptr), 2, offset);
+    Pack(reinterpret_cast<const float *>(tangents_ptr), 3, offset);
+    Pack(reinterpret_cast<const float *>(binormals_ptr), 3, offset);
+    Pack(reinterpret_cast<const float *>(colors_ptr), 3, offset);
+    Pack(opacities_ptr, 1, offset);
   }
 
-  std::vector<uint32_t> out_indices;
-  std::vector<uint32_t> out_point_indices;  // to reorder position data
+  std::vector<uint32_t> reps;
+  WeldCorners(fvIndices, num_points, attribs, stride, eps, num_threads, &reps);
+
+  std::vector<uint32_t> out_indices(num_fvs);
+  std::vector<uint32_t> out_point_indices(num_fvs);  // to reorder position data
   DefaultVertexOutput<DefaultPackedVertexData> vertex_output;
 
-  BuildIndices<DefaultVertexInput<DefaultPackedVertexData>,
-               DefaultVertexOutput<DefaultPackedVertexData>,
-               DefaultPackedVertexData, DefaultPackedVertexDataHasher,
-               DefaultPackedVertexDataEqual>(vertex_input, vertex_output,
-                                             out_indices, out_point_indices);
+  // Assign vertex id in the order of appearance.
+  for (size_t i = 0; i < num_fvs; i++) {
+    if (reps[i] == i) {
+      out_indices[i] = uint32_t(vertex_output.size());
+
+      vertex_output.point_indices.push_back(fvIndices[i]);
+      if (normals_ptr) {
+        vertex_output.normals.push_back(normals_ptr[i]);
+      }
+      if (texcoord0_ptr) {
+        vertex_output.uv0s.push_back(texcoord0_ptr[i]);
+      }
+      if (texcoord1_ptr) {
+        vertex_output.uv1s.push_back(texcoord1_ptr[i]);
+      }
+      if (tangents_ptr) {
+        vertex_output.tangents.push_back(tangents_ptr[i]);
+      }
+      if (binormals_ptr) {
+        vertex_output.binormals.push_back(binormals_ptr[i]);
+      }
+      if (colors_ptr) {
+        vertex_output.colors.push_back(colors_ptr[i]);
+      }
+      if (opacities_ptr) {
+        vertex_output.opacities.push_back(opacities_ptr[i]);
+      }
+    } else {
+      out_indices[i] = out_indices[reps[i]];
+    }
+    out_point_indices[i] = fvIndices[i];
+  }
 
   if (out_indices.size() != out_point_indices.size()) {
     PUSH_ERROR_AND_RETURN(
@@ -2834,6 +3098,50 @@ bool RenderSceneConverter::BuildVertexIndicesImpl(RenderMesh &mesh) {
   return true;
 }
 
+namespace {
+
+//
+// Add Skeleton(and its Animation) to `skeletons` if not yet added.
+// Returns Skeleton ID.
+//
+int RegisterSkeleton(std::vector<SkelHierarchy> &skeletons,
+                     std::vector<Animation> &animations,
+                     const std::string &skel_path, SkelHierarchy &&skel,
+                     nonstd::optional<Animation> &&anim) {
+  auto skel_it = std::find_if(skeletons.begin(), skeletons.end(), [&skel_path](const SkelHierarchy &sk) {
+    DCOUT("sk.abs_path " << sk.abs_path << ", skel_path " << skel_path);
+    return sk.abs_path == skel_path;
+  });
+
+  if (anim) {
+
+    const auto &animAbsPath = anim.value().abs_path;
+    auto anim_it = std::find_if(animations.begin(), animations.end(), [&animAbsPath](const Animation &a) {
+      DCOUT("a.abs_path " << a.abs_path << ", anim_path " << animAbsPath);
+      return a.abs_path == animAbsPath;
+    });
+
+    if (anim_it != animations.end()) {
+      skel.anim_id = int(std::distance(animations.begin(), anim_it));
+    } else {
+      skel.anim_id = int(animations.size());
+      animations.emplace_back(std::move(anim.value()));
+    }
+  }
+
+  int skel_id{0};
+  if (skel_it != skeletons.end()) {
+    skel_id = int(std::distance(skeletons.begin(), skel_it));
+  } else {
+    skel_id = int(skeletons.size());
+    skeletons.emplace_back(std::move(skel));
+  }
+
+  return skel_id;
+}
+
+}  // namespace
+
 bool RenderSceneConverter::ConvertMesh(
     const RenderSceneConverterEnv &env, const Path &abs_prim_path,
     const GeomMesh &mesh, const MaterialPath &material_path,
@@ -3709,34 +4017,9 @@ bool RenderSceneConverter::ConvertMesh(
         }
         DCOUT("Converted skeleton attached to : " << abs_prim_path);
 
-        auto skel_it = std::find_if(skeletons.begin(), skeletons.end(), [&skelPath](const SkelHierarchy &sk) {
-          DCOUT("sk.abs_path " << sk.abs_path << ", skel_path " << skelPath.full_path_name());
-          return sk.abs_path == skelPath.full_path_name();
-        });
-
-        if (anim) {
-
-          const auto &animAbsPath = anim.value().abs_path;
-          auto anim_it = std::find_if(animations.begin(), animations.end(), [&animAbsPath](const Animation &a) {
-            DCOUT("a.abs_path " << a.abs_path << ", anim_path " << animAbsPath);
-            return a.abs_path == animAbsPath;
-          });
-
-          if (anim_it != animations.end()) {
-            skel.anim_id = int(std::distance(animations.begin(), anim_it));
-          } else {
-            skel.anim_id = int(animations.size());
-            animations.emplace_back(anim.value());
-          }
-        }
-
-        int skel_id{0};
-        if (skel_it != skeletons.end()) {
-          skel_id = int(std::distance(skeletons.begin(), skel_it));
-        } else {
-          skel_id = int(skeletons.size());
-          skeletons.emplace_back(std::move(skel));
-        }
+        int skel_id = RegisterSkeleton(skeletons, animations,
+                                       skelPath.full_path_name(),
+                                       std::move(skel), std::move(anim));
 
         dst.skel_id = skel_id;
 
@@ -3896,7 +4179,8 @@ bool RenderSceneConverter::ConvertMesh(
   if (env.mesh_config.build_vertex_indices && (!is_single_indexable)) {
     DCOUT("Build vertex indices");
 
-    if (!BuildVertexIndicesImpl(dst)) {
+    if (!BuildVertexIndicesImpl(dst, env.mesh_config.facevarying_to_vertex_eps,
+                                GetNumThreads(env.scene_config.num_threads))) {
       return false;
     }
 
@@ -3968,7 +4252,9 @@ bool RenderSceneConverter::ConvertMesh(
 
     // 2. Build single vertex indices if `build_vertex_indices` is true.
     if (env.mesh_config.build_vertex_indices) {
-      if (!BuildVertexIndicesImpl(dst)) {
+      if (!BuildVertexIndicesImpl(
+              dst, env.mesh_config.facevarying_to_vertex_eps,
+              GetNumThreads(env.scene_config.num_threads))) {
         return false;
       }
       is_single_indexable = true;
@@ -4225,359 +4511,1114 @@ nonstd::expected<bool, std::string> GetConnectedUVTexture(
 
 }  // namespace
 
-// Convert UsdUVTexture shader node.
-// @return true upon conversion success(textures.back() contains the converted
-// UVTexture)
+namespace {
+
 //
-// Possible network configuration
+// Determine the color space of a texture(TextureImage::usdColorSpace) from
+// `colorSpace` metadata of `inputs:file` or `inputs:sourceColorSpace`
+// attribute. `texImage` must be filled with decoded texture info when
+// `tex_loaded` is true.
 //
-// - UsdUVTexture -> UsdPrimvarReader
-// - UsdUVTexture -> UsdTransform2d -> UsdPrimvarReader
-bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
-                                            const Path &tex_abs_path,
-                                            const AssetInfo &assetInfo,
-                                            const UsdUVTexture &texture,
-                                            UVTexture *tex_out) {
-  DCOUT("ConvertUVTexture " << tex_abs_path);
+bool InferUVTextureColorSpace(const UsdUVTexture &texture,
+                              const value::AssetPath &assetPath,
+                              const double timecode, const bool tex_loaded,
+                              TextureImage *texImage, std::string *warn,
+                              std::string *err) {
+  // colorSpace.
+  // First look into `colorSpace` metadata of asset, then
+  // look into `inputs:sourceColorSpace' attribute.
+  // When both `colorSpace` metadata and `inputs:sourceColorSpace' attribute
+  // exists, `colorSpace` metadata supercedes.
+  // NOTE: `inputs:sourceColorSpace` attribute should be deprecated in favor of `colorSpace` metadata.
+  bool inferColorSpaceFailed = false;
+  if (texture.file.metas().has_colorSpace()) {
+    ColorSpace cs;
+    value::token cs_token = texture.file.metas().get_colorSpace();
+    if (InferColorSpace(cs_token, &cs)) {
+      texImage->usdColorSpace = cs;
+      DCOUT("Inferred colorSpace: " << to_string(cs));
+    } else {
+      inferColorSpaceFailed = true;
+    }
+  }
+
+  bool sourceColorSpaceSet = false;
+  if (inferColorSpaceFailed || !texture.file.metas().has_colorSpace()) {
+    if (texture.sourceColorSpace.authored()) {
+      UsdUVTexture::SourceColorSpace cs;
+      if (texture.sourceColorSpace.get_value().get(timecode, &cs)) {
+        if (cs == UsdUVTexture::SourceColorSpace::SRGB) {
+          texImage->usdColorSpace = tydra::ColorSpace::sRGB;
+          sourceColorSpaceSet = true;
+        } else if (cs == UsdUVTexture::SourceColorSpace::Raw) {
+          texImage->usdColorSpace = tydra::ColorSpace::Raw;
+          sourceColorSpaceSet = true;
+        } else if (cs == UsdUVTexture::SourceColorSpace::Auto) {
+
+          if (tex_loaded) {
+
+            // The spec says: https://openusd.org/release/spec_usdpreviewsurface.html
+            //
+            // auto : Check for gamma/color space metadata in the texture file itself; if metadata is indicative of sRGB, mark texture as sRGB . If no relevant metadata is found, mark texture as sRGB if it is either 8-bit and has 3 channels or if it is 8-bit and has 4 channels. Otherwise, do not mark texture as sRGB and use texture data as it was read from the texture.
+            //
+            if (((texImage->assetTexelComponentType == ComponentType::UInt8) ||
+                (texImage->assetTexelComponentType == ComponentType::Int8)) &&
+              ((texImage->channels == 3) || (texImage->channels ==4))) {
+              texImage->usdColorSpace = tydra::ColorSpace::sRGB;
+              sourceColorSpaceSet = true;
+            } else {
+              (*warn) += fmt::format("Infer colorSpace failed for {}. Set to Raw for now. Results may be wrong.", assetPath.GetAssetPath()) + "\n";
+              // At least 'not' sRGB. For now set to Raw.
 
-  if (!tex_out) {
-    PUSH_ERROR_AND_RETURN("tex_out arg is nullptr.");
+              texImage->usdColorSpace = tydra::ColorSpace::Raw;
+              sourceColorSpaceSet = true;
+            }
+          } else {
+            texImage->usdColorSpace = tydra::ColorSpace::Unknown;
+            sourceColorSpaceSet = true;
+          }
+        }
+      }
+    }
   }
-  std::string err;
-
-  UVTexture tex;
 
-  if (!texture.file.authored()) {
-    PUSH_ERROR_AND_RETURN(fmt::format("`asset:file` is not authored. Path = {}",
-                                      tex_abs_path.prim_part()));
+  if (!sourceColorSpaceSet && inferColorSpaceFailed) {
+    value::token cs_token = texture.file.metas().get_colorSpace();
+    (*err) += fmt::format("Invalid or unknown colorSpace metadataum: {}. Please "
+                          "report an issue to TinyUSDZ github repo.",
+                          cs_token.str()) + "\n";
+    return false;
   }
 
-  value::AssetPath assetPath;
-  if (auto apath = texture.file.get_value()) {
-    if (!apath.value().get(env.timecode, &assetPath)) {
-      PUSH_ERROR_AND_RETURN(fmt::format(
-          "Failed to get `asset:file` value from Path {} at time {}",
-          tex_abs_path.prim_part(), env.timecode));
+  return true;
+}
+
+//
+// Convert texel data of a decoded texture asset(`assetImageBuffer`) to
+// `imageBuffer` according to `linearize_color_space` and
+// `preserve_texel_bitdepth`. `texImage->usdColorSpace` must be determined.
+//
+// Returns false on conversion failure. Unsupported conversion is reported to
+// `err`, but returns true(`imageBuffer` is left empty).
+//
+bool ConvertTextureTexels(const MaterialConverterConfig &config,
+                          TextureImage *texImage,
+                          BufferData &assetImageBuffer,
+                          BufferData &imageBuffer, std::string *warn,
+                          std::string *err) {
+  // Linearlization and widen texel bit depth if required.
+  if (config.linearize_color_space) {
+    // TODO: Support ACEScg and Lin_DisplayP3
+    DCOUT("linearlize colorspace.");
+    size_t width = size_t(texImage->width);
+    size_t height = size_t(texImage->height);
+    size_t channels = size_t(texImage->channels);
+
+    if (channels > 4) {
+      (*err) += fmt::format("TODO: Multiband color channels(5 or more) are not "
+                            "supported(yet).") + "\n";
+      return false;
     }
-  } else {
-    PUSH_ERROR_AND_RETURN(
-        fmt::format("Failed to get `asset:file` value from Path {}",
-                    tex_abs_path.prim_part()));
-  }
 
-  // TextureImage and BufferData
-  {
-    TextureImage texImage;
-    BufferData assetImageBuffer;
+    if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
+      if (texImage->usdColorSpace == tydra::ColorSpace::sRGB) {
+        if (config.preserve_texel_bitdepth) {
+          // u8 sRGB -> u8 Linear
+          imageBuffer.componentType = tydra::ComponentType::UInt8;
 
-    // Texel data is treated as byte array
-    assetImageBuffer.componentType = ComponentType::UInt8;
+          bool ret = srgb_8bit_to_linear_8bit(
+              assetImageBuffer.data, width, height, channels,
+              /* channel stride */ channels, &imageBuffer.data, err);
+          if (!ret) {
+            (*err) += "Failed to convert sRGB u8 image to Linear u8 image.\n";
+            return false;
+          }
 
-    bool tex_loaded{false};
+        } else {
+          DCOUT("u8 sRGB -> fp32 linear.");
+          // u8 sRGB -> fp32 Linear
+          imageBuffer.componentType = tydra::ComponentType::Float;
+
+          std::vector<float> buf;
+          bool ret = srgb_8bit_to_linear_f32(
+              assetImageBuffer.data, width, height, channels,
+              /* channel stride */ channels, &buf, err);
+          if (!ret) {
+            (*err) += "Failed to convert sRGB u8 image to Linear f32 image.\n";
+            return false;
+          }
 
-    if (env.scene_config.load_texture_assets) {
-      DCOUT("load texture : " << assetPath.GetAssetPath());
-      std::string warn;
+          DCOUT("sz = " << buf.size());
+          imageBuffer.data.resize(buf.size() * sizeof(float));
+          memcpy(imageBuffer.data.data(), buf.data(),
+                 sizeof(float) * buf.size());
+        }
 
-      TextureImageLoaderFunction tex_loader_fun =
-          env.material_config.texture_image_loader_function;
+        texImage->colorSpace = tydra::ColorSpace::Lin_sRGB;
 
-      if (!tex_loader_fun) {
-        tex_loader_fun = DefaultTextureImageLoaderFunction;
-      }
+      } else if (texImage->usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
+        if (config.preserve_texel_bitdepth) {
+          // no op.
+          imageBuffer = std::move(assetImageBuffer);
 
-      tex_loaded = tex_loader_fun(
-          assetPath, assetInfo, env.asset_resolver, &texImage,
-          &assetImageBuffer.data,
-          env.material_config.texture_image_loader_function_userdata, &warn,
-          &err);
+        } else {
+          // u8 -> fp32
+          imageBuffer.componentType = tydra::ComponentType::Float;
+
+          std::vector<float> buf;
+          bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
+                                     channels, &buf, err);
+          if (!ret) {
+            (*err) += "Failed to convert u8 image to f32 image.\n";
+            return false;
+          }
 
-      if (warn.size()) {
-        DCOUT("WARN: " << warn);
-        PushWarn(warn);
-      }
+          imageBuffer.data.resize(buf.size() * sizeof(float));
+          memcpy(imageBuffer.data.data(), buf.data(),
+                 sizeof(float) * buf.size());
+        }
 
-      if (!tex_loaded && !env.material_config.allow_texture_load_failure) {
-        PUSH_ERROR_AND_RETURN(fmt::format("Failed to load texture image: `{}` err = {}", assetPath.GetAssetPath(), err));
+        texImage->colorSpace = tydra::ColorSpace::Lin_sRGB;
+
+      } else {
+        (*err) += fmt::format("TODO: Color space {}",
+                              to_string(texImage->usdColorSpace)) + "\n";
       }
 
+    } else if (assetImageBuffer.componentType ==
+               tydra::ComponentType::Float) {
+      // ignore preserve_texel_bitdepth
 
-      if (err.size()) {
-        // report as warn.
-        PUSH_WARN(fmt::format("Failed to load texture image: `{}`. Skip loading. reason = {} ", assetPath.GetAssetPath(), err));
-      }
+      if (texImage->usdColorSpace == tydra::ColorSpace::sRGB) {
+        // srgb f32 -> linear f32
+        std::vector<float> in_buf;
+        std::vector<float> out_buf;
+        in_buf.resize(assetImageBuffer.data.size() / sizeof(float));
+        memcpy(in_buf.data(), assetImageBuffer.data.data(),
+               in_buf.size() * sizeof(float));
 
-      // store unresolved asset path.
-      texImage.asset_identifier = assetPath.GetAssetPath();
+        out_buf.resize(assetImageBuffer.data.size() / sizeof(float));
+
+        // TODO: scale factor & bias
+        float scale_factor = 1.0f;
+        float bias = 0.0f;
+        float alpha_scale_factor = 1.0f;
+        float alpha_bias = 0.0f;
+
+        bool ret =
+            srgb_f32_to_linear_f32(in_buf, width, height, channels,
+                                   /* channel stride */ channels, &out_buf, scale_factor, bias, alpha_scale_factor, alpha_bias, err);
+
+        if (!ret) {
+          (*err) += "Failed to convert sRGB f32 image to Linear f32 image.\n";
+          return false;
+        }
+
+        imageBuffer.data.resize(assetImageBuffer.data.size());
+        memcpy(imageBuffer.data.data(), out_buf.data(),
+               imageBuffer.data.size());
 
-    } else {
-      // store resolved asset path.
-      texImage.asset_identifier =
-          env.asset_resolver.resolve(assetPath.GetAssetPath());
-    }
 
-    // colorSpace.
-    // First look into `colorSpace` metadata of asset, then
-    // look into `inputs:sourceColorSpace' attribute.
-    // When both `colorSpace` metadata and `inputs:sourceColorSpace' attribute
-    // exists, `colorSpace` metadata supercedes.
-    // NOTE: `inputs:sourceColorSpace` attribute should be deprecated in favor of `colorSpace` metadata.
-    bool inferColorSpaceFailed = false;
-    if (texture.file.metas().has_colorSpace()) {
-      ColorSpace cs;
-      value::token cs_token = texture.file.metas().get_colorSpace();
-      if (InferColorSpace(cs_token, &cs)) {
-        texImage.usdColorSpace = cs;
-        DCOUT("Inferred colorSpace: " << to_string(cs));
+      } else if (texImage->usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
+        // no op
+        imageBuffer = std::move(assetImageBuffer);
+
       } else {
-        inferColorSpaceFailed = true;
+        (*err) += fmt::format("TODO: Color space {}",
+                              to_string(texImage->usdColorSpace)) + "\n";
       }
+
+    } else {
+      (*err) += fmt::format("TODO: asset texture texel format {}",
+                            to_string(assetImageBuffer.componentType)) + "\n";
     }
 
-    bool sourceColorSpaceSet = false;
-    if (inferColorSpaceFailed || !texture.file.metas().has_colorSpace()) {
-      if (texture.sourceColorSpace.authored()) {
-        UsdUVTexture::SourceColorSpace cs;
-        if (texture.sourceColorSpace.get_value().get(env.timecode, &cs)) {
-          if (cs == UsdUVTexture::SourceColorSpace::SRGB) {
-            texImage.usdColorSpace = tydra::ColorSpace::sRGB;
-            sourceColorSpaceSet = true;
-          } else if (cs == UsdUVTexture::SourceColorSpace::Raw) {
-            texImage.usdColorSpace = tydra::ColorSpace::Raw;
-            sourceColorSpaceSet = true;
-          } else if (cs == UsdUVTexture::SourceColorSpace::Auto) {
-
-            if (tex_loaded) {
-
-              // The spec says: https://openusd.org/release/spec_usdpreviewsurface.html
-              //
-              // auto : Check for gamma/color space metadata in the texture file itself; if metadata is indicative of sRGB, mark texture as sRGB . If no relevant metadata is found, mark texture as sRGB if it is either 8-bit and has 3 channels or if it is 8-bit and has 4 channels. Otherwise, do not mark texture as sRGB and use texture data as it was read from the texture.
-              //
-              if (((texImage.assetTexelComponentType == ComponentType::UInt8) ||
-                  (texImage.assetTexelComponentType == ComponentType::Int8)) &&
-                ((texImage.channels == 3) || (texImage.channels ==4))) {
-                texImage.usdColorSpace = tydra::ColorSpace::sRGB;
-                sourceColorSpaceSet = true;
-              } else {
-                PUSH_WARN(fmt::format("Infer colorSpace failed for {}. Set to Raw for now. Results may be wrong.", assetPath.GetAssetPath()));
-                // At least 'not' sRGB. For now set to Raw.
+  } else {
+    // Same color space.
+    DCOUT("assetImageBuffer.sz = " << assetImageBuffer.data.size());
 
-                texImage.usdColorSpace = tydra::ColorSpace::Raw;
-                sourceColorSpaceSet = true;
-              }
-            } else {
-              texImage.usdColorSpace = tydra::ColorSpace::Unknown;
-              sourceColorSpaceSet = true;
-            }
-          }
+    if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
+      if (config.preserve_texel_bitdepth) {
+        // Do nothing.
+        imageBuffer = std::move(assetImageBuffer);
+
+      } else {
+        size_t width = size_t(texImage->width);
+        size_t height = size_t(texImage->height);
+        size_t channels = size_t(texImage->channels);
+
+        // u8 to f32, but no sRGB -> linear conversion(this would break
+        // UsdPreviewSurface's spec though)
+        (*warn) += "8bit sRGB texture is converted to fp32 sRGB texture(without "
+                   "linearlization)\n";
+        std::vector<float> buf;
+        bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
+                                   channels, &buf, err);
+        if (!ret) {
+          (*err) += "Failed to convert u8 image to f32 image.\n";
+          return false;
         }
+        imageBuffer.componentType = tydra::ComponentType::Float;
+
+        imageBuffer.data.resize(buf.size() * sizeof(float));
+        memcpy(imageBuffer.data.data(), buf.data(),
+               sizeof(float) * buf.size());
       }
-    }
 
-    if (!sourceColorSpaceSet && inferColorSpaceFailed) {
-      value::token cs_token = texture.file.metas().get_colorSpace();
-      PUSH_ERROR_AND_RETURN(
-          fmt::format("Invalid or unknown colorSpace metadataum: {}. Please "
-                      "report an issue to TinyUSDZ github repo.",
-                      cs_token.str()));
-    }
+      texImage->colorSpace = texImage->usdColorSpace;
 
-    if (tex_loaded) {
-      BufferData imageBuffer;
+    } else if (assetImageBuffer.componentType ==
+               tydra::ComponentType::Float) {
+      // ignore preserve_texel_bitdepth
 
-      // Linearlization and widen texel bit depth if required.
-      if (env.material_config.linearize_color_space) {
-        // TODO: Support ACEScg and Lin_DisplayP3
-        DCOUT("linearlize colorspace.");
-        size_t width = size_t(texImage.width);
-        size_t height = size_t(texImage.height);
-        size_t channels = size_t(texImage.channels);
+      // f32 to f32, so no op
+      imageBuffer = std::move(assetImageBuffer);
 
-        if (channels > 4) {
-          PUSH_ERROR_AND_RETURN(
-              fmt::format("TODO: Multiband color channels(5 or more) are not "
-                          "supported(yet)."));
-        }
+    } else {
+      (*err) += fmt::format("TODO: asset texture texel format {}",
+                            to_string(assetImageBuffer.componentType)) + "\n";
+    }
+  }
 
-        if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
-          if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
-            if (env.material_config.preserve_texel_bitdepth) {
-              // u8 sRGB -> u8 Linear
-              imageBuffer.componentType = tydra::ComponentType::UInt8;
-
-              bool ret = srgb_8bit_to_linear_8bit(
-                  assetImageBuffer.data, width, height, channels,
-                  /* channel stride */ channels, &imageBuffer.data, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN(
-                    "Failed to convert sRGB u8 image to Linear u8 image.");
-              }
+  return true;
+}
 
-            } else {
-              DCOUT("u8 sRGB -> fp32 linear.");
-              // u8 sRGB -> fp32 Linear
-              imageBuffer.componentType = tydra::ComponentType::Float;
-
-              std::vector<float> buf;
-              bool ret = srgb_8bit_to_linear_f32(
-                  assetImageBuffer.data, width, height, channels,
-                  /* channel stride */ channels, &buf, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN(
-                    "Failed to convert sRGB u8 image to Linear f32 image.");
-              }
+}  // namespace
 
-              DCOUT("sz = " << buf.size());
-              imageBuffer.data.resize(buf.size() * sizeof(float));
-              memcpy(imageBuffer.data.data(), buf.data(),
-                     sizeof(float) * buf.size());
-            }
+namespace {
 
-            texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
+//
+// Content hash to find Prims unchanged since the previous
+// `RenderSceneConverter::UpdateRenderScene`.
+//
+// 64bit FNV-1a, but consumes 8 bytes at once so that large arrays(e.g.
+// `points`) are hashed fast.
+//
+class ContentHasher {
+ public:
+  void add_bytes(const void *data, size_t n) {
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      uint64_t w;
+      memcpy(&w, p + i, 8);
+      _h = (_h ^ w) * kFNV_Prime;
+    }
+    for (; i < n; i++) {
+      _h = (_h ^ p[i]) * kFNV_Prime;
+    }
+  }
 
-          } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
-            if (env.material_config.preserve_texel_bitdepth) {
-              // no op.
-              imageBuffer = std::move(assetImageBuffer);
+  void add(const std::string &s) {
+    add(uint64_t(s.size()));
+    add_bytes(s.data(), s.size());
+  }
 
-            } else {
-              // u8 -> fp32
-              imageBuffer.componentType = tydra::ComponentType::Float;
-
-              std::vector<float> buf;
-              bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
-                                         channels, &buf, &_err);
-              if (!ret) {
-                PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
-              }
+  void add(const uint64_t v) { add_bytes(&v, sizeof(v)); }
 
-              imageBuffer.data.resize(buf.size() * sizeof(float));
-              memcpy(imageBuffer.data.data(), buf.data(),
-                     sizeof(float) * buf.size());
-            }
+  void add(const double v) { add_bytes(&v, sizeof(v)); }
 
-            texImage.colorSpace = tydra::ColorSpace::Lin_sRGB;
+  void add(const bool v) { add(uint64_t(v ? 1 : 0)); }
 
-          } else {
-            PUSH_ERROR(fmt::format("TODO: Color space {}",
-                                   to_string(texImage.usdColorSpace)));
-          }
+  template <typename T>
+  void add_array(const std::vector<T> &v) {
+    add(uint64_t(v.size()));
+    add_bytes(v.data(), v.size() * sizeof(T));
+  }
 
-        } else if (assetImageBuffer.componentType ==
-                   tydra::ComponentType::Float) {
-          // ignore preserve_texel_bitdepth
-
-          if (texImage.usdColorSpace == tydra::ColorSpace::sRGB) {
-            // srgb f32 -> linear f32
-            std::vector<float> in_buf;
-            std::vector<float> out_buf;
-            in_buf.resize(assetImageBuffer.data.size() / sizeof(float));
-            memcpy(in_buf.data(), assetImageBuffer.data.data(),
-                   in_buf.size() * sizeof(float));
-
-            out_buf.resize(assetImageBuffer.data.size() / sizeof(float));
-
-            // TODO: scale factor & bias
-            float scale_factor = 1.0f;
-            float bias = 0.0f;
-            float alpha_scale_factor = 1.0f;
-            float alpha_bias = 0.0f;
-
-            bool ret =
-                srgb_f32_to_linear_f32(in_buf, width, height, channels,
-                                       /* channel stride */ channels, &out_buf, scale_factor, bias, alpha_scale_factor, alpha_bias, &_err);
-
-            if (!ret) {
-              PUSH_ERROR_AND_RETURN(
-                  "Failed to convert sRGB f32 image to Linear f32 image.");
-            }
+  uint64_t value() const { return _h; }
 
-            imageBuffer.data.resize(assetImageBuffer.data.size());
-            memcpy(imageBuffer.data.data(), out_buf.data(),
-                   imageBuffer.data.size());
+  // Hashed data contains time samples. i.e. the converted result depends on
+  // timecode.
+  bool time_varying{false};
 
+  // Hashed data contains attribute connections. The value of connection
+  // target is not tracked.
+  bool connected{false};
 
-          } else if (texImage.usdColorSpace == tydra::ColorSpace::Lin_sRGB) {
-            // no op
-            imageBuffer = std::move(assetImageBuffer);
+ private:
+  static constexpr uint64_t kFNV_Prime = 0x100000001b3ull;
+  static constexpr uint64_t kFNV_Offset_Basis = 0xcbf29ce484222325ull;
 
-          } else {
-            PUSH_ERROR(fmt::format("TODO: Color space {}",
-                                   to_string(texImage.usdColorSpace)));
-          }
+  uint64_t _h{kFNV_Offset_Basis};
+};
 
-        } else {
-          PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
-                                 to_string(assetImageBuffer.componentType)));
-        }
+// Hash USDA representation of Prim(or its part) which is usually small.
+void HashText(const std::string &s, ContentHasher *hasher) {
+  if (s.find(".timeSamples") != std::string::npos) {
+    hasher->time_varying = true;
+  }
+  hasher->add(s);
+}
+
+void HashConnections(const std::vector<Path> &paths, ContentHasher *hasher) {
+  hasher->add(uint64_t(paths.size()));
+  for (const auto &path : paths) {
+    hasher->connected = true;
+    hasher->add(path.full_path_name());
+  }
+}
+
+void HashValue(const value::Value &v, ContentHasher *hasher) {
+  hasher->add(uint64_t(v.type_id()));
+
+  // Array of trivially copyable types is hashed as is.
+#define HASH_ARRAY_VALUE(__ty)                                   \
+  case value::TypeTraits<std::vector<__ty>>::type_id(): {       \
+    if (auto pv = v.as<std::vector<__ty>>(/* strict_cast */ true)) { \
+      hasher->add_array(*pv);                                    \
+      return;                                                    \
+    }                                                            \
+    break;                                                       \
+  }
+
+  switch (v.type_id()) {
+    HASH_ARRAY_VALUE(int32_t)
+    HASH_ARRAY_VALUE(uint32_t)
+    HASH_ARRAY_VALUE(float)
+    HASH_ARRAY_VALUE(value::float2)
+    HASH_ARRAY_VALUE(value::float3)
+    HASH_ARRAY_VALUE(value::float4)
+    HASH_ARRAY_VALUE(double)
+    HASH_ARRAY_VALUE(value::double2)
+    HASH_ARRAY_VALUE(value::double3)
+    HASH_ARRAY_VALUE(value::double4)
+    HASH_ARRAY_VALUE(value::half)
+    HASH_ARRAY_VALUE(value::point3f)
+    HASH_ARRAY_VALUE(value::normal3f)
+    HASH_ARRAY_VALUE(value::vector3f)
+    HASH_ARRAY_VALUE(value::color3f)
+    HASH_ARRAY_VALUE(value::color4f)
+    HASH_ARRAY_VALUE(value::texcoord2f)
+    HASH_ARRAY_VALUE(value::texcoord3f)
+    HASH_ARRAY_VALUE(value::matrix4d)
+    default:
+      break;
+  }
+
+#undef HASH_ARRAY_VALUE
+
+  hasher->add(value::pprint_value(v));
+}
+
+void HashAttribute(const Attribute &attr, ContentHasher *hasher) {
+  hasher->add(attr.type_name());
+  hasher->add(uint64_t(attr.variability()));
+  hasher->add(print_attr_metas(attr.metas(), 0));  // e.g. `interpolation`
+  HashConnections(attr.connections(), hasher);
+
+  const primvar::PrimVar &var = attr.get_var();
+  hasher->add(var.is_blocked());
+
+  if (var.has_value()) {
+    HashValue(var.value_raw(), hasher);
+  }
+
+  if (var.has_timesamples()) {
+    hasher->time_varying = true;
+
+    const value::TimeSamples &ts = var.ts_raw();
+    hasher->add_array(ts.get_times());
+    for (size_t i = 0; i < ts.size(); i++) {
+      hasher->add(ts.is_blocked(i));
+      HashValue(ts.get_values()[i], hasher);
+    }
+  }
+}
+
+template <typename T>
+void HashTypedArrayAttribute(
+    const TypedAttribute<Animatable<std::vector<T>>> &attr,
+    ContentHasher *hasher) {
+  hasher->add(attr.authored());
+  hasher->add(attr.is_blocked());
+  hasher->add(print_attr_metas(attr.metas(), 0));
+  HashConnections(attr.get_connections(), hasher);
+
+  const nonstd::optional<Animatable<std::vector<T>>> v = attr.get_value();
+  if (!v) {
+    return;
+  }
+
+  hasher->add(v.value().is_blocked());
+
+  std::vector<T> default_value;
+  if (v.value().get_default(&default_value)) {
+    hasher->add_array(default_value);
+  }
+
+  if (v.value().has_timesamples()) {
+    hasher->time_varying = true;
+
+    const TypedTimeSamples<std::vector<T>> &ts = v.value().get_timesamples();
+    hasher->add_array(ts.get_times());
+    for (size_t i = 0; i < ts.size(); i++) {
+      hasher->add(ts.is_blocked(i));
+      hasher->add_array(ts.get_values()[i]);
+    }
+  }
+}
+
+//
+// Hash GeomMesh data read in `RenderSceneConverter::ConvertMesh`.
+// Returns false when the mesh must be always converted.
+//
+bool HashMeshContent(
+    const RenderSceneConverterEnv &env, const GeomMesh &mesh,
+    const MaterialPath &material_path,
+    const std::map<std::string, MaterialPath> &subset_material_path_map,
+    const std::vector<const GeomSubset *> &material_subsets,
+    const std::vector<std::pair<std::string, const BlendShape *>> &blendshapes,
+    uint64_t *hash) {
+  if (mesh.skeleton.has_value()) {
+    // Skeleton and SkelAnimation are registered while converting the mesh.
+    return false;
+  }
+
+  ContentHasher hasher;
+
+  // Array attributes are hashed as binary. Other(usually small) part of the
+  // mesh is hashed as text.
+  HashTypedArrayAttribute(mesh.points, &hasher);
+  HashTypedArrayAttribute(mesh.normals, &hasher);
+  HashTypedArrayAttribute(mesh.velocities, &hasher);
+  HashTypedArrayAttribute(mesh.faceVertexCounts, &hasher);
+  HashTypedArrayAttribute(mesh.faceVertexIndices, &hasher);
+
+  for (const auto &prop : mesh.props) {
+    hasher.add(prop.first);
+    if (prop.second.is_relationship()) {
+      HashText(print_rel_prop(prop.second, prop.first, 0), &hasher);
+    } else {
+      HashAttribute(prop.second.get_attribute(), &hasher);
+    }
+  }
+
+  {
+    GeomMesh rest = mesh;
+    rest.points = decltype(rest.points)();
+    rest.normals = decltype(rest.normals)();
+    rest.velocities = decltype(rest.velocities)();
+    rest.faceVertexCounts = decltype(rest.faceVertexCounts)();
+    rest.faceVertexIndices = decltype(rest.faceVertexIndices)();
+    rest.props.clear();
+    HashText(tinyusdz::to_string(rest), &hasher);
+  }
+
+  for (const auto &psubset : material_subsets) {
+    HashText(tinyusdz::to_string(*psubset), &hasher);
+  }
+
+  for (const auto &bs : blendshapes) {
+    hasher.add(bs.first);
+    HashText(tinyusdz::to_string(*bs.second), &hasher);
+  }
+
+  auto HashMaterialPath = [&hasher](const MaterialPath &mpath) {
+    hasher.add(mpath.material_path);
+    hasher.add(mpath.backface_material_path);
+    hasher.add(uint64_t(int64_t(mpath.default_material_id)));
+    hasher.add(uint64_t(int64_t(mpath.default_backface_material_id)));
+    hasher.add(mpath.default_texcoords_primvar_name);
+  };
+
+  HashMaterialPath(material_path);
+  for (const auto &it : subset_material_path_map) {
+    hasher.add(it.first);
+    HashMaterialPath(it.second);
+  }
+
+  if (hasher.connected) {
+    return false;
+  }
+
+  if (hasher.time_varying) {
+    hasher.add(env.timecode);
+    hasher.add(uint64_t(env.tinterp));
+  }
+
+  (*hash) = hasher.value();
+  return true;
+}
+
+//
+// Hash Material Prim and its Shader Prims.
+//
+uint64_t HashMaterialContent(const RenderSceneConverterEnv &env,
+                             const Path &abs_path) {
+  ContentHasher hasher;
+  hasher.add(abs_path.full_path_name());
+
+  const Prim *prim{nullptr};
+  std::string err;
+  if (env.stage.find_prim_at_path(abs_path, prim, &err) && prim) {
+    HashText(prim::print_prim(*prim), &hasher);
+  }
+
+  if (hasher.time_varying) {
+    hasher.add(env.timecode);
+    hasher.add(uint64_t(env.tinterp));
+  }
+
+  return hasher.value();
+}
+
+//
+// Conversion results of the previous `UpdateRenderScene` and their keys.
+//
+struct IncrementalCache {
+  // Previous conversion.
+  std::vector<RenderMesh> prev_meshes;
+  StringAndIdMap prev_meshMap;
+  StringAndIdMap prev_materialMap;
+  std::map<std::string, uint64_t> prev_mesh_keys;
+  std::map<std::string, uint64_t> prev_material_keys;
+
+  // Current conversion.
+  std::map<std::string, uint64_t> mesh_keys;
+  std::map<std::string, uint64_t> material_keys;
+  std::set<std::string> reused_meshes;
+
+  // uv_hashes[i] = Hash of UV primvar names used in RenderMaterial [0, i).
+  std::vector<uint64_t> uv_hashes;
+
+  //
+  // Key of RenderMesh. In addition to the content of GeomMesh, the
+  // converted RenderMesh depends on the IDs of bound RenderMaterials and
+  // UV primvar names used in all RenderMaterials converted so far.
+  //
+  uint64_t MeshKey(
+      uint64_t content_hash, const MaterialPath &material_path,
+      const std::map<std::string, MaterialPath> &subset_material_path_map,
+      const StringAndIdMap &materialMap,
+      const std::vector<RenderMaterial> &materials,
+      const std::vector<UVTexture> &textures) {
+    if (uv_hashes.empty()) {
+      uv_hashes.push_back(ContentHasher().value());
+    }
+
+    while (uv_hashes.size() <= materials.size()) {
+      ContentHasher hasher;
+      hasher.add(uv_hashes.back());
+
+      StringAndIdMap uvname_map;
+      ListUVNames(materials[uv_hashes.size() - 1], textures, uvname_map);
+      for (auto it = uvname_map.i_begin(); it != uvname_map.i_end(); it++) {
+        hasher.add(it->first);
+        hasher.add(it->second);
+      }
+
+      uv_hashes.push_back(hasher.value());
+    }
+
+    ContentHasher hasher;
+    hasher.add(content_hash);
+    hasher.add(uv_hashes[materials.size()]);
+
+    auto AddMaterialId = [&](const std::string &path) {
+      auto it = materialMap.find(path);
+      hasher.add((it != materialMap.s_end()) ? it->second : ~uint64_t(0));
+    };
+
+    AddMaterialId(material_path.material_path);
+    AddMaterialId(material_path.backface_material_path);
+    for (const auto &it : subset_material_path_map) {
+      AddMaterialId(it.second.material_path);
+      AddMaterialId(it.second.backface_material_path);
+    }
+
+    return hasher.value();
+  }
+
+  //
+  // Find previous RenderMesh converted from the same input. Returns nullptr
+  // when not found. The returned RenderMesh can be moved.
+  //
+  RenderMesh *FindReusableMesh(const std::string &abs_path, uint64_t key) {
+    mesh_keys[abs_path] = key;
+
+    auto kit = prev_mesh_keys.find(abs_path);
+    if ((kit == prev_mesh_keys.end()) || (kit->second != key)) {
+      return nullptr;
+    }
+
+    auto mit = prev_meshMap.find(abs_path);
+    if ((mit == prev_meshMap.s_end()) || (mit->second >= prev_meshes.size())) {
+      return nullptr;
+    }
+
+    if (reused_meshes.count(abs_path)) {
+      return nullptr;
+    }
+    reused_meshes.insert(abs_path);
+
+    return &prev_meshes[size_t(mit->second)];
+  }
+};
+
+}  // namespace
+
+struct RenderSceneConverter::TextureCache {
+  // Decoded texture asset.
+  struct Asset {
+    bool loaded{false};
+    TextureImage image;
+    std::vector<uint8_t> data;  // Raw texel data. Released once converted.
+    bool data_released{false};
+    std::string warn;
+    std::string err;
+  };
+
+  // Texture image whose texel data is converted for a color space.
+  struct ConvertedImage {
+    bool ok{false};
+    TextureImage image;
+    BufferData buffer;
+    std::string warn;
+    std::string err;
+  };
+
+  using ImageKey = std::pair<std::string, ColorSpace>;
+
+  // key = resolved asset path
+  std::map<std::string, Asset> assets;
+
+  // Converted images prefetched by `PrefetchTextureImages`.
+  // key = (resolved asset path, TextureImage::usdColorSpace)
+  std::map<ImageKey, ConvertedImage> converted_images;
+
+  // Index to `RenderSceneConverter::images`
+  // key = (resolved asset path, TextureImage::usdColorSpace)
+  std::map<ImageKey, int64_t> image_ids;
+
+  static std::string AssetKey(const RenderSceneConverterEnv &env,
+                              const value::AssetPath &assetPath) {
+    std::string resolved_path =
+        env.asset_resolver.resolve(assetPath.GetAssetPath());
+    if (resolved_path.empty()) {
+      return assetPath.GetAssetPath();
+    }
+    return resolved_path;
+  }
+
+  static void LoadAsset(const RenderSceneConverterEnv &env,
+                        const value::AssetPath &assetPath,
+                        const AssetInfo &assetInfo, Asset *asset) {
+    TextureImageLoaderFunction tex_loader_fun =
+        env.material_config.texture_image_loader_function;
+
+    if (!tex_loader_fun) {
+      tex_loader_fun = DefaultTextureImageLoaderFunction;
+    }
+
+    asset->image = TextureImage();
+    asset->data.clear();
+    asset->loaded = tex_loader_fun(
+        assetPath, assetInfo, env.asset_resolver, &asset->image, &asset->data,
+        env.material_config.texture_image_loader_function_userdata,
+        &asset->warn, &asset->err);
+    asset->data_released = false;
+  }
+
+  static void ConvertImage(const MaterialConverterConfig &config,
+                           const TextureImage &texImage,
+                           std::vector<uint8_t> &&data, ConvertedImage *out) {
+    BufferData assetImageBuffer;
+
+    // Texel data is treated as byte array
+    assetImageBuffer.componentType = ComponentType::UInt8;
+    assetImageBuffer.data = std::move(data);
+
+    out->image = texImage;
+    out->ok = ConvertTextureTexels(config, &out->image, assetImageBuffer,
+                                   out->buffer, &out->warn, &out->err);
+  }
+};
+
+struct RenderSceneConverter::IncrementalState : IncrementalCache {
+  bool active{false};    // true while running UpdateRenderScene.
+  bool has_prev{false};  // true when the previous UpdateRenderScene succeeded.
+
+  std::vector<Node> prev_nodes;
+  std::map<TextureCache::ImageKey, int64_t> prev_image_ids;
+};
+
+RenderSceneConverter::~RenderSceneConverter() {
+  delete _texture_cache;
+  delete _incremental;
+}
+
+namespace {
+
+struct UVTextureShader {
+  const Shader *shader{nullptr};
+  const UsdUVTexture *texture{nullptr};
+};
+
+bool CollectUVTexturesVisitor(const tinyusdz::Path &abs_path,
+                              const tinyusdz::Prim &prim, const int32_t level,
+                              void *userdata, std::string *err) {
+  (void)abs_path;
+
+  if (level > 1024 * 1024) {
+    if (err) {
+      (*err) += "Scene graph is too deep.\n";
+    }
+    return false;
+  }
+
+  auto *shaders = reinterpret_cast<std::vector<UVTextureShader> *>(userdata);
+
+  if (const Shader *pshader = prim.as<Shader>()) {
+    if (const UsdUVTexture *ptex = pshader->value.as<UsdUVTexture>()) {
+      UVTextureShader item;
+      item.shader = pshader;
+      item.texture = ptex;
+      shaders->push_back(item);
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+bool RenderSceneConverter::PrefetchTextureImages(
+    const RenderSceneConverterEnv &env, size_t num_threads) {
+  if (!_texture_cache) {
+    _texture_cache = new TextureCache();
+  }
+  TextureCache &cache = *_texture_cache;
+
+  //
+  // 1. Collect unique texture assets referenced by UsdUVTexture Shaders.
+  //
+  std::vector<UVTextureShader> shaders;
+  {
+    std::string err;
+    if (!tydra::VisitPrims(env.stage, CollectUVTexturesVisitor, &shaders,
+                           &err)) {
+      PUSH_ERROR_AND_RETURN(err);
+    }
+  }
+
+  struct TextureRef {
+    const UsdUVTexture *texture{nullptr};
+    value::AssetPath assetPath;
+    std::string key;
+  };
+
+  struct AssetToLoad {
+    std::string key;
+    value::AssetPath assetPath;
+    AssetInfo assetInfo;
+  };
+
+  std::vector<TextureRef> refs;
+  std::vector<AssetToLoad> assets_to_load;
+  {
+    std::set<std::string> keys;
+
+    for (const auto &item : shaders) {
+      TextureRef ref;
+      ref.texture = item.texture;
+
+      if (!item.texture->file.authored()) {
+        continue;
+      }
+
+      // Errors are reported in ConvertUVTexture.
+      auto apath = item.texture->file.get_value();
+      if (!apath || !apath.value().get(env.timecode, &ref.assetPath)) {
+        continue;
+      }
+
+      ref.key = TextureCache::AssetKey(env, ref.assetPath);
+
+      if (!cache.assets.count(ref.key) && !keys.count(ref.key)) {
+        keys.insert(ref.key);
+
+        AssetToLoad asset;
+        asset.key = ref.key;
+        asset.assetPath = ref.assetPath;
+        asset.assetInfo = item.shader->metas().get_assetInfo();
+        assets_to_load.push_back(asset);
+      }
 
+      refs.push_back(ref);
+    }
+  }
+
+  //
+  // 2. Decode texture assets.
+  //
+  {
+    std::vector<TextureCache::Asset> loaded(assets_to_load.size());
+
+    ParallelFor(assets_to_load.size(), num_threads, [&](size_t i) {
+      TextureCache::LoadAsset(env, assets_to_load[i].assetPath,
+                              assets_to_load[i].assetInfo, &loaded[i]);
+    });
+
+    for (size_t i = 0; i < assets_to_load.size(); i++) {
+      cache.assets[assets_to_load[i].key] = std::move(loaded[i]);
+    }
+  }
+
+  //
+  // 3. Convert texel data for each unique (asset, color space) pair.
+  //
+  struct ImageToConvert {
+    TextureCache::ImageKey key;
+    TextureImage image;  // with usdColorSpace
+  };
+
+  std::vector<ImageToConvert> images_to_convert;
+  std::map<std::string, size_t> num_images_per_asset;
+  {
+    std::set<TextureCache::ImageKey> keys;
+
+    for (const auto &ref : refs) {
+      const TextureCache::Asset &asset = cache.assets.at(ref.key);
+      if (!asset.loaded || asset.data_released) {
+        continue;
+      }
+
+      TextureImage texImage = asset.image;
+      std::string warn, err;
+      if (!InferUVTextureColorSpace(*ref.texture, ref.assetPath, env.timecode,
+                                    /* tex_loaded */ true, &texImage, &warn,
+                                    &err)) {
+        // Errors are reported in ConvertUVTexture.
+        continue;
+      }
+
+      TextureCache::ImageKey key(ref.key, texImage.usdColorSpace);
+      if (keys.count(key) || cache.converted_images.count(key) ||
+          cache.image_ids.count(key)) {
+        continue;
+      }
+      keys.insert(key);
+
+      ImageToConvert image;
+      image.key = key;
+      image.image = texImage;
+      images_to_convert.push_back(image);
+
+      num_images_per_asset[ref.key]++;
+    }
+  }
+
+  {
+    std::vector<TextureCache::ConvertedImage> converted(
+        images_to_convert.size());
+
+    ParallelFor(images_to_convert.size(), num_threads, [&](size_t i) {
+      const ImageToConvert &image = images_to_convert[i];
+      TextureCache::Asset &asset = cache.assets.at(image.key.first);
+
+      std::vector<uint8_t> data;
+      if (num_images_per_asset.at(image.key.first) == 1) {
+        // No other image uses the asset.
+        data = std::move(asset.data);
       } else {
-        // Same color space.
-        DCOUT("assetImageBuffer.sz = " << assetImageBuffer.data.size());
+        data = asset.data;
+      }
 
-        if (assetImageBuffer.componentType == tydra::ComponentType::UInt8) {
-          if (env.material_config.preserve_texel_bitdepth) {
-            // Do nothing.
-            imageBuffer = std::move(assetImageBuffer);
+      TextureCache::ConvertImage(env.material_config, image.image,
+                                 std::move(data), &converted[i]);
+    });
 
-          } else {
-            size_t width = size_t(texImage.width);
-            size_t height = size_t(texImage.height);
-            size_t channels = size_t(texImage.channels);
-
-            // u8 to f32, but no sRGB -> linear conversion(this would break
-            // UsdPreviewSurface's spec though)
-            PUSH_WARN(
-                "8bit sRGB texture is converted to fp32 sRGB texture(without "
-                "linearlization)");
-            std::vector<float> buf;
-            bool ret = u8_to_f32_image(assetImageBuffer.data, width, height,
-                                       channels, &buf, &_err);
-            if (!ret) {
-              PUSH_ERROR_AND_RETURN("Failed to convert u8 image to f32 image.");
-            }
-            imageBuffer.componentType = tydra::ComponentType::Float;
+    for (size_t i = 0; i < images_to_convert.size(); i++) {
+      cache.converted_images[images_to_convert[i].key] =
+          std::move(converted[i]);
+    }
 
-            imageBuffer.data.resize(buf.size() * sizeof(float));
-            memcpy(imageBuffer.data.data(), buf.data(),
-                   sizeof(float) * buf.size());
-          }
+    for (const auto &it : num_images_per_asset) {
+      TextureCache::Asset &asset = cache.assets.at(it.first);
+      asset.data.clear();
+      asset.data.shrink_to_fit();
+      asset.data_released = true;
+    }
+  }
+
+  return true;
+}
+
+// Convert UsdUVTexture shader node.
+// @return true upon conversion success(textures.back() contains the converted
+// UVTexture)
+//
+// Possible network configuration
+//
+// - UsdUVTexture -> UsdPrimvarReader
+// - UsdUVTexture -> UsdTransform2d -> UsdPrimvarReader
+bool RenderSceneConverter::ConvertUVTexture(const RenderSceneConverterEnv &env,
+                                            const Path &tex_abs_path,
+                                            const AssetInfo &assetInfo,
+                                            const UsdUVTexture &texture,
+                                            UVTexture *tex_out) {
+  DCOUT("ConvertUVTexture " << tex_abs_path);
+
+  if (!tex_out) {
+    PUSH_ERROR_AND_RETURN("tex_out arg is nullptr.");
+  }
+  std::string err;
 
-          texImage.colorSpace = texImage.usdColorSpace;
+  UVTexture tex;
 
-        } else if (assetImageBuffer.componentType ==
-                   tydra::ComponentType::Float) {
-          // ignore preserve_texel_bitdepth
+  if (!texture.file.authored()) {
+    PUSH_ERROR_AND_RETURN(fmt::format("`asset:file` is not authored. Path = {}",
+                                      tex_abs_path.prim_part()));
+  }
 
-          // f32 to f32, so no op
-          imageBuffer = std::move(assetImageBuffer);
+  value::AssetPath assetPath;
+  if (auto apath = texture.file.get_value()) {
+    if (!apath.value().get(env.timecode, &assetPath)) {
+      PUSH_ERROR_AND_RETURN(fmt::format(
+          "Failed to get `asset:file` value from Path {} at time {}",
+          tex_abs_path.prim_part(), env.timecode));
+    }
+  } else {
+    PUSH_ERROR_AND_RETURN(
+        fmt::format("Failed to get `asset:file` value from Path {}",
+                    tex_abs_path.prim_part()));
+  }
+
+  // TextureImage and BufferData
+  {
+    TextureImage texImage;
+
+    bool tex_loaded{false};
+
+    // Texture assets are identified by its resolved asset path.
+    std::string asset_key;
+
+    if (env.scene_config.load_texture_assets) {
+      DCOUT("load texture : " << assetPath.GetAssetPath());
+
+      if (!_texture_cache) {
+        _texture_cache = new TextureCache();
+      }
+
+      asset_key = TextureCache::AssetKey(env, assetPath);
+
+      auto it = _texture_cache->assets.find(asset_key);
+      if (it == _texture_cache->assets.end()) {
+        TextureCache::Asset asset;
+        TextureCache::LoadAsset(env, assetPath, assetInfo, &asset);
+        it = _texture_cache->assets.emplace(asset_key, std::move(asset)).first;
+      }
+
+      const TextureCache::Asset &asset = it->second;
+
+      texImage = asset.image;
+      tex_loaded = asset.loaded;
+
+      if (asset.warn.size()) {
+        DCOUT("WARN: " << asset.warn);
+        PushWarn(asset.warn);
+      }
+
+      if (!tex_loaded && !env.material_config.allow_texture_load_failure) {
+        PUSH_ERROR_AND_RETURN(fmt::format("Failed to load texture image: `{}` err = {}", assetPath.GetAssetPath(), asset.err));
+      }
+
+
+      if (asset.err.size()) {
+        // report as warn.
+        PUSH_WARN(fmt::format("Failed to load texture image: `{}`. Skip loading. reason = {} ", assetPath.GetAssetPath(), asset.err));
+      }
+
+      // store unresolved asset path.
+      texImage.asset_identifier = assetPath.GetAssetPath();
 
+    } else {
+      // store resolved asset path.
+      texImage.asset_identifier =
+          env.asset_resolver.resolve(assetPath.GetAssetPath());
+    }
+
+    {
+      std::string warn;
+      bool ret = InferUVTextureColorSpace(texture, assetPath, env.timecode,
+                                          tex_loaded, &texImage, &warn, &err);
+      if (warn.size()) {
+        PushWarn(warn);
+      }
+
+      if (!ret) {
+        PUSH_ERROR_AND_RETURN(err);
+      }
+    }
+
+    if (tex_loaded) {
+      const TextureCache::ImageKey image_key(asset_key,
+                                             texImage.usdColorSpace);
+
+      auto id_it = _texture_cache->image_ids.find(image_key);
+      if (id_it != _texture_cache->image_ids.end()) {
+        // Share TextureImage(and BufferData) with other UVTexture.
+        tex.texture_image_id = id_it->second;
+      } else {
+        TextureCache::ConvertedImage converted;
+
+        auto conv_it = _texture_cache->converted_images.find(image_key);
+        if (conv_it != _texture_cache->converted_images.end()) {
+          // Converted in PrefetchTextureImages.
+          converted = std::move(conv_it->second);
+          _texture_cache->converted_images.erase(conv_it);
         } else {
-          PUSH_ERROR(fmt::format("TODO: asset texture texel format {}",
-                                 to_string(assetImageBuffer.componentType)));
+          TextureCache::Asset &asset = _texture_cache->assets.at(asset_key);
+          if (asset.data_released) {
+            // Texel data was consumed by other color space. Load it again.
+            TextureCache::Asset reloaded;
+            TextureCache::LoadAsset(env, assetPath, assetInfo, &reloaded);
+            asset.data = std::move(reloaded.data);
+            asset.data_released = false;
+          }
+
+          // Texel data is kept for UVTextures with other color space.
+          std::vector<uint8_t> data = asset.data;
+          TextureCache::ConvertImage(env.material_config, texImage,
+                                     std::move(data), &converted);
+        }
+
+        if (converted.warn.size()) {
+          PushWarn(converted.warn);
         }
-      }
 
-      // Assign buffer id
-      texImage.buffer_id = int64_t(buffers.size());
+        if (!converted.ok) {
+          PUSH_ERROR_AND_RETURN(converted.err);
+        }
+
+        if (converted.err.size()) {
+          PushError(converted.err);
+        }
 
-      // TODO: Share image data as much as possible.
-      // e.g. Texture A and B uses same image file, but texturing parameter is
-      // different.
-      buffers.emplace_back(imageBuffer);
+        TextureImage &convertedImage = converted.image;
+        convertedImage.asset_identifier = texImage.asset_identifier;
 
-      tex.texture_image_id = int64_t(images.size());
+        // Assign buffer id
+        convertedImage.buffer_id = int64_t(buffers.size());
 
-      images.emplace_back(texImage);
+        buffers.emplace_back(std::move(converted.buffer));
 
-      std::stringstream ss;
-      ss << "Loaded texture image " << assetPath.GetAssetPath()
-         << " : buffer_id " + std::to_string(texImage.buffer_id) << "\n";
-      ss << "  width x height x components " << texImage.width << " x "
-         << texImage.height << " x " << texImage.channels << "\n";
-      ss << "  colorSpace " << tinyusdz::tydra::to_string(texImage.colorSpace)
-         << "\n";
-      PushInfo(ss.str());
+        tex.texture_image_id = int64_t(images.size());
+
+        images.emplace_back(convertedImage);
+
+        _texture_cache->image_ids[image_key] = tex.texture_image_id;
+
+        std::stringstream ss;
+        ss << "Loaded texture image " << assetPath.GetAssetPath()
+           << " : buffer_id " + std::to_string(convertedImage.buffer_id) << "\n";
+        ss << "  width x height x components " << convertedImage.width << " x "
+           << convertedImage.height << " x " << convertedImage.channels << "\n";
+        ss << "  colorSpace " << tinyusdz::tydra::to_string(convertedImage.colorSpace)
+           << "\n";
+        PushInfo(ss.str());
+      }
     }
   }
 
@@ -5053,11 +6094,51 @@ bool RenderSceneConverter::ConvertMaterial(const RenderSceneConverterEnv &env,
 
 namespace {
 
+// GeomMesh Prim to convert, with Materials bound to it already converted.
+struct MeshConvertTask {
+  Path abs_path;
+  const GeomMesh *mesh{nullptr};
+  MaterialPath material_path;
+  std::map<std::string, MaterialPath> subset_material_path_map;
+  std::vector<const GeomSubset *> material_subsets;
+  std::vector<std::pair<std::string, const BlendShape *>> blendshapes;
+
+  // UpdateRenderScene: Hash of the mesh content. Valid when `reusable` is
+  // true.
+  bool reusable{false};
+  uint64_t content_hash{0};
+};
+
 struct MeshVisitorEnv {
   RenderSceneConverter *converter{nullptr};
   const RenderSceneConverterEnv *env{nullptr};
+
+  // When not nullptr, MeshVisitor only converts Materials and collects
+  // GeomMesh Prims to convert(Mesh conversion is done later with
+  // `ConvertMeshesParallel`).
+  std::vector<MeshConvertTask> *mesh_tasks{nullptr};
+
+  // Set in UpdateRenderScene to reuse RenderMeshes of the previous
+  // conversion.
+  IncrementalCache *incremental{nullptr};
 };
 
+bool AddRenderMesh(RenderSceneConverter *converter, const Path &abs_path,
+                   RenderMesh &&rmesh, std::string *err) {
+  uint64_t mesh_id = uint64_t(converter->meshes.size());
+  if (mesh_id >= size_t((std::numeric_limits<int32_t>::max)())) {
+    if (err) {
+      (*err) += "Mesh index too large.\n";
+    }
+    return false;
+  }
+  converter->meshMap.add(abs_path.full_path_name(), mesh_id);
+
+  converter->meshes.emplace_back(std::move(rmesh));
+
+  return true;
+}
+
 bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
                  const int32_t level, void *userdata, std::string *err) {
   if (!userdata) {
@@ -5151,6 +6232,12 @@ bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
 
         visitorEnv->converter->materialMap.add(
             bound_material_path.full_path_name(), uint64_t(rmaterial_id));
+
+        if (visitorEnv->incremental) {
+          visitorEnv->incremental
+              ->material_keys[bound_material_path.full_path_name()] =
+              HashMaterialContent(*visitorEnv->env, bound_material_path);
+        }
         DCOUT("Added renderMaterial: " << mat_id << " " << rmat.abs_path
                                        << " ( " << rmat.name << " ) ");
 
@@ -5321,6 +6408,43 @@ bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
       }
       DCOUT("# of blendshapes : " << blendshapes.size());
 
+      bool reusable = false;
+      uint64_t content_hash = 0;
+      if (visitorEnv->incremental) {
+        reusable = HashMeshContent(*visitorEnv->env, *pmesh, material_path,
+                                   subset_material_path_map, material_subsets,
+                                   blendshapes, &content_hash);
+      }
+
+      if (visitorEnv->mesh_tasks) {
+        MeshConvertTask task;
+        task.abs_path = abs_path;
+        task.mesh = pmesh;
+        task.material_path = material_path;
+        task.subset_material_path_map = std::move(subset_material_path_map);
+        task.material_subsets = std::move(material_subsets);
+        task.blendshapes = std::move(blendshapes);
+        task.reusable = reusable;
+        task.content_hash = content_hash;
+
+        visitorEnv->mesh_tasks->emplace_back(std::move(task));
+        return true;
+      }
+
+      if (reusable) {
+        const RenderSceneConverter *converter = visitorEnv->converter;
+        uint64_t key = visitorEnv->incremental->MeshKey(
+            content_hash, material_path, subset_material_path_map,
+            converter->materialMap, converter->materials,
+            converter->textures);
+
+        if (RenderMesh *prev = visitorEnv->incremental->FindReusableMesh(
+                mesh_path_str, key)) {
+          return AddRenderMesh(visitorEnv->converter, abs_path,
+                               std::move(*prev), err);
+        }
+      }
+
       RenderMesh rmesh;
 
       if (!visitorEnv->converter->ConvertMesh(
@@ -5336,20 +6460,174 @@ bool MeshVisitor(const tinyusdz::Path &abs_path, const tinyusdz::Prim &prim,
         return false;
       }
 
-      uint64_t mesh_id = uint64_t(visitorEnv->converter->meshes.size());
-      if (mesh_id >= size_t((std::numeric_limits<int32_t>::max)())) {
-        if (err) {
-          (*err) += "Mesh index too large.\n";
-        }
+      if (!AddRenderMesh(visitorEnv->converter, abs_path, std::move(rmesh),
+                         err)) {
         return false;
       }
-      visitorEnv->converter->meshMap.add(abs_path.full_path_name(), mesh_id);
+    }
+  }
+
+  return true;  // continue traversal
+}
+
+//
+// Convert GeomMeshes in `tasks` with a pool of `num_threads` workers.
+//
+// Each worker has its own RenderSceneConverter(with a copy of Materials and
+// Textures already converted), and converted RenderMeshes are staged per
+// task. Then RenderMeshes, Skeletons and Animations are added to `converter`
+// in the order of `tasks`(= Prim traversal order), so mesh/skeleton/animation
+// IDs are identical to the ones assigned by serial conversion.
+//
+bool ConvertMeshesParallel(RenderSceneConverter *converter,
+                           const RenderSceneConverterEnv &env,
+                           const std::vector<MeshConvertTask> &tasks,
+                           IncrementalCache *incremental,
+                           size_t num_threads, std::string *warn,
+                           std::string *err) {
+  struct StagedMesh {
+    bool converted{false};
+    bool ok{false};
+    RenderMesh rmesh;
+    nonstd::optional<SkelHierarchy> skel;
+    nonstd::optional<Animation> anim;
+    std::string warn;
+    std::string err;
+  };
+
+  std::vector<StagedMesh> staged(tasks.size());
+
+  if (incremental) {
+    // Take RenderMeshes of the previous conversion for unchanged meshes.
+    for (size_t i = 0; i < tasks.size(); i++) {
+      const MeshConvertTask &task = tasks[i];
+      if (!task.reusable) {
+        continue;
+      }
+
+      uint64_t key = incremental->MeshKey(
+          task.content_hash, task.material_path,
+          task.subset_material_path_map, converter->materialMap,
+          converter->materials, converter->textures);
+
+      if (RenderMesh *prev = incremental->FindReusableMesh(
+              task.abs_path.full_path_name(), key)) {
+        staged[i].converted = true;
+        staged[i].ok = true;
+        staged[i].rmesh = std::move(*prev);
+      }
+    }
+  }
+
+#if defined(TINYUSDZ_TYDRA_PARALLEL_CONVERT)
+  const size_t total_threads = num_threads;
+  num_threads = (std::min)(num_threads, tasks.size());
+
+  // Spare threads are used in each mesh conversion(e.g. vertex welding) when
+  // there are fewer meshes than threads.
+  RenderSceneConverterEnv worker_env(env);
+  worker_env.scene_config.num_threads =
+      int((std::max)(size_t(1), total_threads / (std::max)(size_t(1), num_threads)));
+
+  std::vector<std::thread> workers;
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+
+  for (size_t t = 0; t < num_threads; t++) {
+    workers.emplace_back([&]() {
+      RenderSceneConverter worker;
+      // ConvertMesh looks up Materials and Textures bound to the mesh.
+      worker.materials = converter->materials;
+      worker.textures = converter->textures;
+
+      while (!failed.load()) {
+        size_t i = next++;
+        if (i >= tasks.size()) {
+          break;
+        }
+
+        const MeshConvertTask &task = tasks[i];
+        StagedMesh &dst = staged[i];
+
+        if (dst.converted) {
+          // Reused.
+          continue;
+        }
+
+        const size_t warn_pos = worker.GetWarning().size();
+        const size_t err_pos = worker.GetError().size();
+
+        worker.skeletons.clear();
+        worker.animations.clear();
+
+        dst.converted = true;
+        dst.ok = worker.ConvertMesh(
+            worker_env, task.abs_path, *task.mesh, task.material_path,
+            task.subset_material_path_map, converter->materialMap,
+            task.material_subsets, task.blendshapes, &dst.rmesh);
+
+        dst.warn = worker.GetWarning().substr(warn_pos);
+        dst.err = worker.GetError().substr(err_pos);
+
+        if (!dst.ok) {
+          failed = true;
+          break;
+        }
+
+        // Skeleton IDs are local to the worker at this point.
+        if (worker.skeletons.size()) {
+          dst.skel = std::move(worker.skeletons[0]);
+        }
+        if (worker.animations.size()) {
+          dst.anim = std::move(worker.animations[0]);
+        }
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+#else
+  (void)num_threads;
+  (void)env;
+#endif
+
+  for (size_t i = 0; i < tasks.size(); i++) {
+    StagedMesh &src = staged[i];
+
+    if (!src.converted) {
+      // Conversion stopped by the failure of other mesh.
+      continue;
+    }
+
+    if (warn) {
+      (*warn) += src.warn;
+    }
+
+    if (!src.ok) {
+      if (err) {
+        (*err) += fmt::format("Mesh conversion failed: {}",
+                              tasks[i].abs_path.full_path_name());
+        (*err) += "\n" + src.err + "\n";
+      }
+      return false;
+    }
+
+    if (src.skel) {
+      const std::string skel_path = src.skel.value().abs_path;
+      src.rmesh.skel_id = RegisterSkeleton(
+          converter->skeletons, converter->animations, skel_path,
+          std::move(src.skel.value()), std::move(src.anim));
+    }
 
-      visitorEnv->converter->meshes.emplace_back(std::move(rmesh));
+    if (!AddRenderMesh(converter, tasks[i].abs_path, std::move(src.rmesh),
+                       err)) {
+      return false;
     }
   }
 
-  return true;  // continue traversal
+  return true;
 }
 
 }  // namespace
@@ -5443,21 +6721,23 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
       DCOUT("Convert ttranslations");
       const TypedTimeSamples<std::vector<value::float3>> &ts_txs = translations.get_timesamples();
 
-      if (ts_txs.get_samples().empty()) {
+      if (ts_txs.empty()) {
         PUSH_ERROR_AND_RETURN(fmt::format("`translations` timeSamples in SkelAnimation is empty : {}", abs_path));
       }
 
-      for (const auto &sample : ts_txs.get_samples()) {
-        if (!sample.blocked) {
+      for (size_t i = 0; i < ts_txs.size(); i++) {
+        if (!ts_txs.is_blocked(i)) {
+          const double sample_t = ts_txs.get_times()[i];
+          const auto &sample_value = ts_txs.get_values()[i];
           // length check
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} translations.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} translations.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
 
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float3> s;
-            s.t = float(sample.t);
-            s.value = sample.value[j];
+            s.t = float(sample_t);
+            s.value = sample_value[j];
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Translation];
@@ -5474,18 +6754,20 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
     if (rotations.has_timesamples()) {
       const TypedTimeSamples<std::vector<value::quatf>> &ts_rots = rotations.get_timesamples();
       DCOUT("Convert rotations");
-      for (const auto &sample : ts_rots.get_samples()) {
-        if (!sample.blocked) {
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} rotations.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+      for (size_t i = 0; i < ts_rots.size(); i++) {
+        if (!ts_rots.is_blocked(i)) {
+          const double sample_t = ts_rots.get_times()[i];
+          const auto &sample_value = ts_rots.get_values()[i];
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} rotations.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float4> s;
-            s.t = float(sample.t);
-            s.value[0] = sample.value[j][0];
-            s.value[1] = sample.value[j][1];
-            s.value[2] = sample.value[j][2];
-            s.value[3] = sample.value[j][3];
+            s.t = float(sample_t);
+            s.value[0] = sample_value[j][0];
+            s.value[1] = sample_value[j][1];
+            s.value[2] = sample_value[j][2];
+            s.value[3] = sample_value[j][3];
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Rotation];
@@ -5502,18 +6784,20 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
     if (scales.has_timesamples()) {
       const TypedTimeSamples<std::vector<value::half3>> &ts_scales = scales.get_timesamples();
       DCOUT("Convert scales");
-      for (const auto &sample : ts_scales.get_samples()) {
-        if (!sample.blocked) {
-          if (sample.value.size() != joints.size()) {
-            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} scales.size {} must be equal to joints.size {} : {}", sample.t, sample.value.size(), joints.size(), abs_path));
+      for (size_t i = 0; i < ts_scales.size(); i++) {
+        if (!ts_scales.is_blocked(i)) {
+          const double sample_t = ts_scales.get_times()[i];
+          const auto &sample_value = ts_scales.get_values()[i];
+          if (sample_value.size() != joints.size()) {
+            PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} scales.size {} must be equal to joints.size {} : {}", sample_t, sample_value.size(), joints.size(), abs_path));
           }
 
-          for (size_t j = 0; j < sample.value.size(); j++) {
+          for (size_t j = 0; j < sample_value.size(); j++) {
             AnimationSample<value::float3> s;
-            s.t = float(sample.t);
-            s.value[0] = value::half_to_float(sample.value[j][0]);
-            s.value[1] = value::half_to_float(sample.value[j][1]);
-            s.value[2] = value::half_to_float(sample.value[j][2]);
+            s.t = float(sample_t);
+            s.value[0] = value::half_to_float(sample_value[j][0]);
+            s.value[1] = value::half_to_float(sample_value[j][1]);
+            s.value[2] = value::half_to_float(sample_value[j][2]);
 
             std::string jointName = jointIdMap.at(j);
             auto &it = channelMap[jointName][AnimationChannel::ChannelType::Scale];
@@ -5673,16 +6957,18 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
 
         const TypedTimeSamples<std::vector<float>> &ts_weights = weights.get_timesamples();
         DCOUT("Convert timeSampledd weights");
-        for (const auto &sample : ts_weights.get_samples()) {
-          if (!sample.blocked) {
-            if (sample.value.size() != blendShapes.size()) {
-              PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} blendShapeWeights.size {} must be equal to blendShapes.size {} : {}", sample.t, sample.value.size(), blendShapes.size(), abs_path));
+        for (size_t i = 0; i < ts_weights.size(); i++) {
+          if (!ts_weights.is_blocked(i)) {
+            const double sample_t = ts_weights.get_times()[i];
+            const auto &sample_value = ts_weights.get_values()[i];
+            if (sample_value.size() != blendShapes.size()) {
+              PUSH_ERROR_AND_RETURN(fmt::format("Array length mismatch in SkelAnimation. timeCode {} blendShapeWeights.size {} must be equal to blendShapes.size {} : {}", sample_t, sample_value.size(), blendShapes.size(), abs_path));
             }
 
-            for (size_t j = 0; j < sample.value.size(); j++) {
+            for (size_t j = 0; j < sample_value.size(); j++) {
               AnimationSample<float> s;
-              s.t = float(sample.t);
-              s.value = sample.value[j];
+              s.t = float(sample_t);
+              s.value = sample_value[j];
 
               const std::string &targetName = blendShapes[j].str();
               weightsMap[targetName].samples.push_back(s);
@@ -5711,156 +6997,544 @@ bool RenderSceneConverter::ConvertSkelAnimation(const RenderSceneConverterEnv &e
       }
 
     }
-
-    anim_out->blendshape_weights_map = std::move(weightsMap);
+
+    anim_out->blendshape_weights_map = std::move(weightsMap);
+  }
+
+  anim_out->abs_path = abs_path.full_path_name();
+  anim_out->prim_name = skelAnim.name;
+  anim_out->display_name = skelAnim.metas().displayName.value_or("");
+
+  anim_out->channels_map = std::move(channelMap);
+
+  return true;
+}
+
+bool RenderSceneConverter::BuildNodeHierarchyImpl(
+    const RenderSceneConverterEnv &env, const std::string &parentPrimPath,
+    const XformNode &node, Node &out_rnode) {
+  Node rnode;
+
+  std::string primPath;
+  if (parentPrimPath.empty()) {
+    primPath = "/" + node.element_name;
+  } else {
+    primPath = parentPrimPath + "/" + node.element_name;
+  }
+
+  const tinyusdz::Prim *prim = node.prim;
+  if (prim) {
+    rnode.prim_name = prim->element_name();
+    rnode.abs_path = primPath;
+    rnode.display_name = prim->metas().displayName.value_or("");
+
+    DCOUT("rnode.prim_name " << rnode.prim_name);
+    DCOUT("node.local_mat " << node.get_local_matrix());
+    DCOUT("node.has_resetXform " << node.has_resetXformStack());
+    DCOUT("prim.type_name " << prim->type_name());
+    DCOUT("prim.type_id " << prim->type_id());
+    DCOUT("xform " << value::TYPE_ID_GEOM_XFORM);
+
+    if (prim->type_id() == value::TYPE_ID_GEOM_MESH) {
+      // GeomMesh(GPrim) also has xform.
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.nodeType = NodeType::Mesh;
+      rnode.has_resetXform = node.has_resetXformStack();
+
+      if (meshMap.count(primPath)) {
+        rnode.id = int32_t(meshMap.at(primPath));
+      } else {
+        rnode.id = -1;
+      }
+    } else if (prim->type_id() == value::TYPE_ID_GEOM_CAMERA) {
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.nodeType = NodeType::Mesh;
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Camera;
+      rnode.id = -1;  // TODO: Assign index to cameras
+    } else if (prim->type_id() == value::TYPE_ID_GEOM_XFORM) {
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      DCOUT("rnode.local_matrix " << rnode.local_matrix);
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Xform;
+    } else if (prim->type_id() == value::TYPE_ID_SCOPE) {
+      // NOTE: get_local_matrix() should return identity matrix.
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Xform;
+    } else if (prim->type_id() == value::TYPE_ID_MODEL) {
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Xform;
+    } else if ((prim->type_id() > value::TYPE_ID_MODEL_BEGIN) && (prim->type_id() < value::TYPE_ID_GEOM_END)) {
+      // Other Geom prims(e.g. GeomCube)
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Xform;
+    } else if (IsLightPrim(*prim)) {
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      if (prim->type_id() == value::TYPE_ID_LUX_DISTANT) {
+        rnode.nodeType = NodeType::DirectionalLight;
+      } else if (prim->type_id() == value::TYPE_ID_LUX_SPHERE) {
+        // treat sphereLight as pointLight
+        rnode.nodeType = NodeType::PointLight;
+      } else {
+        // TODO
+        rnode.nodeType = NodeType::Xform;
+      }
+      rnode.id = -1;  // TODO: index to lights
+    } else {
+      // ignore other node types.
+      DCOUT("Unknown/Unsupported prim. " << prim->type_name());
+
+      // Setup as xform for now.
+      rnode.local_matrix = node.get_local_matrix();
+      rnode.global_matrix = node.get_world_matrix();
+      rnode.has_resetXform = node.has_resetXformStack();
+      rnode.nodeType = NodeType::Xform;
+    }
+  }
+
+  for (const auto &child : node.children) {
+    Node child_rnode;
+    if (!BuildNodeHierarchyImpl(env, primPath, child, child_rnode)) {
+      return false;
+    }
+
+    rnode.children.emplace_back(std::move(child_rnode));
+  }
+
+  out_rnode = std::move(rnode);
+
+  return true;
+}
+
+bool RenderSceneConverter::BuildNodeHierarchy(
+    const RenderSceneConverterEnv &env, const XformNode &root) {
+  std::string defaultRootNode = env.stage.metas().defaultPrim.str();
+
+  default_node = -1;
+
+  for (const auto &rootNode : root.children) {
+    Node root_node;
+    if (!BuildNodeHierarchyImpl(env, /* root */ "", rootNode, root_node)) {
+      return false;
+    }
+
+    if (defaultRootNode == rootNode.element_name) {
+      default_node = int(root_nodes.size());
+    }
+
+    root_nodeMap.add("/" + rootNode.element_name, root_nodes.size());
+    root_nodes.push_back(root_node);
+  }
+
+  return true;
+}
+
+namespace {
+
+constexpr size_t kInterleavedBufferAlignment = 16;
+
+inline size_t AlignUp(size_t n, size_t alignment) {
+  return ((n + alignment - 1) / alignment) * alignment;
+}
+
+// Source vertex attribute to be written to an interleaved vertex buffer.
+struct InterleavedSource {
+  const float *data{nullptr};
+  size_t num_components{0};  // # of floats per vertex in `data`.
+  bool constant{false};      // Use the first item for all vertices.
+};
+
+struct InterleavedMeshLayout {
+  InterleavedVertexBuffer buffer;
+  std::vector<InterleavedSource> sources;  // Same order with
+                                           // `buffer.attributes`
+};
+
+//
+// Get vertex attribute for interleaved vertex buffer.
+// Returns false when the attribute cannot be represented with `vertex`
+// variability.
+//
+bool GetInterleavedSource(const VertexAttribute &vattr,
+                          const size_t num_vertices,
+                          const VertexAttributeFormat expected_format,
+                          InterleavedSource *src) {
+  if (vattr.format != expected_format) {
+    return false;
+  }
+
+  if ((vattr.stride != 0) && (vattr.stride != vattr.format_size())) {
+    return false;
+  }
+
+  if (vattr.element_size() != 1) {
+    return false;
+  }
+
+  src->data = reinterpret_cast<const float *>(vattr.get_data().data());
+  src->num_components = vattr.format_size() / sizeof(float);
+
+  if (vattr.is_constant() && (vattr.vertex_count() >= 1)) {
+    src->constant = true;
+    return true;
+  }
+
+  if (vattr.is_vertex() && (vattr.vertex_count() == num_vertices)) {
+    src->constant = false;
+    return true;
+  }
+
+  return false;
+}
+
+//
+// Compute vertex layout of RenderMesh.
+//
+bool ComputeInterleavedMeshLayout(const RenderMesh &mesh,
+                                  const MeshConverterConfig &config,
+                                  InterleavedMeshLayout *layout,
+                                  std::string *err) {
+  const size_t num_vertices = mesh.points.size();
+
+  if (num_vertices > size_t((std::numeric_limits<uint32_t>::max)())) {
+    if (err) {
+      (*err) += "Too many vertices.\n";
+    }
+    return false;
+  }
+
+  InterleavedVertexBuffer &buffer = layout->buffer;
+  uint32_t offset = 0;
+
+  auto AddAttribute = [&](const std::string &name, const VertexAttribute *vattr,
+                          const VertexAttributeFormat src_format,
+                          const VertexAttributeFormat format,
+                          const bool normalized) -> bool {
+    InterleavedSource src;
+    if (vattr) {
+      if (vattr->empty()) {
+        return true;
+      }
+
+      if (!GetInterleavedSource(*vattr, num_vertices, src_format, &src)) {
+        if (err) {
+          (*err) += fmt::format(
+              "`{}` attribute must be 'vertex' or 'constant' variability with "
+              "{} format.\n",
+              name, to_string(src_format));
+        }
+        return false;
+      }
+    } else {
+      // position
+      src.data = reinterpret_cast<const float *>(mesh.points.data());
+      src.num_components = 3;
+    }
+
+    InterleavedVertexAttribute attr;
+    attr.name = name;
+    attr.format = format;
+    attr.normalized = normalized;
+    attr.offset = offset;
+
+    offset += uint32_t(VertexAttributeFormatSize(format));
+
+    buffer.attributes.push_back(attr);
+    layout->sources.push_back(src);
+
+    return true;
+  };
+
+  const VertexAttributeFormat normal_format =
+      config.interleaved_half_normals ? VertexAttributeFormat::Half4
+                                      : VertexAttributeFormat::Vec3;
+
+  if (!AddAttribute("position", nullptr, VertexAttributeFormat::Vec3,
+                    VertexAttributeFormat::Vec3, false)) {
+    return false;
+  }
+
+  if (!AddAttribute("normal", &mesh.normals, VertexAttributeFormat::Vec3,
+                    normal_format, false)) {
+    return false;
+  }
+
+  if (!AddAttribute("tangent", &mesh.tangents, VertexAttributeFormat::Vec3,
+                    normal_format, false)) {
+    return false;
+  }
+
+  if (!AddAttribute("binormal", &mesh.binormals, VertexAttributeFormat::Vec3,
+                    normal_format, false)) {
+    return false;
+  }
+
+  for (uint32_t slot = 0; slot < 2; slot++) {
+    auto it = mesh.texcoords.find(slot);
+    if (it == mesh.texcoords.end()) {
+      continue;
+    }
+
+    bool snorm16 = config.interleaved_snorm16_texcoords;
+    if (snorm16) {
+      // Texcoords outside of [-1, 1] cannot be represented in snorm16.
+      const std::vector<uint8_t> &data = it->second.get_data();
+      const float *uvs = reinterpret_cast<const float *>(data.data());
+      for (size_t i = 0; i < data.size() / sizeof(float); i++) {
+        if (!(std::fabs(uvs[i]) <= 1.0f)) {
+          snorm16 = false;
+          break;
+        }
+      }
+    }
+
+    if (!AddAttribute("texcoord_" + std::to_string(slot), &it->second,
+                      VertexAttributeFormat::Vec2,
+                      snorm16 ? VertexAttributeFormat::Short2
+                              : VertexAttributeFormat::Vec2,
+                      snorm16)) {
+      return false;
+    }
+  }
+
+  if (!AddAttribute("color", &mesh.vertex_colors, VertexAttributeFormat::Vec3,
+                    VertexAttributeFormat::Vec3, false)) {
+    return false;
+  }
+
+  if (!AddAttribute("opacity", &mesh.vertex_opacities,
+                    VertexAttributeFormat::Float, VertexAttributeFormat::Float,
+                    false)) {
+    return false;
+  }
+
+  // All formats used here are 4 bytes aligned.
+  buffer.vertex_stride = uint32_t(AlignUp(offset, 4));
+  buffer.vertex_count = uint32_t(num_vertices);
+
+  const std::vector<uint32_t> &indices = mesh.faceVertexIndices();
+  if (indices.size() > size_t((std::numeric_limits<uint32_t>::max)())) {
+    if (err) {
+      (*err) += "Too many indices.\n";
+    }
+    return false;
+  }
+  buffer.index_count = uint32_t(indices.size());
+  buffer.index_type = (config.interleaved_uint16_indices &&
+                       (num_vertices <= size_t(65536)))
+                          ? ComponentType::UInt16
+                          : ComponentType::UInt32;
+
+  return true;
+}
+
+inline int16_t FloatToSnorm16(const float v) {
+  float c = (std::max)(-1.0f, (std::min)(1.0f, v));
+  return int16_t(std::lround(c * 32767.0f));
+}
+
+//
+// Write vertex and index data of RenderMesh to `dst`.
+// `dst` must have enough space.
+//
+void WriteInterleavedMesh(const RenderMesh &mesh,
+                          const InterleavedMeshLayout &layout, uint8_t *dst) {
+  const InterleavedVertexBuffer &buffer = layout.buffer;
+
+  uint8_t *vertices = dst + buffer.vertex_offset;
+  const size_t stride = buffer.vertex_stride;
+
+  for (size_t a = 0; a < buffer.attributes.size(); a++) {
+    const InterleavedVertexAttribute &attr = buffer.attributes[a];
+    const InterleavedSource &src = layout.sources[a];
+    const size_t nc = src.num_components;
+
+    for (size_t v = 0; v < buffer.vertex_count; v++) {
+      const float *in = src.data + (src.constant ? 0 : v * nc);
+      uint8_t *out = vertices + v * stride + attr.offset;
+
+      if (attr.format == VertexAttributeFormat::Half4) {
+        value::half h[4];
+        for (size_t k = 0; k < 4; k++) {
+          h[k] = value::float_to_half_full((k < nc) ? in[k] : 0.0f);
+        }
+        memcpy(out, h, sizeof(h));
+      } else if (attr.format == VertexAttributeFormat::Short2) {
+        int16_t q[2] = {FloatToSnorm16(in[0]), FloatToSnorm16(in[1])};
+        memcpy(out, q, sizeof(q));
+      } else {
+        memcpy(out, in, nc * sizeof(float));
+      }
+    }
+  }
+
+  // Zero clear padding bytes.
+  uint32_t attribs_size = 0;
+  for (const auto &attr : buffer.attributes) {
+    attribs_size = (std::max)(
+        attribs_size,
+        attr.offset + uint32_t(VertexAttributeFormatSize(attr.format)));
+  }
+  if (attribs_size < stride) {
+    for (size_t v = 0; v < buffer.vertex_count; v++) {
+      memset(vertices + v * stride + attribs_size, 0, stride - attribs_size);
+    }
+  }
+
+  const std::vector<uint32_t> &indices = mesh.faceVertexIndices();
+  uint8_t *index_data = dst + buffer.index_offset;
+  if (buffer.index_type == ComponentType::UInt16) {
+    for (size_t i = 0; i < indices.size(); i++) {
+      uint16_t idx = uint16_t(indices[i]);
+      memcpy(index_data + i * sizeof(uint16_t), &idx, sizeof(uint16_t));
+    }
+  } else {
+    memcpy(index_data, indices.data(), indices.size() * sizeof(uint32_t));
   }
+}
 
-  anim_out->abs_path = abs_path.full_path_name();
-  anim_out->prim_name = skelAnim.name;
-  anim_out->display_name = skelAnim.metas().displayName.value_or("");
+}  // namespace
 
-  anim_out->channels_map = std::move(channelMap);
+bool RenderSceneConverter::BuildInterleavedVertexBuffers(
+    const RenderSceneConverterEnv &env, size_t num_threads) {
+  std::vector<InterleavedMeshLayout> layouts(meshes.size());
 
-  return true;
-}
+  //
+  // 1. Compute vertex layout and the location of each mesh in the buffer.
+  //
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < meshes.size(); i++) {
+    const RenderMesh &mesh = meshes[i];
+
+    if (!mesh.is_single_indexable) {
+      PUSH_WARN(fmt::format(
+          "Interleaved vertex buffer is not built for the mesh `{}`, since its "
+          "vertex attributes are not single-indexable.",
+          mesh.abs_path));
+      continue;
+    }
 
-bool RenderSceneConverter::BuildNodeHierarchyImpl(
-    const RenderSceneConverterEnv &env, const std::string &parentPrimPath,
-    const XformNode &node, Node &out_rnode) {
-  Node rnode;
+    std::string err;
+    if (!ComputeInterleavedMeshLayout(mesh, env.mesh_config, &layouts[i],
+                                      &err)) {
+      PUSH_WARN(fmt::format(
+          "Interleaved vertex buffer is not built for the mesh `{}`: {}",
+          mesh.abs_path, err));
+      layouts[i] = InterleavedMeshLayout();
+      continue;
+    }
 
-  std::string primPath;
-  if (parentPrimPath.empty()) {
-    primPath = "/" + node.element_name;
-  } else {
-    primPath = parentPrimPath + "/" + node.element_name;
-  }
+    InterleavedVertexBuffer &buffer = layouts[i].buffer;
+    buffer.buffer_id = int64_t(buffers.size());
 
-  const tinyusdz::Prim *prim = node.prim;
-  if (prim) {
-    rnode.prim_name = prim->element_name();
-    rnode.abs_path = primPath;
-    rnode.display_name = prim->metas().displayName.value_or("");
+    buffer.vertex_offset = AlignUp(total_bytes, kInterleavedBufferAlignment);
+    total_bytes = buffer.vertex_offset +
+                  size_t(buffer.vertex_stride) * size_t(buffer.vertex_count);
 
-    DCOUT("rnode.prim_name " << rnode.prim_name);
-    DCOUT("node.local_mat " << node.get_local_matrix());
-    DCOUT("node.has_resetXform " << node.has_resetXformStack());
-    DCOUT("prim.type_name " << prim->type_name());
-    DCOUT("prim.type_id " << prim->type_id());
-    DCOUT("xform " << value::TYPE_ID_GEOM_XFORM);
+    const size_t index_size =
+        (buffer.index_type == ComponentType::UInt16) ? sizeof(uint16_t)
+                                                     : sizeof(uint32_t);
+    buffer.index_offset = AlignUp(total_bytes, kInterleavedBufferAlignment);
+    total_bytes = buffer.index_offset + index_size * size_t(buffer.index_count);
+  }
 
-    if (prim->type_id() == value::TYPE_ID_GEOM_MESH) {
-      // GeomMesh(GPrim) also has xform.
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.nodeType = NodeType::Mesh;
-      rnode.has_resetXform = node.has_resetXformStack();
+  if (total_bytes == 0) {
+    return true;
+  }
 
-      if (meshMap.count(primPath)) {
-        rnode.id = int32_t(meshMap.at(primPath));
-      } else {
-        rnode.id = -1;
-      }
-    } else if (prim->type_id() == value::TYPE_ID_GEOM_CAMERA) {
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.nodeType = NodeType::Mesh;
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Camera;
-      rnode.id = -1;  // TODO: Assign index to cameras
-    } else if (prim->type_id() == value::TYPE_ID_GEOM_XFORM) {
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      DCOUT("rnode.local_matrix " << rnode.local_matrix);
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Xform;
-    } else if (prim->type_id() == value::TYPE_ID_SCOPE) {
-      // NOTE: get_local_matrix() should return identity matrix.
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Xform;
-    } else if (prim->type_id() == value::TYPE_ID_MODEL) {
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Xform;
-    } else if ((prim->type_id() > value::TYPE_ID_MODEL_BEGIN) && (prim->type_id() < value::TYPE_ID_GEOM_END)) {
-      // Other Geom prims(e.g. GeomCube)
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Xform;
-    } else if (IsLightPrim(*prim)) {
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      if (prim->type_id() == value::TYPE_ID_LUX_DISTANT) {
-        rnode.nodeType = NodeType::DirectionalLight;
-      } else if (prim->type_id() == value::TYPE_ID_LUX_SPHERE) {
-        // treat sphereLight as pointLight
-        rnode.nodeType = NodeType::PointLight;
-      } else {
-        // TODO
-        rnode.nodeType = NodeType::Xform;
-      }
-      rnode.id = -1;  // TODO: index to lights
-    } else {
-      // ignore other node types.
-      DCOUT("Unknown/Unsupported prim. " << prim->type_name());
+  //
+  // 2. Write vertex and index data directly to the pooled buffer.
+  //
+  BufferData pool;
+  pool.componentType = ComponentType::UInt8;
+  pool.data.resize(AlignUp(total_bytes, kInterleavedBufferAlignment), 0);
 
-      // Setup as xform for now.
-      rnode.local_matrix = node.get_local_matrix();
-      rnode.global_matrix = node.get_world_matrix();
-      rnode.has_resetXform = node.has_resetXformStack();
-      rnode.nodeType = NodeType::Xform;
+  uint8_t *dst = pool.data.data();
+  ParallelFor(meshes.size(), num_threads, [&](size_t i) {
+    if (!layouts[i].buffer.empty()) {
+      WriteInterleavedMesh(meshes[i], layouts[i], dst);
     }
-  }
+  });
 
-  for (const auto &child : node.children) {
-    Node child_rnode;
-    if (!BuildNodeHierarchyImpl(env, primPath, child, child_rnode)) {
-      return false;
-    }
+  buffers.emplace_back(std::move(pool));
 
-    rnode.children.emplace_back(std::move(child_rnode));
+  for (size_t i = 0; i < meshes.size(); i++) {
+    meshes[i].interleaved_buffer = std::move(layouts[i].buffer);
   }
 
-  out_rnode = std::move(rnode);
-
   return true;
 }
 
-bool RenderSceneConverter::BuildNodeHierarchy(
-    const RenderSceneConverterEnv &env, const XformNode &root) {
-  std::string defaultRootNode = env.stage.metas().defaultPrim.str();
+namespace {
 
-  default_node = -1;
+template <typename T>
+uint64_t VectorBytes(const std::vector<T> &v) {
+  return uint64_t(v.size()) * sizeof(T);
+}
 
-  for (const auto &rootNode : root.children) {
-    Node root_node;
-    if (!BuildNodeHierarchyImpl(env, /* root */ "", rootNode, root_node)) {
-      return false;
-    }
+uint64_t VertexAttributeBytes(const VertexAttribute &attr) {
+  return VectorBytes(attr.data) + VectorBytes(attr.indices);
+}
 
-    if (defaultRootNode == rootNode.element_name) {
-      default_node = int(root_nodes.size());
-    }
+// Approximated byte size of array data in RenderScene. Used for LoadStats.
+uint64_t EstimateMemoryUsage(const RenderScene &scene) {
+  uint64_t sz = 0;
 
-    root_nodeMap.add("/" + rootNode.element_name, root_nodes.size());
-    root_nodes.push_back(root_node);
+  for (const auto &buffer : scene.buffers) {
+    sz += VectorBytes(buffer.data);
   }
 
-  return true;
+  for (const auto &mesh : scene.meshes) {
+    sz += VectorBytes(mesh.points);
+    sz += VectorBytes(mesh.usdFaceVertexIndices);
+    sz += VectorBytes(mesh.usdFaceVertexCounts);
+    sz += VectorBytes(mesh.triangulatedFaceVertexIndices);
+    sz += VectorBytes(mesh.triangulatedFaceVertexCounts);
+    sz += VertexAttributeBytes(mesh.normals);
+    sz += VertexAttributeBytes(mesh.tangents);
+    sz += VertexAttributeBytes(mesh.binormals);
+    sz += VertexAttributeBytes(mesh.vertex_colors);
+    sz += VertexAttributeBytes(mesh.vertex_opacities);
+    for (const auto &it : mesh.texcoords) {
+      sz += VertexAttributeBytes(it.second);
+    }
+  }
+
+  return sz;
 }
 
+}  // namespace
+
 bool RenderSceneConverter::ConvertToRenderScene(
     const RenderSceneConverterEnv &env, RenderScene *scene) {
   if (!scene) {
     PUSH_ERROR_AND_RETURN("nullptr for RenderScene argument.");
   }
 
+  performance::ScopedPhase convert_phase(env.stats, "tydra:convert");
+
+  IncrementalCache *incremental{nullptr};
+  if (_incremental) {
+    if (_incremental->active) {
+      incremental = _incremental;
+    } else {
+      // RenderScene converted here is not tracked by UpdateRenderScene.
+      _incremental->has_prev = false;
+    }
+  }
+
   // 1. Convert Xform
   // 2. Convert Material/Texture
   // 3. Convert Mesh/SkinWeights/BlendShapes
@@ -5873,8 +7547,11 @@ bool RenderSceneConverter::ConvertToRenderScene(
   //    Each Prim in Stage is converted to XformNode.
   //
   XformNode xform_node;
-  if (!BuildXformNodeFromStage(env.stage, &xform_node, env.timecode)) {
-    PUSH_ERROR_AND_RETURN("Failed to build Xform node hierarchy.\n");
+  {
+    performance::ScopedPhase phase(env.stats, "tydra:build_xform_nodes");
+    if (!BuildXformNodeFromStage(env.stage, &xform_node, env.timecode)) {
+      PUSH_ERROR_AND_RETURN("Failed to build Xform node hierarchy.\n");
+    }
   }
 
   std::string err;
@@ -5886,22 +7563,68 @@ bool RenderSceneConverter::ConvertToRenderScene(
   //
   // Material conversion will be done in MeshVisitor.
   //
+  // When multi-threading is enabled, texture images are decoded in parallel
+  // first. Then Materials are converted while traversing Prims, and
+  // GeomMeshes are converted in parallel.
+  //
+  const size_t num_threads = GetNumThreads(env.scene_config.num_threads);
+
+  // Decode textures(used in Material conversion) in advance.
+  if (env.scene_config.load_texture_assets && (num_threads > 1)) {
+    performance::ScopedPhase phase(env.stats, "tydra:prefetch_textures");
+    if (!PrefetchTextureImages(env, num_threads)) {
+      return false;
+    }
+  }
+
+  std::vector<MeshConvertTask> mesh_tasks;
+
   MeshVisitorEnv menv;
   menv.env = &env;
   menv.converter = this;
+  menv.incremental = incremental;
+  if (num_threads > 1) {
+    menv.mesh_tasks = &mesh_tasks;
+  }
 
-  bool ret = tydra::VisitPrims(env.stage, MeshVisitor, &menv, &err);
+  bool ret;
+  {
+    performance::ScopedPhase phase(env.stats, "tydra:convert_prims");
+    ret = tydra::VisitPrims(env.stage, MeshVisitor, &menv, &err);
+  }
 
   if (!ret) {
     PUSH_ERROR_AND_RETURN(err);
   }
 
+  if (mesh_tasks.size()) {
+    performance::ScopedPhase phase(env.stats, "tydra:convert_meshes");
+    std::string warn;
+    ret = ConvertMeshesParallel(this, env, mesh_tasks, incremental,
+                                num_threads, &warn, &err);
+    PushWarn(warn);
+
+    if (!ret) {
+      PUSH_ERROR_AND_RETURN(err);
+    }
+  }
+
+  if (env.mesh_config.build_interleaved_vertex_buffer) {
+    performance::ScopedPhase phase(env.stats, "tydra:build_interleaved_buffers");
+    if (!BuildInterleavedVertexBuffers(env, num_threads)) {
+      return false;
+    }
+  }
+
   //
   // 5. Build node hierarchy from XformNode and meshes, materials, skeletons,
   // etc.
   //
-  if (!BuildNodeHierarchy(env, xform_node)) {
-    return false;
+  {
+    performance::ScopedPhase phase(env.stats, "tydra:build_node_hierarchy");
+    if (!BuildNodeHierarchy(env, xform_node)) {
+      return false;
+    }
   }
 
   // render_scene.meshMap = std::move(meshMap);
@@ -5929,10 +7652,228 @@ bool RenderSceneConverter::ConvertToRenderScene(
   render_scene.skeletons = std::move(skeletons);
   render_scene.animations = std::move(animations);
 
+  if (env.stats) {
+    env.stats->update_peak_memory(EstimateMemoryUsage(render_scene));
+  }
+
   (*scene) = std::move(render_scene);
   return true;
 }
 
+namespace {
+
+void CollectNodes(const std::vector<Node> &nodes,
+                  std::map<std::string, const Node *> *dst) {
+  for (const auto &node : nodes) {
+    (*dst)[node.abs_path] = &node;
+    CollectNodes(node.children, dst);
+  }
+}
+
+bool IsSameNode(const Node &a, const Node &b) {
+  return (a.nodeType == b.nodeType) && (a.id == b.id) &&
+         (a.has_resetXform == b.has_resetXform) &&
+         (a.children.size() == b.children.size()) &&
+         (memcmp(a.local_matrix.m, b.local_matrix.m,
+                 sizeof(a.local_matrix.m)) == 0) &&
+         (memcmp(a.global_matrix.m, b.global_matrix.m,
+                 sizeof(a.global_matrix.m)) == 0);
+}
+
+}  // namespace
+
+bool RenderSceneConverter::UpdateRenderScene(
+    const RenderSceneConverterEnv &env, RenderScene *scene,
+    RenderSceneDiff *diff) {
+  if (!scene) {
+    PUSH_ERROR_AND_RETURN("nullptr for RenderScene argument.");
+  }
+
+  if (!_incremental) {
+    _incremental = new IncrementalState();
+  }
+  IncrementalState &state = *_incremental;
+
+  RenderSceneDiff result;
+  result.full_conversion = !state.has_prev;
+
+  //
+  // Take over the previous conversion result.
+  //
+  state.prev_meshes.clear();
+  state.prev_meshMap = StringAndIdMap();
+  state.prev_materialMap = StringAndIdMap();
+  state.prev_nodes.clear();
+  state.prev_image_ids.clear();
+
+  if (state.has_prev) {
+    state.prev_meshes = std::move(scene->meshes);
+    state.prev_meshMap = std::move(meshMap);
+    state.prev_materialMap = std::move(materialMap);
+    state.prev_nodes = std::move(scene->nodes);
+    state.prev_mesh_keys = std::move(state.mesh_keys);
+    state.prev_material_keys = std::move(state.material_keys);
+
+    if (_texture_cache) {
+      // Put converted texture images back to the cache, so that texture
+      // assets are not loaded and converted again.
+      state.prev_image_ids = std::move(_texture_cache->image_ids);
+      for (const auto &it : state.prev_image_ids) {
+        if ((it.second < 0) || (size_t(it.second) >= scene->images.size())) {
+          continue;
+        }
+
+        TextureCache::ConvertedImage converted;
+        converted.ok = true;
+        converted.image = scene->images[size_t(it.second)];
+        const int64_t buffer_id = converted.image.buffer_id;
+        if ((buffer_id >= 0) && (size_t(buffer_id) < scene->buffers.size())) {
+          converted.buffer = std::move(scene->buffers[size_t(buffer_id)]);
+        }
+
+        _texture_cache->converted_images[it.first] = std::move(converted);
+      }
+    }
+  } else {
+    state.prev_mesh_keys.clear();
+    state.prev_material_keys.clear();
+  }
+
+  if (_texture_cache) {
+    // Image IDs are assigned again.
+    _texture_cache->image_ids.clear();
+  }
+
+  state.mesh_keys.clear();
+  state.material_keys.clear();
+  state.reused_meshes.clear();
+  state.uv_hashes.clear();
+  state.has_prev = false;
+
+  //
+  // Clear the result of the previous conversion.
+  //
+  root_nodeMap = StringAndIdMap();
+  meshMap = StringAndIdMap();
+  materialMap = StringAndIdMap();
+  cameraMap = StringAndIdMap();
+  lightMap = StringAndIdMap();
+  textureMap = StringAndIdMap();
+  imageMap = StringAndIdMap();
+  bufferMap = StringAndIdMap();
+  animationMap = StringAndIdMap();
+  default_node = -1;
+  root_nodes.clear();
+  meshes.clear();
+  materials.clear();
+  cameras.clear();
+  lights.clear();
+  textures.clear();
+  images.clear();
+  buffers.clear();
+  skeletons.clear();
+  animations.clear();
+
+  state.active = true;
+  bool ret = ConvertToRenderScene(env, scene);
+  state.active = false;
+
+  state.prev_meshes.clear();
+  if (_texture_cache) {
+    // Images not used anymore.
+    _texture_cache->converted_images.clear();
+  }
+
+  if (!ret) {
+    return false;
+  }
+
+  state.has_prev = true;
+
+  //
+  // Compute the difference.
+  //
+  auto IsSameId = [](const StringAndIdMap &prev, const std::string &path,
+                     uint64_t id) {
+    auto it = prev.find(path);
+    return (it != prev.s_end()) && (it->second == id);
+  };
+
+  for (auto it = meshMap.s_begin(); it != meshMap.s_end(); it++) {
+    if (!state.reused_meshes.count(it->first) ||
+        !IsSameId(state.prev_meshMap, it->first, it->second)) {
+      result.changed_meshes.push_back(uint32_t(it->second));
+    }
+  }
+
+  for (auto it = state.prev_meshMap.s_begin();
+       it != state.prev_meshMap.s_end(); it++) {
+    if (!meshMap.count(it->first)) {
+      result.removed_meshes.push_back(it->first);
+    }
+  }
+
+  for (auto it = materialMap.s_begin(); it != materialMap.s_end(); it++) {
+    auto kit = state.material_keys.find(it->first);
+    auto prev_kit = state.prev_material_keys.find(it->first);
+    if ((kit == state.material_keys.end()) ||
+        (prev_kit == state.prev_material_keys.end()) ||
+        (kit->second != prev_kit->second) ||
+        !IsSameId(state.prev_materialMap, it->first, it->second)) {
+      result.changed_materials.push_back(uint32_t(it->second));
+    }
+  }
+
+  for (auto it = state.prev_materialMap.s_begin();
+       it != state.prev_materialMap.s_end(); it++) {
+    if (!materialMap.count(it->first)) {
+      result.removed_materials.push_back(it->first);
+    }
+  }
+
+  if (_texture_cache) {
+    for (const auto &it : _texture_cache->image_ids) {
+      auto prev_it = state.prev_image_ids.find(it.first);
+      if ((prev_it == state.prev_image_ids.end()) ||
+          (prev_it->second != it.second)) {
+        result.changed_images.push_back(uint32_t(it.second));
+      }
+    }
+  }
+
+  {
+    std::map<std::string, const Node *> prev_nodes;
+    std::map<std::string, const Node *> curr_nodes;
+    CollectNodes(state.prev_nodes, &prev_nodes);
+    CollectNodes(scene->nodes, &curr_nodes);
+
+    for (const auto &it : curr_nodes) {
+      auto prev_it = prev_nodes.find(it.first);
+      if ((prev_it == prev_nodes.end()) ||
+          !IsSameNode(*prev_it->second, *it.second)) {
+        result.changed_nodes.push_back(it.first);
+      }
+    }
+
+    for (const auto &it : prev_nodes) {
+      if (!curr_nodes.count(it.first)) {
+        result.removed_nodes.push_back(it.first);
+      }
+    }
+  }
+  state.prev_nodes.clear();
+
+  std::sort(result.changed_meshes.begin(), result.changed_meshes.end());
+  std::sort(result.changed_materials.begin(), result.changed_materials.end());
+  std::sort(result.changed_images.begin(), result.changed_images.end());
+
+  if (diff) {
+    (*diff) = std::move(result);
+  }
+
+  return true;
+}
+
 bool RenderSceneConverter::ConvertSkeletonImpl(const RenderSceneConverterEnv &env, const tinyusdz::GeomMesh &mesh,
                        SkelHierarchy *out_skel, nonstd::optional<Animation> *out_anim) {
 
@@ -6075,7 +8016,7 @@ bool DefaultTextureImageLoaderFunction(
   DCOUT("Resolved asset path = " << resolvedPath);
 
   // TODO: user-defined image loader handler.
-  auto result = tinyusdz::image::LoadImageFromMemory(asset.data(), asset.size(),
+  auto result = tinyusdz::image::LoadImageFromMemory(asset.cdata(), asset.size(),
                                                      resolvedPath);
   if (!result) {
     if (err) {
@@ -6781,6 +8722,31 @@ std::string DumpMesh(const RenderMesh &mesh, uint32_t indent) {
     ss << pprint::Indent(indent + 1) << "}\n";
   }
 
+  if (!mesh.interleaved_buffer.empty()) {
+    const InterleavedVertexBuffer &buffer = mesh.interleaved_buffer;
+    ss << pprint::Indent(indent + 1) << "interleaved_buffer {\n";
+    ss << pprint::Indent(indent + 2) << "buffer_id " << buffer.buffer_id
+       << "\n";
+    ss << pprint::Indent(indent + 2) << "vertex_offset "
+       << buffer.vertex_offset << "\n";
+    ss << pprint::Indent(indent + 2) << "vertex_stride "
+       << buffer.vertex_stride << "\n";
+    ss << pprint::Indent(indent + 2) << "vertex_count " << buffer.vertex_count
+       << "\n";
+    for (const auto &attr : buffer.attributes) {
+      ss << pprint::Indent(indent + 2) << attr.name << " { format "
+         << to_string(attr.format) << (attr.normalized ? " normalized" : "")
+         << ", offset " << attr.offset << " }\n";
+    }
+    ss << pprint::Indent(indent + 2) << "index_offset " << buffer.index_offset
+       << "\n";
+    ss << pprint::Indent(indent + 2) << "index_type "
+       << to_string(buffer.index_type) << "\n";
+    ss << pprint::Indent(indent + 2) << "index_count " << buffer.index_count
+       << "\n";
+    ss << pprint::Indent(indent + 1) << "}\n";
+  }
+
   // TODO: primvars
 
   ss << "\n";
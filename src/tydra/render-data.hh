@@ -12,6 +12,7 @@
 
 #include "asset-resolution.hh"
 #include "nonstd/expected.hpp"
+#include "performance.hh"
 #include "usdGeom.hh"
 #include "usdShade.hh"
 #include "usdSkel.hh"
@@ -416,8 +417,9 @@ struct VertexAttribute {
   VertexAttributeFormat format{VertexAttributeFormat::Vec3};
   uint32_t elementSize{1};  // `elementSize` in USD terminology(i.e. # of
                             // samples per vertex data)
-  uint32_t stride{0};  //  We don't support packed(interleaved) vertex data, so
-                       //  stride is usually sizeof(VertexAttributeFormat) *
+  uint32_t stride{0};  //  We don't support packed(interleaved) vertex data
+                       //  here(See InterleavedVertexBuffer), so stride is
+                       //  usually sizeof(VertexAttributeFormat) *
                        //  elementSize. 0 = tightly packed.
   std::vector<uint8_t> data;  // raw binary data(TODO: Use Buffer ID?)
   std::vector<uint32_t>
@@ -505,6 +507,52 @@ struct VertexAttribute {
   bool is_indexed() const { return variability == VertexVariability::Indexed; }
 };
 
+///
+/// Vertex attribute in InterleavedVertexBuffer.
+///
+/// Integer format with `normalized` true is normalized to [-1, 1](signed) or
+/// [0, 1](unsigned) as done in glTF. e.g. `Short2` + normalized = snorm16x2
+///
+struct InterleavedVertexAttribute {
+  std::string name;  // "position", "normal", "tangent", "binormal",
+                     // "texcoord_0", "texcoord_1", "color" or "opacity"
+  VertexAttributeFormat format{VertexAttributeFormat::Vec3};
+  bool normalized{false};
+  uint32_t offset{0};  // Byte offset from the beginning of a vertex.
+};
+
+///
+/// GPU-ready interleaved vertex data and index data of RenderMesh.
+///
+/// Data is stored in `RenderScene::buffers[buffer_id]`, which is shared by
+/// all RenderMeshes in the scene(like glTF's bufferView).
+///
+struct InterleavedVertexBuffer {
+  int64_t buffer_id{-1};  // Index to RenderScene::buffers. -1 = not built.
+
+  size_t vertex_offset{0};    // Byte offset to vertex data. 16 bytes aligned.
+  uint32_t vertex_stride{0};  // Bytes per vertex. Multiple of 4.
+  uint32_t vertex_count{0};
+  std::vector<InterleavedVertexAttribute> attributes;
+
+  size_t index_offset{0};  // Byte offset to index data. 16 bytes aligned.
+  ComponentType index_type{ComponentType::UInt32};  // UInt16 or UInt32
+  uint32_t index_count{0};
+
+  bool empty() const { return buffer_id < 0; }
+
+  // Returns nullptr when the attribute is not found.
+  const InterleavedVertexAttribute *find_attribute(
+      const std::string &name) const {
+    for (const auto &attr : attributes) {
+      if (attr.name == name) {
+        return &attr;
+      }
+    }
+    return nullptr;
+  }
+};
+
 #if 0  // TODO: Implement
 ///
 /// Flatten(expand by vertexCounts and vertexIndices) VertexAttribute.
@@ -950,6 +998,10 @@ struct RenderMesh {
   // If you want to access user-defined primvars or custom property,
   // Plese look into corresponding Prim( stage::find_prim_at_path(abs_path) )
 
+  // Interleaved vertex buffer and index buffer. Built when
+  // `MeshConverterConfig::build_interleaved_vertex_buffer` is true.
+  InterleavedVertexBuffer interleaved_buffer;
+
   uint64_t handle{0};  // Handle ID for Graphics API. 0 = invalid
 };
 
@@ -1326,10 +1378,35 @@ struct MeshConverterConfig {
 
   //
   // Allowed relative error to check if vertex data is the same.
-  // Used for 'facevarying' variability to `vertex` variability conversion in
-  // ConvertMesh. Only effective to floating-point vertex data.
+  // Used for 'facevarying' variability to `vertex` variability conversion and
+  // vertex welding(`build_vertex_indices`) in ConvertMesh. Only effective to
+  // floating-point vertex data.
   //
   float facevarying_to_vertex_eps = std::numeric_limits<float>::epsilon();
+
+  //
+  // Build interleaved vertex buffer and index buffer
+  // (`RenderMesh::interleaved_buffer`) for single-indexable meshes.
+  // Vertex and index data of all meshes are packed into one BufferData in
+  // `RenderScene::buffers`.
+  //
+  // Vertex layout: position, normal, tangent, binormal, texcoord_0,
+  // texcoord_1, color, opacity(attributes not present in the mesh are
+  // omitted)
+  //
+  bool build_interleaved_vertex_buffer{false};
+
+  // Store normal, tangent and binormal as half4(w = 0) instead of float3.
+  bool interleaved_half_normals{false};
+
+  // Store texcoords as normalized int16x2(snorm16) instead of float2.
+  // float2 is used for the mesh when any texcoord value is outside of
+  // [-1, 1].
+  bool interleaved_snorm16_texcoords{false};
+
+  // Use 16bit indices when the number of vertices is 65536 or less.
+  // false: Always use 32bit indices.
+  bool interleaved_uint16_indices{true};
 };
 
 struct MaterialConverterConfig {
@@ -1395,6 +1472,14 @@ struct RenderSceneConverterConfig {
   // false: no actual texture file/asset access.
   // App/User must setup TextureImage manually after the conversion.
   bool load_texture_assets{true};
+
+  // # of threads used to convert GeomMeshes and decode texture images.
+  // 1: Convert serially. -1: Use all available hardware threads.
+  // The result is identical to the serial conversion regardless of the number
+  // of threads. Threading is disabled on WASI.
+  // NOTE: `MaterialConverterConfig::texture_image_loader_function` must be
+  // thread-safe when using 2 or more threads.
+  int num_threads{1};
 };
 
 //
@@ -1405,7 +1490,8 @@ struct RenderSceneConverterConfig {
 // tangent and binormal is included in VertexData, considering the situation
 // that tangent and binormal is supplied through user-defined primvar.
 //
-// TODO: Use spatial hash for robust dedup(consider floating-point eps)
+// NOTE: RenderSceneConverter does not use this struct for vertex welding.
+// It merges vertices within `MeshConverterConfig::facevarying_to_vertex_eps`.
 // TODO: Polish interface to support arbitrary vertex configuration.
 //
 struct DefaultPackedVertexData {
@@ -1429,18 +1515,16 @@ struct DefaultPackedVertexData {
 
 struct DefaultPackedVertexDataHasher {
   inline size_t operator()(const DefaultPackedVertexData &v) const {
-    // Simple hasher using FNV1 32bit
-    // TODO: Use 64bit FNV1?
-    // TODO: Use spatial hash or LSH(LocallySensitiveHash) for position value.
-    static constexpr uint32_t kFNV_Prime = 0x01000193;
-    static constexpr uint32_t kFNV_Offset_Basis = 0x811c9dc5;
+    // Simple hasher using FNV1a 64bit
+    static constexpr uint64_t kFNV_Prime = 0x100000001b3ull;
+    static constexpr uint64_t kFNV_Offset_Basis = 0xcbf29ce484222325ull;
 
     const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&v);
     size_t n = sizeof(DefaultPackedVertexData);
 
-    uint32_t hash = kFNV_Offset_Basis;
+    uint64_t hash = kFNV_Offset_Basis;
     for (size_t i = 0; i < n; i++) {
-      hash = (kFNV_Prime * hash) ^ (ptr[i]);
+      hash = (hash ^ ptr[i]) * kFNV_Prime;
     }
 
     return size_t(hash);
@@ -1602,6 +1686,36 @@ class RenderSceneConverterEnv {
   value::TimeSampleInterpolationType tinterp{
       value::TimeSampleInterpolationType::Linear};
 
+  // Record the wall time of each conversion phase and the estimated memory
+  // usage of RenderScene when non-null.
+  performance::LoadStats *stats{nullptr};
+};
+
+///
+/// Changes made by `RenderSceneConverter::UpdateRenderScene`.
+///
+/// IDs are the index in the updated RenderScene. An item is reported as
+/// changed when it is newly converted or its index has been changed.
+///
+struct RenderSceneDiff {
+  bool full_conversion{false};  // true: Everything was converted.
+
+  std::vector<uint32_t> changed_meshes;     // index to `meshes`
+  std::vector<uint32_t> changed_materials;  // index to `materials`
+  std::vector<uint32_t> changed_images;     // index to `images`
+  std::vector<std::string> changed_nodes;   // Node::abs_path
+
+  // USD Prim path of items removed from the scene.
+  std::vector<std::string> removed_meshes;
+  std::vector<std::string> removed_materials;
+  std::vector<std::string> removed_nodes;
+
+  bool empty() const {
+    return !full_conversion && changed_meshes.empty() &&
+           changed_materials.empty() && changed_images.empty() &&
+           changed_nodes.empty() && removed_meshes.empty() &&
+           removed_materials.empty() && removed_nodes.empty();
+  }
 };
 
 //
@@ -1613,6 +1727,7 @@ class RenderSceneConverter {
   RenderSceneConverter() = default;
   RenderSceneConverter(const RenderSceneConverter &rhs) = delete;
   RenderSceneConverter(RenderSceneConverter &&rhs) = delete;
+  ~RenderSceneConverter();
 
   ///
   /// All-in-one Stage to RenderScene conversion.
@@ -1622,6 +1737,39 @@ class RenderSceneConverter {
   ///
   bool ConvertToRenderScene(const RenderSceneConverterEnv &env, RenderScene *scene);
 
+  ///
+  /// Incremental version of `ConvertToRenderScene` for interactive apps(e.g.
+  /// after changing timecode, switching variants or editing Materials).
+  ///
+  /// RenderMeshes whose GeomMesh data(evaluated at `env.timecode`), bound
+  /// Materials and GeomSubsets are unchanged since the previous
+  /// UpdateRenderScene call are reused without triangulation and vertex
+  /// welding, and decoded texture images are reused. Materials and Node
+  /// hierarchy are converted every time(they are cheap).
+  ///
+  /// Unchanged Prims are identified by Prim path and the hash of its
+  /// content. Limitations:
+  ///
+  /// - Meshes with Skeleton or connected attributes are always converted.
+  /// - Changes of texture files are not detected.
+  /// - Shaders of a Material must be placed under the Material Prim to be
+  ///   tracked.
+  /// - Converter configs in `env` must be the same as the previous call. Use
+  ///   a new RenderSceneConverter otherwise.
+  ///
+  /// The first call(or a call after failure or `ConvertToRenderScene`)
+  /// converts everything.
+  ///
+  /// @param[in] env Converter env. `env.stage` can be a different Stage
+  /// object from the previous call.
+  /// @param[inout] scene The RenderScene returned by the previous
+  /// UpdateRenderScene call of this converter. Contents are moved from it
+  /// and it is updated in place. Undefined on failure.
+  /// @param[out] diff Changes from the previous RenderScene(optional).
+  ///
+  bool UpdateRenderScene(const RenderSceneConverterEnv &env,
+                         RenderScene *scene, RenderSceneDiff *diff = nullptr);
+
   const std::string &GetInfo() const { return _info; }
   const std::string &GetWarning() const { return _warn; }
   const std::string &GetError() const { return _err; }
@@ -1810,8 +1958,19 @@ class RenderSceneConverter {
   /// Limitation: Currently we only supports texcoords up to two(primary(0) and secondary(1)).
   ///
   /// @param[inout] mesh
+  /// @param[in] eps Vertices whose attributes are the same within `eps` are
+  /// merged(MeshConverterConfig::facevarying_to_vertex_eps).
+  /// @param[in] num_threads The number of threads used for large meshes.
+  ///
+  bool BuildVertexIndicesImpl(RenderMesh &mesh, const float eps,
+                              const size_t num_threads);
+
+  ///
+  /// Build `RenderMesh::interleaved_buffer` for converted meshes.
+  /// Vertex and index data are written to a new BufferData in `buffers`.
   ///
-  bool BuildVertexIndicesImpl(RenderMesh &mesh);
+  bool BuildInterleavedVertexBuffers(const RenderSceneConverterEnv &env,
+                                     size_t num_threads);
 
   //
   // Get Skeleton assigned to the GeomMesh Prim and convert it to SkelHierarchy.
@@ -1826,6 +1985,26 @@ class RenderSceneConverter {
     const XformNode &node,
     Node &out_rnode);
 
+  ///
+  /// Decode texture assets referenced by UsdUVTexture Shaders in the Stage and
+  /// convert its texel data(linearization, bit depth) with a pool of
+  /// `num_threads` threads. Results are stored to the texture cache and used
+  /// by `ConvertUVTexture`.
+  ///
+  /// Each unique(resolved) asset is decoded only once.
+  ///
+  bool PrefetchTextureImages(const RenderSceneConverterEnv &env,
+                             size_t num_threads);
+
+  // Decoded texture assets and converted texture images. Identical texture
+  // asset shares TextureImage and BufferData.
+  struct TextureCache;
+  TextureCache *_texture_cache{nullptr};
+
+  // Previous conversion result and content hashes for UpdateRenderScene.
+  struct IncrementalState;
+  IncrementalState *_incremental{nullptr};
+
   void PushInfo(const std::string &msg) { _info += msg; }
   void PushWarn(const std::string &msg) { _warn += msg; }
   void PushError(const std::string &msg) { _err += msg; }
@@ -8,6 +8,7 @@
 #include "prim-pprint.hh"
 #include "prim-types.hh"
 #include "primvar.hh"
+#include "str-util.hh"
 #include "tiny-format.hh"
 #include "tydra/prim-apply.hh"
 #include "usdGeom.hh"
@@ -36,13 +37,14 @@ namespace {
 // Typed TimeSamples to typeless TimeSamples
 template <typename T>
 value::TimeSamples ToTypelessTimeSamples(const TypedTimeSamples<T> &ts) {
-  const std::vector<typename TypedTimeSamples<T>::Sample> &samples =
-      ts.get_samples();
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<T> &values = ts.get_values();
 
   value::TimeSamples dst;
+  dst.reserve(times.size());
 
-  for (size_t i = 0; i < samples.size(); i++) {
-    dst.add_sample(samples[i].t, samples[i].value);
+  for (size_t i = 0; i < times.size(); i++) {
+    dst.add_sample(times[i], values[i]);
   }
 
   return dst;
@@ -52,15 +54,16 @@ value::TimeSamples ToTypelessTimeSamples(const TypedTimeSamples<T> &ts) {
 template <typename T>
 value::TimeSamples EnumTimeSamplesToTypelessTimeSamples(
     const TypedTimeSamples<T> &ts) {
-  const std::vector<typename TypedTimeSamples<T>::Sample> &samples =
-      ts.get_samples();
+  const std::vector<double> &times = ts.get_times();
+  const std::vector<T> &values = ts.get_values();
 
   value::TimeSamples dst;
+  dst.reserve(times.size());
 
-  for (size_t i = 0; i < samples.size(); i++) {
+  for (size_t i = 0; i < times.size(); i++) {
     // to token
-    value::token tok(to_string(samples[i].value));
-    dst.add_sample(samples[i].t, tok);
+    value::token tok(to_string(values[i]));
+    dst.add_sample(times[i], tok);
   }
 
   return dst;
@@ -2761,6 +2764,32 @@ bool GetGeomPrimvar(const Stage &stage, const GPrim *gprim,
   return true;
 }
 
+std::vector<GeomPrimvar> GetGeomPrimvars(const Stage &stage,
+                                         const GPrim &gprim) {
+  std::vector<GeomPrimvar> primvars;
+
+  constexpr auto kPrimvars = "primvars:";
+  constexpr auto kIndices = ":indices";
+
+  // `primvars:` Properties are adjacent in PropertyMap, so other Properties
+  // are not visited.
+  auto range = gprim.props.prefix_range(kPrimvars);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (endsWith(it->first, kIndices)) {
+      // Handled in GetGeomPrimvar()
+      continue;
+    }
+
+    GeomPrimvar primvar;
+    if (GetGeomPrimvar(stage, &gprim, removePrefix(it->first, kPrimvars),
+                       &primvar)) {
+      primvars.emplace_back(std::move(primvar));
+    }
+  }
+
+  return primvars;
+}
+
 namespace {
 
 //
@@ -7,6 +7,10 @@
 
 #include "usd-export.hh"
 #include "common-macros.inc"
+#include "io-util.hh"
+#include "str-util.hh"
+#include "usda-writer.hh"
+#include "usdz-writer.hh"
 #include "tiny-format.hh"
 #include "math-util.inc"
 
@@ -1235,15 +1239,10 @@ static bool ToMaterialPrim(const RenderScene &scene, const std::string &abs_path
   return true;
 }
 
-} // namespace detail
-
-bool export_to_usda(const RenderScene &scene,
-  std::string &usda_str, std::string *warn, std::string *err) {
+static bool ToStage(const RenderScene &scene, Stage &stage, std::string *warn, std::string *err) {
 
   (void)warn;
 
-  Stage stage;
-
   stage.metas().comment = "Exported from TinyUSDZ Tydra.";
   if (scene.meta.upAxis == "X") {
     stage.metas().upAxis = Axis::X;
@@ -1430,11 +1429,105 @@ bool export_to_usda(const RenderScene &scene,
     stage.add_root_prim(std::move(matGroupPrim));
   }
 
+  return true;
+}
+
+static bool ForwardToUSDZWriter(const char *data, size_t size, void *userdata) {
+  usdz::USDZWriter *writer = reinterpret_cast<usdz::USDZWriter *>(userdata);
+  return writer->WriteFileData(reinterpret_cast<const uint8_t *>(data), size);
+}
+
+} // namespace detail
+
+bool export_to_usda(const RenderScene &scene,
+  std::string &usda_str, std::string *warn, std::string *err) {
+
+  Stage stage;
+  if (!detail::ToStage(scene, stage, warn, err)) {
+    return false;
+  }
+
   usda_str =stage.ExportToString();
 
   return true;
 }
 
+bool export_to_usdz(const RenderScene &scene,
+  const AssetResolutionResolver &resolver, const std::string &filename,
+  std::string *warn, std::string *err) {
+
+  Stage stage;
+  if (!detail::ToStage(scene, stage, warn, err)) {
+    return false;
+  }
+
+  usdz::USDZWriter writer;
+  if (!writer.Open(filename)) {
+    PUSH_ERROR_AND_RETURN(writer.GetError());
+  }
+
+  // Root layer(streamed).
+  if (!writer.BeginFile("root.usda")) {
+    PUSH_ERROR_AND_RETURN(writer.GetError());
+  }
+
+  if (!usda::SaveAsUSDA(detail::ForwardToUSDZWriter, reinterpret_cast<void *>(&writer), stage, warn, err)) {
+    PUSH_ERROR_AND_RETURN(writer.GetError());
+  }
+
+  if (!writer.EndFile()) {
+    PUSH_ERROR_AND_RETURN(writer.GetError());
+  }
+
+  // Texture images. Package the original file content(not re-encoded), one
+  // by one.
+  std::unordered_set<std::string> packaged;
+  for (const auto &image : scene.images) {
+    const std::string &asset_path = image.asset_identifier;
+    if (asset_path.empty() || packaged.count(asset_path)) {
+      continue;
+    }
+    packaged.insert(asset_path);
+
+    std::string name = asset_path;
+    if (startsWith(name, "./")) {
+      name = removePrefix(name, "./");
+    }
+
+    // The asset path in the root layer must resolve to the entry in USDZ.
+    if (io::IsAbsPath(name) || startsWith(name, "../") ||
+        (name.find("/../") != std::string::npos)) {
+      if (warn) {
+        (*warn) += fmt::format("Texture asset `{}` is not a relative path under the root layer. Not packaged into USDZ.\n", asset_path);
+      }
+      continue;
+    }
+
+    std::string resolved_path = resolver.resolve(asset_path);
+    if (resolved_path.empty()) {
+      if (warn) {
+        (*warn) += fmt::format("Texture asset `{}` not found. Not packaged into USDZ.\n", asset_path);
+      }
+      continue;
+    }
+
+    Asset asset;
+    if (!resolver.open_asset(resolved_path, asset_path, &asset, warn, err)) {
+      PUSH_ERROR_AND_RETURN(fmt::format("Failed to open texture asset `{}`.", asset_path));
+    }
+
+    if (!writer.AddFile(name, asset.cdata(), asset.size())) {
+      PUSH_ERROR_AND_RETURN(writer.GetError());
+    }
+  }
+
+  if (!writer.Close()) {
+    PUSH_ERROR_AND_RETURN(writer.GetError());
+  }
+
+  return true;
+}
+
 
 } // namespace tydra
 } // namespace tinyusdz
@@ -4,7 +4,7 @@
 // Simple RenderScene -> USD exporter.
 // For debugging whether RenderScene is correctly constructed from USD :-)
 //
-// Supports USDA only at the moment.
+// Supports USDA and USDZ.
 //
 // - Features
 //   - [ ] RenderMesh
@@ -37,5 +37,26 @@ bool export_to_usda(const RenderScene &scene,
                    std::string &usda_str,
                    std::string *warn, std::string *err);
 
+///
+/// Export RenderScene to USDZ file.
+///
+/// The root layer(USDA) is streamed into the archive. Texture images are
+/// packaged with their original file content, which is read through
+/// `resolver` from `TextureImage::asset_identifier`(no re-encoding).
+/// Only textures referenced with a relative path are packaged.
+///
+/// @param[in] scene RenderScene
+/// @param[in] resolver AssetResolutionResolver to read texture files.
+/// @param[in] filename USDZ filename
+/// @param[out] warn warning message
+/// @param[out] err error message
+///
+/// @return true upon success.
+///
+bool export_to_usdz(const RenderScene &scene,
+                    const AssetResolutionResolver &resolver,
+                    const std::string &filename,
+                    std::string *warn, std::string *err);
+
 }  // namespace tydra
 }  // namespace tinyusdz
@@ -330,13 +330,8 @@ void GeomPrimvar::set_indices(const std::vector<int32_t> &indices, const double
   if (value::TimeCode(t).is_default()) {
     _indices = indices;
   } else {
-    TypedTimeSamples<std::vector<int32_t>>::Sample *psample{nullptr};
-    if (_ts_indices.get_sample_at(t, &psample)) {
-      // overwrite content
-      psample->value = indices;
-    } else {
-      _ts_indices.add_sample(t, indices);
-    }
+    // overwrite content when a sample exists at `t`.
+    _ts_indices.set_sample(t, indices);
   }
 }
 
@@ -501,7 +496,7 @@ bool GeomPrimvar::get_value(T *dest, std::string *err) const {
       return false;
     }
     
-    if (auto pv =ts.get_samples().at(0).value.as<T>()) {
+    if (auto pv = ts.get_values()[0].as<T>()) {
       (*dest) = (*pv);
       return true;
     }
@@ -604,18 +599,18 @@ APPLY_GEOMPRIVAR_TYPE(INSTANCIATE_GET_VALUE)
 std::vector<GeomPrimvar> GPrim::get_primvars() const {
   std::vector<GeomPrimvar> gpvars;
 
-  for (const auto &prop : props) {
-    if (startsWith(prop.first, kPrimvars)) {
-      // skip `:indices`. Attribute with `:indices` suffix is handled in
-      // `get_primvar`
-      if (props.count(prop.first + kIndices)) {
-        continue;
-      }
+  // `primvars:` Properties are adjacent in PropertyMap.
+  auto range = props.prefix_range(kPrimvars);
+  for (auto it = range.first; it != range.second; ++it) {
+    // skip `:indices`. Attribute with `:indices` suffix is handled in
+    // `get_primvar`
+    if (endsWith(it->first, kIndices)) {
+      continue;
+    }
 
-      GeomPrimvar gprimvar;
-      if (get_primvar(removePrefix(prop.first, kPrimvars), &gprimvar)) {
-        gpvars.emplace_back(std::move(gprimvar));
-      }
+    GeomPrimvar gprimvar;
+    if (get_primvar(removePrefix(it->first, kPrimvars), &gprimvar)) {
+      gpvars.emplace_back(std::move(gprimvar));
     }
   }
 
@@ -663,8 +658,9 @@ bool GPrim::set_primvar(const GeomPrimvar &primvar,
     }
 
     if (primvar.has_timesampled_indices()) {
-      for (const auto &sample : primvar.get_timesampled_indices().get_samples()) {
-        var.set_timesample(sample.t, sample.value);
+      const auto &ts_indices = primvar.get_timesampled_indices();
+      for (size_t i = 0; i < ts_indices.size(); i++) {
+        var.set_timesample(ts_indices.get_times()[i], ts_indices.get_values()[i]);
       }
     }
 
@@ -380,7 +380,7 @@ struct GPrim : Xformable, MaterialBinding, Collection {
   nonstd::optional<Relationship> materialBindingFull; // material:binding:full
 #endif
 
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
@@ -682,7 +682,7 @@ struct GeomSubset : public MaterialBinding, Collection {
 
   TypedAttribute<Animatable<std::vector<int32_t>>> indices; // int[] indices
 
-  std::map<std::string, Property> props;  // custom Properties
+  PropertyMap props;  // custom Properties
   PrimMeta meta;
 
   std::vector<value::token> &primChildrenNames() {
@@ -46,7 +46,7 @@ class BoundableLight : public Xformable, public Collection {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
   PrimMeta meta; // TODO: move to private
 
   const PrimMeta &metas() const { return meta; }
@@ -90,7 +90,7 @@ class NonboundableLight : public Xformable, public Collection {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
   PrimMeta meta; // TODO: move to private
 
   const PrimMeta &metas() const { return meta; }
@@ -997,7 +997,7 @@ bool LoadMaterialXFromAsset(const Asset &asset, const std::string &asset_path,
     return false;
   }
 
-  std::string str(reinterpret_cast<const char *>(asset.data()), asset.size());
+  std::string str(reinterpret_cast<const char *>(asset.cdata()), asset.size());
 
   MtlxModel mtlx;
   if (!ReadMaterialXFromString(str, asset_path, &mtlx, warn, err)) {
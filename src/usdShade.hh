@@ -68,7 +68,7 @@ struct UsdShadePrim {
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
   // Custom properties
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   const std::vector<value::token> &primChildrenNames() const { return _primChildren; }
   const std::vector<value::token> &propertyNames() const { return _properties; }
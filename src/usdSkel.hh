@@ -45,7 +45,7 @@ struct BlendShape {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   ///
   /// Add attribute as in-beteen BlendShape attribute.
@@ -121,7 +121,7 @@ struct Skeleton : Xformable {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
   //std::vector<value::token> xformOpOrder;
 
   PrimMeta meta;
@@ -205,7 +205,7 @@ struct SkelRoot : Xformable {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   const std::vector<value::token> &primChildrenNames() const { return _primChildren; }
   const std::vector<value::token> &propertyNames() const { return _properties; }
@@ -278,7 +278,7 @@ struct SkelAnimation {
   std::pair<ListEditQual, std::vector<Reference>> references;
   std::pair<ListEditQual, std::vector<Payload>> payload;
   std::map<std::string, VariantSet> variantSet;
-  std::map<std::string, Property> props;
+  PropertyMap props;
 
   const std::vector<value::token> &primChildrenNames() const { return _primChildren; }
   const std::vector<value::token> &propertyNames() const { return _properties; }
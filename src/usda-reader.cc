@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <stack>
@@ -26,6 +27,7 @@
 #else
 #include <mutex>
 #include <thread>
+#define TINYUSDZ_USDA_PARALLEL_PARSE
 #endif
 #include <vector>
 
@@ -125,7 +127,7 @@ namespace {
 // intermediate data structure for VariantSet stmt
 struct VariantNode {
   PrimMeta metas;
-  std::map<std::string, Property> props;
+  PropertyMap props;
   std::vector<int64_t> primChildren;
 };
 
@@ -152,6 +154,27 @@ struct PrimSpecNode {
   std::map<std::string, std::map<std::string, VariantNode>> variantNodeMap;
 };
 
+// Shift node indices of PrimNode/PrimSpecNode by `offset`. Used to merge
+// nodes parsed in separate readers.
+template <typename Node>
+void OffsetNodeIndices(const size_t offset, Node *node) {
+  if (node->parent >= 0) {
+    node->parent += int64_t(offset);
+  }
+
+  for (auto &cidx : node->children) {
+    cidx += offset;
+  }
+
+  for (auto &variantSet : node->variantNodeMap) {
+    for (auto &variant : variantSet.second) {
+      for (auto &vidx : variant.second.primChildren) {
+        vidx += int64_t(offset);
+      }
+    }
+  }
+}
+
 // TODO: Move to prim-types.hh?
 
 template <typename T>
@@ -289,7 +312,7 @@ class USDAReader::Impl {
   Stage _stage;
 
  public:
-  Impl(StreamReader *sr) { _parser.SetStream(sr); }
+  Impl(StreamReader *sr) : _sr(sr) { _parser.SetStream(sr); }
 
 #if 0 // TODO: Remove
   // Return the flag if the .usda is read from `references`
@@ -319,6 +342,17 @@ class USDAReader::Impl {
 
   void set_reader_config(const USDAReaderConfig &config) {
     _config = config;
+
+#if defined(TINYUSDZ_USDA_PARALLEL_PARSE)
+    if (_config.numThreads == -1) {
+      _config.numThreads =
+          (std::max)(1, int(std::thread::hardware_concurrency()));
+    }
+    // Limit to 1024 threads.
+    _config.numThreads = (std::min)(1024, _config.numThreads);
+#else
+    _config.numThreads = 1;
+#endif
   }
 
   const USDAReaderConfig get_reader_config() const {
@@ -426,6 +460,10 @@ class USDAReader::Impl {
                                            prim_name.full_path_name());
           }
 
+          if (_config.stats) {
+            prim::AccumulateLoadCounts(properties, &_counts);
+          }
+
           prim.spec = spec;
           prim.name = prim_name.prim_part();
 
@@ -560,6 +598,10 @@ class USDAReader::Impl {
 
           primspec.props() = properties;
 
+          if (_config.stats) {
+            prim::AccumulateLoadCounts(properties, &_counts);
+          }
+
           //
           // variants
           // NOTE: variantChildren setup is delayed. It will be processed ConstructPrimTreeRec()
@@ -1237,8 +1279,33 @@ class USDAReader::Impl {
   // TODO: Remove
   // std::set<std::string> _node_types;
 
+  ///
+  /// Register callbacks to construct Prim/PrimSpec to the parser.
+  ///
+  void RegisterPrimCallbacks();
+
+  ///
+  /// Parse root Prim blocks in the stream(no magic header and Stage metas).
+  /// `cursor` is the location of the stream in the original USDA.
+  ///
+  bool ReadRootPrimBlocks(const uint32_t state_flags, bool as_primspec,
+                          const ascii::AsciiParserOption &parser_option,
+                          const ascii::AsciiParser::Cursor &cursor);
+
+  ///
+  /// Split root Prim blocks into chunks, parse them in parallel, then merge
+  /// the result in the original order.
+  /// Return false when threading is not applicable or parsing failed. Reader
+  /// state is not modified in this case, so the caller should parse root Prim
+  /// blocks sequentially(also to report the error).
+  ///
+  bool ReadRootPrimBlocksParallel(const uint32_t state_flags, bool as_primspec,
+                                  const ascii::AsciiParserOption &parser_option);
+
   std::stack<ParseState> parse_stack;
 
+  StreamReader *_sr{nullptr};
+
   std::string _base_dir;  // Used for importing another USD file
   //AssetResolutionResolver _arr;
 
@@ -1283,6 +1350,9 @@ class USDAReader::Impl {
   // Used for Ascii parser option
   USDAReaderConfig _config;
 
+  // Objects loaded by this reader. Valid when `_config.stats` is set.
+  performance::LoadCounts _counts;
+
   ascii::AsciiParser _parser;
 
 };  // namespace usda
@@ -1391,6 +1461,9 @@ bool USDAReader::Impl::GetAsLayer(Layer *layer) {
   DCOUT("# of subLayers = " << _stage.metas().subLayers.size());
   layer->metas() = _stage.metas();
 
+  // Keep the order of root PrimSpecs(`primspecs` is an unordered map).
+  std::vector<value::token> rootPrimNames;
+
   for (const auto &idx : _toplevel_primspecs) {
     DCOUT("Toplevel primspec idx: " << std::to_string(idx));
 
@@ -1410,11 +1483,17 @@ bool USDAReader::Impl::GetAsLayer(Layer *layer) {
       PUSH_ERROR_AND_RETURN("Construct PrimSpec tree failed.");
     }
 
+    rootPrimNames.push_back(value::token(primSpec.name()));
+
     if (!layer->emplace_primspec(primSpec.name(), std::move(_primspec_nodes[idx].primSpec))) {
       PUSH_ERROR_AND_RETURN(fmt::format("Construct PrimSpec tree failed: PrimSpec.name = {}", primSpec.name()));
     }
   }
 
+  if (layer->metas().primChildren.empty()) {
+    layer->metas().primChildren = std::move(rootPrimNames);
+  }
+
   // NOTE: _toplevel_primspecs are destroyed(std::move'ed)
   _primspec_invalidated = true;
 
@@ -1529,6 +1608,8 @@ bool ConstructPrimTreeRec(const size_t primIdx,
 
 
 bool USDAReader::Impl::ReconstructStage() {
+  performance::ScopedPhase phase(_config.stats, "usda:reconstruct_stage");
+
   _stage.root_prims().clear();
 
   for (const auto &idx : _toplevel_prims) {
@@ -1629,21 +1710,7 @@ bool USDAReader::Impl::ReconstructPrim(
 /// -- Impl Read
 ///
 
-bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
-
-  ///
-  /// Convert parser option.
-  ///
-  ascii::AsciiParserOption ascii_parser_option;
-  ascii_parser_option.allow_unknown_prim = _config.allow_unknown_prims;
-  ascii_parser_option.allow_unknown_apiSchema = _config.allow_unknown_apiSchema;
-  ascii_parser_option.strict_allowedToken_check = _config.strict_allowedToken_check;
-
-  ///
-  /// Setup callbacks.
-  ///
-  StageMetaProcessor();
-
+void USDAReader::Impl::RegisterPrimCallbacks() {
   RegisterPrimIdxAssignCallback();
 
   // For composition(as_primspec == true)
@@ -1682,10 +1749,190 @@ bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
   RegisterReconstructCallback<Skeleton>();
   RegisterReconstructCallback<SkelAnimation>();
   RegisterReconstructCallback<BlendShape>();
+}
+
+bool USDAReader::Impl::ReadRootPrimBlocks(
+    const uint32_t state_flags, bool as_primspec,
+    const ascii::AsciiParserOption &parser_option,
+    const ascii::AsciiParser::Cursor &cursor) {
+  RegisterPrimCallbacks();
+
+  _parser.set_primspec_mode(as_primspec);
+  _parser.SetCursor(cursor);
+
+  bool ret = _parser.ParseRootPrimBlocks(state_flags, parser_option);
+
+  std::string warn = _parser.GetWarning();
+  if (!warn.empty()) {
+    PUSH_WARN("<USDAParser> " + warn);
+  }
+
+  return ret;
+}
+
+bool USDAReader::Impl::ReadRootPrimBlocksParallel(
+    const uint32_t state_flags, bool as_primspec,
+    const ascii::AsciiParserOption &parser_option) {
+#if defined(TINYUSDZ_USDA_PARALLEL_PARSE)
+  size_t num_threads = size_t((std::max)(1, _config.numThreads));
+  if (num_threads < 2) {
+    return false;
+  }
+
+  // Threading does not pay off for small USDA.
+  constexpr uint64_t kMinBytesForThreading = 64 * 1024;
+  if ((_sr->size() - _sr->tell()) < kMinBytesForThreading) {
+    return false;
+  }
+
+  std::vector<ascii::AsciiParser::BlockRange> blocks;
+  if (!_parser.ScanRootPrimBlocks(&blocks)) {
+    return false;
+  }
+
+  if (blocks.size() < 2) {
+    return false;
+  }
+
+  // Group contiguous blocks into chunks of roughly the same byte size.
+  // Use more chunks than threads, since the cost of parsing a block varies.
+  const size_t num_chunks = (std::min)(blocks.size(), num_threads * 4);
+  const uint64_t total_bytes = blocks.back().end - blocks.front().begin;
+
+  std::vector<ascii::AsciiParser::BlockRange> chunks;
+  {
+    ascii::AsciiParser::BlockRange chunk = blocks[0];
+    for (size_t i = 0; i < blocks.size(); i++) {
+      chunk.end = blocks[i].end;
+
+      uint64_t target =
+          total_bytes * uint64_t(chunks.size() + 1) / uint64_t(num_chunks);
+      if (((chunk.end - blocks.front().begin) >= target) ||
+          ((i + 1) == blocks.size())) {
+        chunks.push_back(chunk);
+        if ((i + 1) < blocks.size()) {
+          chunk = blocks[i + 1];
+        }
+      }
+    }
+  }
+
+  num_threads = (std::min)(num_threads, chunks.size());
+
+  struct ChunkReader {
+    std::unique_ptr<StreamReader> sr;
+    std::unique_ptr<Impl> reader;
+  };
+
+  std::vector<ChunkReader> chunk_readers(chunks.size());
+  std::vector<std::thread> workers;
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+
+  for (size_t t = 0; t < num_threads; t++) {
+    workers.emplace_back([&]() {
+      while (!failed.load()) {
+        size_t i = next++;
+        if (i >= chunks.size()) {
+          break;
+        }
+
+        const ascii::AsciiParser::BlockRange &chunk = chunks[i];
+
+        // Each chunk has its own reader(and node indices start with 0).
+        chunk_readers[i].sr.reset(new StreamReader(_sr->data() + chunk.begin,
+                                                   chunk.end - chunk.begin,
+                                                   /* swap endian */ false));
+        chunk_readers[i].reader.reset(new Impl(chunk_readers[i].sr.get()));
+        chunk_readers[i].reader->_config = _config;
+
+        if (!chunk_readers[i].reader->ReadRootPrimBlocks(
+                state_flags, as_primspec, parser_option, chunk.cursor)) {
+          failed = true;
+          break;
+        }
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  bool ok = !failed.load();
+
+  for (auto &item : chunk_readers) {
+    if (ok && item.reader) {
+      // Merge nodes in the original order.
+      Impl &src = *item.reader;
+      const size_t offset = _prim_nodes.size();
+
+      for (auto &node : src._prim_nodes) {
+        OffsetNodeIndices(offset, &node);
+        _prim_nodes.emplace_back(std::move(node));
+      }
+
+      for (const auto &idx : src._toplevel_prims) {
+        _toplevel_prims.push_back(idx + offset);
+      }
+
+      if (!src._primspec_nodes.empty()) {
+        _primspec_nodes.resize(offset);
+        for (auto &node : src._primspec_nodes) {
+          OffsetNodeIndices(offset, &node);
+          _primspec_nodes.emplace_back(std::move(node));
+        }
+      }
+
+      for (const auto &idx : src._toplevel_primspecs) {
+        _toplevel_primspecs.push_back(idx + offset);
+      }
+
+      _warn += src._warn;
+      _counts += src._counts;
+    }
+
+    item.reader.reset();
+    item.sr.reset();
+  }
+
+  return ok;
+#else
+  (void)state_flags;
+  (void)as_primspec;
+  (void)parser_option;
+  return false;
+#endif
+}
+
+bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
+  performance::ScopedPhase phase(_config.stats, "usda:parse");
+
+  ///
+  /// Convert parser option.
+  ///
+  ascii::AsciiParserOption ascii_parser_option;
+  ascii_parser_option.allow_unknown_prim = _config.allow_unknown_prims;
+  ascii_parser_option.allow_unknown_apiSchema = _config.allow_unknown_apiSchema;
+  ascii_parser_option.strict_allowedToken_check = _config.strict_allowedToken_check;
+
+  ///
+  /// Setup callbacks.
+  ///
+  StageMetaProcessor();
+
+  RegisterPrimCallbacks();
 
   _parser.set_primspec_mode(as_primspec);
 
-  bool ret = _parser.Parse(state_flags, ascii_parser_option);
+  bool ret = _parser.ParseHeaderAndStageMetas(state_flags, ascii_parser_option);
+
+  if (ret && !_parser.Eof()) {
+    if (!ReadRootPrimBlocksParallel(state_flags, as_primspec,
+                                    ascii_parser_option)) {
+      ret = _parser.ParseRootPrimBlocks(state_flags, ascii_parser_option);
+    }
+  }
 
   std::string warn = _parser.GetWarning();
   if (!warn.empty()) {
@@ -1696,6 +1943,12 @@ bool USDAReader::Impl::Read(const uint32_t state_flags, bool as_primspec) {
     PUSH_ERROR_AND_RETURN("Parse failed:\n" + _parser.GetError());
   }
 
+  if (_config.stats) {
+    _config.stats->bytes_read += _sr->size();
+    _config.stats->counts += _counts;
+    _config.stats->update_peak_memory(_counts.array_bytes);
+    _counts = performance::LoadCounts();
+  }
 
   return true;
 }
@@ -18,6 +18,19 @@ struct USDAReaderConfig {
   bool allow_unknown_shader{true};
   bool allow_unknown_apiSchema{true};
   bool strict_allowedToken_check{false};
+
+  ///
+  /// The number of threads to parse root Prim blocks in parallel.
+  /// -1 = use system's # of threads. 1 = disable threading(default).
+  /// Threading is only applied to large USDA(e.g. a flattened scene with many
+  /// root Prims).
+  ///
+  int32_t numThreads{1};
+
+  ///
+  /// Record phase timings and the number of loaded objects when non-null.
+  ///
+  performance::LoadStats *stats{nullptr};
 };
 
 ///
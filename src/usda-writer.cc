@@ -9,9 +9,14 @@
 
 #if !defined(TINYUSDZ_DISABLE_MODULE_USDA_WRITER)
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <streambuf>
+#include <vector>
 
 #include "pprinter.hh"
 #include "value-pprint.hh"
@@ -23,18 +28,170 @@ namespace usda {
 
 namespace {
 
+///
+/// streambuf with a fixed size buffer. Buffered data is passed to the callback
+/// each time the buffer becomes full.
+///
+class CallbackStreamBuf : public std::streambuf {
+ public:
+  CallbackStreamBuf(USDAWriteCallback callback, void *userdata,
+                    size_t buffer_size)
+      : _callback(callback), _userdata(userdata) {
+    _buf.resize((std::max)(size_t(1), buffer_size));
+    setp(_buf.data(), _buf.data() + _buf.size());
+  }
+
+  bool failed() const { return _failed; }
+
+ protected:
+  int_type overflow(int_type ch) override {
+    if (!Flush()) {
+      return traits_type::eof();
+    }
+
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    if (n <= 0) {
+      return 0;
+    }
+
+    const size_t len = size_t(n);
+    const size_t remaining = size_t(epptr() - pptr());
+
+    if (len <= remaining) {
+      std::memcpy(pptr(), s, len);
+      pbump(int(n));
+      return n;
+    }
+
+    // Does not fit. Flush buffered data first.
+    if (!Flush()) {
+      return 0;
+    }
+
+    if (len >= _buf.size()) {
+      // Pass large data(e.g. a Prim with a large array attribute) to the
+      // callback directly, without copying it to the buffer.
+      if (!_callback(s, len, _userdata)) {
+        _failed = true;
+        return 0;
+      }
+    } else {
+      std::memcpy(pptr(), s, len);
+      pbump(int(n));
+    }
+
+    return n;
+  }
+
+  int sync() override { return Flush() ? 0 : -1; }
+
+ private:
+  bool Flush() {
+    if (_failed) {
+      return false;
+    }
+
+    const size_t n = size_t(pptr() - pbase());
+    if (n) {
+      if (!_callback(pbase(), n, _userdata)) {
+        _failed = true;
+        return false;
+      }
+    }
+
+    setp(_buf.data(), _buf.data() + _buf.size());
+    return true;
+  }
+
+  USDAWriteCallback _callback{nullptr};
+  void *_userdata{nullptr};
+  std::vector<char> _buf;
+  bool _failed{false};
+};
+
+bool WriteToFileCallback(const char *data, size_t size, void *userdata) {
+  FILE *fp = reinterpret_cast<FILE *>(userdata);
+  return std::fwrite(data, 1, size, fp) == size;
+}
+
+bool SaveAsUSDAToFile(FILE *fp, const std::string &filename,
+                      const Stage &stage, std::string *warn, std::string *err,
+                      const USDAWriterConfig &config) {
+  if (!fp) {
+    if (err) {
+      (*err) += "File open error for writing : " + filename + "\n";
+    }
+    return false;
+  }
+
+  bool ret = SaveAsUSDA(WriteToFileCallback, reinterpret_cast<void *>(fp),
+                        stage, warn, err, config);
+
+  if (std::fclose(fp) != 0) {
+    ret = false;
+  }
+
+  if (!ret) {
+    if (err) {
+      (*err) += "File write error: " + filename + "\n";
+    }
+    return false;
+  }
+
+  return true;
+}
 
 }  // namespace
 
-bool SaveAsUSDA(const std::string &filename, const Stage &stage,
-                std::string *warn, std::string *err) {
+bool SaveAsUSDA(USDAWriteCallback callback, void *userdata,
+                const Stage &stage, std::string *warn, std::string *err,
+                const USDAWriterConfig &config) {
 
   (void)warn;
 
+  if (!callback) {
+    if (err) {
+      (*err) += "`callback` is nullptr.\n";
+    }
+    return false;
+  }
+
+  CallbackStreamBuf buf(callback, userdata, config.buffer_size);
+  std::ostream os(&buf);
+
   // TODO: Handle warn and err on export.
-  std::string s = stage.ExportToString();
+  stage.ExportToStream(os);
+  os.flush();
 
-  if (!io::WriteWholeFile(filename, reinterpret_cast<const unsigned char *>(s.data()), s.size(), err)) {
+  if (buf.failed() || !os) {
+    if (err) {
+      (*err) += "Failed to write USDA data.\n";
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool SaveAsUSDA(const std::string &filename, const Stage &stage,
+                std::string *warn, std::string *err,
+                const USDAWriterConfig &config) {
+
+#if defined(_WIN32)
+  FILE *fp = _wfopen(io::UTF8ToWchar(filename).c_str(), L"wb");
+#else
+  FILE *fp = std::fopen(filename.c_str(), "wb");
+#endif
+
+  if (!SaveAsUSDAToFile(fp, filename, stage, warn, err, config)) {
     return false;
   }
 
@@ -45,14 +202,13 @@ bool SaveAsUSDA(const std::string &filename, const Stage &stage,
 
 #if defined(_WIN32)
 bool SaveAsUSDA(const std::wstring &filename, const Stage &stage,
-                std::string *warn, std::string *err) {
-
-  (void)warn;
+                std::string *warn, std::string *err,
+                const USDAWriterConfig &config) {
 
-  // TODO: Handle warn and err on export.
-  std::string s = stage.ExportToString();
+  FILE *fp = _wfopen(filename.c_str(), L"wb");
 
-  if (!io::WriteWholeFile(filename, reinterpret_cast<const unsigned char *>(s.data()), s.size(), err)) {
+  if (!SaveAsUSDAToFile(fp, io::WcharToUTF8(filename), stage, warn, err,
+                        config)) {
     return false;
   }
 
@@ -71,10 +227,24 @@ bool SaveAsUSDA(const std::wstring &filename, const Stage &stage,
 namespace tinyusdz {
 namespace usda {
 
-bool SaveAsUSDA(const std::string &filename, const Stage &stage, std::string *warn, std::string *err) {
+bool SaveAsUSDA(const std::string &filename, const Stage &stage, std::string *warn, std::string *err, const USDAWriterConfig &config) {
   (void)filename;
   (void)stage;
   (void)warn;
+  (void)config;
+
+  if (err) {
+    (*err) = "USDA Writer feature is disabled in this build.\n";
+  }
+  return false;
+}
+
+bool SaveAsUSDA(USDAWriteCallback callback, void *userdata, const Stage &stage, std::string *warn, std::string *err, const USDAWriterConfig &config) {
+  (void)callback;
+  (void)userdata;
+  (void)stage;
+  (void)warn;
+  (void)config;
 
   if (err) {
     (*err) = "USDA Writer feature is disabled in this build.\n";
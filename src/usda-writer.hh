@@ -1,10 +1,32 @@
 #pragma once
 
+#include <cstddef>
+
 #include "tinyusdz.hh"
 
 namespace tinyusdz {
 namespace usda {
 
+///
+/// Callback to receive a chunk of USDA text.
+///
+/// @param[in] data Pointer to the chunk. Valid only during the callback.
+/// @param[in] size Byte size of the chunk.
+/// @param[in] userdata Userdata passed to `SaveAsUSDA`.
+///
+/// @return false to abort writing.
+///
+typedef bool (*USDAWriteCallback)(const char *data, size_t size,
+                                  void *userdata);
+
+struct USDAWriterConfig {
+  // USDA text is accumulated in a buffer of this size, and passed to the
+  // output(file or callback) each time the buffer becomes full.
+  // Peak memory usage for the output is bounded by this buffer size and the
+  // text size of the largest single Prim(excluding its children).
+  size_t buffer_size{1024 * 1024};
+};
+
 ///
 /// Save scene as USDA(ASCII)
 ///
@@ -12,15 +34,32 @@ namespace usda {
 /// @param[in] stage Stage(scene graph).
 /// @param[out] warn Warning message
 /// @param[out] err Error message
+/// @param[in] config Writer config.
 ///
 /// @return true upon success.
 ///
-bool SaveAsUSDA(const std::string &filename, const Stage &stage, std::string *warn, std::string *err);
+bool SaveAsUSDA(const std::string &filename, const Stage &stage, std::string *warn, std::string *err, const USDAWriterConfig &config = USDAWriterConfig());
 
 #if defined(_WIN32)
 // WideChar(UNICODE) filename version.
-bool SaveAsUSDA(const std::wstring &filename, const Stage &stage, std::string *warn, std::string *err);
+bool SaveAsUSDA(const std::wstring &filename, const Stage &stage, std::string *warn, std::string *err, const USDAWriterConfig &config = USDAWriterConfig());
 #endif
 
+///
+/// Save scene as USDA(ASCII) through user callback.
+/// USDA text is passed to `callback` in chunks of `config.buffer_size` bytes
+/// (a chunk may be larger when a single write exceeds the buffer size).
+///
+/// @param[in] callback Callback function to receive USDA text.
+/// @param[in] userdata Userdata passed to `callback`.
+/// @param[in] stage Stage(scene graph).
+/// @param[out] warn Warning message
+/// @param[out] err Error message
+/// @param[in] config Writer config.
+///
+/// @return true upon success. false when `callback` returns false.
+///
+bool SaveAsUSDA(USDAWriteCallback callback, void *userdata, const Stage &stage, std::string *warn, std::string *err, const USDAWriterConfig &config = USDAWriterConfig());
+
 } // namespace usda
 } // namespace tinyusdz
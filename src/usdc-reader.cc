@@ -363,7 +363,7 @@ class USDCReader::Impl {
       const ListOp<T> &);
 
   ///
-  /// Builds std::map<std::string, Property> from the list of Path(Spec)
+  /// Builds PropertyMap from the list of Path(Spec)
   /// indices.
   ///
   bool BuildPropertyMap(const std::vector<size_t> &pathIndices,
@@ -418,6 +418,28 @@ class USDCReader::Impl {
     return nonstd::nullopt;
   }
 
+  ///
+  /// Get FieldValuePairs of the fieldset.
+  /// In `lazy_array_unpack` mode, values are unpacked on demand into `buf`, and
+  /// returned pointer points to `buf`.
+  ///
+  const crate::FieldValuePairVector *GetFieldValuePairs(
+      const crate::Index &fieldset_index, crate::FieldValuePairVector *buf) {
+    if (_config.lazy_array_unpack) {
+      if (!crate_reader->GetLiveFieldSet(fieldset_index, buf)) {
+        _err += crate_reader->GetError();
+        return nullptr;
+      }
+      return buf;
+    }
+
+    const auto it = _live_fieldsets.find(fieldset_index);
+    if (it == _live_fieldsets.end()) {
+      return nullptr;
+    }
+    return &(it->second);
+  }
+
   // TODO: Do not copy data from crate_reader.
   std::vector<crate::CrateReader::Node> _nodes;
   std::vector<crate::Spec> _specs;
@@ -509,14 +531,16 @@ bool USDCReader::Impl::ReconstructGeomSubset(
                              << ", prop part: " << path.prop_part()
                              << ", spec_index = " << spec_index);
 
-    if (!_live_fieldsets.count(spec.fieldset_index)) {
+    FieldValuePairVector child_fields_buf;
+    const FieldValuePairVector *child_fields_ptr =
+        GetFieldValuePairs(spec.fieldset_index, &child_fields_buf);
+    if (!child_fields_ptr) {
       _err += "FieldSet id: " + std::to_string(spec.fieldset_index.value) +
               " must exist in live fieldsets.\n";
       return false;
     }
 
-    const FieldValuePairVector &child_fields =
-        _live_fieldsets.at(spec.fieldset_index);
+    const FieldValuePairVector &child_fields = *child_fields_ptr;
 
     {
       std::string prop_name = path.prop_part();
@@ -809,6 +833,20 @@ USDCReader::Impl::DecodeListOp(const ListOp<T> &arg) {
 bool USDCReader::Impl::BuildPropertyMap(const std::vector<size_t> &pathIndices,
                                         const PathIndexToSpecIndexMap &psmap,
                                         prim::PropertyMap *props) {
+  {
+    // Reserve storage for Properties(`pathIndices` also contains child Prims).
+    size_t num_props = 0;
+    for (size_t i = 0; i < pathIndices.size(); i++) {
+      auto it = psmap.find(uint32_t(pathIndices[i]));
+      if ((it != psmap.end()) && (it->second < _specs.size()) &&
+          ((_specs[it->second].spec_type == SpecType::Attribute) ||
+           (_specs[it->second].spec_type == SpecType::Relationship))) {
+        num_props++;
+      }
+    }
+    props->reserve(props->size() + num_props);
+  }
+
   for (size_t i = 0; i < pathIndices.size(); i++) {
     int child_index = int(pathIndices[i]);
     if ((child_index < 0) || (child_index >= int(_nodes.size()))) {
@@ -852,14 +890,16 @@ bool USDCReader::Impl::BuildPropertyMap(const std::vector<size_t> &pathIndices,
                              << ", prop part: " << path.value().prop_part()
                              << ", spec_index = " << spec_index);
 
-    if (!_live_fieldsets.count(spec.fieldset_index)) {
+    crate::FieldValuePairVector child_fvs_buf;
+    const crate::FieldValuePairVector *child_fvs_ptr =
+        GetFieldValuePairs(spec.fieldset_index, &child_fvs_buf);
+    if (!child_fvs_ptr) {
       PUSH_ERROR("FieldSet id: " + std::to_string(spec.fieldset_index.value) +
                  " must exist in live fieldsets.");
       return false;
     }
 
-    const crate::FieldValuePairVector &child_fvs =
-        _live_fieldsets.at(spec.fieldset_index);
+    const crate::FieldValuePairVector &child_fvs = *child_fvs_ptr;
 
     {
       std::string prop_name = path.value().prop_part();
@@ -883,7 +923,7 @@ bool USDCReader::Impl::BuildPropertyMap(const std::vector<size_t> &pathIndices,
                 prop_name));
       }
 
-      (*props)[prop_name] = prop;
+      (*props)[prop_name] = std::move(prop);
       DCOUT("Add property : " << prop_name);
     }
   }
@@ -929,6 +969,7 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
   nonstd::optional<value::token> outputName;
   nonstd::optional<CustomDataType> sdrMetadata;
   nonstd::optional<value::StringData> comment;
+  nonstd::optional<std::string> displayName;
   nonstd::optional<Variability> variability;
   AttrMeta meta; // for other not frequently-used attribute/relationship metadata.
   //Property::Type propType{Property::Type::EmptyAttrib};
@@ -1097,7 +1138,10 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
         auto qual = std::get<0>(ps[0]);
         auto items = std::get<1>(ps[0]);
 
-        if (items.size() == 1) {
+        if (items.empty() && (qual == ListEditQual::ResetToExplicit)) {
+          // Explicit empty targets: `rel a = None`
+          rel.set_blocked();
+        } else if (items.size() == 1) {
           // Single
           const Path path = items[0];
 
@@ -1255,6 +1299,14 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
                       << fv.second.type_name() << "`");
       }
 
+    } else if (fv.first == "displayName") {
+      if (auto pv = fv.second.get_value<std::string>()) {
+        displayName = pv.value();
+      } else {
+        PUSH_ERROR_AND_RETURN_TAG(
+            kTag, "`displayName` must be type `string`, but got type `"
+                      << fv.second.type_name() << "`");
+      }
     } else if (fv.first == "colorSpace") {
       if (auto pv = fv.second.get_value<value::token>()) {
         
@@ -1370,6 +1422,9 @@ bool USDCReader::Impl::ParseProperty(const SpecType spec_type,
     if (comment) {
       meta.comment = comment.value();
     }
+    if (displayName) {
+      meta.displayName = displayName.value();
+    }
     if (bindMaterialAs) {
       meta.bindMaterialAs = bindMaterialAs.value();
     }
@@ -1484,6 +1539,10 @@ bool USDCReader::Impl::ReconstructPrim(const Specifier &spec, const crate::Crate
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to build PropertyMap.");
   }
 
+  if (_config.stats) {
+    prim::AccumulateLoadCounts(properties, &_config.stats->counts);
+  }
+
   prim::ReferenceList refs;  // dummy
 
   prim::PrimReconstructOptions reconstruct_options;
@@ -2230,6 +2289,11 @@ bool USDCReader::Impl::ParsePrimSpec(const crate::FieldValuePairVector &fvs,
         auto items = std::get<1>(ps[0]);
         auto listop = (*pv);
         primMeta.inheritPaths = std::make_pair(qual, items);
+
+        // pxrUSD stores `inherits` as `inheritPaths` field.
+        if (!primMeta.inherits) {
+          primMeta.inherits = primMeta.inheritPaths;
+        }
       } else {
         PUSH_ERROR_AND_RETURN_TAG(
             kTag, "`inheritPaths` must be type `ListOp[Path]`, but got type `"
@@ -2341,14 +2405,16 @@ bool USDCReader::Impl::ReconstructPrimNode(int parent, int current, int level,
     }
   }
 
-  if (!_live_fieldsets.count(spec.fieldset_index)) {
+  crate::FieldValuePairVector fvs_buf;
+  const crate::FieldValuePairVector *fvs_ptr =
+      GetFieldValuePairs(spec.fieldset_index, &fvs_buf);
+  if (!fvs_ptr) {
     PUSH_ERROR("FieldSet id: " + std::to_string(spec.fieldset_index.value) +
                " must exist in live fieldsets.");
     return false;
   }
 
-  const crate::FieldValuePairVector &fvs =
-      _live_fieldsets.at(spec.fieldset_index);
+  const crate::FieldValuePairVector &fvs = *fvs_ptr;
 
   if (fvs.size() > _config.kMaxFieldValuePairs) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Too much FieldValue pairs.");
@@ -2802,14 +2868,16 @@ bool USDCReader::Impl::ReconstructPrimSpecNode(int parent, int current, int leve
     }
   }
 
-  if (!_live_fieldsets.count(spec.fieldset_index)) {
+  crate::FieldValuePairVector fvs_buf;
+  const crate::FieldValuePairVector *fvs_ptr =
+      GetFieldValuePairs(spec.fieldset_index, &fvs_buf);
+  if (!fvs_ptr) {
     PUSH_ERROR("FieldSet id: " + std::to_string(spec.fieldset_index.value) +
                " must exist in live fieldsets.");
     return false;
   }
 
-  const crate::FieldValuePairVector &fvs =
-      _live_fieldsets.at(spec.fieldset_index);
+  const crate::FieldValuePairVector &fvs = *fvs_ptr;
 
   if (fvs.size() > _config.kMaxFieldValuePairs) {
     PUSH_ERROR_AND_RETURN_TAG(kTag, "Too much FieldValue pairs.");
@@ -2955,9 +3023,14 @@ bool USDCReader::Impl::ReconstructPrimSpecNode(int parent, int current, int leve
         if (!BuildPropertyMap(node.GetChildren(), psmap, &props)) {
           PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to build PropertyMap.");
         }
+        if (_config.stats) {
+          prim::AccumulateLoadCounts(props, &_config.stats->counts);
+        }
         primspec.props() = props;
         primspec.metas() = primMeta;
-        // TODO: primChildren, properties
+        primspec.metas().primChildren = primChildren;
+        primspec.metas().properties = properties;
+        primspec.specifier() = specifier.value();
 
         if (primOut) {
           (*primOut) = primspec;
@@ -3175,6 +3248,9 @@ bool USDCReader::Impl::ReconstructPrimSpecNode(int parent, int current, int leve
         if (!BuildPropertyMap(node.GetChildren(), psmap, &props)) {
           PUSH_ERROR_AND_RETURN_TAG(kTag, "Failed to build PropertyMap.");
         }
+        if (_config.stats) {
+          prim::AccumulateLoadCounts(props, &_config.stats->counts);
+        }
         variantPrimSpec.props() = props;
         variantPrimSpec.metas() = primMeta;
 
@@ -3446,6 +3522,7 @@ bool USDCReader::Impl::ReconstructPrimRecursively(
 }
 
 bool USDCReader::Impl::ReconstructStage(Stage *stage) {
+  performance::ScopedPhase phase(_config.stats, "usdc:reconstruct_stage");
 
   // format test
   DCOUT(fmt::format("# of Paths = {}", crate_reader->NumPaths()));
@@ -3462,7 +3539,9 @@ bool USDCReader::Impl::ReconstructStage(Stage *stage) {
   _fieldset_indices = crate_reader->GetFieldsetIndices();
   _paths = crate_reader->GetPaths();
   _elemPaths = crate_reader->GetElemPaths();
-  _live_fieldsets = crate_reader->GetLiveFieldSets();
+  if (!_config.lazy_array_unpack) {
+    _live_fieldsets = crate_reader->GetLiveFieldSets();
+  }
 
   PathIndexToSpecIndexMap
       path_index_to_spec_index_map;  // path_index -> spec_index
@@ -3498,6 +3577,11 @@ bool USDCReader::Impl::ReconstructStage(Stage *stage) {
 
   stage->compute_absolute_prim_path_and_assign_prim_id();
 
+  if (_config.stats) {
+    // Values are unpacked while reconstructing Prims in lazy unpack mode.
+    _config.stats->update_peak_memory(crate_reader->GetMemoryUsage());
+  }
+
   return true;
 }
 
@@ -3693,6 +3777,7 @@ bool USDCReader::Impl::ReconstructPrimSpecRecursively(
 }
 
 bool USDCReader::Impl::ToLayer(Layer *layer) {
+  performance::ScopedPhase phase(_config.stats, "usdc:reconstruct_layer");
 
   if (!layer) {
     PUSH_ERROR_AND_RETURN("`layer` argument is nullptr.");
@@ -3713,7 +3798,9 @@ bool USDCReader::Impl::ToLayer(Layer *layer) {
   _fieldset_indices = crate_reader->GetFieldsetIndices();
   _paths = crate_reader->GetPaths();
   _elemPaths = crate_reader->GetElemPaths();
-  _live_fieldsets = crate_reader->GetLiveFieldSets();
+  if (!_config.lazy_array_unpack) {
+    _live_fieldsets = crate_reader->GetLiveFieldSets();
+  }
 
   PathIndexToSpecIndexMap
       path_index_to_spec_index_map;  // path_index -> spec_index
@@ -3757,11 +3844,15 @@ bool USDCReader::Impl::ReadUSDC() {
     delete crate_reader;
   }
 
+  performance::LoadStats *stats = _config.stats;
+  performance::ScopedPhase read_phase(stats, "usdc:read_crate");
+
   // TODO: Setup CrateReaderConfig.
   crate::CrateReaderConfig config;
 
   // Transfer settings
   config.numThreads = _config.numThreads;
+  config.lazyArrayUnpack = _config.lazy_array_unpack;
 
   size_t sz_mb = _config.kMaxAllowedMemoryInMB;
   if (sizeof(size_t) == 4) {
@@ -3779,55 +3870,27 @@ bool USDCReader::Impl::ReadUSDC() {
   _warn.clear();
   _err.clear();
 
-  if (!crate_reader->ReadBootStrap()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
+#define READ_CRATE_SECTION(__phase_name, __fn)  \
+  {                                             \
+    performance::ScopedPhase phase(stats, __phase_name); \
+    if (!crate_reader->__fn()) {                \
+      _warn = crate_reader->GetWarning();       \
+      _err = crate_reader->GetError();          \
+      return false;                             \
+    }                                           \
   }
 
-  if (!crate_reader->ReadTOC()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
+  READ_CRATE_SECTION("usdc:read_bootstrap", ReadBootStrap)
+  READ_CRATE_SECTION("usdc:read_toc", ReadTOC)
 
   // Read known sections
 
-  if (!crate_reader->ReadTokens()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadStrings()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadFields()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadFieldSets()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadPaths()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
-
-  if (!crate_reader->ReadSpecs()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
-    return false;
-  }
+  READ_CRATE_SECTION("usdc:read_tokens", ReadTokens)
+  READ_CRATE_SECTION("usdc:read_strings", ReadStrings)
+  READ_CRATE_SECTION("usdc:read_fields", ReadFields)
+  READ_CRATE_SECTION("usdc:read_fieldsets", ReadFieldSets)
+  READ_CRATE_SECTION("usdc:read_paths", ReadPaths)
+  READ_CRATE_SECTION("usdc:read_specs", ReadSpecs)
 
   // TODO(syoyo): Read unknown sections
 
@@ -3835,16 +3898,19 @@ bool USDCReader::Impl::ReadUSDC() {
   /// Reconstruct C++ representation of USD scene graph.
   ///
   DCOUT("BuildLiveFieldSets");
-  if (!crate_reader->BuildLiveFieldSets()) {
-    _warn = crate_reader->GetWarning();
-    _err = crate_reader->GetError();
+  READ_CRATE_SECTION("usdc:unpack_fields", BuildLiveFieldSets)
 
-    return false;
-  }
+#undef READ_CRATE_SECTION
 
   _warn += crate_reader->GetWarning();
   _err += crate_reader->GetError();
 
+  if (stats) {
+    stats->bytes_read += _sr->size();
+    stats->bytes_decompressed += crate_reader->GetDecompressedBytes();
+    stats->update_peak_memory(crate_reader->GetMemoryUsage());
+  }
+
   DCOUT("Read Crate.");
 
   return true;
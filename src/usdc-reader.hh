@@ -27,6 +27,15 @@ struct USDCReaderConfig {
   bool allow_unknown_apiSchemas = true;
 
   bool strict_allowedToken_check = false;
+
+  // Do not unpack array values and TimeSamples in `ReadUSDC`, but unpack it
+  // on demand when reconstructing each Prim/Property, to reduce peak memory
+  // usage(decoded values are not retained in the reader).
+  bool lazy_array_unpack = false;
+
+  // Record phase timings, decompressed bytes and the number of loaded objects
+  // when non-null.
+  performance::LoadStats *stats = nullptr;
 };
 
 class USDCReader {
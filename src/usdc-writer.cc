@@ -34,13 +34,22 @@
 #endif
 
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
 
 #include "crate-format.hh"
+#include "crate-writer.hh"
 #include "io-util.hh"
-#include "lz4-compression.hh"
+#include "pprinter.hh"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "str-util.hh"
+#include "tiny-format.hh"
+#include "tinyusdz.hh"
 #include "token-type.hh"
 
 #include "common-macros.inc"
@@ -50,8 +59,6 @@ namespace usdc {
 
 namespace {
 
-constexpr size_t kSectionNameMaxLength = 15;
-
 #ifdef _WIN32
 std::wstring UTF8ToWchar(const std::string &str) {
   int wstr_size =
@@ -74,430 +81,834 @@ std::string WcharToUTF8(const std::wstring &wstr) {
 #endif
 #endif
 
-struct Section {
-  Section() { memset(this, 0, sizeof(*this)); }
-  Section(char const *name, int64_t start, int64_t size);
-  char name[kSectionNameMaxLength + 1];
-  int64_t start, size;  // byte offset to section info and its data size
-};
+// Build ListOp from (ListEditQual, items) pair.
+// Return nullopt for non-explicit edit with empty items(no-op).
+template <typename T>
+nonstd::optional<ListOp<T>> ToListOp(ListEditQual qual,
+                                     const std::vector<T> &items) {
+  ListOp<T> lop;
+  if (qual == ListEditQual::ResetToExplicit) {
+    lop.ClearAndMakeExplicit();
+    lop.SetExplicitItems(items);
+    return lop;
+  }
 
-//
-// TOC = list of sections.
-//
-struct TableOfContents {
-  // Section const *GetSection(SectionName) const;
-  // int64_t GetMinimumSectionStart() const;
-  std::vector<Section> sections;
-};
+  if (items.empty()) {
+    return nonstd::nullopt;
+  }
 
-//struct Field {
-//  // FIXME(syoyo): Do we need 4 bytes padding as done in pxrUSD?
-//  // uint32_t padding_;
-//
-//  crate::TokenIndex token_index;
-//  crate::ValueRep value_rep;
-//};
+  if (qual == ListEditQual::Append) {
+    lop.SetAppendedItems(items);
+  } else if (qual == ListEditQual::Add) {
+    lop.SetAddedItems(items);
+  } else if (qual == ListEditQual::Delete) {
+    lop.SetDeletedItems(items);
+  } else if (qual == ListEditQual::Prepend) {
+    lop.SetPrependedItems(items);
+  } else if (qual == ListEditQual::Order) {
+    lop.SetOrderedItems(items);
+  } else {
+    return nonstd::nullopt;
+  }
 
-#if 0
-// For unordered_map
-
-// https://stackoverflow.com/questions/8513911/how-to-create-a-good-hash-combine-with-64-bit-output-inspired-by-boosthash-co
-// From CityHash code.
-template <class T>
-inline void hash_combine(std::size_t &seed, const T &v) {
-#ifdef __wasi__  // 32bit platform
-  // Use boost version.
-  std::hash<T> hasher;
-  seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-#else
-  std::hash<T> hasher;
-  const uint64_t kMul = 0x9ddfea08eb382d69ULL;
-  std::size_t a = (hasher(v) ^ seed) * kMul;
-  a ^= (a >> 47);
-  std::size_t b = (seed ^ a) * kMul;
-  b ^= (b >> 47);
-  seed = b * kMul;
-#endif
+  return lop;
 }
 
-struct PathHasher {
-  size_t operator()(const Path &path) const {
-    size_t seed = std::hash<std::string>()(path.GetPrimPart());
-    hash_combine(seed, std::hash<std::string>()(path.GetPropPart()));
-    hash_combine(seed, std::hash<std::string>()(path.GetLocalPart()));
-    hash_combine(seed, std::hash<bool>()(path.IsValid()));
+std::string VariantElement(const std::string &variantSetName,
+                           const std::string &variantName) {
+  return "{" + variantSetName + "=" + variantName + "}";
+}
 
-    return seed;
-  }
+///
+/// Layer(PrimSpec tree) -> Crate data.
+///
+class Writer {
+ public:
+  Writer(const Layer &layer) : layer_(layer) {}
+
+  bool Write(std::vector<uint8_t> *output);
+
+  const std::string &Error() const { return err_; }
+  const std::string &Warning() const { return warn_; }
+
+ private:
+  using FieldValueRepPairVector = crate::CrateWriter::FieldValueRepPairVector;
+
+  // Root Prims in `primChildren` order(if available).
+  std::vector<const PrimSpec *> RootPrimSpecs() const;
+
+  // Property names in `properties` order(if available).
+  std::vector<std::string> PropertyNames(const PrimSpec &ps) const;
+
+  // Child Prims in `primChildren` order(if available).
+  std::vector<const PrimSpec *> ChildPrimSpecs(const PrimSpec &ps) const;
+
+  // Pass 1: register Spec paths in the traversal order.
+  bool RegisterPaths(const std::string &prim_path, const PrimSpec &ps,
+                     uint32_t depth);
+
+  // Pass 2: pack fields and add Specs.
+  bool WritePseudoRoot(const std::vector<const PrimSpec *> &rootPrims);
+  bool WritePrimSpec(const std::string &prim_path, const PrimSpec &ps,
+                     bool is_variant, uint32_t depth);
+  bool WriteProperty(const Path &path, const Property &prop);
+
+  bool PackPrimMetas(const PrimMeta &meta, FieldValueRepPairVector *fields);
+  bool PackAttrMetas(const AttrMeta &meta, FieldValueRepPairVector *fields);
+  bool PackMetaValue(const std::string &name, const value::Value &v,
+                     FieldValueRepPairVector *fields);
+
+  bool PackTokens(const std::string &name,
+                  const std::vector<value::token> &toks,
+                  FieldValueRepPairVector *fields);
+
+  void PushError(const std::string &s) { err_ += s; }
+  void PushWarn(const std::string &s) { warn_ += s; }
+
+  const Layer &layer_;
+  crate::CrateWriter crate_;
+
+  std::string err_;
+  std::string warn_;
 };
 
-struct PathKeyEqual {
-  bool operator()(const Path &lhs, const Path &rhs) const {
-    bool ret = lhs.GetPrimPart() == rhs.GetPrimPart();
-    ret &= lhs.GetPropPart() == rhs.GetPropPart();
-    ret &= lhs.GetLocalPart() == rhs.GetLocalPart();
-    ret &= lhs.IsValid() == rhs.IsValid();
+std::vector<const PrimSpec *> Writer::RootPrimSpecs() const {
+  std::vector<const PrimSpec *> dst;
+
+  const auto &primspecs = layer_.primspecs();
 
-    return ret;
+  std::set<std::string> done;
+  for (const auto &tok : layer_.metas().primChildren) {
+    auto it = primspecs.find(tok.str());
+    if ((it != primspecs.end()) && !done.count(tok.str())) {
+      dst.push_back(&it->second);
+      done.insert(tok.str());
+    }
   }
-};
 
-struct FieldHasher {
-  size_t operator()(const Field &field) const {
-    size_t seed = std::hash<uint32_t>()(field.token_index.value);
-    hash_combine(seed, std::hash<uint64_t>()(field.value_rep.GetData()));
+  // Prims not listed in `primChildren`: sort by name to get a stable output.
+  std::vector<std::string> names;
+  for (const auto &item : primspecs) {
+    if (!done.count(item.first)) {
+      names.push_back(item.first);
+    }
+  }
+  std::sort(names.begin(), names.end());
 
-    return seed;
+  for (const auto &name : names) {
+    dst.push_back(&primspecs.at(name));
   }
-};
 
-struct FieldKeyEqual {
-  bool operator()(const Field &lhs, const Field &rhs) const {
-    bool ret = lhs.token_index == rhs.token_index;
-    ret &= lhs.value_rep == rhs.value_rep;
+  return dst;
+}
+
+std::vector<std::string> Writer::PropertyNames(const PrimSpec &ps) const {
+  std::vector<std::string> dst;
+  std::set<std::string> done;
 
-    return ret;
+  for (const auto &tok : ps.metas().properties) {
+    if (ps.props().count(tok.str()) && !done.count(tok.str())) {
+      dst.push_back(tok.str());
+      done.insert(tok.str());
+    }
+  }
+
+  for (const auto &item : ps.props()) {
+    if (!done.count(item.first)) {
+      dst.push_back(item.first);
+    }
   }
-};
 
-struct FieldSetHasher {
-  size_t operator()(const std::vector<crate::FieldIndex> &fieldset) const {
-    if (fieldset.empty()) {
-      return 0;
+  return dst;
+}
+
+std::vector<const PrimSpec *> Writer::ChildPrimSpecs(const PrimSpec &ps) const {
+  std::vector<const PrimSpec *> dst;
+
+  const std::vector<value::token> &primChildren = ps.metas().primChildren;
+  if (primChildren.size() == ps.children().size()) {
+    std::map<std::string, const PrimSpec *> m;
+    for (const auto &child : ps.children()) {
+      m[child.name()] = &child;
     }
 
-    size_t seed = std::hash<uint32_t>()(fieldset[0].value);
-    for (size_t i = 1; i < fieldset.size(); i++) {
-      hash_combine(seed, std::hash<uint32_t>()(fieldset[i].value));
+    for (const auto &tok : primChildren) {
+      auto it = m.find(tok.str());
+      if (it == m.end()) {
+        break;
+      }
+      dst.push_back(it->second);
+      m.erase(it);
     }
 
-    return seed;
+    if (dst.size() == ps.children().size()) {
+      return dst;
+    }
   }
-};
-#endif
 
-class Packer {
- public:
-  crate::TokenIndex AddToken(const Token &token);
-  crate::StringIndex AddString(const std::string &str);
-  crate::PathIndex AddPath(const Path &path);
-  crate::FieldIndex AddField(const crate::Field &field);
-  crate::FieldSetIndex AddFieldSet(
-      const std::vector<crate::FieldIndex> &field_indices);
+  // Use the appearance order.
+  dst.clear();
+  for (const auto &child : ps.children()) {
+    dst.push_back(&child);
+  }
 
-  const std::vector<Token> &GetTokens() const { return tokens_; }
+  return dst;
+}
 
- private:
-  std::unordered_map<Token, crate::TokenIndex, TokenHasher, TokenKeyEqual>
-      token_to_index_map;
-  std::unordered_map<std::string, crate::StringIndex> string_to_index_map;
-  std::unordered_map<Path, crate::PathIndex, crate::PathHasher, crate::PathKeyEqual>
-      path_to_index_map;
-  std::unordered_map<crate::Field, crate::FieldIndex, crate::FieldHasher, crate::FieldKeyEqual>
-      field_to_index_map;
-  std::unordered_map<std::vector<crate::FieldIndex>, crate::FieldSetIndex,
-                     crate::FieldSetHasher>
-      fieldset_to_index_map;
-
-  std::vector<Token> tokens_;
-  std::vector<std::string> strings_;
-  std::vector<Path> paths_;
-  std::vector<crate::Field> fields_;
-  std::vector<crate::FieldIndex>
-      fieldsets_;  // flattened 1D array of FieldSets. Each span is terminated
-                   // by Index()(= ~0)
-};
+bool Writer::RegisterPaths(const std::string &prim_path, const PrimSpec &ps,
+                           uint32_t depth) {
+  if (depth > 1024 * 128) {
+    PUSH_ERROR_AND_RETURN("PrimSpec hierarchy is too deep.");
+  }
 
-#if 0 // not used atm.
-crate::TokenIndex Packer::AddToken(const Token &token) {
-  if (token_to_index_map.count(token)) {
-    return token_to_index_map[token];
+  crate::PathIndex index;
+  if (!crate_.AddPath(Path(prim_path, ""), &index)) {
+    return false;
   }
 
-  // index = size of umap
-  token_to_index_map[token] = crate::TokenIndex(uint32_t(tokens_.size()));
-  tokens_.emplace_back(token);
+  for (const auto &name : PropertyNames(ps)) {
+    if (!crate_.AddPath(Path(prim_path, name), &index)) {
+      return false;
+    }
+  }
 
-  return token_to_index_map[token];
-}
+  for (const auto &vs : ps.variantSets()) {
+    if (!crate_.AddPath(Path(prim_path + VariantElement(vs.first, ""), ""),
+                        &index)) {
+      return false;
+    }
 
-crate::StringIndex Packer::AddString(const std::string &str) {
-  if (string_to_index_map.count(str)) {
-    return string_to_index_map[str];
+    for (const auto &variant : vs.second.variantSet) {
+      if (!RegisterPaths(prim_path + VariantElement(vs.first, variant.first),
+                         variant.second, depth + 1)) {
+        return false;
+      }
+    }
   }
 
-  // index = size of umap
-  string_to_index_map[str] = crate::StringIndex(uint32_t(strings_.size()));
-  strings_.emplace_back(str);
+  for (const auto *child : ChildPrimSpecs(ps)) {
+    if (!RegisterPaths(prim_path + "/" + child->name(), *child, depth + 1)) {
+      return false;
+    }
+  }
 
-  return string_to_index_map[str];
+  return true;
 }
 
-crate::PathIndex Packer::AddPath(const Path &path) {
-  if (path_to_index_map.count(path)) {
-    return path_to_index_map[path];
+bool Writer::PackTokens(const std::string &name,
+                        const std::vector<value::token> &toks,
+                        FieldValueRepPairVector *fields) {
+  crate::ValueRep rep;
+  if (!crate_.PackTokenVector(toks, &rep)) {
+    PUSH_ERROR_AND_RETURN(crate_.GetError());
   }
+  fields->push_back({name, rep});
+  return true;
+}
 
-  // index = size of umap
-  path_to_index_map[path] = crate::PathIndex(uint32_t(paths_.size()));
-  paths_.emplace_back(path);
-
-  return path_to_index_map[path];
+bool Writer::PackMetaValue(const std::string &name, const value::Value &v,
+                           FieldValueRepPairVector *fields) {
+  crate::ValueRep rep;
+  if (!crate_.PackValue(v, &rep)) {
+    PUSH_ERROR_AND_RETURN(fmt::format("Failed to encode metadatum `{}`: {}",
+                                      name, crate_.GetError()));
+  }
+  fields->push_back({name, rep});
+  return true;
 }
 
-crate::FieldIndex Packer::AddField(const crate::Field &field) {
-  if (field_to_index_map.count(field)) {
-    return field_to_index_map[field];
+bool Writer::WritePseudoRoot(const std::vector<const PrimSpec *> &rootPrims) {
+  const LayerMetas &metas = layer_.metas();
+
+  FieldValueRepPairVector fields;
+  crate::ValueRep rep;
+
+  if (metas.upAxis.authored()) {
+    fields.push_back(
+        {"upAxis", crate_.PackToken(value::token(to_string(metas.upAxis.get_value())))});
   }
 
-  // index = size of umap
-  field_to_index_map[field] = crate::FieldIndex(uint32_t(fields_.size()));
-  fields_.emplace_back(field);
+  auto PackDouble = [&](const std::string &name,
+                        const TypedAttributeWithFallback<double> &attr) -> bool {
+    if (attr.authored()) {
+      return PackMetaValue(name, value::Value(attr.get_value()), &fields);
+    }
+    return true;
+  };
 
-  return field_to_index_map[field];
-}
+  if (!PackDouble("metersPerUnit", metas.metersPerUnit) ||
+      !PackDouble("timeCodesPerSecond", metas.timeCodesPerSecond) ||
+      !PackDouble("framesPerSecond", metas.framesPerSecond) ||
+      !PackDouble("startTimeCode", metas.startTimeCode) ||
+      !PackDouble("endTimeCode", metas.endTimeCode)) {
+    return false;
+  }
 
-crate::FieldSetIndex Packer::AddFieldSet(
-    const std::vector<crate::FieldIndex> &fieldset) {
-  if (fieldset_to_index_map.count(fieldset)) {
-    return fieldset_to_index_map[fieldset];
+  if (metas.autoPlay.authored()) {
+    fields.push_back({"autoPlay", crate_.PackBool(metas.autoPlay.get_value())});
   }
 
-  // index = size of umap = star index of FieldSet span.
-  fieldset_to_index_map[fieldset] =
-      crate::FieldSetIndex(uint32_t(fieldsets_.size()));
+  if (metas.playbackMode.authored()) {
+    std::string mode =
+        (metas.playbackMode.get_value() == LayerMetas::PlaybackMode::PlaybackModeNone)
+            ? "none"
+            : "loop";
+    fields.push_back({"playbackMode", crate_.PackToken(value::token(mode))});
+  }
 
-  fieldsets_.insert(fieldsets_.end(), fieldset.begin(), fieldset.end());
-  fieldsets_.push_back(crate::FieldIndex());  // terminator(~0)
+  if (metas.defaultPrim.str().size()) {
+    fields.push_back({"defaultPrim", crate_.PackToken(metas.defaultPrim)});
+  }
 
-  return fieldset_to_index_map[fieldset];
-}
-#endif
+  if (metas.doc.value.size()) {
+    fields.push_back({"documentation", crate_.PackString(metas.doc.value)});
+  }
 
-class Writer {
- public:
-  Writer(const Stage &stage) : stage_(stage) {}
+  if (metas.comment.value.size()) {
+    fields.push_back({"comment", crate_.PackString(metas.comment.value)});
+  }
 
-  const Stage &stage_;
+  if (metas.customLayerData.size()) {
+    if (!crate_.PackDictionary(metas.customLayerData, &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields.push_back({"customLayerData", rep});
+  }
 
-  const std::string &GetError() const { return err_; }
-  const std::string &GetWarning() const { return warn_; }
+  if (metas.subLayers.size()) {
+    std::vector<std::string> assetPaths;
+    std::vector<LayerOffset> offsets;
+    bool has_offsets{false};
+    for (const auto &sublayer : metas.subLayers) {
+      assetPaths.push_back(sublayer.assetPath.GetAssetPath());
+      offsets.push_back(sublayer.layerOffset);
+      if ((sublayer.layerOffset._offset != 0.0) ||
+          (sublayer.layerOffset._scale != 1.0)) {
+        has_offsets = true;
+      }
+    }
 
-  void PushError(const std::string &s) {
-    err_ += s;
+    if (!crate_.PackStringVector(assetPaths, &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields.push_back({"subLayers", rep});
+
+    if (has_offsets) {
+      if (!crate_.PackLayerOffsetVector(offsets, &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
+      }
+      fields.push_back({"subLayerOffsets", rep});
+    }
   }
 
-  void PushWarn(const std::string &s) {
-    warn_ += s;
+  if (rootPrims.size()) {
+    std::vector<value::token> primChildren;
+    for (const auto *ps : rootPrims) {
+      primChildren.push_back(value::token(ps->name()));
+    }
+    if (!PackTokens("primChildren", primChildren, &fields)) {
+      return false;
+    }
+  }
+
+  if (!crate_.AddSpec(Path::make_root_path(), SpecType::PseudoRoot, fields)) {
+    PUSH_ERROR_AND_RETURN(crate_.GetError());
   }
 
-  bool WriteHeader(uint64_t toc_offset) {
-    char magic[8];
-    magic[0] = 'P';
-    magic[1] = 'X';
-    magic[2] = 'R';
-    magic[3] = '-';
-    magic[4] = 'U';
-    magic[5] = 'S';
-    magic[6] = 'D';
-    magic[7] = 'C';
+  return true;
+}
+
+bool Writer::PackPrimMetas(const PrimMeta &meta,
+                           FieldValueRepPairVector *fields) {
+  crate::ValueRep rep;
 
-    uint8_t version[8];  // Only first 3 bytes are used.
-    version[0] = 0;
-    version[1] = 8;
-    version[2] = 0;
+  if (meta.active) {
+    fields->push_back({"active", crate_.PackBool(meta.active.value())});
+  }
 
-    std::array<uint8_t, 88> header;
-    memset(&header, 0, 88);
+  if (meta.hidden) {
+    fields->push_back({"hidden", crate_.PackBool(meta.hidden.value())});
+  }
 
-    memcpy(&header[0], magic, 8);
-    memcpy(&header[8], version, 8);
-    memcpy(&header[16], &toc_offset, 8);
+  if (meta.instanceable) {
+    fields->push_back(
+        {"instanceable", crate_.PackBool(meta.instanceable.value())});
+  }
 
-    oss_.write(reinterpret_cast<const char *>(&header[0]), 88);
+  if (meta.kind) {
+    fields->push_back({"kind", crate_.PackToken(value::token(meta.get_kind()))});
+  }
 
+  auto PackDict = [&](const std::string &name,
+                      const nonstd::optional<Dictionary> &dict) -> bool {
+    if (dict) {
+      if (!crate_.PackDictionary(dict.value(), &rep)) {
+        PUSH_ERROR_AND_RETURN(fmt::format("Failed to encode `{}`: {}", name,
+                                          crate_.GetError()));
+      }
+      fields->push_back({name, rep});
+    }
     return true;
+  };
+
+  if (!PackDict("assetInfo", meta.assetInfo) ||
+      !PackDict("customData", meta.customData) ||
+      !PackDict("clips", meta.clips) ||
+      !PackDict("sdrMetadata", meta.sdrMetadata)) {
+    return false;
+  }
+
+  if (meta.doc) {
+    fields->push_back({"documentation", crate_.PackString(meta.doc.value().value)});
+  }
+
+  if (meta.comment) {
+    fields->push_back({"comment", crate_.PackString(meta.comment.value().value)});
+  }
+
+  if (meta.sceneName) {
+    fields->push_back({"sceneName", crate_.PackString(meta.sceneName.value())});
+  }
+
+  if (meta.displayName) {
+    fields->push_back(
+        {"displayName", crate_.PackString(meta.displayName.value())});
+  }
+
+  if (meta.apiSchemas) {
+    std::vector<value::token> names;
+    for (const auto &item : meta.apiSchemas.value().names) {
+      std::string name = to_string(std::get<0>(item));
+      if (std::get<1>(item).size()) {
+        // multiple-apply schema. e.g. `CollectionAPI:lightLink`
+        name += ":" + std::get<1>(item);
+      }
+      names.push_back(value::token(name));
+    }
+    if (auto lop = ToListOp(meta.apiSchemas.value().listOpQual, names)) {
+      if (!crate_.PackTokenListOp(lop.value(), &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
+      }
+      fields->push_back({"apiSchemas", rep});
+    }
+  }
+
+  if (meta.references) {
+    if (auto lop = ToListOp(std::get<0>(meta.references.value()),
+                            std::get<1>(meta.references.value()))) {
+      if (!crate_.PackReferenceListOp(lop.value(), &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
+      }
+      fields->push_back({"references", rep});
+    }
   }
 
-  bool WriteTokens() {
-    // Build single string separated by '\0', then compress it with lz4
-    std::ostringstream oss;
+  if (meta.payload) {
+    if (auto lop = ToListOp(std::get<0>(meta.payload.value()),
+                            std::get<1>(meta.payload.value()))) {
+      if (!crate_.PackPayloadListOp(lop.value(), &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
+      }
+      fields->push_back({"payload", rep});
+    }
+  }
 
-    auto tokens = packer_.GetTokens();
+  auto PackPaths =
+      [&](const std::string &name,
+          const nonstd::optional<std::pair<ListEditQual, std::vector<Path>>>
+              &paths) -> bool {
+    if (paths) {
+      if (auto lop = ToListOp(std::get<0>(paths.value()),
+                              std::get<1>(paths.value()))) {
+        if (!crate_.PackPathListOp(lop.value(), &rep)) {
+          PUSH_ERROR_AND_RETURN(crate_.GetError());
+        }
+        fields->push_back({name, rep});
+      }
+    }
+    return true;
+  };
 
-    for (size_t i = 0; i < tokens.size(); i++) {
-      oss << tokens[i].str();
+  // `inherits` is stored as `inheritPaths` in Crate.
+  if (!PackPaths("inheritPaths", meta.inherits ? meta.inherits : meta.inheritPaths) ||
+      !PackPaths("specializes", meta.specializes)) {
+    return false;
+  }
 
-      if (i != (tokens.size() - 1)) {
-        oss.put('\0');  // separator
+  if (meta.variantSets) {
+    if (auto lop = ToListOp(std::get<0>(meta.variantSets.value()),
+                            std::get<1>(meta.variantSets.value()))) {
+      if (!crate_.PackStringListOp(lop.value(), &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
       }
+      fields->push_back({"variantSetNames", rep});
     }
-    // Last string does not terminated with `\0'
+  }
 
-    // compress
-    size_t input_bytes = oss.str().size();
-    if (input_bytes == 0) {
-      PUSH_ERROR("Invalid data size.");
+  if (meta.variants) {
+    if (!crate_.PackVariantSelectionMap(meta.variants.value(), &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields->push_back({"variantSelection", rep});
+  }
+
+  for (const auto &item : meta.unregisteredMetas) {
+    fields->push_back({item.first, crate_.PackString(item.second)});
+  }
+
+  for (const auto &item : meta.meta) {
+    if (!PackMetaValue(item.first, item.second.get_raw_value(), fields)) {
       return false;
     }
+  }
 
-    std::vector<char> buf;
-    buf.resize(LZ4Compression::GetCompressedBufferSize(input_bytes));
+  return true;
+}
 
-    std::string err;
-    size_t n = LZ4Compression::CompressToBuffer(oss.str().data(), buf.data(),
-                                                input_bytes, &err);
+bool Writer::PackAttrMetas(const AttrMeta &meta,
+                           FieldValueRepPairVector *fields) {
+  crate::ValueRep rep;
 
-    (void)n;
+  if (meta.interpolation) {
+    fields->push_back(
+        {"interpolation",
+         crate_.PackToken(value::token(to_string(meta.interpolation.value())))});
+  }
 
-    if (!err.empty()) {
-      PUSH_ERROR(err);
+  if (meta.elementSize) {
+    if (!PackMetaValue("elementSize",
+                       value::Value(int(meta.elementSize.value())), fields)) {
       return false;
     }
+  }
 
-    return true;
+  if (meta.hidden) {
+    fields->push_back({"hidden", crate_.PackBool(meta.hidden.value())});
   }
 
-  bool WriteStrings() { return false; }
+  if (meta.comment) {
+    fields->push_back({"comment", crate_.PackString(meta.comment.value().value)});
+  }
 
-  bool WriteFields() { return false; }
+  if (meta.displayName) {
+    fields->push_back(
+        {"displayName", crate_.PackString(meta.displayName.value())});
+  }
 
-  bool WriteFieldSets() { return false; }
+  if (meta.weight) {
+    // pxrUSD uses float type.
+    if (!PackMetaValue("weight", value::Value(float(meta.weight.value())),
+                       fields)) {
+      return false;
+    }
+  }
 
-  bool WritePaths() { return false; }
+  if (meta.customData) {
+    if (!crate_.PackDictionary(meta.customData.value(), &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields->push_back({"customData", rep});
+  }
 
-  bool WriteSpecs() { return false; }
+  if (meta.sdrMetadata) {
+    if (!crate_.PackDictionary(meta.sdrMetadata.value(), &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields->push_back({"sdrMetadata", rep});
+  }
 
-  bool WriteTOC() {
-    uint64_t num_sections = toc_.sections.size();
+  if (meta.connectability) {
+    fields->push_back(
+        {"connectability", crate_.PackToken(meta.connectability.value())});
+  }
 
-    DCOUT("# of sections = " << std::to_string(num_sections));
+  if (meta.outputName) {
+    fields->push_back({"outputName", crate_.PackToken(meta.outputName.value())});
+  }
 
-    if (num_sections == 0) {
-      err_ += "Zero sections in TOC.\n";
+  if (meta.renderType) {
+    fields->push_back({"renderType", crate_.PackToken(meta.renderType.value())});
+  }
+
+  if (meta.bindMaterialAs) {
+    fields->push_back(
+        {"bindMaterialAs", crate_.PackToken(meta.bindMaterialAs.value())});
+  }
+
+  for (const auto &item : meta.meta) {
+    if (!PackMetaValue(item.first, item.second.get_raw_value(), fields)) {
       return false;
     }
+  }
 
-    // # of sections
-    oss_.write(reinterpret_cast<const char *>(&num_sections), 8);
+  if (meta.stringData.size()) {
+    PUSH_WARN("String-only Property metadatum is not written to USDC.");
+  }
 
-    return true;
+  return true;
+}
+
+bool Writer::WriteProperty(const Path &path, const Property &prop) {
+  FieldValueRepPairVector fields;
+  crate::ValueRep rep;
+
+  if (prop.has_custom()) {
+    fields.push_back({"custom", crate_.PackBool(true)});
   }
 
-  bool Write() {
-    //
-    //  - TOC
-    //  - Tokens
-    //  - Strings
-    //  - Fields
-    //  - FieldSets
-    //  - Paths
-    //  - Specs
-    //
+  if (prop.is_relationship()) {
+    const Relationship &rel = prop.get_relationship();
 
-    if (!WriteTokens()) {
-      PUSH_ERROR("Failed to write Tokens.");
-      return false;
+    if (rel.is_varying_authored()) {
+      fields.push_back({"variability", crate_.PackVariability(Variability::Varying)});
     }
 
-    if (!WriteStrings()) {
-      PUSH_ERROR("Failed to write Strings.");
-      return false;
+    std::vector<Path> targets;
+    if (rel.is_path()) {
+      targets.push_back(rel.targetPath);
+    } else if (rel.is_pathvector()) {
+      targets = rel.targetPathVector;
+    }
+
+    if (rel.is_blocked()) {
+      // `rel a = None` is represented as explicit empty targets.
+      ListOp<Path> lop;
+      lop.ClearAndMakeExplicit();
+      if (!crate_.PackPathListOp(lop, &rep)) {
+        PUSH_ERROR_AND_RETURN(crate_.GetError());
+      }
+      fields.push_back({"targetPaths", rep});
+    } else if (targets.size()) {
+      ListEditQual qual = rel.get_listedit_qual();
+      if (qual == ListEditQual::ResetToExplicit) {
+        qual = prop.get_listedit_qual();
+      }
+
+      if (auto lop = ToListOp(qual, targets)) {
+        if (!crate_.PackPathListOp(lop.value(), &rep)) {
+          PUSH_ERROR_AND_RETURN(crate_.GetError());
+        }
+        fields.push_back({"targetPaths", rep});
+
+        if (!crate_.PackPathVector(targets, &rep)) {
+          PUSH_ERROR_AND_RETURN(crate_.GetError());
+        }
+        fields.push_back({"targetChildren", rep});
+      }
     }
 
-    if (!WriteFields()) {
-      PUSH_ERROR("Failed to write Fields.");
+    if (!PackAttrMetas(rel.metas(), &fields)) {
       return false;
     }
 
-    if (!WriteFieldSets()) {
-      PUSH_ERROR("Failed to write FieldSets.");
+    if (!crate_.AddSpec(path, SpecType::Relationship, fields)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+
+    return true;
+  }
+
+  const Attribute &attr = prop.get_attribute();
+
+  std::string typeName = attr.type_name();
+  if (typeName.empty()) {
+    PUSH_ERROR_AND_RETURN(
+        fmt::format("typeName is empty for Attribute `{}`.", path.full_path_name()));
+  }
+  fields.push_back({"typeName", crate_.PackToken(value::token(typeName))});
+
+  if (attr.variability() == Variability::Uniform) {
+    fields.push_back({"variability", crate_.PackVariability(Variability::Uniform)});
+  }
+
+  const primvar::PrimVar &var = attr.get_var();
+
+  if (var.has_default()) {
+    if (var.is_blocked()) {
+      fields.push_back({"default", crate_.PackValueBlock()});
+    } else {
+      if (!crate_.PackValue(var.value_raw(), &rep)) {
+        PUSH_ERROR_AND_RETURN(fmt::format("Failed to encode value of `{}`: {}",
+                                          path.full_path_name(),
+                                          crate_.GetError()));
+      }
+      fields.push_back({"default", rep});
+    }
+  }
+
+  if (var.has_timesamples()) {
+    if (!crate_.PackTimeSamples(var.ts_raw(), &rep)) {
+      PUSH_ERROR_AND_RETURN(fmt::format(
+          "Failed to encode timeSamples of `{}`: {}", path.full_path_name(),
+          crate_.GetError()));
+    }
+    fields.push_back({"timeSamples", rep});
+  }
+
+  if (attr.has_connections()) {
+    ListOp<Path> lop;
+    lop.ClearAndMakeExplicit();
+    lop.SetExplicitItems(attr.connections());
+    if (!crate_.PackPathListOp(lop, &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields.push_back({"connectionPaths", rep});
+
+    if (!crate_.PackPathVector(attr.connections(), &rep)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+    fields.push_back({"connectionChildren", rep});
+  }
+
+  if (!PackAttrMetas(attr.metas(), &fields)) {
+    return false;
+  }
+
+  if (!crate_.AddSpec(path, SpecType::Attribute, fields)) {
+    PUSH_ERROR_AND_RETURN(crate_.GetError());
+  }
+
+  return true;
+}
+
+bool Writer::WritePrimSpec(const std::string &prim_path, const PrimSpec &ps,
+                           bool is_variant, uint32_t depth) {
+  if (depth > 1024 * 128) {
+    PUSH_ERROR_AND_RETURN("PrimSpec hierarchy is too deep.");
+  }
+
+  FieldValueRepPairVector fields;
+
+  if (!is_variant) {
+    fields.push_back({"specifier", crate_.PackSpecifier(ps.specifier())});
+  }
+
+  if (ps.typeName().size()) {
+    fields.push_back({"typeName", crate_.PackToken(value::token(ps.typeName()))});
+  }
+
+  if (!PackPrimMetas(ps.metas(), &fields)) {
+    return false;
+  }
+
+  std::vector<std::string> propNames = PropertyNames(ps);
+  if (propNames.size()) {
+    std::vector<value::token> toks;
+    for (const auto &name : propNames) {
+      toks.push_back(value::token(name));
+    }
+    if (!PackTokens("properties", toks, &fields)) {
       return false;
     }
+  }
 
-    if (!WritePaths()) {
-      PUSH_ERROR("Failed to write Paths.");
+  const std::vector<const PrimSpec *> children = ChildPrimSpecs(ps);
+  if (children.size()) {
+    std::vector<value::token> toks;
+    for (const auto *child : children) {
+      toks.push_back(value::token(child->name()));
+    }
+    if (!PackTokens("primChildren", toks, &fields)) {
       return false;
     }
+  }
 
-    if (!WriteSpecs()) {
-      PUSH_ERROR("Failed to write Specs.");
+  if (ps.variantSets().size()) {
+    std::vector<value::token> toks;
+    for (const auto &vs : ps.variantSets()) {
+      toks.push_back(value::token(vs.first));
+    }
+    if (!PackTokens("variantSetChildren", toks, &fields)) {
       return false;
     }
+  }
 
-    // TODO(syoyo): Add feature to support writing unknown section(custom user
-    // data)
-    // if (!WriteUnknownSections()) {
-    //  PUSH_ERROR("Failed to write custom sections.");
-    //  return false;
-    //}
+  if (!crate_.AddSpec(Path(prim_path, ""),
+                      is_variant ? SpecType::Variant : SpecType::Prim, fields)) {
+    PUSH_ERROR_AND_RETURN(crate_.GetError());
+  }
 
-    const uint64_t toc_offset = static_cast<uint64_t>(oss_.tellp());
-    if (!WriteTOC()) {
-      PUSH_ERROR("Failed to write TOC.");
+  for (const auto &name : propNames) {
+    if (!WriteProperty(Path(prim_path, name), ps.props().at(name))) {
       return false;
     }
+  }
 
-    // write header
-    oss_.seekp(0, std::ios::beg);
-    if (!WriteHeader(toc_offset)) {
-      PUSH_ERROR("Failed to write Header.");
+  for (const auto &vs : ps.variantSets()) {
+    FieldValueRepPairVector vsfields;
+
+    std::vector<value::token> variantChildren;
+    for (const auto &variant : vs.second.variantSet) {
+      variantChildren.push_back(value::token(variant.first));
+    }
+    if (!PackTokens("variantChildren", variantChildren, &vsfields)) {
       return false;
     }
 
-    return true;
+    if (!crate_.AddSpec(Path(prim_path + VariantElement(vs.first, ""), ""),
+                        SpecType::VariantSet, vsfields)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+
+    for (const auto &variant : vs.second.variantSet) {
+      if (!WritePrimSpec(prim_path + VariantElement(vs.first, variant.first),
+                         variant.second, /* is_variant */ true, depth + 1)) {
+        return false;
+      }
+    }
   }
 
-  // Get serialized USDC binary data
-  bool GetOutput(std::vector<uint8_t> *output) {
-    if (!err_.empty()) {
+  for (const auto *child : children) {
+    if (!WritePrimSpec(prim_path + "/" + child->name(), *child,
+                       /* is_variant */ false, depth + 1)) {
       return false;
     }
+  }
 
-    (void)output;
+  return true;
+}
 
-    // TODO
-    return false;
-  }
+bool Writer::Write(std::vector<uint8_t> *output) {
+  std::vector<const PrimSpec *> rootPrims = RootPrimSpecs();
 
- private:
-  Writer() = delete;
-  Writer(const Writer &) = delete;
+  for (const auto *ps : rootPrims) {
+    if (!RegisterPaths("/" + ps->name(), *ps, 0)) {
+      PUSH_ERROR_AND_RETURN(crate_.GetError());
+    }
+  }
 
-  TableOfContents toc_;
+  if (!WritePseudoRoot(rootPrims)) {
+    return false;
+  }
 
-  Packer packer_;
+  for (const auto *ps : rootPrims) {
+    if (!WritePrimSpec("/" + ps->name(), *ps, /* is_variant */ false, 0)) {
+      return false;
+    }
+  }
 
-  //
-  // Serialized data
-  //
-  std::ostringstream oss_;
+  if (!crate_.Write(output)) {
+    PUSH_ERROR_AND_RETURN(crate_.GetError());
+  }
 
-  std::string err_;
-  std::string warn_;
-};
+  if (crate_.GetWarning().size()) {
+    PUSH_WARN(crate_.GetWarning());
+  }
 
-}  // namespace
+  return true;
+}
 
-bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
-                      std::string *warn, std::string *err) {
+bool WriteToFile(const std::string &filename,
+                 const std::vector<uint8_t> &output, std::string *err) {
 #ifdef __ANDROID__
   (void)filename;
-  (void)stage;
-  (void)warn;
+  (void)output;
 
   if (err) {
     (*err) += "Saving USDC to a file is not supported for Android platform(at the moment).\n";
   }
   return false;
 #else
-
-  std::vector<uint8_t> output;
-
-  if (!SaveAsUSDCToMemory(stage, &output, warn, err)) {
-    return false;
-  }
-
 #ifdef _WIN32
 #if defined(_MSC_VER) || defined(__GLIBCXX__) || defined(__clang__)
   FILE *fp = nullptr;
@@ -531,6 +942,8 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
 #endif
 
   size_t n = fwrite(output.data(), /* size */ 1, /* count */ output.size(), fp);
+  fclose(fp);
+
   if (n < output.size()) {
     // TODO: Retry writing data when n < output.size()
 
@@ -544,19 +957,44 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
 #endif
 }
 
-bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
+}  // namespace
+
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
+                      std::string *warn, std::string *err) {
+  std::vector<uint8_t> output;
+
+  if (!SaveAsUSDCToMemory(layer, &output, warn, err)) {
+    return false;
+  }
+
+  return WriteToFile(filename, output, err);
+}
+
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
                         std::string *warn, std::string *err) {
-  (void)warn;
-  (void)output;
+  if (!output) {
+    if (err) {
+      (*err) += "`output` argument is nullptr.\n";
+    }
+    return false;
+  }
 
-  // TODO
-  Writer writer(stage);
+  Writer writer(layer);
 
-  if (err) {
-    (*err) += "USDC writer is not yet implemented.\n";
+  bool ret = writer.Write(output);
+
+  if (warn && writer.Warning().size()) {
+    (*warn) += writer.Warning();
   }
 
-  return false;
+  if (!ret) {
+    if (err) {
+      (*err) += writer.Error();
+    }
+    return false;
+  }
+
+  return true;
 }
 
 }  // namespace usdc
@@ -567,10 +1005,10 @@ bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
 namespace tinyusdz {
 namespace usdc {
 
-bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
                       std::string *warn, std::string *err) {
   (void)filename;
-  (void)stage;
+  (void)layer;
   (void)warn;
 
   if (err) {
@@ -580,9 +1018,9 @@ bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
   return false;
 }
 
-bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
                         std::string *warn, std::string *err) {
-  (void)stage;
+  (void)layer;
   (void)output;
   (void)warn;
 
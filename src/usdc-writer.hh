@@ -9,29 +9,29 @@ namespace tinyusdz {
 namespace usdc {
 
 ///
-/// Save scene as USDC(binary) to a file
+/// Save Layer as USDC(binary) to a file
 ///
 /// @param[in] filename USDC filename
-/// @param[in] stage Stage
+/// @param[in] layer Layer
 /// @param[out] warn Warning message
 /// @param[out] err Error message
 ///
 /// @return true upon success.
 ///
-bool SaveAsUSDCToFile(const std::string &filename, const Stage &stage,
+bool SaveAsUSDCToFile(const std::string &filename, const Layer &layer,
                       std::string *warn, std::string *err);
 
 ///
-/// Save scene as USDC(binary) to a memory
+/// Save Layer as USDC(binary) to a memory
 ///
-/// @param[in] stage Stage
+/// @param[in] layer Layer
 /// @param[out] output Binary data
 /// @param[out] warn Warning message
 /// @param[out] err Error message
 ///
 /// @return true upon success.
 ///
-bool SaveAsUSDCToMemory(const Stage &stage, std::vector<uint8_t> *output,
+bool SaveAsUSDCToMemory(const Layer &layer, std::vector<uint8_t> *output,
                         std::string *warn, std::string *err);
 
 }  // namespace usdc
@@ -0,0 +1,615 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// USDZ(uncompressed ZIP) writer
+//
+// https://openusd.org/release/spec_usdz.html
+// https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+//
+
+#include "usdz-writer.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "io-util.hh"
+#include "str-util.hh"
+#include "usda-writer.hh"
+
+namespace tinyusdz {
+namespace usdz {
+
+namespace {
+
+constexpr uint32_t kLocalFileHeaderSignature = 0x04034b50;
+constexpr uint32_t kCentralDirectoryHeaderSignature = 0x02014b50;
+constexpr uint32_t kEndOfCentralDirectorySignature = 0x06054b50;
+constexpr uint32_t kZIP64EndOfCentralDirectorySignature = 0x06064b50;
+constexpr uint32_t kZIP64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+
+constexpr uint16_t kZIP64ExtraFieldId = 0x0001;
+// Same id as pxrUSD uses for alignment padding.
+constexpr uint16_t kPaddingExtraFieldId = 0x1986;
+
+constexpr size_t kLocalFileHeaderSize = 30;
+constexpr size_t kZIP64LocalExtraFieldSize = 4 + 16;  // uncompressed + compressed
+
+constexpr uint16_t kVersion = 20;       // 2.0
+constexpr uint16_t kVersionZIP64 = 45;  // 4.5
+
+// 1980/01/01 00:00:00 in MS-DOS format, so that the output is deterministic.
+constexpr uint16_t kDOSTime = 0;
+constexpr uint16_t kDOSDate = (1 << 5) | 1;
+
+constexpr uint64_t kMaxUInt32 = 0xffffffff;
+constexpr uint64_t kMaxUInt16 = 0xffff;
+
+constexpr size_t kDataAlignment = 64;
+
+void Put16(std::vector<uint8_t> *dst, uint64_t v) {
+  dst->push_back(uint8_t(v & 0xff));
+  dst->push_back(uint8_t((v >> 8) & 0xff));
+}
+
+void Put32(std::vector<uint8_t> *dst, uint64_t v) {
+  Put16(dst, v & 0xffff);
+  Put16(dst, (v >> 16) & 0xffff);
+}
+
+void Put64(std::vector<uint8_t> *dst, uint64_t v) {
+  Put32(dst, v & 0xffffffff);
+  Put32(dst, v >> 32);
+}
+
+///
+/// Slicing-by-8 CRC32 tables.
+///
+struct CRC32Table {
+  uint32_t t[8][256];
+
+  CRC32Table() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? (0xedb88320u ^ (c >> 1)) : (c >> 1);
+      }
+      t[0][i] = c;
+    }
+
+    for (uint32_t i = 0; i < 256; i++) {
+      for (size_t s = 1; s < 8; s++) {
+        t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xff];
+      }
+    }
+  }
+};
+
+const CRC32Table &GetCRC32Table() {
+  static const CRC32Table table;
+  return table;
+}
+
+bool Seek(FILE *fp, uint64_t offset) {
+#if defined(_WIN32)
+  return _fseeki64(fp, int64_t(offset), SEEK_SET) == 0;
+#else
+  return fseeko(fp, off_t(offset), SEEK_SET) == 0;
+#endif
+}
+
+///
+/// Build local file header.
+///
+/// When `reserve_zip64` is true, space for ZIP64 extended information is
+/// always reserved(as a padding field when ZIP64 is not required), so that the
+/// header can be rewritten in place once the entry size is known.
+///
+void BuildLocalHeader(const std::string &name, uint64_t local_header_offset,
+                      uint32_t crc32, uint64_t size, bool reserve_zip64,
+                      std::vector<uint8_t> *dst) {
+  const bool zip64 = (size >= kMaxUInt32);
+  const bool zip64_field = zip64 || reserve_zip64;
+
+  // Padding so that the data starts at a 64 bytes boundary.
+  const uint64_t base = local_header_offset + kLocalFileHeaderSize +
+                        name.size() +
+                        (zip64_field ? kZIP64LocalExtraFieldSize : 0);
+  size_t padding = size_t((kDataAlignment - (base % kDataAlignment)) %
+                          kDataAlignment);
+  if ((padding > 0) && (padding < 4)) {
+    // No room for the extra field header.
+    padding += kDataAlignment;
+  }
+
+  const size_t extra_len =
+      (zip64_field ? kZIP64LocalExtraFieldSize : 0) + padding;
+
+  dst->clear();
+  Put32(dst, kLocalFileHeaderSignature);
+  Put16(dst, zip64 ? kVersionZIP64 : kVersion);
+  Put16(dst, 0);  // flags
+  Put16(dst, 0);  // compression: stored
+  Put16(dst, kDOSTime);
+  Put16(dst, kDOSDate);
+  Put32(dst, crc32);
+  Put32(dst, zip64 ? kMaxUInt32 : size);  // compressed size
+  Put32(dst, zip64 ? kMaxUInt32 : size);  // uncompressed size
+  Put16(dst, name.size());
+  Put16(dst, extra_len);
+  dst->insert(dst->end(), name.begin(), name.end());
+
+  if (zip64_field) {
+    Put16(dst, zip64 ? kZIP64ExtraFieldId : kPaddingExtraFieldId);
+    Put16(dst, 16);
+    Put64(dst, zip64 ? size : 0);
+    Put64(dst, zip64 ? size : 0);
+  }
+
+  if (padding > 0) {
+    Put16(dst, kPaddingExtraFieldId);
+    Put16(dst, padding - 4);
+    dst->resize(dst->size() + padding - 4, 0);
+  }
+}
+
+bool ForwardToUSDZWriter(const char *data, size_t size, void *userdata) {
+  USDZWriter *writer = reinterpret_cast<USDZWriter *>(userdata);
+  return writer->WriteFileData(reinterpret_cast<const uint8_t *>(data), size);
+}
+
+bool WriteUSDZ(USDZWriter &writer, const Stage &stage,
+               const std::vector<USDZAssetEntry> &assets, std::string *warn,
+               std::string *err, const USDZWriterConfig &config) {
+  if (to_lower(io::GetFileExtension(config.root_layer_name)) != "usda") {
+    if (err) {
+      (*err) += "Root layer name must have `.usda` extension: " +
+                config.root_layer_name + "\n";
+    }
+    return false;
+  }
+
+  // The root layer must be the first entry.
+  if (!writer.BeginFile(config.root_layer_name)) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  if (!usda::SaveAsUSDA(ForwardToUSDZWriter, reinterpret_cast<void *>(&writer),
+                        stage, warn, err)) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  if (!writer.EndFile()) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  for (const auto &asset : assets) {
+    if (!writer.AddFile(asset.name, asset.data, asset.size)) {
+      if (err) {
+        (*err) += writer.GetError();
+      }
+      return false;
+    }
+  }
+
+  if (!writer.Close()) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+uint32_t ComputeCRC32(const uint8_t *data, size_t size, uint32_t crc) {
+  const CRC32Table &table = GetCRC32Table();
+
+  crc = ~crc;
+
+  while (size >= 8) {
+    uint32_t lo;
+    uint32_t hi;
+    memcpy(&lo, data, 4);  // assume little endian
+    memcpy(&hi, data + 4, 4);
+    lo ^= crc;
+
+    crc = table.t[7][lo & 0xff] ^ table.t[6][(lo >> 8) & 0xff] ^
+          table.t[5][(lo >> 16) & 0xff] ^ table.t[4][lo >> 24] ^
+          table.t[3][hi & 0xff] ^ table.t[2][(hi >> 8) & 0xff] ^
+          table.t[1][(hi >> 16) & 0xff] ^ table.t[0][hi >> 24];
+
+    data += 8;
+    size -= 8;
+  }
+
+  while (size--) {
+    crc = table.t[0][(crc ^ (*data++)) & 0xff] ^ (crc >> 8);
+  }
+
+  return ~crc;
+}
+
+USDZWriter::~USDZWriter() {
+  if (_fp) {
+    fclose(_fp);
+  }
+}
+
+bool USDZWriter::Open(const std::string &filename) {
+  if (_fp || _callback) {
+    PushError("USDZWriter is already opened.\n");
+    return false;
+  }
+
+#if defined(_WIN32)
+  _fp = _wfopen(io::UTF8ToWchar(filename).c_str(), L"wb");
+#else
+  _fp = fopen(filename.c_str(), "wb");
+#endif
+
+  if (!_fp) {
+    PushError("File open error for writing : " + filename + "\n");
+    return false;
+  }
+
+  return true;
+}
+
+bool USDZWriter::Open(USDZWriteCallback callback, void *userdata) {
+  if (_fp || _callback) {
+    PushError("USDZWriter is already opened.\n");
+    return false;
+  }
+
+  if (!callback) {
+    PushError("`callback` is nullptr.\n");
+    return false;
+  }
+
+  _callback = callback;
+  _userdata = userdata;
+
+  return true;
+}
+
+bool USDZWriter::Write(const uint8_t *data, size_t size) {
+  if (_failed) {
+    return false;
+  }
+
+  if (size == 0) {
+    return true;
+  }
+
+  bool ok;
+  if (_fp) {
+    ok = (fwrite(data, 1, size, _fp) == size);
+  } else {
+    ok = _callback(data, size, _userdata);
+  }
+
+  if (!ok) {
+    _failed = true;
+    PushError("Failed to write USDZ data.\n");
+    return false;
+  }
+
+  _offset += size;
+  return true;
+}
+
+bool USDZWriter::ValidateName(const std::string &name) {
+  if (!_fp && !_callback) {
+    PushError("USDZWriter is not opened.\n");
+    return false;
+  }
+
+  if (_in_file) {
+    PushError("Previous entry is not finished with `EndFile`.\n");
+    return false;
+  }
+
+  if (name.empty() || (name.size() > kMaxUInt16)) {
+    PushError("Invalid entry name length.\n");
+    return false;
+  }
+
+  if ((name[0] == '/') || startsWith(name, "./") ||
+      (name.find('\\') != std::string::npos)) {
+    PushError("Entry name must be a relative path with `/` separator: " +
+              name + "\n");
+    return false;
+  }
+
+  if (_names.count(name)) {
+    PushError("Duplicated entry name: " + name + "\n");
+    return false;
+  }
+
+  return true;
+}
+
+bool USDZWriter::WriteLocalHeader(const Entry &entry, bool reserve_zip64) {
+  std::vector<uint8_t> header;
+  BuildLocalHeader(entry.name, entry.local_header_offset, entry.crc32,
+                   entry.size, reserve_zip64, &header);
+  return Write(header.data(), header.size());
+}
+
+bool USDZWriter::UpdateLocalHeader(const Entry &entry) {
+  std::vector<uint8_t> header;
+  BuildLocalHeader(entry.name, entry.local_header_offset, entry.crc32,
+                   entry.size, /* reserve_zip64 */ true, &header);
+
+  if (!Seek(_fp, entry.local_header_offset) ||
+      (fwrite(header.data(), 1, header.size(), _fp) != header.size()) ||
+      !Seek(_fp, _offset)) {
+    _failed = true;
+    PushError("Failed to update local file header: " + entry.name + "\n");
+    return false;
+  }
+
+  return true;
+}
+
+bool USDZWriter::BeginFile(const std::string &name) {
+  if (!ValidateName(name)) {
+    return false;
+  }
+
+  _names.insert(name);
+
+  _current = Entry();
+  _current.name = name;
+  _current.local_header_offset = _offset;
+
+  if (_fp) {
+    // Write data as it comes, then update the header in `EndFile`.
+    if (!WriteLocalHeader(_current, /* reserve_zip64 */ true)) {
+      return false;
+    }
+  }
+
+  _in_file = true;
+
+  return true;
+}
+
+bool USDZWriter::WriteFileData(const uint8_t *data, size_t size) {
+  if (!_in_file) {
+    PushError("`BeginFile` is not called.\n");
+    return false;
+  }
+
+  if (_fp) {
+    _current.crc32 = ComputeCRC32(data, size, _current.crc32);
+    _current.size += size;
+    return Write(data, size);
+  }
+
+  _pending.insert(_pending.end(), data, data + size);
+  return true;
+}
+
+bool USDZWriter::EndFile() {
+  if (!_in_file) {
+    PushError("`BeginFile` is not called.\n");
+    return false;
+  }
+
+  _in_file = false;
+
+  if (_fp) {
+    if (!UpdateLocalHeader(_current)) {
+      return false;
+    }
+    _entries.push_back(_current);
+    return true;
+  }
+
+  std::vector<uint8_t> data;
+  data.swap(_pending);
+
+  return WriteEntry(_current, data.data(), data.size());
+}
+
+bool USDZWriter::WriteEntry(Entry &entry, const uint8_t *data, size_t size) {
+  entry.crc32 = ComputeCRC32(data, size);
+  entry.size = size;
+
+  if (!WriteLocalHeader(entry, /* reserve_zip64 */ false)) {
+    return false;
+  }
+
+  if (!Write(data, size)) {
+    return false;
+  }
+
+  _entries.push_back(entry);
+
+  return true;
+}
+
+bool USDZWriter::AddFile(const std::string &name, const uint8_t *data,
+                         size_t size) {
+  if (!data && (size > 0)) {
+    PushError("`data` is nullptr: " + name + "\n");
+    return false;
+  }
+
+  if (_fp) {
+    return BeginFile(name) && WriteFileData(data, size) && EndFile();
+  }
+
+  if (!ValidateName(name)) {
+    return false;
+  }
+
+  _names.insert(name);
+
+  Entry entry;
+  entry.name = name;
+  entry.local_header_offset = _offset;
+
+  return WriteEntry(entry, data, size);
+}
+
+bool USDZWriter::WriteCentralDirectory() {
+  const uint64_t cd_offset = _offset;
+
+  std::vector<uint8_t> buf;
+  for (const auto &entry : _entries) {
+    const bool zip64_size = (entry.size >= kMaxUInt32);
+    const bool zip64_offset = (entry.local_header_offset >= kMaxUInt32);
+
+    std::vector<uint8_t> extra;
+    if (zip64_size || zip64_offset) {
+      const size_t n = (zip64_size ? 16 : 0) + (zip64_offset ? 8 : 0);
+      Put16(&extra, kZIP64ExtraFieldId);
+      Put16(&extra, n);
+      if (zip64_size) {
+        Put64(&extra, entry.size);  // uncompressed
+        Put64(&extra, entry.size);  // compressed
+      }
+      if (zip64_offset) {
+        Put64(&extra, entry.local_header_offset);
+      }
+    }
+
+    const uint16_t version =
+        (zip64_size || zip64_offset) ? kVersionZIP64 : kVersion;
+
+    buf.clear();
+    Put32(&buf, kCentralDirectoryHeaderSignature);
+    Put16(&buf, version);  // version made by(MS-DOS)
+    Put16(&buf, version);  // version needed
+    Put16(&buf, 0);        // flags
+    Put16(&buf, 0);        // compression: stored
+    Put16(&buf, kDOSTime);
+    Put16(&buf, kDOSDate);
+    Put32(&buf, entry.crc32);
+    Put32(&buf, zip64_size ? kMaxUInt32 : entry.size);
+    Put32(&buf, zip64_size ? kMaxUInt32 : entry.size);
+    Put16(&buf, entry.name.size());
+    Put16(&buf, extra.size());
+    Put16(&buf, 0);  // comment
+    Put16(&buf, 0);  // disk number
+    Put16(&buf, 0);  // internal attributes
+    Put32(&buf, 0);  // external attributes
+    Put32(&buf, zip64_offset ? kMaxUInt32 : entry.local_header_offset);
+    buf.insert(buf.end(), entry.name.begin(), entry.name.end());
+    buf.insert(buf.end(), extra.begin(), extra.end());
+
+    if (!Write(buf.data(), buf.size())) {
+      return false;
+    }
+  }
+
+  const uint64_t cd_size = _offset - cd_offset;
+  const uint64_t num_entries = _entries.size();
+
+  const bool zip64 = (num_entries >= kMaxUInt16) ||
+                     (cd_size >= kMaxUInt32) || (cd_offset >= kMaxUInt32);
+
+  buf.clear();
+  if (zip64) {
+    const uint64_t eocd64_offset = _offset;
+
+    Put32(&buf, kZIP64EndOfCentralDirectorySignature);
+    Put64(&buf, 44);  // size of the remaining record
+    Put16(&buf, kVersionZIP64);
+    Put16(&buf, kVersionZIP64);
+    Put32(&buf, 0);  // disk number
+    Put32(&buf, 0);  // disk number with the central directory
+    Put64(&buf, num_entries);
+    Put64(&buf, num_entries);
+    Put64(&buf, cd_size);
+    Put64(&buf, cd_offset);
+
+    Put32(&buf, kZIP64EndOfCentralDirectoryLocatorSignature);
+    Put32(&buf, 0);  // disk number with ZIP64 EOCD
+    Put64(&buf, eocd64_offset);
+    Put32(&buf, 1);  // total number of disks
+  }
+
+  Put32(&buf, kEndOfCentralDirectorySignature);
+  Put16(&buf, 0);  // disk number
+  Put16(&buf, 0);  // disk number with the central directory
+  Put16(&buf, (std::min)(num_entries, kMaxUInt16));
+  Put16(&buf, (std::min)(num_entries, kMaxUInt16));
+  Put32(&buf, (std::min)(cd_size, kMaxUInt32));
+  Put32(&buf, (std::min)(cd_offset, kMaxUInt32));
+  Put16(&buf, 0);  // comment length
+
+  return Write(buf.data(), buf.size());
+}
+
+bool USDZWriter::Close() {
+  if (!_fp && !_callback) {
+    PushError("USDZWriter is not opened.\n");
+    return false;
+  }
+
+  if (_in_file) {
+    PushError("Last entry is not finished with `EndFile`.\n");
+    return false;
+  }
+
+  bool ret = WriteCentralDirectory();
+
+  if (_fp) {
+    if (fclose(_fp) != 0) {
+      PushError("Failed to close USDZ file.\n");
+      ret = false;
+    }
+    _fp = nullptr;
+  }
+  _callback = nullptr;
+  _userdata = nullptr;
+
+  return ret;
+}
+
+bool SaveAsUSDZ(const std::string &filename, const Stage &stage,
+                const std::vector<USDZAssetEntry> &assets, std::string *warn,
+                std::string *err, const USDZWriterConfig &config) {
+  USDZWriter writer;
+  if (!writer.Open(filename)) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  return WriteUSDZ(writer, stage, assets, warn, err, config);
+}
+
+bool SaveAsUSDZ(USDZWriteCallback callback, void *userdata,
+                const Stage &stage, const std::vector<USDZAssetEntry> &assets,
+                std::string *warn, std::string *err,
+                const USDZWriterConfig &config) {
+  USDZWriter writer;
+  if (!writer.Open(callback, userdata)) {
+    if (err) {
+      (*err) += writer.GetError();
+    }
+    return false;
+  }
+
+  return WriteUSDZ(writer, stage, assets, warn, err, config);
+}
+
+}  // namespace usdz
+}  // namespace tinyusdz
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: Apache 2.0
+// Copyright 2024 - Present, Light Transport Entertainment Inc.
+//
+// USDZ(uncompressed ZIP) writer
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "tinyusdz.hh"
+
+namespace tinyusdz {
+namespace usdz {
+
+///
+/// Callback to receive a chunk of USDZ data.
+///
+/// @param[in] data Pointer to the chunk. Valid only during the callback.
+/// @param[in] size Byte size of the chunk.
+/// @param[in] userdata Userdata passed to `USDZWriter::Open`.
+///
+/// @return false to abort writing.
+///
+typedef bool (*USDZWriteCallback)(const uint8_t *data, size_t size,
+                                  void *userdata);
+
+///
+/// Compute CRC-32(ZIP, ISO-HDLC). Pass the previous result as `crc` to
+/// compute CRC incrementally.
+///
+uint32_t ComputeCRC32(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+///
+/// USDZ(ZIP) archive writer.
+///
+/// Entries are stored without compression and their data is aligned to 64
+/// bytes, as required by the USDZ spec. ZIP64 records are written when the
+/// archive exceeds 4GB.
+///
+/// Data is written in a single pass. When writing to a file, entry data is
+/// written to the file as it is given and CRC32 is computed incrementally,
+/// then the local file header is updated at the end of the entry, so memory
+/// usage does not depend on the entry size. When writing through the
+/// callback, the data written by `BeginFile`/`WriteFileData` is buffered in
+/// memory until `EndFile`, since the local file header precedes the data.
+///
+/// Usage:
+///
+///   USDZWriter writer;
+///   writer.Open("output.usdz");
+///   writer.AddFile("root.usda", usda_data, usda_size); // root layer first
+///   writer.AddFile("textures/a.png", png_data, png_size);
+///   writer.Close();
+///
+class USDZWriter {
+ public:
+  USDZWriter() = default;
+  ~USDZWriter();
+
+  USDZWriter(const USDZWriter &) = delete;
+  USDZWriter &operator=(const USDZWriter &) = delete;
+
+  ///
+  /// Open a file to write USDZ(UTF-8 filename).
+  ///
+  bool Open(const std::string &filename);
+
+  ///
+  /// Write USDZ through user callback.
+  ///
+  bool Open(USDZWriteCallback callback, void *userdata);
+
+  ///
+  /// Add an entry whose content is in memory.
+  ///
+  /// @param[in] name Path in the archive(e.g. "textures/a.png").
+  ///
+  bool AddFile(const std::string &name, const uint8_t *data, size_t size);
+
+  ///
+  /// Add an entry whose content is produced incrementally.
+  /// Call `WriteFileData` any number of times, then `EndFile`.
+  ///
+  bool BeginFile(const std::string &name);
+  bool WriteFileData(const uint8_t *data, size_t size);
+  bool EndFile();
+
+  ///
+  /// Write the central directory and close the output.
+  ///
+  bool Close();
+
+  const std::string &GetError() const { return _err; }
+  const std::string &GetWarning() const { return _warn; }
+
+ private:
+  struct Entry {
+    std::string name;
+    uint64_t local_header_offset{0};
+    uint32_t crc32{0};
+    uint64_t size{0};
+  };
+
+  bool Write(const uint8_t *data, size_t size);
+  bool WriteLocalHeader(const Entry &entry, bool zip64);
+  bool UpdateLocalHeader(const Entry &entry);
+  // Write the entry whose content is in memory(callback output).
+  bool WriteEntry(Entry &entry, const uint8_t *data, size_t size);
+  bool WriteCentralDirectory();
+  bool ValidateName(const std::string &name);
+
+  void PushError(const std::string &s) { _err += s; }
+
+  FILE *_fp{nullptr};
+  USDZWriteCallback _callback{nullptr};
+  void *_userdata{nullptr};
+
+  uint64_t _offset{0};  // Bytes written so far.
+  std::vector<Entry> _entries;
+  std::unordered_set<std::string> _names;
+
+  // State of the entry written with `BeginFile`.
+  bool _in_file{false};
+  Entry _current;
+  std::vector<uint8_t> _pending;  // Data buffered for callback output.
+
+  bool _failed{false};
+
+  std::string _err;
+  std::string _warn;
+};
+
+///
+/// Asset to be packaged into USDZ.
+///
+struct USDZAssetEntry {
+  USDZAssetEntry() = default;
+
+  USDZAssetEntry(const std::string &_name, const uint8_t *_data, size_t _size)
+      : name(_name), data(_data), size(_size) {}
+
+  USDZAssetEntry(const std::string &_name, const Asset &asset)
+      : name(_name), data(asset.data()), size(asset.size()) {}
+
+  // Path in the archive, relative to the root layer(e.g. "textures/a.png"
+  // for `@./textures/a.png@`).
+  std::string name;
+
+  // Content. Must be retained until `SaveAsUSDZ` returns.
+  const uint8_t *data{nullptr};
+  size_t size{0};
+};
+
+struct USDZWriterConfig {
+  // Name of the root layer in the archive. Must have `.usda` extension.
+  std::string root_layer_name{"root.usda"};
+};
+
+///
+/// Save Stage as USDZ. The Stage is written as the root layer(USDA), followed
+/// by `assets`. The root layer text is streamed into the archive.
+///
+/// @param[in] filename USDZ filename(UTF-8)
+/// @param[in] stage Stage
+/// @param[in] assets Assets to be packaged.
+/// @param[out] warn Warning message
+/// @param[out] err Error message
+/// @param[in] config Writer config.
+///
+/// @return true upon success.
+///
+bool SaveAsUSDZ(const std::string &filename, const Stage &stage,
+                const std::vector<USDZAssetEntry> &assets, std::string *warn,
+                std::string *err,
+                const USDZWriterConfig &config = USDZWriterConfig());
+
+///
+/// Save Stage as USDZ through user callback.
+///
+bool SaveAsUSDZ(USDZWriteCallback callback, void *userdata,
+                const Stage &stage, const std::vector<USDZAssetEntry> &assets,
+                std::string *warn, std::string *err,
+                const USDZWriterConfig &config = USDZWriterConfig());
+
+}  // namespace usdz
+}  // namespace tinyusdz
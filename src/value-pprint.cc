@@ -16,6 +16,12 @@
 //
 #include "common-macros.inc"
 
+#if !defined(__wasi__)
+#include <atomic>
+#include <thread>
+#define TINYUSDZ_VALUE_PPRINT_PARALLEL
+#endif
+
 // For fast int/float to ascii
 // Default disabled.
 //#define TINYUSDZ_LOCAL_USE_JEAIII_ITOA
@@ -66,6 +72,100 @@ inline std::string dtos(const double v) {
   return std::string(buf);
 }
 
+// Arrays with this number of elements or more are formatted in parallel.
+constexpr size_t kParallelPrintMinElements = 128 * 1024;
+
+// The number of elements formatted by each task.
+constexpr size_t kPrintChunkElements = 16 * 1024;
+
+//
+// Print 1D array as `[a, b, ...]`. `print_fn(os, v[i])` prints an element.
+//
+// Large array is split into chunks and chunks are formatted in parallel, then
+// written to `ofs` in order. Up to `num_threads * 2` formatted chunks are held
+// in memory at once.
+//
+template <typename T, typename F>
+void PrintArray(std::ostream &ofs, const std::vector<T> &v, const F &print_fn) {
+  ofs << "[";
+
+  size_t num_threads = 1;
+#if defined(TINYUSDZ_VALUE_PPRINT_PARALLEL)
+  if (v.size() >= kParallelPrintMinElements) {
+    num_threads = (std::min)(
+        size_t(64),
+        size_t((std::max)(1u, std::thread::hardware_concurrency())));
+  }
+#endif
+
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < v.size(); i++) {
+      if (i > 0) {
+        ofs << ", ";
+      }
+      print_fn(ofs, v[i]);
+    }
+  } else {
+#if defined(TINYUSDZ_VALUE_PPRINT_PARALLEL)
+    const size_t num_chunks =
+        (v.size() + kPrintChunkElements - 1) / kPrintChunkElements;
+    const size_t batch_size = num_threads * 2;
+
+    std::vector<std::string> texts(batch_size);
+
+    for (size_t batch_begin = 0; batch_begin < num_chunks;
+         batch_begin += batch_size) {
+      const size_t n = (std::min)(batch_size, num_chunks - batch_begin);
+
+      std::atomic<size_t> next{0};
+      std::vector<std::thread> workers;
+
+      for (size_t t = 0; t < (std::min)(num_threads, n); t++) {
+        workers.emplace_back([&]() {
+          std::ostringstream ss;
+          ss.flags(ofs.flags());
+          ss.precision(ofs.precision());
+
+          while (true) {
+            size_t k = next++;
+            if (k >= n) {
+              break;
+            }
+
+            const size_t begin = (batch_begin + k) * kPrintChunkElements;
+            const size_t end = (std::min)(v.size(), begin + kPrintChunkElements);
+
+            ss.str(std::string());
+            for (size_t i = begin; i < end; i++) {
+              if (i > 0) {
+                ss << ", ";
+              }
+              print_fn(ss, v[i]);
+            }
+            texts[k] = ss.str();
+          }
+        });
+      }
+
+      for (auto &worker : workers) {
+        worker.join();
+      }
+
+      for (size_t k = 0; k < n; k++) {
+        ofs << texts[k];
+      }
+    }
+#endif
+  }
+
+  ofs << "]";
+}
+
+template <typename T>
+void PrintArray(std::ostream &ofs, const std::vector<T> &v) {
+  PrintArray(ofs, v, [](std::ostream &os, const T &item) { os << item; });
+}
+
 }  // namespace
 
 }  // namespace tinyusdz
@@ -551,45 +651,58 @@ std::ostream &operator<<(std::ostream &ofs,
 
 template <>
 std::ostream &operator<<(std::ostream &ofs, const std::vector<double> &v) {
-  // Not sure what is the HARD-LIMT buffer length for dtoa_milo,
-  // but according to std::numeric_limits<double>::digits10(=15),
-  // 32 should be sufficient, but allocate 128 just in case
-  char buf[128];
-
-  // TODO: multi-threading for further performance gain?
-
-  ofs << "[";
-  for (size_t i = 0; i < v.size(); i++) {
-    if (i > 0) {
-      ofs << ", ";
-    }
-    dtoa_milo(v[i], buf);
-    ofs << std::string(buf);
-  }
-  ofs << "]";
+  tinyusdz::PrintArray(ofs, v, [](std::ostream &os, const double &item) {
+    // Not sure what is the HARD-LIMT buffer length for dtoa_milo,
+    // but according to std::numeric_limits<double>::digits10(=15),
+    // 32 should be sufficient, but allocate 128 just in case
+    char buf[128];
+    dtoa_milo(item, buf);
+    os << buf;
+  });
 
   return ofs;
 }
 
 template <>
 std::ostream &operator<<(std::ostream &ofs, const std::vector<float> &v) {
-  // Use floaxie
-  char buf[128];
+  tinyusdz::PrintArray(ofs, v, [](std::ostream &os, const float &item) {
+    // Use floaxie
+    char buf[128];
+    floaxie::ftoa(item, buf);
+    os << buf;
+  });
 
-  // TODO: multi-threading for further performance gain?
+  return ofs;
+}
 
-  ofs << "[";
-  for (size_t i = 0; i < v.size(); i++) {
-    if (i > 0) {
-      ofs << ", ";
-    }
-    floaxie::ftoa(v[i], buf);
-    ofs << std::string(buf);
+#define PRINT_ARRAY_SPECIALIZATION(__ty)                                      \
+  template <>                                                                 \
+  std::ostream &operator<<(std::ostream &ofs,                                 \
+                           const std::vector<tinyusdz::value::__ty> &v) {     \
+    tinyusdz::PrintArray(ofs, v);                                             \
+    return ofs;                                                               \
   }
-  ofs << "]";
 
-  return ofs;
-}
+PRINT_ARRAY_SPECIALIZATION(float2)
+PRINT_ARRAY_SPECIALIZATION(float3)
+PRINT_ARRAY_SPECIALIZATION(float4)
+PRINT_ARRAY_SPECIALIZATION(double2)
+PRINT_ARRAY_SPECIALIZATION(double3)
+PRINT_ARRAY_SPECIALIZATION(double4)
+PRINT_ARRAY_SPECIALIZATION(point3f)
+PRINT_ARRAY_SPECIALIZATION(point3d)
+PRINT_ARRAY_SPECIALIZATION(normal3f)
+PRINT_ARRAY_SPECIALIZATION(normal3d)
+PRINT_ARRAY_SPECIALIZATION(vector3f)
+PRINT_ARRAY_SPECIALIZATION(vector3d)
+PRINT_ARRAY_SPECIALIZATION(color3f)
+PRINT_ARRAY_SPECIALIZATION(color3d)
+PRINT_ARRAY_SPECIALIZATION(color4f)
+PRINT_ARRAY_SPECIALIZATION(color4d)
+PRINT_ARRAY_SPECIALIZATION(texcoord2f)
+PRINT_ARRAY_SPECIALIZATION(texcoord2d)
+
+#undef PRINT_ARRAY_SPECIALIZATION
 
 template <>
 std::ostream &operator<<(std::ostream &ofs, const std::vector<int32_t> &v) {
@@ -160,6 +160,62 @@ std::ostream &operator<<(std::ostream &os, const std::vector<int64_t> &v);
 template <>
 std::ostream &operator<<(std::ostream &os, const std::vector<uint64_t> &v);
 
+// Large float/double arrays are formatted in parallel.
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::float2> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::float3> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::float4> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::double2> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::double3> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::double4> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::point3f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::point3d> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::normal3f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::normal3d> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::vector3f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::vector3d> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::color3f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::color3d> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::color4f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::color4d> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::texcoord2f> &v);
+template <>
+std::ostream &operator<<(std::ostream &os,
+                         const std::vector<tinyusdz::value::texcoord2d> &v);
+
 }  // namespace std
 
 namespace tinyusdz {
@@ -799,13 +799,7 @@ matrix4d &matrix4d::operator=(const matrix4f &src) {
 }
 
 
-size_t Value::array_size() const {
-  if (!is_array()) {
-    return 0;
-  }
-
-  // primvar types only.
-
+// primvar types only.
 #define APPLY_FUNC_TO_TYPES(__FUNC) \
   __FUNC(bool)                 \
   __FUNC(value::token)                 \
@@ -861,6 +855,11 @@ size_t Value::array_size() const {
   __FUNC(matrix4d) \
   __FUNC(frame4d)
 
+size_t Value::array_size() const {
+  if (!is_array()) {
+    return 0;
+  }
+
 #define ARRAY_SIZE_GET(__ty) case value::TypeTraits<__ty>::type_id() | value::TYPE_ID_1D_ARRAY_BIT: { \
     if (auto pv = v_.cast<std::vector<__ty>>()) { \
       return pv->size(); \
@@ -876,10 +875,32 @@ size_t Value::array_size() const {
   }
 
 #undef ARRAY_SIZE_GET
-#undef APPLY_FUNC_TO_TYPES
 
 }
 
+size_t Value::array_data_size() const {
+  if (!is_array()) {
+    return 0;
+  }
+
+#define ARRAY_DATA_SIZE_GET(__ty) case value::TypeTraits<__ty>::type_id() | value::TYPE_ID_1D_ARRAY_BIT: { \
+    if (auto pv = v_.cast<std::vector<__ty>>()) { \
+      return pv->size() * sizeof(__ty); \
+    } \
+    return 0; \
+  }
+
+  switch (v_.type_id()) {
+    APPLY_FUNC_TO_TYPES(ARRAY_DATA_SIZE_GET)
+    default:
+      return 0;
+  }
+
+#undef ARRAY_DATA_SIZE_GET
+}
+
+#undef APPLY_FUNC_TO_TYPES
+
 bool RoleTypeCast(const uint32_t roleTyId, value::Value &inout) {
   const uint32_t srcUnderlyingTyId = inout.underlying_type_id();
 
@@ -1077,34 +1098,78 @@ bool FlexibleTypeCast(const value::Value &src, value::Value &dst) {
 #endif
 
 bool TimeSamples::has_sample_at(const double t) const {
-  if (_dirty) {
-    update();
+  // `_times` is sorted, so only neighbors of the insertion point need to be
+  // checked.
+  auto it = std::lower_bound(_times.begin(), _times.end(), t);
+  if ((it != _times.end()) && math::is_close(t, *it)) {
+    return true;
+  }
+  if ((it != _times.begin()) && math::is_close(t, *(it - 1))) {
+    return true;
   }
 
-  const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &s) {
-    return math::is_close(t, s.t);
-  });
-
-  return (it != _samples.end());
+  return false;
 }
 
-bool TimeSamples::get_sample_at(const double t, Sample **dst) {
+bool TimeSamples::get_sample_at(const double t, value::Value **dst) {
   if (!dst) {
     return false;
   }
 
-  if (_dirty) {
-    update();
+  auto it = std::lower_bound(_times.begin(), _times.end(), t);
+  if ((it == _times.end()) || !math::is_close(t, *it)) {
+    if ((it != _times.begin()) && math::is_close(t, *(it - 1))) {
+      it--;
+    } else {
+      return false;
+    }
   }
 
-  const auto it = std::find_if(_samples.begin(), _samples.end(), [&t](const Sample &sample) {
-    return math::is_close(t, sample.t);
+  thaw();
+  (*dst) = &_values[size_t(std::distance(_times.begin(), it))];
+  return true;
+}
+
+bool TimeSamples::set_samples(std::vector<double> &&times,
+                              std::vector<value::Value> &&values,
+                              std::vector<bool> &&blocked) {
+  thaw();
+
+  if (times.size() != values.size()) {
+    return false;
+  }
+
+  if (blocked.empty()) {
+    blocked.assign(times.size(), false);
+  } else if (blocked.size() != times.size()) {
+    return false;
+  }
+
+  if (std::is_sorted(times.begin(), times.end())) {
+    _times = std::move(times);
+    _values = std::move(values);
+    _blocked = std::move(blocked);
+    return true;
+  }
+
+  // Sort once with a permutation.
+  std::vector<size_t> perm(times.size());
+  for (size_t i = 0; i < perm.size(); i++) {
+    perm[i] = i;
+  }
+  std::stable_sort(perm.begin(), perm.end(), [&times](size_t a, size_t b) {
+    return times[a] < times[b];
   });
 
-  if (it != _samples.end()) {
-    (*dst) = &(*it); 
+  clear();
+  reserve(perm.size());
+  for (size_t i = 0; i < perm.size(); i++) {
+    _times.push_back(times[perm[i]]);
+    _values.emplace_back(std::move(values[perm[i]]));
+    _blocked.push_back(blocked[perm[i]]);
   }
-  return false;
+
+  return true;
 }
 
 }  // namespace value
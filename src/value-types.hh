@@ -2129,6 +2129,10 @@ class Value {
   // ...)
   size_t array_size() const;
 
+  // Byte size of array elements(`array_size() * sizeof(element type)`).
+  // return 0 for non array type or non-Primvar types.
+  size_t array_data_size() const;
+
   bool is_empty() const { return v_.type_id() == value::TYPE_ID_NULL; }
 
  private:
@@ -2254,130 +2258,264 @@ bool Lerp(const value::Value &a, const value::Value &b, double dt,
 
 
 
-// Handy, but may not be efficient for large time samples(e.g. 1M samples or
-// more)
-//
-// For the runtime speed, with "-O2 -g" optimization, adding 10M `double`
-// samples to linb::any takes roughly 1.8 ms on Threadripper 1950X, whereas
-// simple vector<double> push_back takes 390 us(roughly x4 times faster). (Build
-// benchmarks to see the numbers on your CPU)
+///
+/// View of samples stored in Structure-of-Arrays layout, which provides
+/// Array-of-Structures style access(`view[i].t`, `view[i].value`,
+/// `view[i].blocked`) without copying values.
+///
+/// When `IsConst` is false, the value of a sample can be modified through the
+/// view. Sample time and blocked flag are read-only since samples are kept
+/// sorted.
+///
+/// The view is invalidated when samples are added or removed.
+///
+template <typename V, typename Sample, bool IsConst = true>
+class TimeSampleView {
+  using values_type = typename std::conditional<IsConst, const std::vector<V>,
+                                                std::vector<V>>::type;
+  using value_ref = typename std::conditional<
+      IsConst, typename std::vector<V>::const_reference,
+      typename std::vector<V>::reference>::type;
+
+ public:
+  struct Ref {
+    Ref(double _t, value_ref _value, bool _blocked)
+        : t(_t), value(_value), blocked(_blocked) {}
+
+    double t;
+    value_ref value;
+    bool blocked;
+
+    // Materialize a sample(copies the value).
+    operator Sample() const {
+      Sample s;
+      s.t = t;
+      s.value = value;
+      s.blocked = blocked;
+      return s;
+    }
+  };
+
+  class iterator {
+   public:
+    iterator(const TimeSampleView *view, size_t idx) : _view(view), _idx(idx) {}
+
+    // Returns a reference so that `for (auto &s : view)` works. The
+    // referenced object is valid until the iterator is dereferenced again.
+    Ref &operator*() const {
+      _ref.emplace(_view->_times[_idx], _view->_values[_idx],
+                   _view->_blocked[_idx]);
+      return *_ref;
+    }
+
+    iterator &operator++() {
+      _idx++;
+      return *this;
+    }
+
+    bool operator==(const iterator &rhs) const { return _idx == rhs._idx; }
+    bool operator!=(const iterator &rhs) const { return _idx != rhs._idx; }
+
+   private:
+    const TimeSampleView *_view;
+    size_t _idx;
+    mutable nonstd::optional<Ref> _ref;
+  };
+
+  TimeSampleView(const std::vector<double> &times, values_type &values,
+                 const std::vector<bool> &blocked)
+      : _times(times), _values(values), _blocked(blocked) {}
+
+  size_t size() const { return _times.size(); }
+  bool empty() const { return _times.empty(); }
+
+  Ref operator[](size_t idx) const {
+    return Ref(_times[idx], _values[idx], _blocked[idx]);
+  }
+
+  Ref front() const { return (*this)[0]; }
+  Ref back() const { return (*this)[size() - 1]; }
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, size()); }
+
+  // Materialize samples in AoS layout(copies values).
+  operator std::vector<Sample>() const {
+    std::vector<Sample> samples;
+    samples.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+      samples.push_back((*this)[i]);
+    }
+    return samples;
+  }
+
+ private:
+  const std::vector<double> &_times;
+  values_type &_values;
+  const std::vector<bool> &_blocked;
+};
+
+// Samples are stored in Structure-of-Arrays layout: sorted `times`, `values`
+// and `blocked` flags. Samples are kept sorted by time on insertion(appending
+// samples in time order is O(1)), so no sort is required to look up a value.
 //
-// We assume having large time samples is rare situlation, and above benchmark
-// speed is acceptable in general  usecases.
+// `None`(ValueBlock) is represented by setting `blocked` flag true.
 //
-// `None`(ValueBlock) is represented by setting `Sample::blocked` true.
+// Thread safety: const member functions never modify the container, so
+// concurrent reads without locks are safe as long as nobody writes to it.
+// Readers(USDA/USDC) `freeze()` TimeSamples at load time. Any modification
+// makes frozen TimeSamples mutable again(thaw), so the app must not modify
+// TimeSamples while other threads are reading it.
 //
 struct TimeSamples {
+  // AoS representation of a sample. Used for `get_samples()`.
   struct Sample {
     double t;
     value::Value value;
     bool blocked{false};
   };
 
-  bool empty() const { return _samples.empty(); }
+  bool empty() const { return _times.empty(); }
 
-  size_t size() const { return _samples.size(); }
+  size_t size() const { return _times.size(); }
 
   void clear() {
-    _samples.clear();
-    _dirty = true;
+    thaw();
+
+    _times.clear();
+    _values.clear();
+    _blocked.clear();
+  }
+
+  void reserve(size_t n) {
+    thaw();
+
+    _times.reserve(n);
+    _values.reserve(n);
+    _blocked.reserve(n);
   }
 
-  void update() const {
-    std::sort(_samples.begin(), _samples.end(),
-              [](const Sample &a, const Sample &b) { return a.t < b.t; });
+  // Samples are always sorted. Kept for backward compatibility.
+  void update() const {}
 
-    _dirty = false;
+  ///
+  /// Finalize samples(release extra capacity) and mark the container as
+  /// read-only. Modification(`add_sample`, `set_samples`, `clear`, ...) to
+  /// frozen TimeSamples unfreezes it.
+  ///
+  void freeze() {
+    if (_frozen) {
+      return;
+    }
+
+    _times.shrink_to_fit();
+    _values.shrink_to_fit();
+    _blocked.shrink_to_fit();
+    _frozen = true;
   }
 
+  /// Make the container modifiable again. Caller must ensure no other thread
+  /// is reading it.
+  void unfreeze() { _frozen = false; }
+
+  bool is_frozen() const { return _frozen; }
+
   bool has_sample_at(const double t) const;
-  bool get_sample_at(const double t, Sample **s);
 
   nonstd::optional<double> get_time(size_t idx) const {
-    if (idx >= _samples.size()) {
+    if (idx >= _times.size()) {
       return nonstd::nullopt;
     }
 
-    if (_dirty) {
-      update();
-    }
-
-    return _samples[idx].t;
+    return _times[idx];
   }
 
   nonstd::optional<value::Value> get_value(size_t idx) const {
-    if (idx >= _samples.size()) {
+    if (idx >= _values.size()) {
       return nonstd::nullopt;
     }
 
-    if (_dirty) {
-      update();
+    return _values[idx];
+  }
+
+  // Returns false when `idx` is out-of-range.
+  bool is_blocked(size_t idx) const {
+    if (idx >= _blocked.size()) {
+      return false;
     }
 
-    return _samples[idx].value;
+    return _blocked[idx];
   }
 
+  // Sorted sample times.
+  const std::vector<double> &get_times() const { return _times; }
+
+  // Sample values in the order of `get_times()`.
+  const std::vector<value::Value> &get_values() const { return _values; }
+
   uint32_t type_id() const {
-    if (_samples.size()) {
-      if (_dirty) {
-        update();
-      }
-      return _samples[0].value.type_id();
+    if (_values.size()) {
+      return _values[0].type_id();
     } else {
       return value::TypeId::TYPE_ID_INVALID;
     }
   }
 
   std::string type_name() const {
-    if (_samples.size()) {
-      if (_dirty) {
-        update();
-      }
-      return _samples[0].value.type_name();
+    if (_values.size()) {
+      return _values[0].type_name();
     } else {
       return std::string();
     }
   }
 
-  void add_sample(const Sample &s) {
-    _samples.push_back(s);
-    _dirty = true;
+  bool add_sample(const Sample &s) {
+    return insert_sample(s.t, s.value, s.blocked);
   }
 
-  void add_sample(double t, const value::Value &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    s.blocked = false;
-    _samples.push_back(s);
-    _dirty = true;
+  bool add_sample(double t, const value::Value &v) {
+    return insert_sample(t, v, false);
   }
 
   // We still need "dummy" value for type_name() and type_id()
-  void add_blocked_sample(double t, const value::Value &v) {
-    Sample s;
-    s.t = t;
-    s.value = v;
-    s.blocked = true;
-
-    _samples.emplace_back(s);
-    _dirty = true;
+  bool add_blocked_sample(double t, const value::Value &v) {
+    return insert_sample(t, v, true);
   }
 
-  const std::vector<Sample> &get_samples() const {
-    if (_dirty) {
-      update();
-    }
-    return _samples;
+  ///
+  /// Set samples at once. `times` and `values` must have the same length.
+  /// Sorted when `times` is not in ascending order.
+  /// `blocked` may be empty(= no blocked samples).
+  ///
+  bool set_samples(std::vector<double> &&times,
+                   std::vector<value::Value> &&values,
+                   std::vector<bool> &&blocked = std::vector<bool>());
+
+  using SampleView = TimeSampleView<value::Value, Sample>;
+  using MutableSampleView = TimeSampleView<value::Value, Sample, false>;
+
+  ///
+  /// Samples in AoS style(no copy). Prefer `get_times()`, `get_values()` and
+  /// `is_blocked()` in new code.
+  ///
+  SampleView get_samples() const {
+    return SampleView(_times, _values, _blocked);
   }
 
-  std::vector<Sample> &samples() {
-    if (_dirty) {
-      update();
-    }
-    return _samples;
+  ///
+  /// DEPRECATED. Modifiable samples. Use `get_sample_at()` or `set_samples()`.
+  ///
+  MutableSampleView samples() {
+    thaw();
+    return MutableSampleView(_times, _values, _blocked);
   }
 
+  ///
+  /// Get a pointer to the value of the sample at time `t`. Returns false when
+  /// there is no sample at `t`.
+  ///
+  bool get_sample_at(const double t, value::Value **dst);
+
 #if 1  // TODO: Write implementation in .cc
 
     // Get value at specified time.
@@ -2400,34 +2538,24 @@ struct TimeSamples {
         return false;
       }
 
-      if (_dirty) {
-        update();
-      }
-
       if (value::TimeCode(t).is_default()) {
         // TODO: Handle bloked
-        if (const auto pv = _samples[0].value.as<T>()) {
+        if (const auto pv = _values[0].as<T>()) {
           (*dst) = *pv;
           return true;
         }
         return false;
       } else {
 
-        if (_samples.size() == 1) {
-          if (const auto pv = _samples[0].value.as<T>()) {
+        if (_times.size() == 1) {
+          if (const auto pv = _values[0].as<T>()) {
             (*dst) = *pv;
             return true;
           }
           return false;
         }
 
-        auto it = std::upper_bound(
-          _samples.begin(), _samples.end(), t,
-          [](double tval, const Sample &a) { return tval < a.t; });
-
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
-
-        const value::Value &v = it_minus_1->value;
+        const value::Value &v = _values[held_index(t)];
 
         if (const T *pv = v.as<T>()) {
           (*dst) = *pv;
@@ -2452,22 +2580,18 @@ struct TimeSamples {
       return false;
     }
 
-    if (_dirty) {
-      update();
-    }
-
     if (value::TimeCode(t).is_default()) {
       // FIXME: Use the first item for now.
       // TODO: Handle bloked
-      if (const auto pv = _samples[0].value.as<T>()) {
+      if (const auto pv = _values[0].as<T>()) {
         (*dst) = *pv;
         return true;
       }
       return false;
     } else {
 
-      if (_samples.size() == 1) {
-        if (const auto pv = _samples[0].value.as<T>()) {
+      if (_times.size() == 1) {
+        if (const auto pv = _values[0].as<T>()) {
           (*dst) = *pv;
           return true;
         }
@@ -2475,39 +2599,12 @@ struct TimeSamples {
       }
 
       if (interp == TimeSampleInterpolationType::Linear) {
-        auto it = std::lower_bound(
-            _samples.begin(), _samples.end(), t,
-            [](const Sample &a, double tval) { return a.t < tval; });
-
-
-        // MS STL does not allow seek vector iterator before begin
-        // Issue #110
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
-
-        size_t idx0 = size_t(std::max(
-            int64_t(0),
-            std::min(int64_t(_samples.size() - 1),
-                     int64_t(std::distance(_samples.begin(), it_minus_1)))));
-        size_t idx1 =
-            size_t(std::max(int64_t(0), std::min(int64_t(_samples.size() - 1),
-                                                 int64_t(idx0) + 1)));
-
-        double tl = _samples[idx0].t;
-        double tu = _samples[idx1].t;
-
-        double dt = (t - tl);
-        if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
-          // slope is zero.
-          dt = 0.0;
-        } else {
-          dt /= (tu - tl);
-        }
+        size_t idx0, idx1;
+        double dt;
+        lerp_indices(t, &idx0, &idx1, &dt);
 
-        // Just in case.
-        dt = std::max(0.0, std::min(1.0, dt));
-
-        const value::Value &p0 = _samples[idx0].value;
-        const value::Value &p1 = _samples[idx1].value;
+        const value::Value &p0 = _values[idx0];
+        const value::Value &p1 = _values[idx1];
 
         value::Value p;
         if (!Lerp(p0, p1, dt, &p)) {
@@ -2521,19 +2618,13 @@ struct TimeSamples {
         return false;
       } else {
         // Held
-        auto it = std::upper_bound(
-          _samples.begin(), _samples.end(), t,
-          [](double tval, const Sample &a) { return tval < a.t; });
-
-        const auto it_minus_1 = (it == _samples.begin()) ? _samples.begin() : (it - 1);
-
-        const value::Value &v = it_minus_1->value;
+        const value::Value &v = _values[held_index(t)];
 
         if (const T *pv = v.as<T>()) {
           (*dst) = *pv;
           return true;
         }
-        
+
         return false;
       }
     }
@@ -2542,9 +2633,81 @@ struct TimeSamples {
   }
 #endif
 
+  ///
+  /// Index of the sample for Held interpolation at time `t`(the nearest
+  /// preceding sample. The first sample when `t` is before the first sample).
+  /// Samples must not be empty.
+  ///
+  size_t held_index(double t) const {
+    auto it = std::upper_bound(_times.begin(), _times.end(), t);
+    return (it == _times.begin()) ? 0 : size_t(std::distance(_times.begin(), it) - 1);
+  }
+
+  ///
+  /// Sample indices and the interpolator for Linear interpolation at time
+  /// `t`. Samples must not be empty.
+  ///
+  void lerp_indices(double t, size_t *idx0, size_t *idx1, double *dt) const {
+    auto it = std::lower_bound(_times.begin(), _times.end(), t);
+
+    // MS STL does not allow seek vector iterator before begin
+    // Issue #110
+    const auto it_minus_1 = (it == _times.begin()) ? _times.begin() : (it - 1);
+
+    size_t i0 = size_t((std::max)(
+        int64_t(0),
+        (std::min)(int64_t(_times.size() - 1),
+                   int64_t(std::distance(_times.begin(), it_minus_1)))));
+    size_t i1 =
+        size_t((std::max)(int64_t(0), (std::min)(int64_t(_times.size() - 1),
+                                                 int64_t(i0) + 1)));
+
+    double tl = _times[i0];
+    double tu = _times[i1];
+
+    double d = (t - tl);
+    if (std::fabs(tu - tl) < std::numeric_limits<double>::epsilon()) {
+      // slope is zero.
+      d = 0.0;
+    } else {
+      d /= (tu - tl);
+    }
+
+    // Just in case.
+    d = (std::max)(0.0, (std::min)(1.0, d));
+
+    (*idx0) = i0;
+    (*idx1) = i1;
+    (*dt) = d;
+  }
+
  private:
-  mutable std::vector<Sample> _samples;
-  mutable bool _dirty{false};
+  void thaw() { _frozen = false; }
+
+  bool insert_sample(double t, const value::Value &v, bool blocked) {
+    thaw();
+
+    if (_times.empty() || (_times.back() <= t)) {
+      // fast path: samples are usually added in time order.
+      _times.push_back(t);
+      _values.push_back(v);
+      _blocked.push_back(blocked);
+      return true;
+    }
+
+    auto it = std::upper_bound(_times.begin(), _times.end(), t);
+    size_t idx = size_t(std::distance(_times.begin(), it));
+
+    _times.insert(it, t);
+    _values.insert(_values.begin() + std::ptrdiff_t(idx), v);
+    _blocked.insert(_blocked.begin() + std::ptrdiff_t(idx), blocked);
+    return true;
+  }
+
+  std::vector<double> _times;  // sorted
+  std::vector<value::Value> _values;
+  std::vector<bool> _blocked;
+  bool _frozen{false};
 };
 
 
@@ -190,26 +190,19 @@ struct Xformable {
   /// @param[out] resetTransformStack Is xformOpOrder contains !resetTransformStack!? 
   ///
   nonstd::expected<value::matrix4d, std::string> GetLocalMatrix(double t = value::TimeCode::Default(), value::TimeSampleInterpolationType tinterp = value::TimeSampleInterpolationType::Linear, bool *resetTransformStack = nullptr) const {
-    if (_dirty || !value::TimeCode(t).is_default()) {
-      value::matrix4d m;
-      std::string err;
-      if (EvaluateXformOps(t, tinterp, &m, resetTransformStack, &err)) {
-        if (value::TimeCode(t).is_default()) {
-          _matrix = m;
-          _dirty = false;
-        }
-        else {
-          return m;
-        }
-      } else {
-        return nonstd::make_unexpected(err);
-      }
+    // No cache here, so that Xformable can be evaluated from multiple threads
+    // concurrently.
+    value::matrix4d m;
+    std::string err;
+    if (EvaluateXformOps(t, tinterp, &m, resetTransformStack, &err)) {
+      return m;
     }
 
-    return _matrix;
+    return nonstd::make_unexpected(err);
   }
 
-  void set_dirty(bool onoff) { _dirty = onoff; }
+  // Deprecated. Local matrix is not cached anymore.
+  void set_dirty(bool onoff) { (void)onoff; }
 
   bool has_timesamples() const {
     for (size_t i = 0; i < xformOps.size(); i++) {
@@ -224,9 +217,6 @@ struct Xformable {
   std::vector<value::token> xformOpOrder() const;
 
   std::vector<XformOp> xformOps;
-
-  mutable bool _dirty{true};
-  mutable value::matrix4d _matrix;  // Matrix of this Xform(local matrix)
 };
 
 
@@ -0,0 +1,269 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "unit-composition.h"
+#include "composition.hh"
+#include "pprinter.hh"
+#include "prim-types.hh"
+#include "tinyusdz.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+// Serve assets from memory.
+using MemoryAssetMap = std::map<std::string, std::string>;
+
+int MemoryResolve(const char *asset_name,
+                  const std::vector<std::string> &search_paths,
+                  std::string *resolved_asset_name, std::string *err,
+                  void *userdata) {
+  (void)search_paths;
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!asset_name || !resolved_asset_name || !assets) {
+    return -2;
+  }
+
+  if (!assets->count(asset_name)) {
+    return -1;
+  }
+
+  (*resolved_asset_name) = asset_name;
+  return 0;
+}
+
+int MemorySize(const char *resolved_asset_name, uint64_t *nbytes,
+               std::string *err, void *userdata) {
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!resolved_asset_name || !nbytes || !assets) {
+    return -2;
+  }
+
+  auto it = assets->find(resolved_asset_name);
+  if (it == assets->end()) {
+    return -1;
+  }
+
+  (*nbytes) = it->second.size();
+  return 0;
+}
+
+int MemoryMap(const char *resolved_asset_name, const uint8_t **out_addr,
+              uint64_t *nbytes, std::string *err, void *userdata) {
+  (void)err;
+  const MemoryAssetMap *assets = reinterpret_cast<MemoryAssetMap *>(userdata);
+  if (!resolved_asset_name || !out_addr || !nbytes || !assets) {
+    return -2;
+  }
+
+  auto it = assets->find(resolved_asset_name);
+  if (it == assets->end()) {
+    return -1;
+  }
+
+  (*out_addr) = reinterpret_cast<const uint8_t *>(it->second.data());
+  (*nbytes) = it->second.size();
+  return 0;
+}
+
+std::string MakeRootLayer(uint32_t num_instances) {
+  std::string s = "#usda 1.0\n\ndef Xform \"root\"\n{\n";
+  for (uint32_t i = 0; i < num_instances; i++) {
+    s += "  def \"instance_" + std::to_string(i) +
+         "\" (\n    prepend references = @proto.usda@\n  )\n  {\n  }\n";
+  }
+  s += "}\n";
+  return s;
+}
+
+bool ComposeReferences(AssetResolutionResolver &resolver,
+                       const std::string &root_usda, LayerCache *cache,
+                       Layer *dst) {
+  std::string warn;
+  std::string err;
+
+  Layer root_layer;
+  if (!LoadLayerFromMemory(reinterpret_cast<const uint8_t *>(root_usda.data()),
+                           root_usda.size(), "root.usda", &root_layer, &warn,
+                           &err)) {
+    return false;
+  }
+
+  ReferencesCompositionOptions options;
+  options.layer_cache = cache;
+  return CompositeReferences(resolver, root_layer, dst, &warn, &err, options);
+}
+
+std::string InstanceTypeName(const Layer &layer, uint32_t idx) {
+  const PrimSpec *ps{nullptr};
+  std::string err;
+  if (!layer.find_primspec_at(
+          Path("/root/instance_" + std::to_string(idx), ""), &ps, &err) ||
+      !ps) {
+    return std::string();
+  }
+  return ps->typeName();
+}
+
+}  // namespace
+
+void composition_layer_cache_test(void) {
+  const uint32_t kNumInstances = 8;
+
+  MemoryAssetMap assets;
+  assets["proto.usda"] =
+      "#usda 1.0\n(\n  defaultPrim = \"proto\"\n)\n\n"
+      "def Mesh \"proto\"\n{\n  int[] faceVertexCounts = [3]\n}\n";
+
+  AssetResolutionHandler handler;
+  handler.resolve_fun = MemoryResolve;
+  handler.size_fun = MemorySize;
+  handler.map_fun = MemoryMap;
+  handler.userdata = &assets;
+
+  AssetResolutionResolver resolver;
+  resolver.register_asset_resolution_handler("usda", handler);
+
+  const std::string root_usda = MakeRootLayer(kNumInstances);
+
+  // Without LayerCache(a temporary cache is used in the composition pass).
+  Layer uncached;
+  TEST_CHECK(ComposeReferences(resolver, root_usda, nullptr, &uncached));
+  TEST_CHECK(InstanceTypeName(uncached, 0) == "Mesh");
+
+  // The referenced asset is loaded once.
+  LayerCache cache;
+  Layer composited;
+  TEST_CHECK(ComposeReferences(resolver, root_usda, &cache, &composited));
+  TEST_CHECK(cache.size() == 1);
+  TEST_CHECK(cache.stats().misses == 1);
+  TEST_CHECK(cache.stats().hits == kNumInstances - 1);
+  TEST_CHECK(cache.stats().resolve_misses == 1);
+  TEST_CHECK(cache.stats().resolve_hits == kNumInstances - 1);
+  for (uint32_t i = 0; i < kNumInstances; i++) {
+    TEST_CHECK(InstanceTypeName(composited, i) == "Mesh");
+    TEST_MSG("instance_%u", i);
+  }
+
+  // Share the cache across composition passes.
+  Layer composited2;
+  TEST_CHECK(ComposeReferences(resolver, root_usda, &cache, &composited2));
+  TEST_CHECK(cache.stats().misses == 1);
+  TEST_CHECK(cache.stats().hits == 2 * kNumInstances - 1);
+  TEST_CHECK(InstanceTypeName(composited2, kNumInstances - 1) == "Mesh");
+
+  // Modified asset(the stamp differs) is reloaded.
+  assets["proto.usda"] =
+      "#usda 1.0\n(\n  defaultPrim = \"proto\"\n)\n\n"
+      "def Xform \"proto\"\n{\n}\n";
+  cache.reset_stats();
+  Layer composited3;
+  TEST_CHECK(ComposeReferences(resolver, root_usda, &cache, &composited3));
+  TEST_CHECK(cache.size() == 1);
+  TEST_CHECK(cache.stats().reloads == 1);
+  TEST_CHECK(cache.stats().misses == 1);
+  TEST_CHECK(cache.stats().hits == kNumInstances - 1);
+  TEST_CHECK(InstanceTypeName(composited3, 0) == "Xform");
+
+  cache.clear();
+  TEST_CHECK(cache.size() == 0);
+}
+
+void composition_prefetch_test(void) {
+  MemoryAssetMap assets;
+  assets["a.usda"] =
+      "#usda 1.0\n(\n  defaultPrim = \"a\"\n)\n\n"
+      "def Xform \"a\"\n{\n"
+      "  def \"nested\" (\n    prepend references = @c.usda@\n  )\n  {\n  }\n"
+      "}\n";
+  assets["b.usda"] =
+      "#usda 1.0\n(\n  defaultPrim = \"b\"\n)\n\n"
+      "def Mesh \"b\"\n{\n}\n";
+  assets["c.usda"] =
+      "#usda 1.0\n(\n  defaultPrim = \"c\"\n)\n\n"
+      "def Scope \"c\"\n{\n}\n";
+
+  AssetResolutionHandler handler;
+  handler.resolve_fun = MemoryResolve;
+  handler.size_fun = MemorySize;
+  handler.map_fun = MemoryMap;
+  handler.userdata = &assets;
+
+  AssetResolutionResolver resolver;
+  resolver.register_asset_resolution_handler("usda", handler);
+
+  std::string root_usda = "#usda 1.0\n\ndef Xform \"root\"\n{\n";
+  for (uint32_t i = 0; i < 4; i++) {
+    root_usda += "  def \"instance_" + std::to_string(i) +
+                 "\" (\n    prepend references = @a.usda@\n"
+                 "    prepend payload = @b.usda@\n  )\n  {\n  }\n";
+  }
+  // Not found asset is skipped in prefetch.
+  root_usda +=
+      "  def \"missing\" (\n    prepend references = @missing.usda@\n  )\n"
+      "  {\n  }\n";
+  root_usda += "}\n";
+
+  std::string warn;
+  std::string err;
+
+  Layer root_layer;
+  TEST_CHECK(LoadLayerFromMemory(
+      reinterpret_cast<const uint8_t *>(root_usda.data()), root_usda.size(),
+      "root.usda", &root_layer, &warn, &err));
+
+  auto compose = [&](LayerCache *cache, Layer *dst) {
+    ReferencesCompositionOptions ref_options;
+    ref_options.layer_cache = cache;
+    PayloadCompositionOptions payload_options;
+    payload_options.layer_cache = cache;
+
+    Layer referenced;
+    if (!CompositeReferences(resolver, root_layer, &referenced, &warn, &err,
+                             ref_options)) {
+      return false;
+    }
+    return CompositePayload(resolver, referenced, dst, &warn, &err,
+                            payload_options);
+  };
+
+  Layer expected;
+  TEST_CHECK(compose(nullptr, &expected));
+
+  for (int num_threads : {1, 4}) {
+    LayerCache cache;
+    LayerPrefetchOptions options;
+    options.num_threads = num_threads;
+    TEST_CHECK(PrefetchLayers(resolver, root_layer, &cache, &warn, &err,
+                              options));
+    TEST_MSG("%s", err.c_str());
+
+    // a.usda, b.usda and c.usda(referenced from a.usda).
+    TEST_CHECK(cache.size() == 3);
+    TEST_CHECK(cache.stats().prefetched == 3);
+    TEST_CHECK(cache.stats().misses == 0);
+
+    Layer composited;
+    TEST_CHECK(compose(&cache, &composited));
+    TEST_CHECK(cache.stats().misses == 0);
+    TEST_CHECK(cache.stats().hits == 8);
+    TEST_CHECK(print_layer(composited, 0) == print_layer(expected, 0));
+
+    // Prefetch again. Nothing to load.
+    TEST_CHECK(PrefetchLayers(resolver, root_layer, &cache, &warn, &err,
+                              options));
+    TEST_CHECK(cache.stats().prefetched == 3);
+  }
+
+  TEST_CHECK(!PrefetchLayers(resolver, root_layer, nullptr, &warn, &err));
+}
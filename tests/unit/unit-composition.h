@@ -0,0 +1,4 @@
+#pragma once
+
+void composition_layer_cache_test(void);
+void composition_prefetch_test(void);
@@ -5,7 +5,11 @@
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+#include <cstdio>
+#include <string>
+
 #include "unit-ioutil.h"
+#include "asset-resolution.hh"
 #include "io-util.hh"
 
 using namespace tinyusdz;
@@ -15,3 +19,77 @@ void ioutil_test(void) {
     TEST_CHECK(io::JoinPath("./", "./dora") == "./dora");
   }
 }
+
+static bool WriteTestFile(const std::string &filename,
+                          const std::string &content) {
+  FILE *fp = fopen(filename.c_str(), "wb");
+  if (!fp) {
+    return false;
+  }
+  size_t n = fwrite(content.data(), 1, content.size(), fp);
+  fclose(fp);
+  return n == content.size();
+}
+
+void asset_resolution_mmap_test(void) {
+  const std::string filename = "unit-ioutil-asset-mmap-test.usda";
+  const std::string empty_filename = "unit-ioutil-asset-mmap-empty.usda";
+  const std::string content = "#usda 1.0\n\ndef Xform \"root\"\n{\n}\n";
+
+  TEST_CHECK(WriteTestFile(filename, content));
+  TEST_CHECK(WriteTestFile(empty_filename, std::string()));
+
+  std::string warn, err;
+
+  // Default: read the whole file into the Asset.
+  {
+    AssetResolutionResolver resolver;
+    TEST_CHECK(!resolver.get_use_mmap());
+
+    Asset asset;
+    TEST_CHECK(resolver.open_asset(filename, filename, &asset, &warn, &err));
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(!asset.is_view());
+    TEST_CHECK(asset.size() == content.size());
+    TEST_CHECK(std::string(reinterpret_cast<const char *>(asset.cdata()),
+                           asset.size()) == content);
+  }
+
+  // mmap
+  if (io::IsMMapSupported()) {
+    AssetResolutionResolver resolver;
+    resolver.set_use_mmap(true);
+
+    Asset asset;
+    TEST_CHECK(resolver.open_asset(filename, filename, &asset, &warn, &err));
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(asset.is_view());
+    TEST_CHECK(asset.size() == content.size());
+    TEST_CHECK(std::string(reinterpret_cast<const char *>(asset.cdata()),
+                           asset.size()) == content);
+
+    // A copy references the same mapping.
+    Asset copied = asset;
+    TEST_CHECK(copied.is_view());
+    TEST_CHECK(copied.cdata() == asset.cdata());
+
+    // Writable access copies the content. The mapping is not modified.
+    uint8_t *p = copied.data();
+    TEST_CHECK(!copied.is_view());
+    p[0] = uint8_t('!');
+    TEST_CHECK(asset.is_view());
+    TEST_CHECK(asset.cdata()[0] == uint8_t('#'));
+
+    // mmap fails for an empty file, then falls back to the file reader,
+    // which reports an error for an empty file.
+    Asset empty_asset;
+    err.clear();
+    TEST_CHECK(!resolver.open_asset(empty_filename, empty_filename,
+                                    &empty_asset, &warn, &err));
+    TEST_CHECK(err.find("File is empty") != std::string::npos);
+    TEST_MSG("%s", err.c_str());
+  }
+
+  std::remove(filename.c_str());
+  std::remove(empty_filename.c_str());
+}
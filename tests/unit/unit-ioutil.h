@@ -1,3 +1,4 @@
 #pragma once
 
 void ioutil_test(void);
+void asset_resolution_mmap_test(void);
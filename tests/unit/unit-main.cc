@@ -16,6 +16,19 @@
 #include "unit-strutil.h"
 #include "unit-timesamples.h"
 #include "unit-pprint.h"
+#include "unit-usda-reader.h"
+#include "unit-stage.h"
+#include "unit-tydra.h"
+#include "unit-usdz.h"
+#include "unit-composition.h"
+
+#if defined(TINYUSDZ_WITH_MODULE_USDA_WRITER)
+#include "unit-usda-writer.h"
+#endif
+
+#if defined(TINYUSDZ_WITH_MODULE_USDC_WRITER)
+#include "unit-usdc-writer.h"
+#endif
 
 #if defined(TINYUSDZ_WITH_PXR_COMPAT_API)
 #include "unit-pxr-compat-api.h"
@@ -26,8 +39,11 @@
 TEST_LIST = {
   { "prim_type_test", prim_type_test },
   { "prim_add_test", prim_add_test },
+  { "prim_property_map_test", prim_property_map_test },
   { "primvar_test", primvar_test },
   { "value_types_test", value_types_test },
+  { "value_cow_array_test", value_cow_array_test },
+  { "value_token_pool_test", value_token_pool_test },
   { "xformOp_test", xformOp_test },
   { "customdata_test", customdata_test },
   { "handle_allocator_test", handle_allocator_test },
@@ -35,9 +51,35 @@ TEST_LIST = {
   { "math_sin_pi_test", math_sin_pi_test },
   { "math_sin_cos_pi_test", math_sin_cos_pi_test },
   { "pathutil_test", pathutil_test },
+  { "pathutil_path_node_test", pathutil_path_node_test },
   { "ioutil_test", ioutil_test },
+  { "asset_resolution_mmap_test", asset_resolution_mmap_test },
   { "strutil_test", strutil_test },
   { "timesamples_test", timesamples_test },
+  { "timesamples_concurrent_eval_test", timesamples_concurrent_eval_test },
+  { "timesamples_edit_loaded_test", timesamples_edit_loaded_test },
+  { "usda_scan_root_prim_blocks_test", usda_scan_root_prim_blocks_test },
+  { "usda_parallel_parse_test", usda_parallel_parse_test },
+  { "usda_load_stats_test", usda_load_stats_test },
+  { "stage_prim_index_test", stage_prim_index_test },
+  { "tydra_parallel_mesh_convert_test", tydra_parallel_mesh_convert_test },
+  { "tydra_shared_texture_image_test", tydra_shared_texture_image_test },
+  { "tydra_vertex_welding_test", tydra_vertex_welding_test },
+  { "tydra_interleaved_vertex_buffer_test", tydra_interleaved_vertex_buffer_test },
+  { "tydra_incremental_update_test", tydra_incremental_update_test },
+  { "usdz_central_directory_test", usdz_central_directory_test },
+  { "usdz_writer_test", usdz_writer_test },
+  { "composition_layer_cache_test", composition_layer_cache_test },
+  { "composition_prefetch_test", composition_prefetch_test },
+#if defined(TINYUSDZ_WITH_MODULE_USDA_WRITER)
+  { "usda_writer_stream_test", usda_writer_stream_test },
+#endif
+#if defined(TINYUSDZ_WITH_MODULE_USDC_WRITER)
+  { "crate_writer_inline_test", crate_writer_inline_test },
+  { "crate_writer_dedup_test", crate_writer_dedup_test },
+  { "usdc_writer_roundtrip_test", usdc_writer_roundtrip_test },
+  { "usdc_lazy_array_unpack_test", usdc_lazy_array_unpack_test },
+#endif
 #if defined(TINYUSDZ_WITH_PXR_COMPAT_API)
   { "pxr_compat_api_test", pxr_compat_api_test },
 #endif
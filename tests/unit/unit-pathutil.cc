@@ -2,6 +2,8 @@
 #define NOMINMAX
 #endif
 
+#include <algorithm>
+
 #define TEST_NO_MAIN
 #include "acutest.h"
 
@@ -149,3 +151,94 @@ void pathutil_test(void) {
   }
 
 }
+
+void pathutil_path_node_test(void) {
+  {
+    Path p("/root/xform", "points");
+    Path q = Path::make_root_path().AppendPrim("root").AppendPrim("xform").AppendProperty("points");
+    TEST_CHECK(p.is_valid());
+    TEST_CHECK(q.is_valid());
+    TEST_CHECK(p == q);
+    TEST_CHECK(p.node() == q.node());
+    TEST_CHECK(p.hash() == q.hash());
+    TEST_CHECK(q.prim_part() == "/root/xform");
+    TEST_CHECK(q.prop_part() == "points");
+    TEST_CHECK(q.element_name() == "points");
+    TEST_CHECK(q.full_path_name() == "/root/xform.points");
+    TEST_CHECK(q.is_prim_property_path());
+
+    // Same string = same node.
+    size_t n = PathNodePool::Size();
+    Path r("/root/xform.points", "");
+    TEST_CHECK(r.node() == p.node());
+    TEST_CHECK(n == PathNodePool::Size());
+  }
+
+  {
+    Path p("/root/xform", "points");
+
+    Path parent = p.get_parent_path();
+    TEST_CHECK(parent.is_prim_path());
+    TEST_CHECK(parent.node() == Path("/root/xform", "").node());
+    TEST_CHECK(parent.element_name() == "xform");
+
+    parent = parent.get_parent_path();
+    TEST_CHECK(parent.node() == Path("/root", "").node());
+    TEST_CHECK(parent.is_root_prim());
+
+    parent = parent.get_parent_path();
+    TEST_CHECK(parent.is_root_path());
+    TEST_CHECK(parent == Path::make_root_path());
+
+    TEST_CHECK(!parent.get_parent_path().is_valid());
+  }
+
+  {
+    Path p("/root/xform/mesh", "");
+    TEST_CHECK(p.has_prefix(Path("/root", "")));
+    TEST_CHECK(p.has_prefix(Path("/root/xform", "")));
+    TEST_CHECK(p.has_prefix(Path("/root/xform/mesh", "")));
+    TEST_CHECK(!p.has_prefix(Path("/root/xf", "")));
+    TEST_CHECK(!p.has_prefix(Path("/xform", "")));
+    TEST_CHECK(p.has_prefix(Path::make_root_path()));
+  }
+
+  {
+    // relative and property only path.
+    Path p("xform/mesh", "");
+    TEST_CHECK(p.is_relative_path());
+    TEST_CHECK(p.element_name() == "mesh");
+    TEST_CHECK(p.get_parent_path().prim_part() == "xform");
+    TEST_CHECK(!p.get_parent_path().get_parent_path().is_valid());
+
+    Path q = Path("/xform/mesh", "").make_relative();
+    TEST_CHECK(q == p);
+
+    Path prop("", "visibility");
+    TEST_CHECK(prop.is_valid());
+    TEST_CHECK(prop.prim_part().empty());
+    TEST_CHECK(prop.prop_part() == "visibility");
+    TEST_CHECK(!prop.is_prim_property_path());
+  }
+
+  {
+    // variant selection
+    Path p = Path("/root", "").AppendElement("{shape=cube}");
+    TEST_CHECK(p.prim_part() == "/root{shape=cube}");
+    TEST_CHECK(p.variant_part() == "{shape=cube}");
+    TEST_CHECK(Path("/root", "").variant_part().empty());
+  }
+
+  {
+    // Paths are sorted by its hierarchy.
+    std::vector<Path> paths;
+    paths.push_back(Path("/b", ""));
+    paths.push_back(Path("/a/c", ""));
+    paths.push_back(Path("/a", "x"));
+    paths.push_back(Path("/a", ""));
+    std::sort(paths.begin(), paths.end());
+    TEST_CHECK(paths[0].full_path_name() == "/a");
+    TEST_CHECK(paths[1].full_path_name() == "/a.x");
+    TEST_CHECK(paths[3].full_path_name() == "/b");
+  }
+}
@@ -1,3 +1,4 @@
 #pragma once
 
 void pathutil_test(void);
+void pathutil_path_node_test(void);
@@ -2,6 +2,9 @@
 #define NOMINMAX
 #endif
 
+#include <algorithm>
+#include <iterator>
+
 #define TEST_NO_MAIN
 #include "acutest.h"
 
@@ -140,3 +143,94 @@ void prim_add_test(void) {
   TEST_CHECK(root.add_child(std::move(dprim), /* rename_if_required */true)); 
   
 }
+
+void prim_property_map_test(void) {
+  PropertyMap props;
+  TEST_CHECK(props.empty());
+
+  // Insert in unsorted order.
+  const char *names[] = {"primvars:st", "points", "primvars:normals",
+                         "extent", "primvars:st:indices", "visibility",
+                         "primvars:displayColor"};
+  for (const char *name : names) {
+    Attribute attr;
+    attr.set_name(name);
+    auto ret = props.emplace(name, Property(attr, /* custom */ false));
+    TEST_CHECK(ret.second);
+    TEST_CHECK(ret.first->first == name);
+  }
+  TEST_CHECK(props.size() == 7);
+
+  // Duplicated key is not inserted.
+  TEST_CHECK(props.emplace("points", Property()).second == false);
+  TEST_CHECK(props.size() == 7);
+
+  for (const char *name : names) {
+    TEST_CHECK(props.count(name) == 1);
+    auto it = props.find(name);
+    TEST_CHECK(it != props.end());
+    TEST_CHECK(it->second.get_attribute().name() == name);
+    TEST_CHECK(props.at(name).get_attribute().name() == name);
+  }
+  TEST_CHECK(props.count("primvars:") == 0);
+  TEST_CHECK(props.find("normals") == props.end());
+
+  // Iterated in the order of name(same as std::map).
+  {
+    std::vector<std::string> keys;
+    for (const auto &item : props) {
+      keys.push_back(item.first);
+    }
+    std::vector<std::string> sorted(std::begin(names), std::end(names));
+    std::sort(sorted.begin(), sorted.end());
+    TEST_CHECK(keys == sorted);
+  }
+
+  // `primvars:` namespace
+  {
+    auto range = props.prefix_range("primvars:");
+    std::vector<std::string> keys;
+    for (auto it = range.first; it != range.second; ++it) {
+      keys.push_back(it->first);
+    }
+    TEST_CHECK(keys.size() == 4);
+    TEST_CHECK(keys[0] == "primvars:displayColor");
+    TEST_CHECK(keys[3] == "primvars:st:indices");
+
+    auto empty_range = props.prefix_range("inputs:");
+    TEST_CHECK(empty_range.first == empty_range.second);
+  }
+
+  // operator[] inserts a Property when the key does not exist.
+  props["velocities"] = Property();
+  TEST_CHECK(props.size() == 8);
+  TEST_CHECK(props.count("velocities") == 1);
+
+  TEST_CHECK(props.erase("points") == 1);
+  TEST_CHECK(props.erase("points") == 0);
+  TEST_CHECK(props.size() == 7);
+  TEST_CHECK(props.count("points") == 0);
+  for (const auto &item : props) {
+    TEST_CHECK(props.find(item.first)->first == item.first);
+  }
+
+  // Grow the hash table.
+  for (size_t i = 0; i < 300; i++) {
+    props["primvars:attr" + std::to_string(i)] = Property();
+  }
+  TEST_CHECK(props.size() == 307);
+  TEST_CHECK(props.count("primvars:attr123") == 1);
+  TEST_CHECK(props.at("primvars:st").get_attribute().name() == "primvars:st");
+  {
+    auto range = props.prefix_range("primvars:");
+    TEST_CHECK(std::distance(range.first, range.second) == 304);
+  }
+
+  PropertyMap copied = props;
+  TEST_CHECK(copied.size() == props.size());
+  TEST_CHECK(copied.count("primvars:attr299") == 1);
+
+  props.clear();
+  TEST_CHECK(props.empty());
+  TEST_CHECK(props.find("primvars:st") == props.end());
+}
@@ -2,3 +2,4 @@
 
 void prim_type_test(void);
 void prim_add_test(void);
+void prim_property_map_test(void);
@@ -0,0 +1,172 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include "unit-stage.h"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "usdGeom.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+Prim MakeXformPrim(const std::string &name,
+                   const std::vector<std::string> &child_names) {
+  Xform xform;
+  Prim prim(name, xform);
+  for (const auto &child_name : child_names) {
+    Xform child;
+    prim.add_child(Prim(child_name, child));
+  }
+  return prim;
+}
+
+}  // namespace
+
+void stage_prim_index_test(void) {
+  Stage stage;
+
+  TEST_CHECK(stage.add_root_prim(MakeXformPrim("root", {"a", "b"})));
+  TEST_CHECK(stage.add_root_prim(MakeXformPrim("root2", {"c"})));
+
+  // Lookup before `commit()`(brute-force search).
+  {
+    auto ret = stage.GetPrimAtPath(Path("/root/b", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value()->element_name() == "b");
+    }
+  }
+
+  TEST_CHECK(stage.commit());
+
+  {
+    auto ret = stage.GetPrimAtPath(Path("/root2/c", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[1].children()[0]);
+    }
+
+    TEST_CHECK(!stage.GetPrimAtPath(Path("/root/c", "")).has_value());
+    TEST_CHECK(!stage.GetPrimAtPath(Path("/root3", "")).has_value());
+  }
+
+  // prim_id lookup for all Prims.
+  {
+    const Prim &b = stage.root_prims()[0].children()[1];
+    TEST_CHECK(b.prim_id() > 0);
+
+    const Prim *prim{nullptr};
+    TEST_CHECK(stage.find_prim_by_prim_id(uint64_t(b.prim_id()), prim));
+    TEST_CHECK(prim == &b);
+
+    TEST_CHECK(!stage.find_prim_by_prim_id(100000, prim));
+  }
+
+  // Copied Stage must return Prims owned by the copy.
+  {
+    Stage copied = stage;
+
+    auto ret = copied.GetPrimAtPath(Path("/root/a", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &copied.root_prims()[0].children()[0]);
+    }
+
+    const Prim &c = copied.root_prims()[1].children()[0];
+    const Prim *prim{nullptr};
+    TEST_CHECK(copied.find_prim_by_prim_id(uint64_t(c.prim_id()), prim));
+    TEST_CHECK(prim == &c);
+  }
+
+  // Adding a root Prim after `commit()`
+  {
+    TEST_CHECK(stage.add_root_prim(MakeXformPrim("root3", {"d"})));
+
+    auto ret = stage.GetPrimAtPath(Path("/root3/d", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[2].children()[0]);
+    }
+
+    // Existing Prims are still found.
+    ret = stage.GetPrimAtPath(Path("/root/a", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[0].children()[0]);
+    }
+  }
+
+  // Replacing a root Prim
+  {
+    TEST_CHECK(stage.replace_root_prim("root", MakeXformPrim("root", {"e"})));
+
+    TEST_CHECK(!stage.GetPrimAtPath(Path("/root/a", "")).has_value());
+    auto ret = stage.GetPrimAtPath(Path("/root/e", ""));
+    TEST_CHECK(ret.has_value());
+  }
+
+  // Modifying root Prims through non-const `root_prims()` without `commit()`
+  {
+    TEST_CHECK(stage.commit());
+
+    stage.root_prims().emplace_back(MakeXformPrim("root4", {"f"}));
+
+    auto ret = stage.GetPrimAtPath(Path("/root4/f", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[3].children()[0]);
+    }
+  }
+
+  // Modifying children through non-const `Prim::children()` without
+  // `commit()`. Indexed entries must not point to relocated Prims.
+  {
+    TEST_CHECK(stage.commit());
+
+    const int64_t e_id = stage.root_prims()[0].children()[0].prim_id();
+    TEST_CHECK(e_id > 0);
+
+    std::vector<Prim> &children = stage.root_prims()[0].children();
+    for (size_t i = 0; i < 64; i++) {
+      Xform xform;
+      children.emplace_back(Prim("g" + std::to_string(i), xform));
+    }
+
+    // New Prim(not in the index)
+    auto ret = stage.GetPrimAtPath(Path("/root/g63", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[0].children()[64]);
+    }
+
+    // Indexed Prim in a reallocated array.
+    ret = stage.GetPrimAtPath(Path("/root/e", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[0].children()[0]);
+    }
+
+    // Move the indexed Prim to another location.
+    std::swap(children[0], children[1]);
+
+    ret = stage.GetPrimAtPath(Path("/root/e", ""));
+    TEST_CHECK(ret.has_value());
+    if (ret) {
+      TEST_CHECK(ret.value() == &stage.root_prims()[0].children()[1]);
+    }
+
+    const Prim *prim{nullptr};
+    TEST_CHECK(stage.find_prim_by_prim_id(uint64_t(e_id), prim));
+    TEST_CHECK(prim == &stage.root_prims()[0].children()[1]);
+
+    // Removed Prim
+    children.erase(children.begin() + 1);
+    TEST_CHECK(!stage.GetPrimAtPath(Path("/root/e", "")).has_value());
+    TEST_CHECK(!stage.find_prim_by_prim_id(uint64_t(e_id), prim));
+  }
+}
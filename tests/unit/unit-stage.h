@@ -0,0 +1,3 @@
+#pragma once
+
+void stage_prim_index_test(void);
@@ -5,8 +5,16 @@
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+#include <atomic>
+#include <sstream>
+#include <thread>
+
 #include "unit-timesamples.h"
 #include "prim-types.hh"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "usdGeom.hh"
+#include "xform.hh"
 #include "math-util.inc"
 
 using namespace tinyusdz;
@@ -199,4 +207,334 @@ void timesamples_test(void) {
     TEST_CHECK(!value::IsLerpSupportedType(value::TypeTraits<std::vector<std::string>>::type_id()));
   }
 
+
+  // Out-of-order insertion. Samples are kept sorted.
+  {
+    value::TimeSamples ts;
+    ts.add_sample(10.0, value::Value(10.0f));
+    ts.add_sample(0.0, value::Value(0.0f));
+    ts.add_blocked_sample(5.0, value::Value(0.0f));
+    ts.add_sample(20.0, value::Value(20.0f));
+
+    TEST_CHECK(ts.size() == 4);
+    TEST_CHECK(math::is_close(ts.get_times()[0], 0.0));
+    TEST_CHECK(math::is_close(ts.get_times()[1], 5.0));
+    TEST_CHECK(math::is_close(ts.get_times()[2], 10.0));
+    TEST_CHECK(math::is_close(ts.get_times()[3], 20.0));
+    TEST_CHECK(ts.is_blocked(1));
+    TEST_CHECK(!ts.is_blocked(2));
+    TEST_CHECK(ts.has_sample_at(10.0));
+    TEST_CHECK(!ts.has_sample_at(11.0));
+
+    float f;
+    TEST_CHECK(ts.get(&f, 15.0, value::TimeSampleInterpolationType::Held));
+    TEST_CHECK(math::is_close(f, 10.0f));
+    TEST_CHECK(ts.get(&f, 15.0, value::TimeSampleInterpolationType::Linear));
+    TEST_CHECK(math::is_close(f, 15.0f));
+  }
+
+  // Bulk set. Unsorted input is sorted at once.
+  {
+    value::TimeSamples ts;
+    std::vector<double> times = {2.0, 0.0, 1.0};
+    std::vector<value::Value> values = {value::Value(2), value::Value(0), value::Value(1)};
+    TEST_CHECK(ts.set_samples(std::move(times), std::move(values)));
+    TEST_CHECK(ts.size() == 3);
+    for (size_t i = 0; i < ts.size(); i++) {
+      TEST_CHECK(math::is_close(ts.get_times()[i], double(i)));
+      const int *pv = ts.get_values()[i].as<int>();
+      TEST_CHECK(pv && (*pv == int(i)));
+      TEST_CHECK(!ts.is_blocked(i));
+    }
+
+    std::vector<double> bad_times = {0.0};
+    TEST_CHECK(!ts.set_samples(std::move(bad_times), std::vector<value::Value>()));
+  }
+
+  // Typed: overwrite an existing sample.
+  {
+    TypedTimeSamples<float> ts;
+    ts.add_sample(1.0, 1.0f);
+    ts.add_sample(0.0, 0.0f);
+    ts.set_sample(1.0, 3.0f);
+    ts.set_sample(2.0, 4.0f);
+
+    TEST_CHECK(ts.size() == 3);
+    TEST_CHECK(math::is_close(ts.get_values()[0], 0.0f));
+    TEST_CHECK(math::is_close(ts.get_values()[1], 3.0f));
+    TEST_CHECK(math::is_close(ts.get_values()[2], 4.0f));
+
+    float *pv{nullptr};
+    TEST_CHECK(ts.get_sample_at(2.0, &pv));
+    TEST_CHECK(pv && math::is_close(*pv, 4.0f));
+    TEST_CHECK(!ts.get_sample_at(0.5, &pv));
+  }
+
+  // AoS style access through a view(no copy).
+  {
+    value::TimeSamples ts;
+    ts.add_sample(0.0, value::Value(1.0f));
+    ts.add_blocked_sample(1.0, value::Value(0.0f));
+    ts.add_sample(2.0, value::Value(3.0f));
+
+    const auto samples = ts.get_samples();
+    TEST_CHECK(samples.size() == 3);
+    TEST_CHECK(&samples[0].value == &ts.get_values()[0]);
+    TEST_CHECK(samples[1].blocked);
+
+    size_t n = 0;
+    for (const auto &s : ts.get_samples()) {
+      TEST_CHECK(math::is_close(s.t, double(n)));
+      n++;
+    }
+    TEST_CHECK(n == 3);
+
+    const std::vector<value::TimeSamples::Sample> aos = ts.get_samples();
+    TEST_CHECK(aos.size() == 3);
+    TEST_CHECK(math::is_close(aos[2].t, 2.0));
+
+    // Deprecated shims.
+    value::Value *pv{nullptr};
+    TEST_CHECK(ts.get_sample_at(2.0, &pv));
+    (*pv) = value::Value(5.0f);
+    TEST_CHECK(!ts.get_sample_at(3.0, &pv));
+
+    ts.samples()[0].value = value::Value(4.0f);
+
+    const float *pf = ts.get_values()[0].as<float>();
+    TEST_CHECK(pf && math::is_close(*pf, 4.0f));
+    pf = ts.get_values()[2].as<float>();
+    TEST_CHECK(pf && math::is_close(*pf, 5.0f));
+  }
+
+  {
+    TypedTimeSamples<float> ts;
+    ts.add_sample(0.0, 1.0f);
+    ts.add_sample(1.0, 2.0f);
+
+    TEST_CHECK(ts.get_samples().size() == 2);
+    TEST_CHECK(&ts.get_samples()[1].value == &ts.get_values()[1]);
+
+    for (auto s : ts.samples()) {
+      s.value *= 2.0f;
+    }
+    TEST_CHECK(math::is_close(ts.get_values()[0], 2.0f));
+    TEST_CHECK(math::is_close(ts.get_values()[1], 4.0f));
+  }
+
+}
+
+// Evaluate timeSampled attributes of a loaded Stage from multiple threads.
+// Build with `-DSANITIZE_THREAD=ON` to check data races with TSan.
+void timesamples_concurrent_eval_test(void) {
+  const int kNumPrims = 64;
+
+  std::stringstream ss;
+  ss << "#usda 1.0\n";
+  for (int i = 0; i < kNumPrims; i++) {
+    ss << "def Xform \"x" << i << "\" {\n";
+    ss << "  double3 xformOp:translate.timeSamples = { 0: (" << i << ", 0, 0), 10: (" << i << ", 10, 0) }\n";
+    ss << "  uniform token[] xformOpOrder = [\"xformOp:translate\"]\n";
+    ss << "  custom float myval.timeSamples = { 10: " << (i + 10) << ", 0: " << i << " }\n";
+    ss << "  def Mesh \"m\" {\n";
+    ss << "    point3f[] points.timeSamples = { 0: [(0, 0, 0)], 10: [(" << i << ", " << i << ", " << i << ")] }\n";
+    ss << "  }\n";
+    ss << "}\n";
+  }
+  std::string usda = ss.str();
+
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "<memory>", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  TEST_CHECK(stage.root_prims().size() == size_t(kNumPrims));
+  if (stage.root_prims().size() != size_t(kNumPrims)) {
+    return;
+  }
+
+  {
+    const GeomMesh *mesh = stage.root_prims()[0].children()[0].as<GeomMesh>();
+    TEST_CHECK(mesh != nullptr);
+    if (mesh) {
+      auto pts = mesh->points.get_value();
+      TEST_CHECK(pts && pts.value().get_timesamples().is_frozen());
+    }
+  }
+
+  const double times[] = {-1.0, 0.0, 2.5, 5.0, 10.0, 20.0};
+  const size_t kNumTimes = sizeof(times) / sizeof(times[0]);
+
+  std::atomic<int> num_failures(0);
+
+  auto eval_fn = [&]() {
+    for (int iter = 0; iter < 8; iter++) {
+      for (int i = 0; i < kNumPrims; i++) {
+        const Prim &prim = stage.root_prims()[size_t(i)];
+        const Xform *xform = prim.as<Xform>();
+        if (!xform) {
+          num_failures++;
+          continue;
+        }
+
+        {
+          // Default time: the first sample.
+          auto m = xform->GetLocalMatrix();
+          if (!m || !math::is_close(m.value().m[3][0], double(i)) ||
+              !math::is_close(m.value().m[3][1], 0.0)) {
+            num_failures++;
+          }
+        }
+
+        for (size_t k = 0; k < kNumTimes; k++) {
+          // expected value: linearly interpolated and clamped
+          const double t = times[k];
+          const double s = (std::max)(0.0, (std::min)(1.0, t / 10.0));
+
+          auto m = xform->GetLocalMatrix(t);
+          if (!m || !math::is_close(m.value().m[3][0], double(i)) ||
+              !math::is_close(m.value().m[3][1], 10.0 * s)) {
+            num_failures++;
+          }
+
+          float f;
+          auto it = xform->props.find("myval");
+          if ((it == xform->props.end()) ||
+              !it->second.get_attribute().get(t, &f) ||
+              !math::is_close(f, float(i) + float(10.0 * s))) {
+            num_failures++;
+          }
+
+          const GeomMesh *mesh = prim.children()[0].as<GeomMesh>();
+          std::vector<value::point3f> pts;
+          if (!mesh) {
+            num_failures++;
+            continue;
+          }
+          auto pv = mesh->points.get_value();
+          if (!pv || !pv.value().get(t, &pts) || (pts.size() != 1) ||
+              !math::is_close(pts[0][0], float(double(i) * s))) {
+            num_failures++;
+          }
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < 8; i++) {
+    workers.emplace_back(eval_fn);
+  }
+  for (auto &th : workers) {
+    th.join();
+  }
+
+  TEST_CHECK(num_failures.load() == 0);
+  TEST_MSG("# of failures = %d", num_failures.load());
+}
+
+void timesamples_edit_loaded_test(void) {
+  std::string usda = R"(#usda 1.0
+
+def Xform "x"
+{
+    custom float myval.timeSamples = {
+        0: 1,
+        10: 2,
+    }
+
+    def Mesh "m"
+    {
+        point3f[] points.timeSamples = {
+            0: [(0, 0, 0)],
+            10: [(1, 1, 1)],
+        }
+    }
+}
+)";
+
+  std::string warn, err;
+
+  // Typed(Animatable) samples of a loaded Stage.
+  {
+    Stage stage;
+    bool ret = LoadUSDAFromMemory(
+        reinterpret_cast<const uint8_t *>(usda.data()), usda.size(),
+        "<memory>", &stage, &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    if (!ret) {
+      return;
+    }
+
+    const GeomMesh *mesh = stage.root_prims()[0].children()[0].as<GeomMesh>();
+    TEST_CHECK(mesh != nullptr);
+    if (!mesh) {
+      return;
+    }
+
+    auto pts = mesh->points.get_value();
+    TEST_CHECK(pts.has_value());
+    if (!pts) {
+      return;
+    }
+
+    Animatable<std::vector<value::point3f>> anim = pts.value();
+    TEST_CHECK(anim.get_timesamples().is_frozen());
+
+    anim.add_sample(20.0, {{2.0f, 2.0f, 2.0f}});
+    anim.add_blocked_sample(30.0);
+    TEST_CHECK(!anim.get_timesamples().is_frozen());
+    TEST_CHECK(anim.get_timesamples().size() == 4);
+
+    std::vector<value::point3f> v;
+    TEST_CHECK(anim.get(20.0, &v));
+    TEST_CHECK((v.size() == 1) && math::is_close(v[0][0], 2.0f));
+
+    anim.freeze_timesamples();
+    anim.reserve_timesamples(8);
+    TEST_CHECK(!anim.get_timesamples().is_frozen());
+
+    anim.freeze_timesamples();
+    anim.clear_timesamples();
+    TEST_CHECK(anim.get_timesamples().size() == 0);
+  }
+
+  // Type-erased samples of a loaded Layer.
+  {
+    Layer layer;
+    bool ret = LoadUSDALayerFromMemory(
+        reinterpret_cast<const uint8_t *>(usda.data()), usda.size(),
+        "<memory>", &layer, &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    if (!ret) {
+      return;
+    }
+
+    auto it = layer.primspecs()["x"].props().find("myval");
+    TEST_CHECK(it != layer.primspecs()["x"].props().end());
+    if (it == layer.primspecs()["x"].props().end()) {
+      return;
+    }
+
+    primvar::PrimVar &var = it->second.attribute().get_var();
+    TEST_CHECK(var.ts_raw().is_frozen());
+    TEST_CHECK(var.ts_raw().size() == 2);
+
+    var.set_timesample(20.0, 3.0f);
+    TEST_CHECK(var.ts_raw().size() == 3);
+
+    float f;
+    TEST_CHECK(it->second.get_attribute().get(20.0, &f));
+    TEST_CHECK(math::is_close(f, 3.0f));
+
+    var.clear_timesamples();
+    TEST_CHECK(var.ts_raw().size() == 0);
+  }
 }
@@ -1,3 +1,5 @@
 #pragma once
 
 void timesamples_test(void);
+void timesamples_concurrent_eval_test(void);
+void timesamples_edit_loaded_test(void);
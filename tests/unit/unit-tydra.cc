@@ -0,0 +1,695 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include "unit-tydra.h"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "tydra/render-data.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+// Meshes with alternating Material bindings. Every 3rd mesh is bound to a
+// Skeleton.
+std::string MakeMeshesUSDA(size_t num_meshes) {
+  std::stringstream ss;
+
+  ss << R"(#usda 1.0
+
+def SkelRoot "root"
+{
+    def Skeleton "skel"
+    {
+        uniform matrix4d[] bindTransforms = [( (1, 0, 0, 0), (0, 1, 0, 0), (0, 0, 1, 0), (0, 0, 0, 1) ), ( (1, 0, 0, 0), (0, 1, 0, 0), (0, 0, 1, 0), (0, 1, 0, 1) )]
+        uniform token[] joints = ["a", "a/b"]
+        uniform matrix4d[] restTransforms = [( (1, 0, 0, 0), (0, 1, 0, 0), (0, 0, 1, 0), (0, 0, 0, 1) ), ( (1, 0, 0, 0), (0, 1, 0, 0), (0, 0, 1, 0), (0, 1, 0, 1) )]
+    }
+)";
+
+  for (size_t i = 0; i < num_meshes; i++) {
+    float x = float(i);
+    ss << "    def Mesh \"mesh" << i << "\"\n";
+    ss << "    {\n";
+    ss << "        int[] faceVertexCounts = [4, 3]\n";
+    ss << "        int[] faceVertexIndices = [0, 1, 2, 3, 1, 4, 2]\n";
+    ss << "        point3f[] points = [(" << x << ", 0, 0), (" << x + 1.0f
+       << ", 0, 0), (" << x + 1.0f << ", 1, 0), (" << x
+       << ", 1, 0), (" << x + 2.0f << ", 0.5, 0.5)]\n";
+    ss << "        texCoord2f[] primvars:st = [(0, 0), (1, 0), (1, 1), (0, "
+          "1), (1, 0), (0.5, 0.5), (1, 1)] (\n";
+    ss << "            interpolation = \"faceVarying\"\n";
+    ss << "        )\n";
+    ss << "        rel material:binding = </Looks/"
+       << ((i % 2) ? "Red" : "Green") << ">\n";
+    if ((i % 3) == 0) {
+      ss << "        int[] primvars:skel:jointIndices = [0, 1, 0, 1, 1] (\n";
+      ss << "            elementSize = 1\n";
+      ss << "            interpolation = \"vertex\"\n";
+      ss << "        )\n";
+      ss << "        float[] primvars:skel:jointWeights = [1, 1, 1, 1, 1] (\n";
+      ss << "            elementSize = 1\n";
+      ss << "            interpolation = \"vertex\"\n";
+      ss << "        )\n";
+      ss << "        rel skel:skeleton = </root/skel>\n";
+    }
+    ss << "    }\n";
+  }
+  ss << "}\n";
+
+  ss << R"(
+def "Looks"
+{
+    def Material "Red"
+    {
+        token outputs:surface.connect = </Looks/Red/shader.outputs:surface>
+
+        def Shader "shader"
+        {
+            uniform token info:id = "UsdPreviewSurface"
+            color3f inputs:diffuseColor = (1, 0, 0)
+            token outputs:surface
+        }
+    }
+
+    def Material "Green"
+    {
+        token outputs:surface.connect = </Looks/Green/shader.outputs:surface>
+
+        def Shader "shader"
+        {
+            uniform token info:id = "UsdPreviewSurface"
+            color3f inputs:diffuseColor = (0, 1, 0)
+            token outputs:surface
+        }
+    }
+}
+)";
+
+  return ss.str();
+}
+
+// Materials referencing texture assets. `a.png` is used by two Materials with
+// the same color space and one Material with a different color space.
+std::string MakeTexturedMaterialsUSDA() {
+  const char *textures[][2] = {
+      {"a.png", "sRGB"}, {"b.png", "sRGB"}, {"a.png", "sRGB"}, {"a.png", "raw"}};
+  constexpr size_t kNumMaterials = sizeof(textures) / sizeof(textures[0]);
+
+  std::stringstream ss;
+
+  ss << "#usda 1.0\n";
+
+  for (size_t i = 0; i < kNumMaterials; i++) {
+    ss << "def Mesh \"mesh" << i << "\"\n";
+    ss << "{\n";
+    ss << "    int[] faceVertexCounts = [3]\n";
+    ss << "    int[] faceVertexIndices = [0, 1, 2]\n";
+    ss << "    point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0)]\n";
+    ss << "    rel material:binding = </Looks/mat" << i << ">\n";
+    ss << "}\n";
+  }
+
+  ss << "def \"Looks\"\n";
+  ss << "{\n";
+  for (size_t i = 0; i < kNumMaterials; i++) {
+    std::string mat = "/Looks/mat" + std::to_string(i);
+    ss << "    def Material \"mat" << i << "\"\n";
+    ss << "    {\n";
+    ss << "        token outputs:surface.connect = <" << mat
+       << "/shader.outputs:surface>\n";
+    ss << "        def Shader \"shader\"\n";
+    ss << "        {\n";
+    ss << "            uniform token info:id = \"UsdPreviewSurface\"\n";
+    ss << "            color3f inputs:diffuseColor.connect = <" << mat
+       << "/tex.outputs:rgb>\n";
+    ss << "            token outputs:surface\n";
+    ss << "        }\n";
+    ss << "        def Shader \"tex\"\n";
+    ss << "        {\n";
+    ss << "            uniform token info:id = \"UsdUVTexture\"\n";
+    ss << "            asset inputs:file = @" << textures[i][0] << "@\n";
+    ss << "            token inputs:sourceColorSpace = \"" << textures[i][1]
+       << "\"\n";
+    ss << "            float3 outputs:rgb\n";
+    ss << "        }\n";
+    ss << "    }\n";
+  }
+  ss << "}\n";
+
+  return ss.str();
+}
+
+// Returns 2x2 RGBA8 image without reading a file.
+bool TestTextureLoader(const value::AssetPath &assetPath,
+                       const AssetInfo &assetInfo,
+                       const AssetResolutionResolver &assetResolver,
+                       tydra::TextureImage *imageOut,
+                       std::vector<uint8_t> *imageData, void *userdata,
+                       std::string *warn, std::string *err) {
+  (void)assetInfo;
+  (void)assetResolver;
+  (void)warn;
+  (void)err;
+
+  auto *num_loads = reinterpret_cast<std::atomic<int> *>(userdata);
+  (*num_loads)++;
+
+  uint8_t v = (assetPath.GetAssetPath() == "a.png") ? 64 : 192;
+
+  imageOut->width = 2;
+  imageOut->height = 2;
+  imageOut->channels = 4;
+  imageOut->texelComponentType = tydra::ComponentType::UInt8;
+  imageOut->assetTexelComponentType = tydra::ComponentType::UInt8;
+  imageData->assign(2 * 2 * 4, v);
+
+  return true;
+}
+
+// G x G quad grid with facevarying normals and texcoords. Normals of odd faces
+// are slightly perturbed. Texcoords have a seam at the center column.
+std::string MakeGridMeshUSDA(size_t G, float normal_perturbation) {
+  std::stringstream ss;
+
+  ss << "#usda 1.0\n";
+  ss << "def Mesh \"grid\"\n";
+  ss << "{\n";
+
+  ss << "    int[] faceVertexCounts = [";
+  for (size_t i = 0; i < G * G; i++) {
+    ss << (i ? ", " : "") << "4";
+  }
+  ss << "]\n";
+
+  ss << "    int[] faceVertexIndices = [";
+  for (size_t y = 0; y < G; y++) {
+    for (size_t x = 0; x < G; x++) {
+      size_t p = y * (G + 1) + x;
+      ss << ((x + y) ? ", " : "") << p << ", " << p + 1 << ", " << p + G + 2
+         << ", " << p + G + 1;
+    }
+  }
+  ss << "]\n";
+
+  ss << "    point3f[] points = [";
+  for (size_t y = 0; y <= G; y++) {
+    for (size_t x = 0; x <= G; x++) {
+      ss << ((x + y) ? ", " : "") << "(" << x << ", " << y << ", 0)";
+    }
+  }
+  ss << "]\n";
+
+  ss << "    normal3f[] normals = [";
+  for (size_t f = 0; f < G * G; f++) {
+    float nx = (f % 2) ? normal_perturbation : 0.0f;
+    for (size_t k = 0; k < 4; k++) {
+      ss << ((f + k) ? ", " : "") << "(" << nx << ", 0, 1)";
+    }
+  }
+  ss << "] (\n";
+  ss << "        interpolation = \"faceVarying\"\n";
+  ss << "    )\n";
+
+  const size_t corner_offsets[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  ss << "    texCoord2f[] primvars:st = [";
+  for (size_t y = 0; y < G; y++) {
+    for (size_t x = 0; x < G; x++) {
+      float seam = (x >= G / 2) ? 1.0f : 0.0f;
+      for (size_t k = 0; k < 4; k++) {
+        float u = float(x + corner_offsets[k][0]) / float(G) + seam;
+        float v = float(y + corner_offsets[k][1]) / float(G);
+        ss << ((x + y + k) ? ", " : "") << "(" << u << ", " << v << ")";
+      }
+    }
+  }
+  ss << "] (\n";
+  ss << "        interpolation = \"faceVarying\"\n";
+  ss << "    )\n";
+
+  ss << "}\n";
+
+  return ss.str();
+}
+
+bool ConvertStage(const Stage &stage, int num_threads,
+                  tydra::RenderScene *scene) {
+  tydra::RenderSceneConverterEnv env(stage);
+  env.scene_config.num_threads = num_threads;
+
+  tydra::RenderSceneConverter converter;
+  bool ret = converter.ConvertToRenderScene(env, scene);
+  if (!ret) {
+    std::cerr << converter.GetError() << "\n";
+  }
+  return ret;
+}
+
+}  // namespace
+
+void tydra_parallel_mesh_convert_test(void) {
+  constexpr size_t kNumMeshes = 37;
+
+  std::string usda = MakeMeshesUSDA(kNumMeshes);
+
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  tydra::RenderScene serial_scene;
+  TEST_CHECK(ConvertStage(stage, /* num_threads */ 1, &serial_scene));
+  TEST_CHECK(serial_scene.meshes.size() == kNumMeshes);
+  TEST_CHECK(serial_scene.materials.size() == 2);
+  TEST_CHECK(serial_scene.skeletons.size() == 1);
+
+  const std::string serial_dump = tydra::DumpRenderScene(serial_scene);
+
+  for (int num_threads : {2, 4, 16}) {
+    tydra::RenderScene scene;
+    TEST_CHECK(ConvertStage(stage, num_threads, &scene));
+
+    TEST_CHECK(scene.meshes.size() == serial_scene.meshes.size());
+    TEST_CHECK(scene.materials.size() == serial_scene.materials.size());
+    TEST_CHECK(scene.skeletons.size() == serial_scene.skeletons.size());
+
+    size_t n = (std::min)(scene.meshes.size(), serial_scene.meshes.size());
+    for (size_t i = 0; i < n; i++) {
+      const tydra::RenderMesh &a = serial_scene.meshes[i];
+      const tydra::RenderMesh &b = scene.meshes[i];
+      TEST_CHECK(a.abs_path == b.abs_path);
+      TEST_CHECK(a.material_id == b.material_id);
+      TEST_CHECK(a.skel_id == b.skel_id);
+      TEST_CHECK(a.points == b.points);
+      TEST_CHECK(a.faceVertexIndices() == b.faceVertexIndices());
+      TEST_CHECK(a.normals.get_data() == b.normals.get_data());
+    }
+
+    TEST_CHECK(tydra::DumpRenderScene(scene) == serial_dump);
+  }
+}
+
+void tydra_shared_texture_image_test(void) {
+  std::string usda = MakeTexturedMaterialsUSDA();
+
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  std::string serial_dump;
+
+  for (int num_threads : {1, 4}) {
+    std::atomic<int> num_loads{0};
+
+    tydra::RenderSceneConverterEnv env(stage);
+    env.scene_config.num_threads = num_threads;
+    env.scene_config.load_texture_assets = true;
+    env.material_config.preserve_texel_bitdepth = true;
+    env.material_config.texture_image_loader_function = TestTextureLoader;
+    env.material_config.texture_image_loader_function_userdata = &num_loads;
+
+    tydra::RenderScene scene;
+    tydra::RenderSceneConverter converter;
+    ret = converter.ConvertToRenderScene(env, &scene);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", converter.GetError().c_str());
+    if (!ret) {
+      return;
+    }
+
+    // Each asset is decoded once.
+    TEST_CHECK(num_loads == 2);
+    TEST_MSG("num_loads %d", int(num_loads));
+
+    TEST_CHECK(scene.textures.size() == 4);
+    // (a.png, sRGB), (b.png, sRGB), (a.png, raw)
+    TEST_CHECK(scene.images.size() == 3);
+    TEST_CHECK(scene.buffers.size() == 3);
+    if ((scene.textures.size() != 4) || (scene.images.size() != 3)) {
+      return;
+    }
+
+    TEST_CHECK(scene.textures[0].texture_image_id ==
+               scene.textures[2].texture_image_id);
+    TEST_CHECK(scene.textures[0].texture_image_id !=
+               scene.textures[1].texture_image_id);
+    TEST_CHECK(scene.textures[0].texture_image_id !=
+               scene.textures[3].texture_image_id);
+
+    const tydra::TextureImage &srgb_image =
+        scene.images[size_t(scene.textures[0].texture_image_id)];
+    const tydra::TextureImage &raw_image =
+        scene.images[size_t(scene.textures[3].texture_image_id)];
+    TEST_CHECK(srgb_image.usdColorSpace == tydra::ColorSpace::sRGB);
+    TEST_CHECK(raw_image.usdColorSpace == tydra::ColorSpace::Raw);
+    TEST_CHECK(srgb_image.buffer_id != raw_image.buffer_id);
+    TEST_CHECK(scene.buffers[size_t(srgb_image.buffer_id)].data ==
+               std::vector<uint8_t>(2 * 2 * 4, 64));
+    TEST_CHECK(scene.buffers[size_t(raw_image.buffer_id)].data ==
+               std::vector<uint8_t>(2 * 2 * 4, 64));
+
+    std::string dump = tydra::DumpRenderScene(scene);
+    if (num_threads == 1) {
+      serial_dump = dump;
+    } else {
+      TEST_CHECK(dump == serial_dump);
+    }
+  }
+}
+
+void tydra_vertex_welding_test(void) {
+  constexpr size_t G = 128;
+
+  auto Convert = [](const std::string &usda, int num_threads, float eps,
+                    tydra::RenderScene *scene) -> bool {
+    Stage stage;
+    std::string warn, err;
+    bool ret = LoadUSDAFromMemory(
+        reinterpret_cast<const uint8_t *>(usda.data()), usda.size(), "",
+        &stage, &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    if (!ret) {
+      return false;
+    }
+
+    tydra::RenderSceneConverterEnv env(stage);
+    env.scene_config.num_threads = num_threads;
+    env.mesh_config.facevarying_to_vertex_eps = eps;
+
+    tydra::RenderSceneConverter converter;
+    ret = converter.ConvertToRenderScene(env, scene);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", converter.GetError().c_str());
+    if (!ret) {
+      return false;
+    }
+
+    TEST_CHECK(scene->meshes.size() == 1);
+    return scene->meshes.size() == 1;
+  };
+
+  // Points on the seam are duplicated.
+  const size_t num_welded_points = (G + 1) * (G + 1) + (G + 1);
+
+  const std::string usda = MakeGridMeshUSDA(G, 2.0e-8f);
+
+  tydra::RenderScene serial_scene;
+  if (!Convert(usda, 1, std::numeric_limits<float>::epsilon(),
+               &serial_scene)) {
+    return;
+  }
+  TEST_CHECK(serial_scene.meshes[0].points.size() == num_welded_points);
+  TEST_MSG("# of points %d", int(serial_scene.meshes[0].points.size()));
+
+  // Welding large mesh in parallel.
+  tydra::RenderScene scene;
+  if (!Convert(usda, 4, std::numeric_limits<float>::epsilon(), &scene)) {
+    return;
+  }
+  TEST_CHECK(tydra::DumpRenderScene(scene) ==
+             tydra::DumpRenderScene(serial_scene));
+
+  // Perturbed normals are not merged when eps is zero.
+  tydra::RenderScene exact_scene;
+  if (!Convert(usda, 1, 0.0f, &exact_scene)) {
+    return;
+  }
+  TEST_CHECK(exact_scene.meshes[0].points.size() > num_welded_points);
+
+  // Unperturbed mesh gives the same result.
+  tydra::RenderScene unperturbed_scene;
+  if (!Convert(MakeGridMeshUSDA(G, 0.0f), 1, 0.0f, &unperturbed_scene)) {
+    return;
+  }
+  TEST_CHECK(unperturbed_scene.meshes[0].points.size() == num_welded_points);
+}
+
+void tydra_interleaved_vertex_buffer_test(void) {
+  // `quad` has texcoords in [0, 1]. `tiled` has texcoords outside of [-1, 1].
+  const std::string usda = R"(#usda 1.0
+
+def Mesh "quad"
+{
+    int[] faceVertexCounts = [4]
+    int[] faceVertexIndices = [0, 1, 2, 3]
+    normal3f[] normals = [(0, 0, 1), (0, 0, 1), (0, 0, 1), (0, 0, 1)] (
+        interpolation = "vertex"
+    )
+    point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)]
+    texCoord2f[] primvars:st = [(0, 0), (1, 0), (1, 1), (0, 1)] (
+        interpolation = "vertex"
+    )
+}
+
+def Mesh "tiled"
+{
+    int[] faceVertexCounts = [3]
+    int[] faceVertexIndices = [0, 1, 2]
+    point3f[] points = [(0, 0, 0), (1, 0, 0), (1, 1, 0)]
+    texCoord2f[] primvars:st = [(0, 0), (4, 0), (4, 4)] (
+        interpolation = "vertex"
+    )
+}
+)";
+
+  Stage stage;
+  std::string warn, err;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  if (!ret) {
+    return;
+  }
+
+  tydra::RenderSceneConverterEnv env(stage);
+  env.mesh_config.compute_tangents_and_binormals = false;
+  env.mesh_config.build_interleaved_vertex_buffer = true;
+  env.mesh_config.interleaved_half_normals = true;
+  env.mesh_config.interleaved_snorm16_texcoords = true;
+
+  tydra::RenderScene scene;
+  tydra::RenderSceneConverter converter;
+  ret = converter.ConvertToRenderScene(env, &scene);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", converter.GetError().c_str());
+  TEST_CHECK(scene.meshes.size() == 2);
+  if (!ret || (scene.meshes.size() != 2)) {
+    return;
+  }
+
+  const tydra::RenderMesh &quad = scene.meshes[0];
+  const tydra::RenderMesh &tiled = scene.meshes[1];
+  const tydra::InterleavedVertexBuffer &qbuf = quad.interleaved_buffer;
+  const tydra::InterleavedVertexBuffer &tbuf = tiled.interleaved_buffer;
+
+  TEST_CHECK(!qbuf.empty());
+  TEST_CHECK(!tbuf.empty());
+  if (qbuf.empty() || tbuf.empty()) {
+    return;
+  }
+
+  // Both meshes share one buffer.
+  TEST_CHECK(qbuf.buffer_id == tbuf.buffer_id);
+  TEST_CHECK(size_t(qbuf.buffer_id) < scene.buffers.size());
+  TEST_CHECK((qbuf.vertex_offset % 16) == 0);
+  TEST_CHECK((qbuf.index_offset % 16) == 0);
+  TEST_CHECK((tbuf.vertex_offset % 16) == 0);
+  TEST_CHECK((tbuf.index_offset % 16) == 0);
+
+  // position(float3) + normal(half4) + texcoord_0(snorm16x2)
+  const tydra::InterleavedVertexAttribute *pos =
+      qbuf.find_attribute("position");
+  const tydra::InterleavedVertexAttribute *nrm = qbuf.find_attribute("normal");
+  const tydra::InterleavedVertexAttribute *uv =
+      qbuf.find_attribute("texcoord_0");
+  TEST_CHECK(pos && nrm && uv);
+  if (!pos || !nrm || !uv) {
+    return;
+  }
+  TEST_CHECK(qbuf.vertex_stride == 12 + 8 + 4);
+  TEST_CHECK(nrm->format == tydra::VertexAttributeFormat::Half4);
+  TEST_CHECK(uv->format == tydra::VertexAttributeFormat::Short2);
+  TEST_CHECK(uv->normalized);
+  TEST_CHECK(qbuf.vertex_count == quad.points.size());
+  TEST_CHECK(qbuf.index_type == tydra::ComponentType::UInt16);
+  TEST_CHECK(qbuf.index_count == quad.faceVertexIndices().size());
+
+  const std::vector<uint8_t> &data = scene.buffers[size_t(qbuf.buffer_id)].data;
+  TEST_CHECK(tbuf.index_offset + tbuf.index_count * sizeof(uint16_t) <=
+             data.size());
+
+  const float *uvs = reinterpret_cast<const float *>(
+      quad.texcoords.at(0).get_data().data());
+  for (size_t v = 0; v < qbuf.vertex_count; v++) {
+    const uint8_t *vtx = data.data() + qbuf.vertex_offset + v * qbuf.vertex_stride;
+
+    float p[3];
+    memcpy(p, vtx + pos->offset, sizeof(p));
+    TEST_CHECK(p[0] == quad.points[v][0]);
+    TEST_CHECK(p[1] == quad.points[v][1]);
+    TEST_CHECK(p[2] == quad.points[v][2]);
+
+    value::half n[4];
+    memcpy(n, vtx + nrm->offset, sizeof(n));
+    TEST_CHECK(value::half_to_float(n[2]) == 1.0f);
+    TEST_CHECK(value::half_to_float(n[3]) == 0.0f);
+
+    int16_t q[2];
+    memcpy(q, vtx + uv->offset, sizeof(q));
+    TEST_CHECK(q[0] == int16_t(uvs[2 * v + 0] * 32767.0f));
+    TEST_CHECK(q[1] == int16_t(uvs[2 * v + 1] * 32767.0f));
+  }
+
+  const std::vector<uint32_t> &indices = quad.faceVertexIndices();
+  for (size_t i = 0; i < indices.size(); i++) {
+    uint16_t idx;
+    memcpy(&idx, data.data() + qbuf.index_offset + i * sizeof(uint16_t),
+           sizeof(uint16_t));
+    TEST_CHECK(idx == indices[i]);
+  }
+
+  // Texcoords of `tiled` cannot be represented in snorm16.
+  const tydra::InterleavedVertexAttribute *tuv =
+      tbuf.find_attribute("texcoord_0");
+  TEST_CHECK(tuv && (tuv->format == tydra::VertexAttributeFormat::Vec2));
+  TEST_CHECK(tuv && !tuv->normalized);
+
+  // 32bit indices
+  env.mesh_config.interleaved_uint16_indices = false;
+  tydra::RenderScene scene32;
+  tydra::RenderSceneConverter converter32;
+  TEST_CHECK(converter32.ConvertToRenderScene(env, &scene32));
+  TEST_CHECK(scene32.meshes.size() == 2);
+  if (scene32.meshes.size() == 2) {
+    TEST_CHECK(scene32.meshes[0].interleaved_buffer.index_type ==
+               tydra::ComponentType::UInt32);
+  }
+}
+
+void tydra_incremental_update_test(void) {
+  std::string usda = MakeTexturedMaterialsUSDA();
+
+  for (int num_threads : {1, 4}) {
+    Stage stage;
+    std::string warn, err;
+    bool ret = LoadUSDAFromMemory(
+        reinterpret_cast<const uint8_t *>(usda.data()), usda.size(), "",
+        &stage, &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    if (!ret) {
+      return;
+    }
+
+    std::atomic<int> num_loads{0};
+
+    tydra::RenderSceneConverterEnv env(stage);
+    env.scene_config.num_threads = num_threads;
+    env.scene_config.load_texture_assets = true;
+    env.material_config.preserve_texel_bitdepth = true;
+    env.material_config.texture_image_loader_function = TestTextureLoader;
+    env.material_config.texture_image_loader_function_userdata = &num_loads;
+
+    auto FullConversionDump = [&]() {
+      tydra::RenderScene scene;
+      tydra::RenderSceneConverter converter;
+      TEST_CHECK(converter.ConvertToRenderScene(env, &scene));
+      return tydra::DumpRenderScene(scene);
+    };
+
+    tydra::RenderSceneConverter converter;
+    tydra::RenderScene scene;
+    tydra::RenderSceneDiff diff;
+
+    // The first update converts everything.
+    ret = converter.UpdateRenderScene(env, &scene, &diff);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", converter.GetError().c_str());
+    if (!ret) {
+      return;
+    }
+    TEST_CHECK(diff.full_conversion);
+    TEST_CHECK(diff.changed_meshes.size() == 4);
+    TEST_CHECK(diff.changed_materials.size() == 4);
+    TEST_CHECK(diff.changed_images.size() == 3);
+    TEST_CHECK(num_loads == 2);
+
+    // Nothing changed.
+    TEST_CHECK(converter.UpdateRenderScene(env, &scene, &diff));
+    TEST_CHECK(diff.empty());
+    TEST_CHECK(num_loads == 2);
+    TEST_CHECK(tydra::DumpRenderScene(scene) == FullConversionDump());
+
+    // Edit `points` of /mesh1.
+    const Prim *prim{nullptr};
+    TEST_CHECK(stage.find_prim_at_path(Path("/mesh1", ""), prim, &err));
+    if (!prim || !prim->as<GeomMesh>()) {
+      return;
+    }
+    GeomMesh *mesh = const_cast<GeomMesh *>(prim->as<GeomMesh>());
+    std::vector<value::point3f> points = {
+        {0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 0.0f}};
+    mesh->points.set_value(points);
+
+    num_loads = 0;
+    TEST_CHECK(converter.UpdateRenderScene(env, &scene, &diff));
+    TEST_CHECK(!diff.full_conversion);
+    TEST_CHECK(diff.changed_meshes.size() == 1);
+    if (diff.changed_meshes.size() == 1) {
+      TEST_CHECK(scene.meshes[diff.changed_meshes[0]].abs_path == "/mesh1");
+    }
+    TEST_CHECK(diff.changed_materials.empty());
+    TEST_CHECK(diff.changed_images.empty());
+    TEST_CHECK(diff.changed_nodes.empty());
+    TEST_CHECK(num_loads == 0);
+    TEST_CHECK(tydra::DumpRenderScene(scene) == FullConversionDump());
+  }
+
+  // Meshes bound to a Skeleton are always converted.
+  {
+    usda = MakeMeshesUSDA(6);
+
+    Stage stage;
+    std::string warn, err;
+    TEST_CHECK(LoadUSDAFromMemory(
+        reinterpret_cast<const uint8_t *>(usda.data()), usda.size(), "",
+        &stage, &warn, &err));
+
+    tydra::RenderSceneConverterEnv env(stage);
+    tydra::RenderSceneConverter converter;
+    tydra::RenderScene scene;
+    tydra::RenderSceneDiff diff;
+    TEST_CHECK(converter.UpdateRenderScene(env, &scene, &diff));
+    TEST_CHECK(converter.UpdateRenderScene(env, &scene, &diff));
+    TEST_CHECK(diff.changed_meshes.size() == 2);
+    TEST_CHECK(diff.changed_materials.empty());
+
+    tydra::RenderScene full_scene;
+    TEST_CHECK(ConvertStage(stage, /* num_threads */ 1, &full_scene));
+    TEST_CHECK(tydra::DumpRenderScene(scene) ==
+               tydra::DumpRenderScene(full_scene));
+  }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+void tydra_parallel_mesh_convert_test(void);
+void tydra_shared_texture_image_test(void);
+void tydra_vertex_welding_test(void);
+void tydra_interleaved_vertex_buffer_test(void);
+void tydra_incremental_update_test(void);
@@ -0,0 +1,196 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include "unit-usda-reader.h"
+#include "ascii-parser.hh"
+#include "pprinter.hh"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "stream-reader.hh"
+#include "tinyusdz.hh"
+
+using namespace tinyusdz;
+
+void usda_scan_root_prim_blocks_test(void) {
+  // Brackets in strings, paths, asset paths and comments must be ignored.
+  std::string usda = R"(#usda 1.0
+(
+  doc = "}"
+)
+
+def Xform "a" (
+  customData = { int x = 1 }
+)
+{
+  string s = "} { \" }"
+  asset tex = @a}.png@
+  rel r = </a{v=x}>
+  # }
+}
+
+over "b" { string t = """ } """ }
+# trailing
+)";
+
+  StreamReader sr(reinterpret_cast<const uint8_t *>(usda.data()), usda.size(),
+                  /* swap endian */ false);
+  ascii::AsciiParser parser(&sr);
+  TEST_CHECK(parser.ParseHeaderAndStageMetas());
+
+  std::vector<ascii::AsciiParser::BlockRange> blocks;
+  TEST_CHECK(parser.ScanRootPrimBlocks(&blocks));
+  TEST_CHECK(blocks.size() == 2);
+  if (blocks.size() == 2) {
+    TEST_CHECK(blocks[0].end == blocks[1].begin);
+    TEST_CHECK(blocks[1].end == usda.size());
+
+    std::string b0 = usda.substr(size_t(blocks[0].begin),
+                                 size_t(blocks[0].end - blocks[0].begin));
+    TEST_CHECK(b0.find("def Xform \"a\"") != std::string::npos);
+    TEST_CHECK(b0.find("over") == std::string::npos);
+
+    // Row(0-based) at the beginning of the second block, i.e. the line of
+    // the closing brace of the first block.
+    TEST_CHECK(blocks[1].cursor.row == 13);
+  }
+
+  // Unbalanced brackets.
+  std::string bad = "#usda 1.0\ndef \"a\" { int x = [1 }\n";
+  StreamReader sr_bad(reinterpret_cast<const uint8_t *>(bad.data()),
+                      bad.size(), /* swap endian */ false);
+  ascii::AsciiParser bad_parser(&sr_bad);
+  TEST_CHECK(bad_parser.ParseHeaderAndStageMetas());
+  TEST_CHECK(!bad_parser.ScanRootPrimBlocks(&blocks));
+}
+
+void usda_parallel_parse_test(void) {
+  // Large enough to use threads.
+  std::string usda = "#usda 1.0\n(\n  defaultPrim = \"p0\"\n)\n";
+  for (size_t i = 0; i < 2000; i++) {
+    std::string name = "p" + std::to_string(i);
+    usda += "def Xform \"" + name + "\" (\n  variants = { string v = \"a\" }\n"
+            "  prepend variantSets = \"v\"\n)\n{\n"
+            "  double3 xformOp:translate = (" + std::to_string(i) + ", 0, 0)\n"
+            "  uniform token[] xformOpOrder = [\"xformOp:translate\"]\n"
+            "  def Mesh \"m\" {\n    point3f[] points = [(0, 0, 0), (1, 0, 0)]\n  }\n"
+            "  variantSet \"v\" = {\n    \"a\" { def Xform \"va\" {} }\n"
+            "    \"b\" { def Xform \"vb\" {} }\n  }\n}\n";
+  }
+
+  const uint8_t *addr = reinterpret_cast<const uint8_t *>(usda.data());
+
+  USDLoadOptions options;
+  options.num_threads = 4;
+
+  // Parallel parsing is opt-in.
+  Stage stage;
+  std::string warn, err;
+  TEST_CHECK(LoadUSDAFromMemory(addr, usda.size(), "", &stage, &warn, &err,
+                                options));
+  Layer layer;
+  TEST_CHECK(LoadLayerFromMemory(addr, usda.size(), "test.usda", &layer, &warn,
+                                 &err, options));
+
+  options.usda_parallel_parse = true;
+
+  Stage mt_stage;
+  TEST_CHECK(LoadUSDAFromMemory(addr, usda.size(), "", &mt_stage, &warn, &err,
+                                options));
+  Layer mt_layer;
+  TEST_CHECK(LoadLayerFromMemory(addr, usda.size(), "test.usda", &mt_layer,
+                                 &warn, &err, options));
+
+  TEST_CHECK(stage.root_prims().size() == 2000);
+  TEST_CHECK(stage.ExportToString() == mt_stage.ExportToString());
+  TEST_CHECK(to_string(layer) == to_string(mt_layer));
+
+  // Parse error must be reported with the same location as single-threaded
+  // parsing.
+  std::string bad = usda;
+  size_t pos = bad.find("def Xform \"p1000\"");
+  TEST_CHECK(pos != std::string::npos);
+  bad.insert(pos, "def Xform \"bad\" { float x = @ }\n");
+
+  const uint8_t *bad_addr = reinterpret_cast<const uint8_t *>(bad.data());
+
+  std::string st_err;
+  options.usda_parallel_parse = false;
+  TEST_CHECK(!LoadUSDAFromMemory(bad_addr, bad.size(), "", &stage, &warn,
+                                 &st_err, options));
+
+  std::string mt_err;
+  options.usda_parallel_parse = true;
+  TEST_CHECK(!LoadUSDAFromMemory(bad_addr, bad.size(), "", &mt_stage, &warn,
+                                 &mt_err, options));
+  TEST_CHECK(st_err == mt_err);
+}
+
+void usda_load_stats_test(void) {
+  std::string usda = R"(#usda 1.0
+def Xform "root"
+{
+  def Mesh "mesh"
+  {
+    int[] faceVertexCounts = [3]
+    int[] faceVertexIndices = [0, 1, 2]
+    point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0)]
+    float3 xformOp:translate.timeSamples = {
+      0: (0, 0, 0),
+      1: (1, 0, 0),
+    }
+    uniform token[] xformOpOrder = ["xformOp:translate"]
+    rel material:binding = </root/mat>
+  }
+}
+)";
+
+  const uint8_t *addr = reinterpret_cast<const uint8_t *>(usda.data());
+  std::string warn, err;
+
+  // Nothing is recorded without `stats`.
+  USDLoadOptions options;
+  Stage stage;
+  TEST_CHECK(LoadUSDAFromMemory(addr, usda.size(), "", &stage, &warn, &err,
+                                options));
+
+  performance::LoadStats stats;
+  options.stats = &stats;
+  TEST_CHECK(LoadUSDAFromMemory(addr, usda.size(), "", &stage, &warn, &err,
+                                options));
+  TEST_MSG("%s", err.c_str());
+
+  TEST_CHECK(stats.bytes_read == usda.size());
+  TEST_CHECK(stats.counts.num_prims == 2);
+  TEST_CHECK(stats.counts.num_attributes == 5);
+  TEST_CHECK(stats.counts.num_relationships == 1);
+  TEST_CHECK(stats.counts.num_timesamples == 2);
+  // `token[]`(xformOpOrder) is not counted as an array value.
+  TEST_CHECK(stats.counts.num_arrays == 3);
+  TEST_CHECK(stats.counts.array_bytes > 0);
+  TEST_CHECK(stats.peak_memory_estimate > 0);
+
+  TEST_CHECK(stats.phases.size() >= 2);
+  bool has_parse = false;
+  for (const auto &phase : stats.phases) {
+    TEST_CHECK(phase.duration_ms >= 0.0);
+    has_parse |= (phase.name == "usda:parse");
+  }
+  TEST_CHECK(has_parse);
+
+  std::string json = performance::ToChromeTraceJSON(stats);
+  TEST_CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  TEST_CHECK(json.find("\"usda:parse\"") != std::string::npos);
+
+  // Statistics are accumulated until clear().
+  const uint64_t bytes_read = stats.bytes_read;
+  TEST_CHECK(LoadUSDAFromMemory(addr, usda.size(), "", &stage, &warn, &err,
+                                options));
+  TEST_CHECK(stats.bytes_read == 2 * bytes_read);
+  stats.clear();
+  TEST_CHECK(stats.phases.empty());
+  TEST_CHECK(stats.bytes_read == 0);
+}
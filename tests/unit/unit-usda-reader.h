@@ -0,0 +1,5 @@
+#pragma once
+
+void usda_scan_root_prim_blocks_test(void);
+void usda_parallel_parse_test(void);
+void usda_load_stats_test(void);
@@ -0,0 +1,147 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <sstream>
+#include <type_traits>
+
+#include "unit-usda-writer.h"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "usda-writer.hh"
+#include "value-pprint.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+struct ChunkCollector {
+  std::string text;
+  size_t num_chunks{0};
+  size_t max_chunk_size{0};
+  size_t fail_after{0};  // 0 = never fail
+};
+
+bool CollectChunk(const char *data, size_t size, void *userdata) {
+  ChunkCollector *c = reinterpret_cast<ChunkCollector *>(userdata);
+  if (c->fail_after && (c->num_chunks >= c->fail_after)) {
+    return false;
+  }
+  c->text.append(data, size);
+  c->num_chunks++;
+  c->max_chunk_size = (std::max)(c->max_chunk_size, size);
+  return true;
+}
+
+}  // namespace
+
+void usda_writer_stream_test(void) {
+  // Large enough to be formatted in parallel chunks.
+  const size_t num_points = 200 * 1000;
+
+  std::stringstream usda;
+  usda << "#usda 1.0\n(\n    defaultPrim = \"root\"\n)\n\n";
+  usda << "def Xform \"root\" (\n    variants = {\n        string shapes = \"a\"\n    }\n    prepend variantSets = \"shapes\"\n)\n{\n";
+  usda << "    def Mesh \"mesh\"\n    {\n        point3f[] points = [";
+  for (size_t i = 0; i < num_points; i++) {
+    if (i > 0) {
+      usda << ", ";
+    }
+    usda << "(" << i << ", " << (float(i) * 0.25f) << ", -1.5)";
+  }
+  usda << "]\n        float[] primvars:w = [";
+  for (size_t i = 0; i < num_points; i++) {
+    if (i > 0) {
+      usda << ", ";
+    }
+    usda << (float(i) * 0.125f);
+  }
+  usda << "]\n    }\n\n    def Xform \"child\"\n    {\n    }\n\n";
+  usda << "    variantSet \"shapes\" = {\n        \"a\" {\n            def Xform \"va\"\n            {\n            }\n        }\n    }\n}\n";
+
+  const std::string usda_str = usda.str();
+
+  std::string warn, err;
+  Stage stage;
+  bool ret = LoadUSDAFromMemory(
+      reinterpret_cast<const uint8_t *>(usda_str.data()), usda_str.size(),
+      "test.usda", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  const std::string expected = stage.ExportToString();
+  TEST_CHECK(expected.find("def Xform \"va\"") != std::string::npos);
+
+  {
+    std::stringstream ss;
+    stage.ExportToStream(ss);
+    TEST_CHECK(ss.str() == expected);
+  }
+
+  {
+    usda::USDAWriterConfig config;
+    config.buffer_size = 4096;
+
+    ChunkCollector collector;
+    ret = usda::SaveAsUSDA(CollectChunk, &collector, stage, &warn, &err,
+                           config);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(collector.text == expected);
+    TEST_CHECK(collector.num_chunks > 1);
+  }
+
+  {
+    // Abort writing.
+    ChunkCollector collector;
+    collector.fail_after = 1;
+
+    usda::USDAWriterConfig config;
+    config.buffer_size = 256;
+
+    err.clear();
+    ret = usda::SaveAsUSDA(CollectChunk, &collector, stage, &warn, &err,
+                           config);
+    TEST_CHECK(!ret);
+    TEST_CHECK(!err.empty());
+  }
+
+  // Parallel array formatting gives the same text as serial formatting.
+  {
+    std::vector<value::point3f> points(num_points);
+    std::vector<float> ws(num_points);
+    for (size_t i = 0; i < num_points; i++) {
+      points[i] = {float(i) * 0.1f, float(i) * 0.25f, -1.5f};
+      ws[i] = float(i) / 3.0f;
+    }
+
+    // Each half is formatted serially.
+    const size_t half = num_points / 2;
+    auto print_halves = [&](const auto &v) {
+      using T = typename std::decay<decltype(v)>::type;
+      T first(v.begin(), v.begin() + std::ptrdiff_t(half));
+      T second(v.begin() + std::ptrdiff_t(half), v.end());
+
+      std::stringstream s0, s1;
+      s0 << first;
+      s1 << second;
+
+      std::string a = s0.str();
+      std::string b = s1.str();
+      // strip ']' and '['
+      return a.substr(0, a.size() - 1) + ", " + b.substr(1);
+    };
+
+    std::stringstream ss_points;
+    ss_points << points;
+    TEST_CHECK(ss_points.str() == print_halves(points));
+
+    std::stringstream ss_ws;
+    ss_ws << ws;
+    TEST_CHECK(ss_ws.str() == print_halves(ws));
+  }
+}
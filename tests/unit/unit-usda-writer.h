@@ -0,0 +1,3 @@
+#pragma once
+
+void usda_writer_stream_test(void);
@@ -0,0 +1,286 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include "unit-usdc-writer.h"
+#include "crate-writer.hh"
+#include "pprinter.hh"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "usdc-writer.hh"
+
+using namespace tinyusdz;
+
+void crate_writer_inline_test(void) {
+  // Exactly representable as float.
+  TEST_CHECK(crate::TryEncodeInline(1.5).has_value());
+  TEST_CHECK(!crate::TryEncodeInline(0.1).has_value());
+
+  TEST_CHECK(crate::TryEncodeInline(int64_t(-3)).has_value());
+  TEST_CHECK(!crate::TryEncodeInline(int64_t(1) << 40).has_value());
+
+  // Vector whose components fit in int8.
+  value::float3 v0 = {1.0f, -2.0f, 127.0f};
+  TEST_CHECK(crate::TryEncodeInline(v0).has_value());
+
+  value::float3 v1 = {1.5f, 0.0f, 0.0f};
+  TEST_CHECK(!crate::TryEncodeInline(v1).has_value());
+
+  // Diagonal matrix
+  value::matrix4d m;  // identity
+  TEST_CHECK(crate::TryEncodeInline(m).has_value());
+  m.m[0][1] = 1.0;
+  TEST_CHECK(!crate::TryEncodeInline(m).has_value());
+}
+
+void crate_writer_dedup_test(void) {
+  std::vector<value::float3> points(1000);
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = {float(i), 0.5f * float(i), 0.0f};
+  }
+
+  {
+    crate::CrateWriter writer;
+
+    crate::ValueRep rep0, rep1;
+    TEST_CHECK(writer.PackValue(value::Value(points), &rep0));
+    TEST_CHECK(writer.PackValue(value::Value(points), &rep1));
+
+    // Same data offset.
+    TEST_CHECK(rep0 == rep1);
+    TEST_CHECK(rep0.IsArray());
+    TEST_CHECK(!rep0.IsInlined());
+  }
+
+  {
+    crate::CrateWriterConfig config;
+    config.dedupValues = false;
+    crate::CrateWriter writer(config);
+
+    crate::ValueRep rep0, rep1;
+    TEST_CHECK(writer.PackValue(value::Value(points), &rep0));
+    TEST_CHECK(writer.PackValue(value::Value(points), &rep1));
+    TEST_CHECK(rep0 != rep1);
+  }
+
+  {
+    // Integer array is compressed.
+    std::vector<int32_t> indices(1000);
+    for (size_t i = 0; i < indices.size(); i++) {
+      indices[i] = int32_t(i % 7);
+    }
+
+    crate::CrateWriter writer;
+    crate::ValueRep rep;
+    TEST_CHECK(writer.PackValue(value::Value(indices), &rep));
+    TEST_CHECK(rep.IsCompressed());
+  }
+}
+
+void usdc_writer_roundtrip_test(void) {
+  const std::string usda = R"(#usda 1.0
+(
+    defaultPrim = "root"
+    metersPerUnit = 0.01
+    upAxis = "Z"
+)
+
+def Xform "root" (
+    customData = {
+        string author = "tinyusdz"
+        int version = 3
+    }
+    kind = "component"
+    variants = {
+        string shapes = "big"
+    }
+    prepend variantSets = "shapes"
+)
+{
+    double3 xformOp:translate.timeSamples = {
+        0: (0, 0, 0),
+        10: (1.5, 2, 3),
+    }
+    uniform token[] xformOpOrder = ["xformOp:translate"]
+
+    def Mesh "mesh" (
+        prepend references = @./ref.usda@</ref>
+    )
+    {
+        int[] faceVertexCounts = [3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3]
+        int[] faceVertexIndices = [0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3, 0, 1, 2, 2, 1, 3]
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0), (1, 1, 0.25)]
+        texCoord2f[] primvars:uv = [(0, 0), (1, 0), (0, 1), (1, 1)] (
+            interpolation = "vertex"
+        )
+        rel material:binding = </root/mat>
+    }
+
+    def Material "mat"
+    {
+        token outputs:surface.connect = </root/mat/shader.outputs:surface>
+
+        def Shader "shader"
+        {
+            uniform token info:id = "UsdPreviewSurface"
+            color3f inputs:diffuseColor = (0.25, 0.5, 0.75)
+            token outputs:surface
+        }
+    }
+
+    variantSet "shapes" = {
+        "big" {
+            float size = 10
+        }
+        "small" {
+            float size = 1
+        }
+    }
+}
+
+over "tail"
+{
+}
+)";
+
+  std::string warn, err;
+
+  Stage stage;
+  bool ret = LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "test.usda", &stage, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  Layer layer;
+  ret = LoadUSDALayerFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                usda.size(), "test.usda", &layer, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  std::vector<uint8_t> usdc;
+  ret = usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  TEST_CHECK(usdc.size() > 88);
+
+  Stage usdc_stage;
+  ret = LoadUSDCFromMemory(usdc.data(), usdc.size(), "test.usdc", &usdc_stage,
+                           &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  TEST_CHECK(stage.ExportToString() == usdc_stage.ExportToString());
+  TEST_MSG("USDA:\n%s\nUSDC:\n%s", stage.ExportToString().c_str(),
+           usdc_stage.ExportToString().c_str());
+
+  Layer usdc_layer;
+  ret = LoadUSDCLayerFromMemory(usdc.data(), usdc.size(), "test.usdc",
+                                &usdc_layer, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+  TEST_CHECK(usdc_layer.primspecs().size() == 2);
+  TEST_CHECK(usdc_layer.metas().defaultPrim.str() == "root");
+  // 0.01 is not representable as float, so must be stored out-of-line.
+  TEST_CHECK(usdc_layer.metas().metersPerUnit.get_value() == 0.01);
+}
+
+void usdc_lazy_array_unpack_test(void) {
+  // Two meshes share identical `points` and `extent` fields, so their values
+  // are deduplicated in Crate and requested from multiple Specs.
+  std::string usda = R"(#usda 1.0
+(
+    defaultPrim = "root"
+)
+
+def Xform "root"
+{
+    double3 xformOp:translate.timeSamples = {
+        0: (0.0, 0.0, 0.0),
+        10: (1.5, 2.0, 3.0),
+    }
+    uniform token[] xformOpOrder = ["xformOp:translate"]
+
+    def Mesh "mesh0"
+    {
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0), (1, 1, 0.25)]
+        int[] faceVertexIndices = [0, 1, 2, 2, 1, 3]
+        int[] faceVertexCounts = [3, 3]
+        float[] primvars:w = [0.5, 1.5, 2.5, 3.5]
+    }
+
+    def Mesh "mesh1"
+    {
+        point3f[] points = [(0, 0, 0), (1, 0, 0), (0, 1, 0), (1, 1, 0.25)]
+        int[] faceVertexIndices = [0, 1, 2, 2, 1, 3]
+        int[] faceVertexCounts = [3, 3]
+        float[] primvars:w = [0.5, 1.5, 2.5, 3.5]
+    }
+}
+)";
+
+  std::string warn, err;
+
+  Layer layer;
+  bool ret = LoadUSDALayerFromMemory(
+      reinterpret_cast<const uint8_t *>(usda.data()), usda.size(), "test.usda",
+      &layer, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  std::vector<uint8_t> usdc;
+  ret = usdc::SaveAsUSDCToMemory(layer, &usdc, &warn, &err);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  USDLoadOptions options;
+  Stage stage;
+  ret = LoadUSDCFromMemory(usdc.data(), usdc.size(), "test.usdc", &stage,
+                           &warn, &err, options);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  USDLoadOptions lazy_options;
+  lazy_options.lazy_array_unpack = true;
+
+  Stage lazy_stage;
+  ret = LoadUSDCFromMemory(usdc.data(), usdc.size(), "test.usdc", &lazy_stage,
+                           &warn, &err, lazy_options);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  TEST_CHECK(stage.ExportToString() == lazy_stage.ExportToString());
+  TEST_MSG("eager:\n%s\nlazy:\n%s", stage.ExportToString().c_str(),
+           lazy_stage.ExportToString().c_str());
+
+  // Values shared by both meshes must be decoded for each of them.
+  const Prim *mesh1{nullptr};
+  ret = lazy_stage.find_prim_at_path(Path("/root/mesh1", ""), mesh1, &err);
+  TEST_CHECK(ret);
+  if (ret) {
+    const GeomMesh *mesh = mesh1->as<GeomMesh>();
+    TEST_CHECK(mesh != nullptr);
+    if (mesh) {
+      std::vector<value::point3f> points = mesh->get_points();
+      TEST_CHECK(points.size() == 4);
+    }
+  }
+
+  // Layer path
+  Layer eager_layer;
+  ret = LoadUSDCLayerFromMemory(usdc.data(), usdc.size(), "test.usdc",
+                                &eager_layer, &warn, &err, options);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  Layer lazy_layer;
+  ret = LoadUSDCLayerFromMemory(usdc.data(), usdc.size(), "test.usdc",
+                                &lazy_layer, &warn, &err, lazy_options);
+  TEST_CHECK(ret);
+  TEST_MSG("%s", err.c_str());
+
+  TEST_CHECK(to_string(eager_layer) == to_string(lazy_layer));
+}
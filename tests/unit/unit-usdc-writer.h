@@ -0,0 +1,6 @@
+#pragma once
+
+void crate_writer_inline_test(void);
+void crate_writer_dedup_test(void);
+void usdc_writer_roundtrip_test(void);
+void usdc_lazy_array_unpack_test(void);
@@ -0,0 +1,315 @@
+#ifdef _MSC_VER
+#define NOMINMAX
+#endif
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "unit-usdz.h"
+#include "prim-types.hh"
+#include "stage.hh"
+#include "tinyusdz.hh"
+#include "usdz-writer.hh"
+
+using namespace tinyusdz;
+
+namespace {
+
+//
+// Build USDZ(uncompressed ZIP whose entry data is 64 bytes aligned).
+// When `data_descriptor` is true, sizes in local file headers are zero and
+// only the central directory has them(as done by streaming ZIP writers).
+//
+std::vector<uint8_t> BuildUSDZ(
+    const std::vector<std::pair<std::string, std::string>> &files,
+    bool data_descriptor, size_t *central_directory_offset = nullptr) {
+  std::vector<uint8_t> buf;
+
+  auto put16 = [&buf](uint32_t v) {
+    buf.push_back(uint8_t(v & 0xff));
+    buf.push_back(uint8_t((v >> 8) & 0xff));
+  };
+  auto put32 = [&](uint32_t v) {
+    put16(v & 0xffff);
+    put16(v >> 16);
+  };
+
+  std::vector<uint32_t> offsets;
+  for (const auto &file : files) {
+    offsets.push_back(uint32_t(buf.size()));
+
+    const size_t header_end = buf.size() + 30 + file.first.size() + 4;
+    const size_t padding = (64 - (header_end % 64)) % 64;
+    const uint32_t size = data_descriptor ? 0 : uint32_t(file.second.size());
+
+    put32(0x04034b50);
+    put16(20);                        // version needed
+    put16(data_descriptor ? 8 : 0);  // flags
+    put16(0);                         // compression(stored)
+    put16(0);                         // time
+    put16(0);                         // date
+    put32(0);                         // crc32
+    put32(size);
+    put32(size);
+    put16(uint32_t(file.first.size()));
+    put16(uint32_t(4 + padding));
+    buf.insert(buf.end(), file.first.begin(), file.first.end());
+    put16(0x1986);  // padding extra field
+    put16(uint32_t(padding));
+    buf.resize(buf.size() + padding, 0);
+    buf.insert(buf.end(), file.second.begin(), file.second.end());
+  }
+
+  const uint32_t cd_offset = uint32_t(buf.size());
+  for (size_t i = 0; i < files.size(); i++) {
+    put32(0x02014b50);
+    put16(20);  // version made by
+    put16(20);  // version needed
+    put16(data_descriptor ? 8 : 0);
+    put16(0);
+    put16(0);
+    put16(0);
+    put32(0);
+    put32(uint32_t(files[i].second.size()));
+    put32(uint32_t(files[i].second.size()));
+    put16(uint32_t(files[i].first.size()));
+    put16(0);  // extra
+    put16(0);  // comment
+    put16(0);  // disk
+    put16(0);  // internal attr
+    put32(0);  // external attr
+    put32(offsets[i]);
+    buf.insert(buf.end(), files[i].first.begin(), files[i].first.end());
+  }
+  const uint32_t cd_size = uint32_t(buf.size()) - cd_offset;
+
+  put32(0x06054b50);
+  put16(0);
+  put16(0);
+  put16(uint32_t(files.size()));
+  put16(uint32_t(files.size()));
+  put32(cd_size);
+  put32(cd_offset);
+  put16(0);
+
+  if (central_directory_offset) {
+    (*central_directory_offset) = cd_offset;
+  }
+
+  return buf;
+}
+
+bool AppendToVector(const uint8_t *data, size_t size, void *userdata) {
+  std::vector<uint8_t> *dst = reinterpret_cast<std::vector<uint8_t> *>(userdata);
+  dst->insert(dst->end(), data, data + size);
+  return true;
+}
+
+}  // namespace
+
+void usdz_central_directory_test(void) {
+  const std::string usda = "#usda 1.0\n\ndef Xform \"root\"\n{\n}\n";
+  const std::string png(1000, 'p');
+  const std::string bin(77, 'b');
+
+  std::vector<std::pair<std::string, std::string>> files;
+  files.emplace_back("scene.usda", usda);
+  files.emplace_back("textures/a.png", png);
+  files.emplace_back("data.bin", bin);
+
+  for (bool data_descriptor : {false, true}) {
+    size_t cd_offset = 0;
+    std::vector<uint8_t> usdz = BuildUSDZ(files, data_descriptor, &cd_offset);
+
+    std::string warn, err;
+    USDZAsset asset;
+    bool ret = ReadUSDZAssetInfoFromMemory(usdz.data(), usdz.size(),
+                                           /* asset_on_memory */ true, &asset,
+                                           &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(asset.asset_map.size() == 3);
+
+    for (const auto &file : files) {
+      const uint8_t *addr = nullptr;
+      size_t sz = 0;
+      TEST_CHECK(asset.find_asset(file.first, &addr, &sz));
+      TEST_CHECK(sz == file.second.size());
+
+      // No copy. Points into USDZ data with 64 bytes alignment.
+      TEST_CHECK(addr >= usdz.data());
+      TEST_CHECK(addr + sz <= usdz.data() + usdz.size());
+      TEST_CHECK(((addr - usdz.data()) % 64) == 0);
+      TEST_CHECK(std::string(reinterpret_cast<const char *>(addr), sz) ==
+                 file.second);
+    }
+    TEST_CHECK(!asset.find_asset("missing.png", nullptr, nullptr));
+
+    // Asset resolution callbacks
+    {
+      std::string resolved;
+      TEST_CHECK(USDZResolveAsset("./textures/a.png", {}, &resolved, &err,
+                                  &asset) == 0);
+      TEST_CHECK(resolved == "textures/a.png");
+      TEST_CHECK(USDZResolveAsset("b.png", {}, &resolved, &err, &asset) ==
+                 -1);
+
+      uint64_t nbytes = 0;
+      TEST_CHECK(USDZSizeAsset(resolved.c_str(), &nbytes, &err, &asset) == 0);
+      TEST_CHECK(nbytes == png.size());
+
+      std::vector<uint8_t> dst(png.size());
+      TEST_CHECK(USDZReadAsset(resolved.c_str(), dst.size(), dst.data(),
+                               &nbytes, &err, &asset) == 0);
+      TEST_CHECK(std::string(dst.begin(), dst.end()) == png);
+    }
+
+    Stage stage;
+    ret = LoadUSDZFromMemory(usdz.data(), usdz.size(), "test.usdz", &stage,
+                             &warn, &err);
+    TEST_CHECK(ret);
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(stage.root_prims().size() == 1);
+
+    if (!data_descriptor) {
+      // Without the central directory, fall back to scan local file headers.
+      USDZAsset partial;
+      ret = ReadUSDZAssetInfoFromMemory(usdz.data(), cd_offset,
+                                        /* asset_on_memory */ true, &partial,
+                                        &warn, &err);
+      TEST_CHECK(ret);
+      TEST_CHECK(partial.asset_map.size() == 3);
+      TEST_CHECK(partial.asset_map == asset.asset_map);
+    }
+  }
+
+  {
+    // USDZ only allows stored(uncompressed) entries.
+    size_t cd_offset = 0;
+    std::vector<uint8_t> usdz = BuildUSDZ(files, false, &cd_offset);
+    usdz[cd_offset + 10] = 8;  // deflate
+
+    std::string warn, err;
+    USDZAsset asset;
+    TEST_CHECK(!ReadUSDZAssetInfoFromMemory(usdz.data(), usdz.size(),
+                                            /* asset_on_memory */ true,
+                                            &asset, &warn, &err));
+    TEST_CHECK(!err.empty());
+  }
+}
+
+void usdz_writer_test(void) {
+  {
+    const std::string s = "123456789";
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(s.data());
+    TEST_CHECK(usdz::ComputeCRC32(p, s.size()) == 0xcbf43926u);
+    // Incremental
+    uint32_t crc = usdz::ComputeCRC32(p, 3);
+    crc = usdz::ComputeCRC32(p + 3, s.size() - 3, crc);
+    TEST_CHECK(crc == 0xcbf43926u);
+  }
+
+  const std::string usda = "#usda 1.0\n\ndef Xform \"root\"\n{\n}\n";
+
+  // Entry names of various lengths to exercise alignment padding.
+  std::vector<std::pair<std::string, std::string>> files;
+  files.emplace_back("scene.usda", usda);
+  for (size_t i = 0; i < 70; i++) {
+    files.emplace_back("t/" + std::string(i + 1, 'a') + ".png",
+                       std::string(i * 13, char('0' + (i % 10))));
+  }
+
+  // Through callback
+  {
+    std::vector<uint8_t> usdz;
+    usdz::USDZWriter writer;
+    TEST_CHECK(writer.Open(AppendToVector, &usdz));
+    for (size_t i = 0; i < files.size(); i++) {
+      const uint8_t *data =
+          reinterpret_cast<const uint8_t *>(files[i].second.data());
+      if (i % 2) {
+        TEST_CHECK(writer.AddFile(files[i].first, data, files[i].second.size()));
+      } else {
+        // Streamed
+        TEST_CHECK(writer.BeginFile(files[i].first));
+        const size_t half = files[i].second.size() / 2;
+        TEST_CHECK(writer.WriteFileData(data, half));
+        TEST_CHECK(writer.WriteFileData(data + half,
+                                        files[i].second.size() - half));
+        TEST_CHECK(writer.EndFile());
+      }
+    }
+    // Duplicated name
+    TEST_CHECK(!writer.AddFile("scene.usda", nullptr, 0));
+    TEST_CHECK(writer.Close());
+    TEST_MSG("%s", writer.GetError().c_str());
+
+    std::string warn, err;
+    USDZAsset asset;
+    TEST_CHECK(ReadUSDZAssetInfoFromMemory(usdz.data(), usdz.size(),
+                                           /* asset_on_memory */ true, &asset,
+                                           &warn, &err));
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(asset.asset_map.size() == files.size());
+
+    for (const auto &file : files) {
+      const uint8_t *addr = nullptr;
+      size_t sz = 0;
+      TEST_CHECK(asset.find_asset(file.first, &addr, &sz));
+      TEST_CHECK(((addr - usdz.data()) % 64) == 0);
+      TEST_CHECK(std::string(reinterpret_cast<const char *>(addr), sz) ==
+                 file.second);
+    }
+
+    Stage stage;
+    TEST_CHECK(LoadUSDZFromMemory(usdz.data(), usdz.size(), "test.usdz",
+                                  &stage, &warn, &err));
+    TEST_CHECK(stage.root_prims().size() == 1);
+  }
+
+  // Stage to a file
+  {
+    std::string warn, err;
+    Stage stage;
+    TEST_CHECK(LoadUSDAFromMemory(reinterpret_cast<const uint8_t *>(usda.data()),
+                                  usda.size(), "test.usda", &stage, &warn,
+                                  &err));
+
+    std::vector<usdz::USDZAssetEntry> assets;
+    for (size_t i = 1; i < files.size(); i++) {
+      assets.emplace_back(
+          files[i].first,
+          reinterpret_cast<const uint8_t *>(files[i].second.data()),
+          files[i].second.size());
+    }
+
+    const std::string filename = "unit-usdz-writer-test.usdz";
+    TEST_CHECK(usdz::SaveAsUSDZ(filename, stage, assets, &warn, &err));
+    TEST_MSG("%s", err.c_str());
+
+    USDZAsset asset;
+    TEST_CHECK(ReadUSDZAssetInfoFromFile(filename, &asset, &warn, &err));
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(asset.asset_map.size() == files.size());
+    TEST_CHECK(asset.asset_map.count("root.usda") == 1);
+
+    for (size_t i = 1; i < files.size(); i++) {
+      const uint8_t *addr = nullptr;
+      size_t sz = 0;
+      TEST_CHECK(asset.find_asset(files[i].first, &addr, &sz));
+      TEST_CHECK(std::string(reinterpret_cast<const char *>(addr), sz) ==
+                 files[i].second);
+    }
+
+    Stage usdz_stage;
+    TEST_CHECK(LoadUSDZFromFile(filename, &usdz_stage, &warn, &err));
+    TEST_MSG("%s", err.c_str());
+    TEST_CHECK(usdz_stage.ExportToString() == stage.ExportToString());
+  }
+}
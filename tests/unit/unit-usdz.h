@@ -0,0 +1,4 @@
+#pragma once
+
+void usdz_central_directory_test(void);
+void usdz_writer_test(void);
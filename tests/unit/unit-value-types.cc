@@ -5,6 +5,10 @@
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "unit-value-types.h"
 #include "value-types.hh"
 #include "math-util.inc"
@@ -41,3 +45,145 @@ void value_types_test(void) {
 
 }
 
+
+void value_cow_array_test(void) {
+  std::vector<value::point3f> pts(1000, {1.0f, 2.0f, 3.0f});
+
+  value::Value a(pts);
+  TEST_CHECK(a.get_raw().use_count() == 1);
+
+  // Copy shares the array buffer.
+  value::Value b = a;
+  TEST_CHECK(a.get_raw().use_count() == 2);
+  {
+    const value::Value &ca = a;
+    const value::Value &cb = b;
+    TEST_CHECK(ca.as<std::vector<value::point3f>>() == cb.as<std::vector<value::point3f>>());
+
+    // role type cast also refers the shared buffer.
+    TEST_CHECK(reinterpret_cast<const void *>(cb.as<std::vector<value::float3>>()) ==
+               reinterpret_cast<const void *>(ca.as<std::vector<value::point3f>>()));
+  }
+
+  // Non-const access copies the buffer(copy-on-write).
+  std::vector<value::point3f> *pb = b.as<std::vector<value::point3f>>();
+  TEST_CHECK(pb != nullptr);
+  TEST_CHECK(a.get_raw().use_count() == 1);
+  TEST_CHECK(b.get_raw().use_count() == 1);
+  if (pb) {
+    (*pb)[0][0] = 100.0f;
+  }
+
+  {
+    const value::Value &ca = a;
+    const std::vector<value::point3f> *pa = ca.as<std::vector<value::point3f>>();
+    TEST_CHECK(pa != nullptr);
+    if (pa) {
+      TEST_CHECK(math::is_close((*pa)[0][0], 1.0f));
+    }
+  }
+
+  // Move does not change the reference count.
+  value::Value c = a;
+  value::Value d = std::move(c);
+  TEST_CHECK(a.get_raw().use_count() == 2);
+  TEST_CHECK(d.get_raw().use_count() == 2);
+
+  // Release
+  d = 1.0f;
+  TEST_CHECK(a.get_raw().use_count() == 1);
+  TEST_CHECK(d.get_raw().use_count() == 1);
+
+  // A non-const pointer obtained before a copy must not alias the copy.
+  {
+    value::Value e(pts);
+    std::vector<value::point3f> *pe = e.as<std::vector<value::point3f>>();
+    TEST_CHECK(pe != nullptr);
+
+    value::Value f = e;
+    // `e` was handed out mutably, so the copy gets its own buffer.
+    TEST_CHECK(e.get_raw().use_count() == 1);
+    TEST_CHECK(f.get_raw().use_count() == 1);
+    if (pe) {
+      (*pe)[0][0] = 200.0f;
+    }
+
+    const value::Value &cf = f;
+    const std::vector<value::point3f> *pf = cf.as<std::vector<value::point3f>>();
+    TEST_CHECK(pf != nullptr);
+    if (pf) {
+      TEST_CHECK(math::is_close((*pf)[0][0], 1.0f));
+    }
+
+    const value::Value &ce = e;
+    const std::vector<value::point3f> *pce = ce.as<std::vector<value::point3f>>();
+    TEST_CHECK(pce != nullptr);
+    if (pce) {
+      TEST_CHECK(math::is_close((*pce)[0][0], 200.0f));
+    }
+
+    // Copies of a never-mutated copy are still shared.
+    value::Value g = f;
+    TEST_CHECK(f.get_raw().use_count() == 2);
+    TEST_CHECK(g.get_raw().use_count() == 2);
+  }
+}
+
+void value_token_pool_test(void) {
+#if !defined(TINYUSDZ_USE_STRING_ID_FOR_TOKEN_TYPE)
+  // Equal strings share the interned entry.
+  value::token a("primvars:st");
+  value::token b(std::string("primvars:") + "st");
+  value::token c("primvars:st0", 11);
+  TEST_CHECK(a.id() == b.id());
+  TEST_CHECK(a.id() == c.id());
+  TEST_CHECK(a.hash() == b.hash());
+  TEST_CHECK(a.str() == "primvars:st");
+  TEST_CHECK(&a.str() == &b.str());
+
+  value::token d("primvars:st1");
+  TEST_CHECK(a != d);
+  TEST_CHECK(a < d);
+  TEST_CHECK(!(d < a));
+  TEST_CHECK(!(a < b));
+
+  // Empty token
+  value::token e;
+  value::token f("");
+  value::token g(std::string(""));
+  TEST_CHECK(!e.valid());
+  TEST_CHECK(e == f);
+  TEST_CHECK(e == g);
+  TEST_CHECK(e.hash() == 0);
+  TEST_CHECK(e.str().empty());
+  TEST_CHECK(e < a);
+
+  // Embedded null character is a part of the token.
+  value::token h(std::string("bora\0dora", 9));
+  TEST_CHECK(h.str().size() == 9);
+  TEST_CHECK(h != value::token("bora"));
+
+  // Intern the same strings from multiple threads.
+  const size_t kNumThreads = 4;
+  const size_t kNumTokens = 1000;
+  std::vector<std::vector<value::token>> results(kNumThreads);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < kNumThreads; t++) {
+    workers.emplace_back([&results, t]() {
+      for (size_t i = 0; i < kNumTokens; i++) {
+        results[t].emplace_back("token_pool_test_" + std::to_string(i));
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (size_t t = 1; t < kNumThreads; t++) {
+    for (size_t i = 0; i < kNumTokens; i++) {
+      TEST_CHECK(results[t][i].id() == results[0][i].id());
+    }
+  }
+  TEST_CHECK(TokenPool::Size() >= kNumTokens);
+#endif
+}
@@ -1,3 +1,5 @@
 #pragma once
 
 void value_types_test(void);
+void value_cow_array_test(void);
+void value_token_pool_test(void);